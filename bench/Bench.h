@@ -0,0 +1,56 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+// Minimal micro-benchmark harness for the rental_bench binary.
+// Each benchmark is a function taking an iteration count; the runner calibrates
+// the count until a run takes at least the minimum time, then reports ns/op.
+
+#include <iostream>
+#include <streambuf>
+#include <string>
+
+namespace bench {
+
+typedef void (*BenchFn)(long long iterations);
+
+// Registers a benchmark at static-initialisation time
+struct Registration {
+    Registration(const char* name, BenchFn fn);
+};
+
+// Keeps the optimiser from discarding a computed value
+template <typename T>
+inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r"(&value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+// Swallows std::cout while a rendering benchmark runs, so we time the
+// formatting work rather than the terminal
+class SilenceOutput {
+public:
+    SilenceOutput() : saved(std::cout.rdbuf(&sink)) {}
+    ~SilenceOutput() { std::cout.rdbuf(saved); }
+
+private:
+    class NullBuffer : public std::streambuf {
+    protected:
+        int overflow(int c) override { return c; }
+        std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+    };
+    NullBuffer sink;
+    std::streambuf* saved;
+};
+
+} // namespace bench
+
+#define BENCHMARK(id, name)                                        \
+    static void id(long long iterations);                          \
+    static bench::Registration id##_registration(name, id);        \
+    static void id(long long iterations)
+
+#endif
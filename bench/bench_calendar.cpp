@@ -0,0 +1,92 @@
+// Benchmarks for AvailabilityCalendar over 200k dresses with a few bookings
+// each: the dresses free for a three-day wedding, the same answer from each
+// dress's list of booked ranges (what the overlap query does per dress), and
+// the common free days of a five-dress bridal party. One op is one query.
+
+#include "Bench.h"
+#include "AvailabilityCalendar.h"
+#include <utility>
+#include <vector>
+
+namespace {
+
+const int CALENDAR_DRESSES = 200000;
+const int BOOKINGS_PER_DRESS = 6;
+
+struct Booking {
+    int first;      // days into the window
+    int last;
+};
+
+// Booked ranges per dress, from a fixed LCG so every run sees the same data
+const std::vector<std::vector<Booking>>& bookings() {
+    static std::vector<std::vector<Booking>> data;
+    if (data.empty()) {
+        data.resize(CALENDAR_DRESSES);
+        unsigned int seed = 2468;
+        for (int i = 0; i < CALENDAR_DRESSES; ++i) {
+            for (int b = 0; b < BOOKINGS_PER_DRESS; ++b) {
+                seed = seed * 1103515245u + 12345u;
+                unsigned int r = seed >> 8;
+                Booking booking;
+                booking.first = static_cast<int>(r % AvailabilityCalendar::WINDOW_DAYS);
+                booking.last = booking.first + 1 + static_cast<int>((r >> 8) % 14);
+                data[i].push_back(booking);
+            }
+        }
+    }
+    return data;
+}
+
+const AvailabilityCalendar& calendar() {
+    static AvailabilityCalendar built;
+    if (built.size() == 0) {
+        built.reset("2026-01-01");
+        const std::vector<std::vector<Booking>>& source = bookings();
+        for (int i = 0; i < CALENDAR_DRESSES; ++i) built.addDress(i + 1, true);
+        for (int i = 0; i < CALENDAR_DRESSES; ++i) {
+            for (const Booking& booking : source[i]) {
+                for (int day = booking.first; day <= booking.last; ++day) built.markBooked(i + 1, day);
+            }
+        }
+    }
+    return built;
+}
+
+} // namespace
+
+BENCHMARK(benchCalendarFreeDresses, "calendar.freeDresses200k") {
+    const AvailabilityCalendar& dressCalendar = calendar();
+    for (long long i = 0; i < iterations; ++i) {
+        std::vector<int> free = dressCalendar.freeDresses(90, 92);
+        bench::doNotOptimize(free);
+    }
+}
+
+BENCHMARK(benchCalendarFreeDressesScan, "calendar.freeDresses200k.intervals") {
+    const std::vector<std::vector<Booking>>& source = bookings();
+    for (long long i = 0; i < iterations; ++i) {
+        std::vector<int> free;
+        for (int d = 0; d < CALENDAR_DRESSES; ++d) {
+            bool overlaps = false;
+            for (const Booking& booking : source[d]) {
+                if (booking.first <= 92 && booking.last >= 90) {
+                    overlaps = true;
+                    break;
+                }
+            }
+            if (!overlaps) free.push_back(d + 1);
+        }
+        bench::doNotOptimize(free);
+    }
+}
+
+BENCHMARK(benchCalendarFreeDays, "calendar.freeDays5") {
+    const AvailabilityCalendar& dressCalendar = calendar();
+    std::vector<int> party;
+    for (int id = 1001; id <= 1005; ++id) party.push_back(id);
+    for (long long i = 0; i < iterations; ++i) {
+        std::vector<int> free = dressCalendar.freeDays(party);
+        bench::doNotOptimize(free);
+    }
+}
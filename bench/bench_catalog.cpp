@@ -0,0 +1,146 @@
+// Benchmarks for DressCatalog over 1M dresses: a five-facet query with facet
+// counts, the same query answered by scanning a std::vector<Dress>, and
+// building the catalogue. One op is one query (or one build). The memory of
+// both representations is printed once to stderr.
+
+#include "Bench.h"
+#include "DressCatalog.h"
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace {
+
+const int CATALOG_DRESSES = 1000000;
+
+const std::vector<Dress>& dresses() {
+    static const char* CATEGORIES[] = { "Evening", "Formal", "Wedding", "Casual", "Cocktail", "Traditional",
+                                        "Party", "Vintage" };
+    static const char* SIZES[] = { "XS", "S", "M", "L", "XL" };
+    static const char* COLORS[] = { "Black", "White", "Ivory", "Red", "Pink", "Blue", "Navy", "Green", "Gold",
+                                    "Silver", "Purple", "Teal", "Yellow", "Gray", "Maroon", "Peach" };
+    static const char* CONDITIONS[] = { "Good", "Good", "Good", "Fair", "Poor" };
+    static const char* AVAILABILITY[] = { "Available", "Available", "Rented", "Maintenance" };
+    static const char* CLEANING[] = { "Clean", "Clean", "Clean", "Needs Cleaning", "In Cleaning" };
+    static const char* STYLES[] = { "Sparkly Ball Gown", "Elegant Maxi Dress", "Classic Baju Kurung",
+                                    "Royal Mermaid Gown", "Satin Sheath Dress" };
+    static std::vector<Dress> data;
+    if (data.empty()) {
+        data.reserve(CATALOG_DRESSES);
+        unsigned int seed = 12345;
+        for (int i = 0; i < CATALOG_DRESSES; ++i) {
+            seed = seed * 1103515245u + 12345u;
+            unsigned int r = seed >> 8;
+            Dress dress;
+            dress.DressID = i + 1;
+            dress.DressName = std::string(STYLES[r % 5]) + " " + std::to_string(i + 1);
+            dress.Category = CATEGORIES[(r >> 3) % 8];
+            dress.Size = SIZES[(r >> 6) % 5];
+            dress.Color = COLORS[(r >> 9) % 16];
+            dress.RentalPrice = Money::fromCents(8000 + (r % 400) * 100);
+            dress.ConditionStatus = CONDITIONS[(r >> 13) % 5];
+            dress.AvailabilityStatus = AVAILABILITY[(r >> 16) % 4];
+            dress.CleaningStatus = CLEANING[(r >> 18) % 5];
+            dress.Version = 1;
+            data.push_back(dress);
+        }
+    }
+    return data;
+}
+
+size_t stringHeap(const std::string& text) {
+    // Short strings live inside the object (small-string optimisation)
+    return text.capacity() > 15 ? text.capacity() + 1 : 0;
+}
+
+const DressCatalog& catalog() {
+    static DressCatalog built;
+    if (built.size() == 0) {
+        const std::vector<Dress>& source = dresses();
+        for (const Dress& dress : source) built.add(dress);
+
+        size_t vectorBytes = source.capacity() * sizeof(Dress);
+        for (const Dress& dress : source) {
+            vectorBytes += stringHeap(dress.DressName) + stringHeap(dress.Category) + stringHeap(dress.Size) +
+                           stringHeap(dress.Color) + stringHeap(dress.ConditionStatus) +
+                           stringHeap(dress.AvailabilityStatus) + stringHeap(dress.CleaningStatus);
+        }
+        std::cerr << "catalog: " << built.size() << " dresses in " << built.memoryBytes() / 1024 << " KB, "
+                  << "std::vector<Dress> " << vectorBytes / 1024 << " KB" << std::endl;
+    }
+    return built;
+}
+
+DressCatalog::Query eveningQuery() {
+    DressCatalog::Query query;
+    query.require(DressCatalog::SIZE, "M");
+    query.require(DressCatalog::COLOR, "Red");
+    query.require(DressCatalog::AVAILABILITY, "Available");
+    query.require(DressCatalog::CLEANING, "Clean");
+    query.require(DressCatalog::CATEGORY, "Evening");
+    return query;
+}
+
+} // namespace
+
+BENCHMARK(benchCatalogSearch, "catalog.facetSearch1M") {
+    const DressCatalog& dressCatalog = catalog();
+    DressCatalog::Query query = eveningQuery();
+    for (long long i = 0; i < iterations; ++i) {
+        DressCatalog::Result result = dressCatalog.search(query, 20);
+        bench::doNotOptimize(result);
+    }
+}
+
+BENCHMARK(benchCatalogBrowse, "catalog.unfiltered1M") {
+    const DressCatalog& dressCatalog = catalog();
+    DressCatalog::Query query;
+    for (long long i = 0; i < iterations; ++i) {
+        DressCatalog::Result result = dressCatalog.search(query, 20);
+        bench::doNotOptimize(result);
+    }
+}
+
+// The same answer (matches plus per-facet counts) from a row-by-row scan
+BENCHMARK(benchCatalogScan, "catalog.facetSearch1M.scan") {
+    const std::vector<Dress>& source = dresses();
+    catalog();
+    for (long long i = 0; i < iterations; ++i) {
+        size_t total = 0;
+        std::map<std::string, size_t> counts[DressCatalog::FACET_COUNT];
+        for (const Dress& dress : source) {
+            bool ok[DressCatalog::FACET_COUNT] = { dress.Category == "Evening", dress.Size == "M", dress.Color == "Red",
+                                                   true, dress.AvailabilityStatus == "Available",
+                                                   dress.CleaningStatus == "Clean" };
+            const std::string* values[DressCatalog::FACET_COUNT] = { &dress.Category, &dress.Size, &dress.Color,
+                                                                     &dress.ConditionStatus, &dress.AvailabilityStatus,
+                                                                     &dress.CleaningStatus };
+            int failed = 0;
+            int failedFacet = -1;
+            for (int f = 0; f < DressCatalog::FACET_COUNT; ++f) {
+                if (!ok[f]) {
+                    ++failed;
+                    failedFacet = f;
+                }
+            }
+            if (failed == 0) {
+                ++total;
+                for (int f = 0; f < DressCatalog::FACET_COUNT; ++f) ++counts[f][*values[f]];
+            } else if (failed == 1) {
+                ++counts[failedFacet][*values[failedFacet]];
+            }
+        }
+        bench::doNotOptimize(total);
+        bench::doNotOptimize(counts);
+    }
+}
+
+BENCHMARK(benchCatalogBuild, "catalog.build1M") {
+    const std::vector<Dress>& source = dresses();
+    for (long long i = 0; i < iterations; ++i) {
+        DressCatalog built;
+        for (const Dress& dress : source) built.add(dress);
+        bench::doNotOptimize(built);
+    }
+}
@@ -0,0 +1,42 @@
+// Benchmark for CleaningScheduler::plan: a week of returns, 3000 a day, with
+// cleaning capacity for 2500 a day and most dresses booked again within a
+// fortnight. One op plans the whole queue.
+
+#include "Bench.h"
+#include "CleaningScheduler.h"
+#include <climits>
+#include <vector>
+
+namespace {
+
+const int RETURN_DAYS = 7;
+const int RETURNS_PER_DAY = 3000;
+const int CAPACITY_PER_DAY = 2500;
+
+// From a fixed LCG so every run plans the same queue
+const std::vector<CleaningScheduler::Task>& queue() {
+    static std::vector<CleaningScheduler::Task> data;
+    if (data.empty()) {
+        unsigned int seed = 8642;
+        for (int i = 0; i < RETURN_DAYS * RETURNS_PER_DAY; ++i) {
+            seed = seed * 1103515245u + 12345u;
+            unsigned int r = seed >> 8;
+            CleaningScheduler::Task task;
+            task.jobID = i + 1;
+            task.returnDay = i / RETURNS_PER_DAY;
+            task.nextBookingDay = r % 5 == 0 ? LONG_MAX : task.returnDay + 1 + static_cast<long>((r >> 4) % 14);
+            task.cleanDay = 0;
+            data.push_back(task);
+        }
+    }
+    return data;
+}
+
+} // namespace
+
+BENCHMARK(benchCleaningPlan, "cleaning.plan21k") {
+    for (long long i = 0; i < iterations; ++i) {
+        std::vector<CleaningScheduler::Task> tasks(queue());
+        bench::doNotOptimize(CleaningScheduler::plan(tasks, 0, CAPACITY_PER_DAY));
+    }
+}
@@ -0,0 +1,230 @@
+// Benchmarks for the pure-CPU helpers: hashing, validation, date arithmetic,
+// money formatting, console rendering and result-row decoding.
+
+#include "Bench.h"
+#include "AuthManager.h"
+#include "InputValidator.h"
+#include "LateFeePolicy.h"
+#include "Money.h"
+#include "RentalManager.h"
+#include "ReportManager.h"
+#include "UIColors.h"
+#include <cctype>
+#include <cstdlib>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+std::vector<std::pair<std::string, Money>> monthlySales() {
+    static const char* MONTHS[] = { "January", "February", "March", "April", "May", "June", "July",
+                                    "August", "September", "October", "November", "December" };
+    std::vector<std::pair<std::string, Money>> data;
+    for (int i = 0; i < 12; ++i) {
+        data.push_back(std::make_pair(std::string(MONTHS[i]), Money::fromCents(150000 + 37525 * ((i * 7) % 12))));
+    }
+    return data;
+}
+
+// Payment amounts as the connector returns them for a DECIMAL(10, 2) column
+std::vector<std::string> paymentAmounts() {
+    std::vector<std::string> amounts;
+    for (int i = 0; i < 1000; ++i) {
+        amounts.push_back(Money::fromCents(1000 + (i * 7919) % 250000).toString());
+    }
+    return amounts;
+}
+
+// A result row as the connector holds it: column names plus text-protocol values.
+// Decoding mirrors what the managers do per row (lookup by name, then parse).
+struct TextRow {
+    std::vector<std::string> columns;
+    std::vector<std::string> values;
+
+    size_t find(const char* column) const {
+        for (size_t i = 0; i < columns.size(); ++i) {
+            const char* a = columns[i].c_str();
+            const char* b = column;
+            while (*a && std::tolower(static_cast<unsigned char>(*a)) == std::tolower(static_cast<unsigned char>(*b))) {
+                ++a;
+                ++b;
+            }
+            if (*a == '\0' && *b == '\0') return i;
+        }
+        return 0;
+    }
+    int getInt(const char* column) const { return std::atoi(values[find(column)].c_str()); }
+    std::string getString(const char* column) const { return values[find(column)]; }
+};
+
+TextRow rentalRow() {
+    TextRow row;
+    const char* columns[] = { "RentalID", "CustomerID", "RentalDate", "DueDate", "ReturnDate",
+                              "TotalAmount", "LateFee", "Status", "CreatedBy", "CreatedAt" };
+    const char* values[] = { "184223", "5121", "2025-03-14", "2025-03-17", "", "1245.00", "0.00",
+                             "Active", "3", "2025-03-14 10:22:41" };
+    row.columns.assign(columns, columns + 10);
+    row.values.assign(values, values + 10);
+    return row;
+}
+
+} // namespace
+
+BENCHMARK(benchHashPassword, "auth.hashPassword") {
+    std::string password = "Staff2025!@";
+    for (long long i = 0; i < iterations; ++i) {
+        std::string hash = AuthManager::hashPassword(password);
+        bench::doNotOptimize(hash);
+    }
+}
+
+BENCHMARK(benchValidEmail, "validator.isValidEmail") {
+    std::string email = "nurul.aisyah1024@example.com";
+    std::string tip;
+    for (long long i = 0; i < iterations; ++i) {
+        bool ok = InputValidator::isValidEmail(email, &tip);
+        bench::doNotOptimize(ok);
+    }
+}
+
+BENCHMARK(benchValidPhone, "validator.isValidPhone") {
+    std::string phone = "0123456789";
+    std::string tip;
+    for (long long i = 0; i < iterations; ++i) {
+        bool ok = InputValidator::isValidPhone(phone, &tip);
+        bench::doNotOptimize(ok);
+    }
+}
+
+BENCHMARK(benchValidIC, "validator.isValidIC") {
+    std::string ic = "900101145678";
+    std::string tip;
+    for (long long i = 0; i < iterations; ++i) {
+        bool ok = InputValidator::isValidIC(ic, &tip);
+        bench::doNotOptimize(ok);
+    }
+}
+
+BENCHMARK(benchValidDate, "validator.isValidDate") {
+    std::string date = "2025-02-28";
+    for (long long i = 0; i < iterations; ++i) {
+        bool ok = InputValidator::isValidDate(date);
+        bench::doNotOptimize(ok);
+    }
+}
+
+BENCHMARK(benchDueDate, "rental.calculateDueDate") {
+    RentalManager rentals;
+    std::string rentalDate = "2025-12-28";
+    for (long long i = 0; i < iterations; ++i) {
+        std::string due = rentals.calculateDueDate(rentalDate, 7);
+        bench::doNotOptimize(due);
+    }
+}
+
+// Derived on every rental read
+BENCHMARK(benchLateFee, "rental.lateFee") {
+    const LateFeePolicy& policy = LateFeePolicy::standard();
+    std::string dueDate = "2025-03-17";
+    std::string today = "2025-04-02";
+    for (long long i = 0; i < iterations; ++i) {
+        Money fee = policy.lateFee(dueDate, "", today);
+        bench::doNotOptimize(fee);
+    }
+}
+
+// One amount cell of a report, written straight into a buffer
+BENCHMARK(benchMoneyFormat, "money.format") {
+    char buffer[Money::MAX_TEXT];
+    for (long long i = 0; i < iterations; ++i) {
+        size_t length = Money::fromCents(123456 + (i & 0xffff)).format(buffer);
+        bench::doNotOptimize(length);
+        bench::doNotOptimize(buffer[0]);
+    }
+}
+
+// The same cell the way the reports used to format a double
+BENCHMARK(benchMoneyFormatStream, "money.formatStream") {
+    for (long long i = 0; i < iterations; ++i) {
+        std::ostringstream out;
+        out << std::fixed << std::setprecision(2) << (1234.56 + (i & 0xffff) / 100.0);
+        std::string text = out.str();
+        bench::doNotOptimize(text);
+    }
+}
+
+// Reading and totalling payments, one amount per iteration; the total stays exact
+BENCHMARK(benchMoneySum, "money.parseAndSum") {
+    std::vector<std::string> amounts = paymentAmounts();
+    Money total;
+    for (long long i = 0; i < iterations; ++i) {
+        total += Money::fromString(amounts[static_cast<size_t>(i) % amounts.size()]);
+    }
+    bench::doNotOptimize(total);
+}
+
+BENCHMARK(benchColorize, "ui.colorize") {
+    std::string text = "Rental created successfully";
+    for (long long i = 0; i < iterations; ++i) {
+        std::string colored = UIColors::colorize(text, UIColors::GREEN);
+        bench::doNotOptimize(colored);
+    }
+}
+
+BENCHMARK(benchPrintCentered, "ui.printCentered") {
+    bench::SilenceOutput silence;
+    std::string text = "DRESS RENTAL MANAGEMENT SYSTEM";
+    for (long long i = 0; i < iterations; ++i) {
+        UIColors::printCentered(text, 80, UIColors::CYAN);
+    }
+}
+
+BENCHMARK(benchBarChart, "report.displayBarChart") {
+    bench::SilenceOutput silence;
+    ReportManager reports;
+    std::vector<std::pair<std::string, double>> data;
+    for (const auto& month : monthlySales()) {
+        data.push_back(std::make_pair(month.first, month.second.toDouble()));
+    }
+    for (long long i = 0; i < iterations; ++i) {
+        reports.displayBarChart("Monthly Sales Trend", data);
+    }
+}
+
+BENCHMARK(benchTextChart, "report.displayTextChart") {
+    bench::SilenceOutput silence;
+    ReportManager reports;
+    std::vector<std::pair<std::string, Money>> data = monthlySales();
+    for (long long i = 0; i < iterations; ++i) {
+        reports.displayTextChart("Text-Based Monthly Sales Chart", data);
+    }
+}
+
+BENCHMARK(benchDecodeRental, "rows.decodeRental") {
+    TextRow row = rentalRow();
+    for (long long i = 0; i < iterations; ++i) {
+        Rental rental;
+        rental.RentalID = row.getInt("RentalID");
+        rental.CustomerID = row.getInt("CustomerID");
+        rental.RentalDate = row.getString("RentalDate");
+        rental.DueDate = row.getString("DueDate");
+        rental.ReturnDate = row.getString("ReturnDate");
+        rental.TotalAmount = Money::fromString(row.getString("TotalAmount"));
+        rental.LateFee = Money::fromString(row.getString("LateFee"));
+        rental.Status = row.getString("Status");
+        bench::doNotOptimize(rental);
+    }
+}
+
+// The due-date parse behind the overdue check and late fee of every rental
+BENCHMARK(benchParseDueDate, "rows.parseDueDate") {
+    std::string dueDate = "2025-03-17";
+    for (long long i = 0; i < iterations; ++i) {
+        long dueDay = 0;
+        bench::doNotOptimize(LateFeePolicy::parseDate(dueDate, dueDay));
+        bench::doNotOptimize(dueDay);
+    }
+}
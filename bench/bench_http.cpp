@@ -0,0 +1,73 @@
+// Benchmarks for the HTTP API: parsing a browser-sized GET with its query
+// string, and rendering the 50-dress JSON page of a catalogue search over 50k
+// dresses (the work a cache miss costs before the body is shared). One op is
+// one request or one page.
+
+#include "Bench.h"
+#include "HttpServer.h"
+#include <cstring>
+#include <string>
+
+namespace {
+
+const int HTTP_DRESSES = 50000;
+
+const DressCatalog& catalog() {
+    static const char* CATEGORIES[] = { "Evening", "Formal", "Wedding", "Casual", "Cocktail", "Traditional" };
+    static const char* SIZES[] = { "XS", "S", "M", "L", "XL" };
+    static const char* COLORS[] = { "Black", "White", "Ivory", "Red", "Pink", "Blue", "Navy", "Gold" };
+    static DressCatalog built;
+    if (built.size() == 0) {
+        unsigned int seed = 4242;
+        for (int i = 0; i < HTTP_DRESSES; ++i) {
+            seed = seed * 1103515245u + 12345u;
+            unsigned int r = seed >> 8;
+            Dress dress;
+            dress.DressID = i + 1;
+            dress.DressName = "Satin Sheath Dress " + std::to_string(i + 1);
+            dress.Category = CATEGORIES[r % 6];
+            dress.Size = SIZES[(r >> 4) % 5];
+            dress.Color = COLORS[(r >> 8) % 8];
+            dress.RentalPrice = Money::fromCents(8000 + (r % 400) * 100);
+            dress.ConditionStatus = "Good";
+            dress.AvailabilityStatus = r % 4 == 0 ? "Rented" : "Available";
+            dress.CleaningStatus = "Clean";
+            dress.Version = 1;
+            built.add(dress);
+        }
+    }
+    return built;
+}
+
+const char REQUEST[] =
+    "GET /api/dresses?category=Evening,Formal&size=M&availability=Available&limit=50 HTTP/1.1\r\n"
+    "Host: localhost:8080\r\n"
+    "User-Agent: Mozilla/5.0 (X11; Linux x86_64; rv:128.0) Gecko/20100101 Firefox/128.0\r\n"
+    "Accept: application/json\r\n"
+    "Accept-Language: en-GB,en;q=0.5\r\n"
+    "Accept-Encoding: gzip, deflate\r\n"
+    "Connection: keep-alive\r\n"
+    "\r\n";
+
+} // namespace
+
+BENCHMARK(benchHttpParseRequest, "http.parseRequest") {
+    size_t length = std::strlen(REQUEST);
+    for (long long i = 0; i < iterations; ++i) {
+        HttpServer::Request request;
+        int errorStatus = 0;
+        bench::doNotOptimize(HttpServer::parseRequest(REQUEST, length, request, errorStatus));
+    }
+}
+
+BENCHMARK(benchHttpRenderDresses, "http.renderDresses50") {
+    const DressCatalog& dresses = catalog();
+    DressCatalog::Query query;
+    query.require(DressCatalog::CATEGORY, "Evening");
+    query.require(DressCatalog::CATEGORY, "Formal");
+    query.require(DressCatalog::SIZE, "M");
+    query.require(DressCatalog::AVAILABILITY, "Available");
+    for (long long i = 0; i < iterations; ++i) {
+        bench::doNotOptimize(HttpServer::renderDresses(dresses, query, 50).size());
+    }
+}
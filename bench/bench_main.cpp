@@ -0,0 +1,130 @@
+// Benchmark runner: calibrates each registered benchmark and prints the results
+// as JSON. The format is versioned by "schema" so results from different
+// releases can be compared by tooling.
+//
+// Usage: ./rental_bench [--filter SUBSTRING] [--min-time SECONDS] [--out FILE]
+
+#include "Bench.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Entry {
+    std::string name;
+    bench::BenchFn fn;
+};
+
+struct Result {
+    std::string name;
+    long long iterations;
+    double nsPerOp;
+};
+
+std::vector<Entry>& registry() {
+    static std::vector<Entry> entries;
+    return entries;
+}
+
+double timeRun(bench::BenchFn fn, long long iterations) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    fn(iterations);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+Result runBenchmark(const Entry& entry, double minTime) {
+    // An untimed zero-iteration run builds any fixture the benchmark sets up
+    // on first use, so that cost is not charged to its first timed run
+    entry.fn(0);
+
+    // Grow the iteration count until one run covers the minimum time
+    long long iterations = 1;
+    double seconds = timeRun(entry.fn, iterations);
+    while (seconds < minTime && iterations < (1LL << 40)) {
+        double scale = seconds > 0.0 ? (minTime * 1.2) / seconds : 100.0;
+        scale = std::min(std::max(scale, 2.0), 100.0);
+        iterations = static_cast<long long>(iterations * scale);
+        seconds = timeRun(entry.fn, iterations);
+    }
+    Result result;
+    result.name = entry.name;
+    result.iterations = iterations;
+    result.nsPerOp = seconds * 1e9 / static_cast<double>(iterations);
+    return result;
+}
+
+std::string escapeJson(const std::string& text) {
+    std::string out;
+    for (char c : text) {
+        if (c == '"' || c == '\\') out += '\\';
+        out += c;
+    }
+    return out;
+}
+
+void writeJson(std::ostream& out, const std::vector<Result>& results) {
+    out << "{\"schema\":1,\"benchmarks\":[";
+    for (size_t i = 0; i < results.size(); ++i) {
+        char numbers[128];
+        std::snprintf(numbers, sizeof(numbers), "\"iterations\":%lld,\"ns_per_op\":%.3f,\"ops_per_sec\":%.1f",
+                      results[i].iterations, results[i].nsPerOp,
+                      results[i].nsPerOp > 0.0 ? 1e9 / results[i].nsPerOp : 0.0);
+        out << (i ? "," : "") << "\n  {\"name\":\"" << escapeJson(results[i].name) << "\"," << numbers << "}";
+    }
+    out << "\n]}\n";
+}
+
+} // namespace
+
+bench::Registration::Registration(const char* name, BenchFn fn) {
+    Entry entry;
+    entry.name = name;
+    entry.fn = fn;
+    registry().push_back(entry);
+}
+
+int main(int argc, char** argv) {
+    std::string filter;
+    std::string outPath;
+    double minTime = 0.25;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string arg = argv[i];
+        if (arg == "--filter") filter = argv[i + 1];
+        else if (arg == "--min-time") minTime = std::atof(argv[i + 1]);
+        else if (arg == "--out") outPath = argv[i + 1];
+        else {
+            std::cerr << "Usage: rental_bench [--filter SUBSTRING] [--min-time SECONDS] [--out FILE]" << std::endl;
+            return 1;
+        }
+    }
+
+    // Registration order depends on link order; sort so the output is stable
+    std::vector<Entry> entries = registry();
+    std::sort(entries.begin(), entries.end(),
+              [](const Entry& a, const Entry& b) { return a.name < b.name; });
+
+    std::vector<Result> results;
+    for (const Entry& entry : entries) {
+        if (!filter.empty() && entry.name.find(filter) == std::string::npos) continue;
+        results.push_back(runBenchmark(entry, minTime));
+        std::cerr << entry.name << ": " << results.back().nsPerOp << " ns/op" << std::endl;
+    }
+
+    if (outPath.empty()) {
+        writeJson(std::cout, results);
+    } else {
+        std::ofstream file(outPath.c_str());
+        if (!file) {
+            std::cerr << "Error: cannot write " << outPath << std::endl;
+            return 1;
+        }
+        writeJson(file, results);
+    }
+    return 0;
+}
@@ -0,0 +1,92 @@
+// Benchmarks for the report tables on 1M rows: the monthly sales and dress
+// utilization renderers, and the same monthly sales rows formatted cell by
+// cell through iostream the way the reports used to. One op is one table.
+
+#include "Bench.h"
+#include "Format.h"
+#include "ReportManager.h"
+#include <iomanip>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+namespace {
+
+const int REPORT_ROWS = 1000000;
+
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+    std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+};
+
+const std::vector<MonthlySales>& salesRows() {
+    static std::vector<MonthlySales> rows;
+    if (rows.empty()) {
+        rows.reserve(REPORT_ROWS);
+        for (int i = 0; i < REPORT_ROWS; ++i) {
+            MonthlySales row;
+            int month = i % 12 + 1;
+            row.Month = Format::integer(2000 + i / 12 % 1000) + (month < 10 ? "-0" : "-") + Format::integer(month);
+            row.TotalSales = Money::fromCents(150000 + (i * 7919LL) % 2500000);
+            row.RentalCount = 40 + i % 260;
+            rows.push_back(row);
+        }
+    }
+    return rows;
+}
+
+const std::vector<DressUtilization>& utilizationRows() {
+    static const char* NAMES[] = { "Red Silk Evening Gown", "Baju Kurung Moden", "Ivory Lace Wedding Dress",
+                                   "Emerald Sequin Cocktail Dress with Long Train", "Navy Chiffon Maxi" };
+    static std::vector<DressUtilization> rows;
+    if (rows.empty()) {
+        rows.reserve(REPORT_ROWS);
+        for (int i = 0; i < REPORT_ROWS; ++i) {
+            DressUtilization row;
+            row.DressID = i + 1;
+            row.DressName = NAMES[i % 5];
+            row.RentalCount = (i * 31) % 180;
+            row.UtilizationRate = row.RentalCount * 100.0 / 4000.0;
+            rows.push_back(row);
+        }
+    }
+    return rows;
+}
+
+} // namespace
+
+BENCHMARK(benchMonthlySalesReport, "report.monthlySales1M") {
+    NullBuffer sink;
+    std::ostream out(&sink);
+    ReportManager reports;
+    const std::vector<MonthlySales>& rows = salesRows();
+    for (long long i = 0; i < iterations; ++i) {
+        reports.renderMonthlySales(out, rows);
+    }
+}
+
+// The per-cell setw/setprecision formatting the report used before Format
+BENCHMARK(benchMonthlySalesStream, "report.monthlySales1M.iostream") {
+    NullBuffer sink;
+    std::ostream out(&sink);
+    const std::vector<MonthlySales>& rows = salesRows();
+    for (long long i = 0; i < iterations; ++i) {
+        for (const MonthlySales& row : rows) {
+            out << std::setw(15) << row.Month
+                << std::setw(20) << std::fixed << std::setprecision(2) << row.TotalSales.toDouble()
+                << std::setw(20) << row.RentalCount << '\n';
+        }
+    }
+}
+
+BENCHMARK(benchUtilizationReport, "report.dressUtilization1M") {
+    NullBuffer sink;
+    std::ostream out(&sink);
+    ReportManager reports;
+    const std::vector<DressUtilization>& rows = utilizationRows();
+    for (long long i = 0; i < iterations; ++i) {
+        reports.renderDressUtilization(out, rows);
+    }
+}
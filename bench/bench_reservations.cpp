@@ -0,0 +1,81 @@
+// Benchmarks for ReservationPlanner: planning a year of 40k reservations over
+// 8 category/size groups of 60 dresses each from scratch (what every replan
+// does after loading them), and one booking change on the planned year, which
+// moves no other reservation. The load is about 80% of the dress-days, so
+// some reservations wait and every group gets solved.
+
+#include "Bench.h"
+#include "ReservationPlanner.h"
+#include <string>
+#include <vector>
+
+namespace {
+
+const int GROUPS = 8;
+const int DRESSES_PER_GROUP = 60;
+const int RESERVATIONS = 40000;
+const int YEAR_DAYS = 365;
+
+struct Request {
+    int group;
+    long firstDay;
+    long lastDay;
+};
+
+// From a fixed LCG so every run plans the same year
+const std::vector<Request>& requests() {
+    static std::vector<Request> data;
+    if (data.empty()) {
+        unsigned int seed = 1357;
+        for (int i = 0; i < RESERVATIONS; ++i) {
+            seed = seed * 1103515245u + 12345u;
+            unsigned int r = seed >> 8;
+            Request request;
+            request.group = static_cast<int>(r % GROUPS);
+            request.firstDay = static_cast<long>((r >> 4) % YEAR_DAYS);
+            request.lastDay = request.firstDay + 1 + static_cast<long>((r >> 12) % 5);
+            data.push_back(request);
+        }
+    }
+    return data;
+}
+
+std::string groupName(int group) {
+    return ReservationPlanner::groupOf("Gown", std::to_string(group));
+}
+
+void plan(ReservationPlanner& planner) {
+    for (int g = 0; g < GROUPS; ++g) {
+        for (int d = 0; d < DRESSES_PER_GROUP; ++d) planner.addDress(groupName(g), g * DRESSES_PER_GROUP + d + 1, 1);
+    }
+    const std::vector<Request>& source = requests();
+    for (size_t i = 0; i < source.size(); ++i) {
+        planner.addReservation(static_cast<int>(i + 1), groupName(source[i].group), source[i].firstDay,
+                               source[i].lastDay);
+    }
+    planner.solveAll();
+}
+
+} // namespace
+
+BENCHMARK(benchReservationsPlan, "reservations.plan40k") {
+    for (long long i = 0; i < iterations; ++i) {
+        ReservationPlanner planner;
+        plan(planner);
+        bench::doNotOptimize(planner.assignedCount());
+    }
+}
+
+BENCHMARK(benchReservationsChange, "reservations.change") {
+    static ReservationPlanner planner;
+    if (planner.size() == 0) plan(planner);
+    const std::vector<Request>& source = requests();
+    for (long long i = 0; i < iterations; ++i) {
+        // Cancel a reservation, then book it again
+        int reservationID = static_cast<int>(i % RESERVATIONS) + 1;
+        const Request& request = source[reservationID - 1];
+        planner.removeReservation(reservationID);
+        bench::doNotOptimize(planner.addReservation(reservationID, groupName(request.group), request.firstDay,
+                                                    request.lastDay));
+    }
+}
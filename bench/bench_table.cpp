@@ -0,0 +1,93 @@
+// Benchmarks for TableRenderer on 100k-row tables: building the rows (where
+// widths are measured), rendering a built table, and streaming rows straight
+// through. One op is one whole table.
+
+#include "Bench.h"
+#include "TableRenderer.h"
+#include "UIColors.h"
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+namespace {
+
+const int TABLE_ROWS = 100000;
+
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+    std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+};
+
+void defineColumns(TableRenderer& table) {
+    table.addColumn("ID", 6);
+    table.addColumn("Name");
+    table.addColumn("IC Number", 14);
+    table.addColumn("Phone", 12);
+    table.addColumn("Email");
+    table.addColumn("Status", 10);
+}
+
+// Rows shaped like the customer list; every fifth name is long enough to be
+// cut, and the status cell is colored like the rental listings
+std::vector<std::vector<std::string>> sampleRows() {
+    static const char* NAMES[] = { "Nurul Aisyah binti Ahmad", "Tan Mei Ling", "Siti Hajar", "Rajesh Kumar",
+                                   "Muhammad Hafiz bin Abdullah Rahman" };
+    std::string active = UIColors::colorize("Active", UIColors::GREEN);
+    std::string overdue = UIColors::colorize("Overdue", UIColors::RED);
+    std::vector<std::vector<std::string>> rows;
+    rows.reserve(TABLE_ROWS);
+    for (int i = 0; i < TABLE_ROWS; ++i) {
+        std::vector<std::string> row;
+        row.push_back(std::to_string(i + 1));
+        row.push_back(NAMES[i % 5]);
+        row.push_back("90010114" + std::to_string(1000000 + i));
+        row.push_back("01" + std::to_string(20000000 + i));
+        row.push_back("customer" + std::to_string(i) + "@example.com");
+        row.push_back(i % 7 == 0 ? overdue : active);
+        rows.push_back(row);
+    }
+    return rows;
+}
+
+const std::vector<std::vector<std::string>>& rows() {
+    static const std::vector<std::vector<std::string>> data = sampleRows();
+    return data;
+}
+
+} // namespace
+
+BENCHMARK(benchTableBuild, "table.build100k") {
+    const std::vector<std::vector<std::string>>& data = rows();
+    for (long long i = 0; i < iterations; ++i) {
+        TableRenderer table(80);
+        defineColumns(table);
+        for (const auto& row : data) table.addRow(row);
+        bench::doNotOptimize(table);
+    }
+}
+
+BENCHMARK(benchTableRender, "table.render100k") {
+    NullBuffer sink;
+    std::ostream out(&sink);
+    TableRenderer table(80);
+    defineColumns(table);
+    for (const auto& row : rows()) table.addRow(row);
+    for (long long i = 0; i < iterations; ++i) {
+        table.render(out);
+    }
+}
+
+BENCHMARK(benchTableStream, "table.stream100k") {
+    NullBuffer sink;
+    std::ostream out(&sink);
+    const std::vector<std::vector<std::string>>& data = rows();
+    for (long long i = 0; i < iterations; ++i) {
+        TableRenderer table(80);
+        defineColumns(table);
+        table.beginStream(out);
+        for (const auto& row : data) table.streamRow(row);
+        table.endStream();
+    }
+}
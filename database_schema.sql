@@ -1,6 +1,8 @@
 -- Dress Rental Management System Database Schema
 -- Database: dress_rental_db
 -- User: root, Password: ""
+-- Matches schema migration 10 in src/SchemaMigrator.cpp. The application applies
+-- its migrations at startup, so keep the two in step.
 
 CREATE DATABASE IF NOT EXISTS dress_rental_db;
 USE dress_rental_db;
@@ -48,9 +50,14 @@ CREATE TABLE IF NOT EXISTS Dresses (
     CleaningStatus VARCHAR(20) DEFAULT 'Clean',
     StockQuantity INT DEFAULT 1,
     MinimumStockLevel INT DEFAULT 1,
+    UnitsOut INT NOT NULL DEFAULT 0,
+    LowStock BOOLEAN NOT NULL DEFAULT FALSE,
+    Version INT NOT NULL DEFAULT 0,
     CreatedAt TIMESTAMP DEFAULT CURRENT_TIMESTAMP,
-    INDEX idx_category (Category),
-    INDEX idx_availability (AvailabilityStatus)
+    INDEX idx_category_availability (Category, AvailabilityStatus),
+    INDEX idx_category_size (Category, Size),
+    INDEX idx_availability (AvailabilityStatus),
+    INDEX idx_low_stock (LowStock)
 );
 
 -- Rental Transactions Table
@@ -59,6 +66,7 @@ CREATE TABLE IF NOT EXISTS Rentals (
     CustomerID INT NOT NULL,
     RentalDate DATE NOT NULL,
     DueDate DATE NOT NULL,
+    HeldThrough DATE,
     ReturnDate DATE,
     TotalAmount DECIMAL(10, 2) NOT NULL,
     LateFee DECIMAL(10, 2) DEFAULT 0.00,
@@ -67,9 +75,10 @@ CREATE TABLE IF NOT EXISTS Rentals (
     CreatedAt TIMESTAMP DEFAULT CURRENT_TIMESTAMP,
     FOREIGN KEY (CustomerID) REFERENCES Customers(CustomerID) ON DELETE CASCADE,
     FOREIGN KEY (CreatedBy) REFERENCES Users(UserID) ON DELETE SET NULL,
-    INDEX idx_customer (CustomerID),
-    INDEX idx_status (Status),
-    INDEX idx_due_date (DueDate)
+    INDEX idx_customer_status (CustomerID, Status),
+    INDEX idx_status_due (Status, DueDate),
+    INDEX idx_due_date (DueDate),
+    INDEX idx_date_amounts (RentalDate, TotalAmount, LateFee)
 );
 
 -- Rental Items Table (Many-to-Many: Rentals to Dresses)
@@ -81,7 +90,7 @@ CREATE TABLE IF NOT EXISTS RentalItems (
     FOREIGN KEY (RentalID) REFERENCES Rentals(RentalID) ON DELETE CASCADE,
     FOREIGN KEY (DressID) REFERENCES Dresses(DressID) ON DELETE CASCADE,
     INDEX idx_rental (RentalID),
-    INDEX idx_dress (DressID)
+    INDEX idx_dress_rental (DressID, RentalID)
 );
 
 -- Payments Table
@@ -97,8 +106,8 @@ CREATE TABLE IF NOT EXISTS Payments (
     CreatedAt TIMESTAMP DEFAULT CURRENT_TIMESTAMP,
     FOREIGN KEY (RentalID) REFERENCES Rentals(RentalID) ON DELETE CASCADE,
     FOREIGN KEY (ProcessedBy) REFERENCES Users(UserID) ON DELETE SET NULL,
-    INDEX idx_rental (RentalID),
-    INDEX idx_status (Status),
+    INDEX idx_rental_status (RentalID, Status, Amount),
+    INDEX idx_status_date (Status, PaymentDate, Amount),
     INDEX idx_payment_date (PaymentDate)
 );
 
@@ -115,3 +124,80 @@ CREATE TABLE IF NOT EXISTS ActivityLog (
     INDEX idx_user (UserID),
     INDEX idx_timestamp (Timestamp)
 );
+
+-- System Counters Table (refreshed by the background overdue sweeper)
+CREATE TABLE IF NOT EXISTS SystemCounters (
+    CounterName VARCHAR(50) PRIMARY KEY,
+    CounterValue DECIMAL(14, 2) NOT NULL DEFAULT 0,
+    UpdatedAt TIMESTAMP DEFAULT CURRENT_TIMESTAMP
+);
+
+-- Reminders Table (queued by the overdue sweeper, one per rental, type and day)
+CREATE TABLE IF NOT EXISTS Reminders (
+    ReminderID INT AUTO_INCREMENT PRIMARY KEY,
+    RentalID INT NOT NULL,
+    CustomerID INT NOT NULL,
+    ReminderType VARCHAR(20) NOT NULL,
+    ReminderDate DATE NOT NULL,
+    Status VARCHAR(20) DEFAULT 'Queued',
+    CreatedAt TIMESTAMP DEFAULT CURRENT_TIMESTAMP,
+    FOREIGN KEY (RentalID) REFERENCES Rentals(RentalID) ON DELETE CASCADE,
+    FOREIGN KEY (CustomerID) REFERENCES Customers(CustomerID) ON DELETE CASCADE,
+    UNIQUE KEY uq_reminder (RentalID, ReminderType, ReminderDate),
+    INDEX idx_status (Status)
+);
+
+-- Rental Balances Table (ledger kept in step with Rentals and Payments by the application)
+CREATE TABLE IF NOT EXISTS RentalBalances (
+    RentalID INT PRIMARY KEY,
+    AmountDue DECIMAL(10, 2) NOT NULL DEFAULT 0,
+    AmountPaid DECIMAL(10, 2) NOT NULL DEFAULT 0,
+    Outstanding DECIMAL(10, 2) AS (AmountDue - AmountPaid) STORED,
+    UpdatedAt TIMESTAMP DEFAULT CURRENT_TIMESTAMP ON UPDATE CURRENT_TIMESTAMP,
+    FOREIGN KEY (RentalID) REFERENCES Rentals(RentalID) ON DELETE CASCADE,
+    INDEX idx_outstanding (Outstanding)
+);
+
+-- Dress Daily Stock Table (units of each dress reserved per day by active rentals)
+CREATE TABLE IF NOT EXISTS DressDailyStock (
+    DressID INT NOT NULL,
+    StockDate DATE NOT NULL,
+    Reserved INT NOT NULL DEFAULT 0,
+    PRIMARY KEY (DressID, StockDate),
+    FOREIGN KEY (DressID) REFERENCES Dresses(DressID) ON DELETE CASCADE
+);
+
+-- Reservations Table (advance bookings for a category and size; the dress is assigned by the planner)
+CREATE TABLE IF NOT EXISTS Reservations (
+    ReservationID INT AUTO_INCREMENT PRIMARY KEY,
+    CustomerID INT NOT NULL,
+    Category VARCHAR(50) NOT NULL,
+    Size VARCHAR(10) NOT NULL,
+    StartDate DATE NOT NULL,
+    EndDate DATE NOT NULL,
+    Status VARCHAR(20) NOT NULL DEFAULT 'Booked',
+    AssignedDressID INT NULL,
+    RentalID INT NULL,
+    CreatedAt TIMESTAMP DEFAULT CURRENT_TIMESTAMP,
+    FOREIGN KEY (CustomerID) REFERENCES Customers(CustomerID) ON DELETE CASCADE,
+    FOREIGN KEY (AssignedDressID) REFERENCES Dresses(DressID) ON DELETE SET NULL,
+    FOREIGN KEY (RentalID) REFERENCES Rentals(RentalID) ON DELETE SET NULL,
+    INDEX idx_group (Category, Size, Status, EndDate),
+    INDEX idx_status_end (Status, EndDate)
+);
+
+-- Cleaning Jobs Table (returned dresses waiting for cleaning; the unit stays reserved through HeldThrough)
+CREATE TABLE IF NOT EXISTS CleaningJobs (
+    JobID INT AUTO_INCREMENT PRIMARY KEY,
+    DressID INT NOT NULL,
+    RentalID INT NULL,
+    ReturnDate DATE NOT NULL,
+    ScheduledDate DATE NULL,
+    HeldThrough DATE NOT NULL,
+    CompletedDate DATE NULL,
+    Status VARCHAR(20) NOT NULL DEFAULT 'Queued',
+    CreatedAt TIMESTAMP DEFAULT CURRENT_TIMESTAMP,
+    FOREIGN KEY (DressID) REFERENCES Dresses(DressID) ON DELETE CASCADE,
+    FOREIGN KEY (RentalID) REFERENCES Rentals(RentalID) ON DELETE SET NULL,
+    INDEX idx_status_dress (Status, DressID)
+);
@@ -0,0 +1,36 @@
+#ifndef APPCONFIG_H
+#define APPCONFIG_H
+
+#include <map>
+#include <string>
+
+// Runtime settings, loaded once on first use. A setting named "db_host" is
+// read from the environment variable DRS_DB_HOST first, then from the config
+// file, then falls back to the caller's default. The file (DRS_CONFIG, default
+// dress_rental.conf in the working directory) holds "key = value" lines; '#'
+// starts a comment and a missing file is not an error.
+class AppConfig {
+public:
+    static AppConfig& getInstance();
+
+    std::string getString(const std::string& key, const std::string& fallback) const;
+    // Malformed numbers are reported on std::cerr and replaced by the fallback
+    int getInt(const std::string& key, int fallback) const;
+    bool getBool(const std::string& key, bool fallback) const;
+
+    // Config file that was read; empty if none was found
+    const std::string& getSourcePath() const { return sourcePath; }
+
+private:
+    AppConfig();
+    AppConfig(const AppConfig&) = delete;
+    AppConfig& operator=(const AppConfig&) = delete;
+
+    bool lookup(const std::string& key, std::string& value) const;
+    bool loadFile(const std::string& path);
+
+    std::map<std::string, std::string> fileValues;
+    std::string sourcePath;
+};
+
+#endif
@@ -22,6 +22,13 @@ class AuthManager {
 public:
     static std::string hashPassword(const std::string& password);
     static bool verifyPassword(const std::string& password, const std::string& hash);
+    // Checks the credentials of an active Staff or Administrator account and
+    // fills user, without touching the logged-in session (server terminals
+    // keep one each); updates LastLogin
+    static bool authenticate(const std::string& username, const std::string& password, User& user);
+    // Reloads the account behind a session; false if it has been deactivated,
+    // deleted or made a Customer since, or the lookup failed
+    static bool reloadUser(int userID, User& user);
     bool login(const std::string& username, const std::string& password);
     bool logout();
     bool changePassword(int userID, const std::string& oldPassword, const std::string& newPassword);
@@ -30,7 +37,6 @@ public:
     bool isLoggedIn();
     bool hasPermission(const std::string& requiredRole);
     void logActivity(const std::string& action, const std::string& tableName = "", int recordID = 0, const std::string& details = "");
-    std::vector<std::pair<int, std::string>> getLowStockDresses(int threshold = 3);
     
 private:
     static User* currentUser;
@@ -0,0 +1,73 @@
+#ifndef AVAILABILITYCALENDAR_H
+#define AVAILABILITYCALENDAR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Which dresses are free on which days, over a fixed window of WINDOW_DAYS
+// days from a start date (today by default). A day is free for a dress if it
+// has a unit left that day (see DressStock) and is not in maintenance.
+//
+// The window is kept twice as bitsets: per dress, one bit per day, for "free
+// days of this dress" and for combining a few dresses; and per day, one bit
+// per dress, for "dresses free on the wedding date". Combining days is then a
+// word-wise AND across all dresses, done 128 or 256 bits at a time where the
+// target has SSE2 or AVX2.
+//
+// Like DressCatalog the calendar is a snapshot: load() reads the database
+// once and later bookings are not applied to it.
+class AvailabilityCalendar {
+public:
+    static const int WINDOW_DAYS = 180;
+
+    AvailabilityCalendar();
+
+    // Replaces the contents with the dresses and their fully booked days in
+    // the window starting at startDate (YYYY-MM-DD, empty for today); false
+    // on error
+    bool load(const std::string& startDate = "");
+    // Starts an empty calendar at startDate; false if it is not a date
+    bool reset(const std::string& startDate);
+
+    // DressIDs must arrive in ascending order; a dress that cannot be rented
+    // at all starts with no free day
+    void addDress(int dressID, bool rentable);
+    // Marks one day (0 = the start date) of a dress as taken
+    void markBooked(int dressID, int day);
+
+    size_t size() const { return ids.size(); }
+    bool contains(int dressID) const { return rowOf(dressID) >= 0; }
+    const std::string& getStartDate() const { return startDate; }
+    // Day of the window for a date, or -1 outside it
+    int dayOf(const std::string& date) const;
+    std::string dateAt(int day) const;
+
+    bool isFree(int dressID, int day) const;
+    // Days from firstDay to lastDay on which every one of the dresses is free
+    std::vector<int> freeDays(const std::vector<int>& dressIDs, int firstDay = 0,
+                              int lastDay = WINDOW_DAYS - 1) const;
+    // Dresses free on every day from firstDay to lastDay, by DressID; up to
+    // limit of them, 0 = all
+    std::vector<int> freeDresses(int firstDay, int lastDay, size_t limit = 0) const;
+
+    // Month grids of the window with the days the dresses are all free
+    void displayCalendar(const std::vector<int>& dressIDs) const;
+
+    size_t memoryBytes() const;
+
+private:
+    static const int ROW_WORDS = (WINDOW_DAYS + 63) / 64;
+
+    // Index of a DressID in ids, or -1
+    long rowOf(int dressID) const;
+
+    std::string startDate;
+    long startDay;                              // day number of startDate
+    std::vector<int> ids;                       // ascending; row number = index
+    std::vector<uint64_t> rows;                 // ROW_WORDS per dress, bit = day
+    std::vector<std::vector<uint64_t>> days;    // per day, bit = row
+};
+
+#endif
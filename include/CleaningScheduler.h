@@ -0,0 +1,105 @@
+#ifndef CLEANINGSCHEDULER_H
+#define CLEANINGSCHEDULER_H
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct CleaningJob {
+    int JobID;
+    int DressID;
+    std::string DressName;
+    std::string ReturnDate;
+    std::string ScheduledDate;      // day it is cleaned, empty until planned
+    std::string NextBookingDate;    // first rental or reservation ahead, empty if none
+};
+
+// Turnaround of returned dresses. Returning a rental queues a cleaning job per
+// dress in CleaningJobs, and the unit stays reserved in DressDailyStock from
+// the return date through the day it is cleaned, so every availability check
+// (DressStock, AvailabilityCalendar, ReservationPlanner) counts it as out.
+//
+// A background thread plans the queue every interval, and straight away when
+// woken after returns: at most cleaning_capacity dresses a day, the one whose
+// next booking is soonest first (earliest deadline first, which keeps the
+// latest dress as little late as possible), and moves each job's reserved
+// days to its planned day. Marking a job cleaned frees its remaining days.
+// Instances sharing a database take turns through GET_LOCK, like
+// OverdueSweeper.
+class CleaningScheduler {
+public:
+    struct Task {
+        int jobID;
+        long returnDay;             // day numbers (LateFeePolicy::parseDate)
+        long nextBookingDay;        // LONG_MAX if the dress has none
+        long cleanDay;              // set by plan()
+    };
+
+    struct Stats {
+        int runs;                   // completed runs since start
+        std::string lastRunAt;      // "YYYY-MM-DD HH:MM:SS", empty if never run
+        double lastDurationMs;
+        int jobsPlanned;            // queued jobs in the last run
+        int jobsMoved;              // of those, jobs whose day changed
+        int jobsLate;               // cleaned on or after their next booking
+        std::string lastError;      // empty if the last run succeeded
+    };
+
+    static CleaningScheduler& getInstance();
+
+    // Starts the thread; it plans straight away and then every intervalSeconds
+    void start(int intervalSeconds);
+    void stop();
+    bool isRunning();
+    // Makes the thread plan now instead of at the end of its interval
+    void wake();
+
+    // Plans the queue on the calling thread; false if another instance holds
+    // the lock or a statement failed
+    bool runOnce();
+
+    Stats getStats();
+
+    // cleaning_interval (seconds, default 600; 0 disables the thread)
+    static int intervalFromConfig();
+    // cleaning_capacity (dresses cleaned per day, default 40)
+    static int capacityFromConfig();
+
+    // Sets each task's cleanDay, from firstDay on and not before its return:
+    // every day the capacityPerDay waiting tasks with the soonest next
+    // booking. Returns how many are cleaned on or after that booking.
+    static int plan(std::vector<Task>& tasks, long firstDay, int capacityPerDay);
+
+    // Queues a job for every dress of these rentals, returned on returnDate,
+    // and reserves its unit that day. Throws sql::SQLException; call it in the
+    // transaction that returns the rentals.
+    static void enqueue(const std::vector<int>& rentalIDs, const std::string& returnDate);
+    // Marks queued jobs cleaned on date and frees the days reserved after it;
+    // returns how many were marked, or -1 on error
+    static int complete(const std::vector<int>& jobIDs, const std::string& date);
+    // Queued jobs, by planned day and then return date
+    static std::vector<CleaningJob> getQueue();
+    static void displayQueue(const std::vector<CleaningJob>& jobs);
+
+private:
+    CleaningScheduler();
+    ~CleaningScheduler();
+    CleaningScheduler(const CleaningScheduler&) = delete;
+    CleaningScheduler& operator=(const CleaningScheduler&) = delete;
+
+    void threadMain();
+    bool schedule();
+
+    std::thread worker;
+    std::mutex mutex;
+    std::condition_variable wakeUp;
+    bool stopRequested;
+    bool wakeRequested;
+    bool running;
+    int intervalSeconds;
+    Stats stats;
+};
+
+#endif
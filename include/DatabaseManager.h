@@ -10,30 +10,133 @@
 #include <cppconn/prepared_statement.h>
 #include <string>
 #include <memory>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <ostream>
+#include <random>
+#include <functional>
 
 class DatabaseManager {
 private:
     sql::mysql::MySQL_Driver* driver;
-    sql::Connection* connection;
+    // One connection per thread: a MySQL connection must not be shared between
+    // threads, so worker threads (load driver, background jobs) get their own.
+    std::map<std::thread::id, sql::Connection*> connections;
+    std::mutex connectionsMutex;
+    // Connection settings from AppConfig (db_host, db_socket, db_user, ...)
     std::string host;
     std::string user;
     std::string password;
     std::string database;
-    
+    int connectTimeoutSeconds;
+    int readTimeoutSeconds;
+    int writeTimeoutSeconds;
+    bool compress;
+
+    // Circuit breaker for reconnects. After breakerThreshold consecutive failed
+    // connects, reconnects fail fast until retryAt; the delay doubles (with
+    // jitter) from retryBaseMs up to retryMaxMs on every further failure. Once
+    // retryAt passes, one thread probes while the others keep failing fast.
+    std::mutex breakerMutex;
+    int breakerThreshold;
+    int retryBaseMs;
+    int retryMaxMs;
+    int connectFailures;
+    bool probeInFlight;
+    std::chrono::steady_clock::time_point retryAt;
+    std::string lastConnectError;
+    std::mt19937 jitter;
+
+    // Read replicas (the replicas setting). Each thread keeps at most one replica
+    // connection next to its primary one, also guarded by connectionsMutex.
+    struct ReplicaConnection {
+        sql::Connection* connection;
+        size_t endpoint;
+        std::chrono::steady_clock::time_point lagCheckedAt;
+        std::chrono::steady_clock::time_point retryAfter;   // all replicas failed
+        bool degraded;                                      // warned about the failure
+    };
+    std::vector<std::string> replicaHosts;
+    std::map<std::thread::id, ReplicaConnection> replicas;
+    int maxReplicaLagSeconds;
+    int readYourWritesMs;
+    std::atomic<unsigned> nextReplica;
+    std::atomic<unsigned long> replicaReads;
+    std::atomic<unsigned long> primaryReads;
+    std::atomic<unsigned long> replicaFallbacks;
+
     DatabaseManager();
     ~DatabaseManager();
     DatabaseManager(const DatabaseManager&) = delete;
     DatabaseManager& operator=(const DatabaseManager&) = delete;
 
+    sql::Connection* threadConnection();
+    sql::Connection* openConnection(const std::string& hostName);
+    bool reconnectAllowed(std::string& reason);
+    void recordConnectResult(bool connected, const std::string& error);
+    sql::Connection* usableConnection(std::string& error);
+    void noteConnectionError(const sql::SQLException& e);
+    sql::Connection* replicaConnection();
+    bool replicaLagOk(sql::Connection* connection);
+    void dropReplicaConnection();
+
 public:
     static DatabaseManager& getInstance();
+    // Connects the calling thread now, regardless of the circuit breaker
     bool connect();
     void disconnect();
+    void releaseThreadConnection();
+    // Throws std::runtime_error if there is no connection and one cannot be
+    // made, immediately while the circuit breaker is open
     sql::Connection* getConnection();
     bool executeQuery(const std::string& query);
     sql::ResultSet* executeSelect(const std::string& query);
+
+    // Prepared statements created with prepare() and run through these are
+    // timed per statement (see QueryStats). They throw sql::SQLException like
+    // the connector calls they wrap.
+    sql::PreparedStatement* prepare(const std::string& query);
+    sql::ResultSet* executePreparedQuery(sql::PreparedStatement* pstmt);
+    int executePreparedUpdate(sql::PreparedStatement* pstmt);
+
+    // Helpers shared by the managers. runQuery and runUpdate run pstmt on the
+    // instance and delete it if it throws; runUpdate also deletes it after a
+    // successful run, runQuery leaves that to the caller with the result set.
+    static std::string placeholderList(size_t count);           // "?, ?, ?" for an IN list
+    static void bindIDs(sql::PreparedStatement* pstmt, int firstIndex, const std::vector<int>& ids);
+    static sql::ResultSet* runQuery(sql::PreparedStatement* pstmt);
+    static int runUpdate(sql::PreparedStatement* pstmt);
+    // Rolls back the calling thread's transaction and restores autocommit,
+    // ignoring any error; for catch blocks of transactions
+    static void rollbackQuietly();
+
+    // Reads that tolerate slightly stale data (reports, list and search
+    // screens) go through these. They use a read replica when one is
+    // configured, is at most replica_max_lag seconds behind and this thread
+    // has not written in the last read_your_writes_ms; otherwise
+    // they behave exactly like executeSelect() and prepare(). A query that
+    // fails on the replica drops that replica and runs again on the primary.
+    sql::ResultSet* executeReadSelect(const std::string& query);
+    // Prepared form: bind sets the parameters, and is called again if the
+    // statement has to be prepared again on the primary. pstmt is set to the
+    // statement the result came from; the caller deletes both as usual.
+    sql::ResultSet* executeRead(const std::string& query, const std::function<void(sql::PreparedStatement*)>& bind,
+                                sql::PreparedStatement*& pstmt);
+
+    // Marks the calling thread as having just written, so its next reads stay
+    // on the primary. Called by executeQuery() and executePreparedUpdate().
+    void noteWrite();
+
+    bool hasReplicas() const { return !replicaHosts.empty(); }
+    void printReadRouting(std::ostream& out);
+
     bool isConnected();
+    // "dress_rental_db on tcp://127.0.0.1:3306 as root", for messages
+    std::string describeTarget() const;
 };
 
 #endif
-
@@ -0,0 +1,89 @@
+#ifndef DRESSCATALOG_H
+#define DRESSCATALOG_H
+
+#include "DressManager.h"
+#include "Money.h"
+#include "RowBitmap.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// In-memory dress catalogue for faceted browsing. The six low-cardinality
+// attributes are dictionary-encoded: each distinct value gets a small code,
+// each dress stores one code per attribute, and each value keeps a RowBitmap
+// of the dresses that have it. A query like "Size M, Red, Available, Clean,
+// Evening" is then an intersection of a few bitmaps, and the per-value facet
+// counts are intersection counts that build nothing. Names live in a single
+// buffer, so a dress costs a few dozen bytes instead of a Dress with nine
+// strings.
+//
+// The catalogue is a snapshot: load() reads the Dresses table once and later
+// changes are not applied to it.
+class DressCatalog {
+public:
+    enum Facet { CATEGORY, SIZE, COLOR, CONDITION, AVAILABILITY, CLEANING, FACET_COUNT };
+
+    // Values within a facet are alternatives, facets are combined; a facet
+    // with no accepted values is not filtered
+    struct Query {
+        std::vector<std::string> accepted[FACET_COUNT];
+
+        void require(Facet facet, const std::string& value) { accepted[facet].push_back(value); }
+    };
+
+    struct FacetCount {
+        std::string value;
+        size_t count;
+    };
+
+    struct Result {
+        size_t total;                       // dresses matching the query
+        std::vector<int> dressIDs;          // the first ones by DressID, up to the limit
+        // Per facet, the dresses each value would match with the other facets'
+        // filters applied; most common first, zero counts left out
+        std::vector<FacetCount> facets[FACET_COUNT];
+    };
+
+    DressCatalog();
+
+    // Replaces the contents with the Dresses table; false on error
+    bool load();
+    // DressIDs must arrive in ascending order, as load() reads them
+    void add(const Dress& dress);
+    void clear();
+
+    size_t size() const { return ids.size(); }
+    Result search(const Query& query, size_t limit = 50) const;
+    // Rebuilds the Dress for a DressID in the catalogue; false if absent
+    bool getDress(int dressID, Dress& dress) const;
+
+    // Distinct values of a facet in first-seen order
+    const std::vector<std::string>& values(Facet facet) const { return dictionaries[facet].values; }
+    size_t memoryBytes() const;
+    static const char* facetName(Facet facet);
+
+private:
+    struct Dictionary {
+        std::vector<std::string> values;                    // by code
+        std::unordered_map<std::string, uint16_t> codes;
+        std::vector<RowBitmap> rows;                        // by code
+    };
+
+    uint16_t encode(Facet facet, const std::string& value);
+    // Rows with any accepted value, built in storage when more than one value
+    // is accepted; nullptr if the facet is unfiltered
+    const RowBitmap* facetFilter(const Query& query, Facet facet, RowBitmap& storage) const;
+
+    std::vector<int> ids;                   // ascending; row number = index
+    std::vector<uint32_t> nameEnds;         // end of each name in names
+    std::string names;
+    std::vector<Money> prices;
+    std::vector<int> versions;
+    std::vector<uint16_t> codes[FACET_COUNT];
+    Dictionary dictionaries[FACET_COUNT];
+    RowBitmap allRows;
+};
+
+#endif
@@ -2,6 +2,7 @@
 #define DRESSMANAGER_H
 
 #include "DatabaseManager.h"
+#include "Money.h"
 #include <string>
 #include <vector>
 
@@ -11,10 +12,11 @@ struct Dress {
     std::string Category;
     std::string Size;
     std::string Color;
-    double RentalPrice;
+    Money RentalPrice;
     std::string ConditionStatus;
     std::string AvailabilityStatus;
     std::string CleaningStatus;
+    int Version;                    // bumped on every change; updateDress() checks it
 };
 
 class DressManager {
@@ -27,11 +29,10 @@ public:
     std::vector<Dress> getDressesByCategory(const std::string& category);
     bool updateDress(int dressID, const Dress& dress);
     bool deleteDress(int dressID);
-    bool updateAvailability(int dressID, const std::string& status);
     bool isDressAvailable(int dressID, const std::string& startDate, const std::string& endDate);
     void displayDress(const Dress& dress);
     void displayAllDresses(const std::vector<Dress>& dresses);
-    double getDressPrice(int dressID);
+    Money getDressPrice(int dressID);
 };
 
 #endif
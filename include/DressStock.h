@@ -0,0 +1,71 @@
+#ifndef DRESSSTOCK_H
+#define DRESSSTOCK_H
+
+#include "DatabaseManager.h"
+#include <string>
+#include <vector>
+
+struct StockLevel {
+    int DressID;
+    std::string DressName;
+    int StockQuantity;          // units of the dress the shop owns
+    int MinimumStockLevel;      // fewer free units than this is low stock
+    int UnitsOut;               // units on active rentals
+};
+
+// Multi-unit stock. A dress has StockQuantity units, and DressDailyStock holds
+// how many of them active rentals have reserved on each day. A rental reserves
+// one unit per dress for every day from its RentalDate to its DueDate with a
+// single conditional UPDATE over those day rows, so two counters booking the
+// last unit cannot both get it; the caller's transaction rolls back a
+// reservation that fell short on any day. Rentals.HeldThrough records the last
+// day a rental holds: its DueDate, or today once it is overdue and the dress
+// is still with the customer (see holdThroughToday).
+//
+// The same statements keep Dresses.UnitsOut, Dresses.LowStock and the
+// Available/Rented status in step, so the low-stock alert reads an index
+// instead of scanning every dress.
+class DressStock {
+public:
+    // Longest date range reserve() accepts, in days
+    static const int MAX_RANGE_DAYS = 100;
+
+    // Reserves a unit of the dress for startDate to endDate (YYYY-MM-DD, both
+    // included). False if a day has no unit left, the dress is missing or in
+    // maintenance, or the range is invalid. Throws sql::SQLException; call it
+    // inside the rental transaction and roll back on false.
+    static bool reserve(int dressID, const std::string& startDate, const std::string& endDate);
+
+    // Gives back the units reserved by the items of these rentals, from
+    // RentalDate through HeldThrough. Throws sql::SQLException; call it in the
+    // transaction that ends the rentals.
+    static void release(const std::vector<int>& rentalIDs);
+
+    // Extends the units held by these overdue rentals from HeldThrough to
+    // today, without checking what is free: the dresses are out whatever was
+    // booked. Throws sql::SQLException; call it in a transaction that has
+    // locked the rentals, so a return cannot release the old range meanwhile.
+    static void holdThroughToday(const std::vector<int>& rentalIDs);
+
+    // Adds units (negative to give them back) to every day from firstDate to
+    // lastDate without checking what is free, for units that are in the shop
+    // but cannot go out, such as dresses waiting to be cleaned. False if the
+    // range is invalid. Throws sql::SQLException.
+    static bool hold(int dressID, const std::string& firstDate, const std::string& lastDate, int units);
+
+    // Fewest units free on any day of the range; 0 if the dress is missing,
+    // -1 on error
+    static int freeUnits(int dressID, const std::string& startDate, const std::string& endDate);
+
+    // Reads the stock of one dress; false if it is missing or on error
+    static bool getLevel(int dressID, StockLevel& level);
+
+    // Changes the units owned and the low-stock level. Fails if quantity is
+    // below the units already reserved on some day from today on.
+    static bool setStockQuantity(int dressID, int quantity, int minimumLevel);
+
+    // Dresses with fewer free units than their minimum, by DressID
+    static std::vector<StockLevel> getLowStock();
+};
+
+#endif
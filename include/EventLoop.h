@@ -0,0 +1,57 @@
+#ifndef EVENTLOOP_H
+#define EVENTLOOP_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+// Single-threaded readiness loop over epoll (Linux only). File descriptors
+// are registered with a handler that is called on the loop thread with the
+// epoll events that fired (level-triggered). Other threads hand work back to
+// the loop with post(), which wakes it through an eventfd.
+class EventLoop {
+public:
+    typedef std::function<void(uint32_t events)> Handler;
+
+    EventLoop();
+    ~EventLoop();
+
+    // Creates the epoll and wake-up descriptors; false (reported on
+    // std::cerr) if the platform has no epoll or they cannot be created
+    bool open();
+
+    // Loop thread only. A handler may add, modify or remove any descriptor,
+    // including its own.
+    bool add(int fd, uint32_t events, Handler handler);
+    bool modify(int fd, uint32_t events);
+    void remove(int fd);
+
+    // Runs task on the loop thread at its next turn; any thread
+    void post(std::function<void()> task);
+
+    // Dispatches events until stop(); returns false if epoll failed
+    bool run();
+    // Any thread, and safe in a signal handler
+    void stop();
+
+private:
+    EventLoop(const EventLoop&) = delete;
+    EventLoop& operator=(const EventLoop&) = delete;
+
+    void wake();
+    void runPosted();
+
+    int epollFD;
+    int wakeFD;
+    std::atomic<bool> stopRequested;
+    // Shared so a handler that removes itself is not destroyed while it runs
+    std::unordered_map<int, std::shared_ptr<Handler>> handlers;
+    std::mutex postedMutex;
+    std::vector<std::function<void()>> posted;
+};
+
+#endif
@@ -0,0 +1,45 @@
+#ifndef FORMAT_H
+#define FORMAT_H
+
+#include "Money.h"
+#include <cstddef>
+#include <ctime>
+#include <string>
+
+// Number and date text for reports and tables, without streams. Integers are
+// written digit by digit into a stack buffer; fixed-point values are rounded
+// to an integer at the requested precision and written the same way. The
+// append* helpers add to a caller's string so a whole report can be built in
+// one buffer and written at once.
+//
+// Padding counts bytes, which is right for numbers, dates and plain ASCII
+// labels; colored or non-ASCII cells belong in a TableRenderer.
+class Format {
+public:
+    // Room for any integer, fixed-point value (up to 6 decimals) or date
+    static const size_t MAX_TEXT = 32;
+
+    // Each writes without a terminator and returns the length
+    static size_t integer(char* buffer, long long value);
+    // decimals 0-6; non-finite or huge values fall back to snprintf
+    static size_t fixed(char* buffer, double value, int decimals);
+    static size_t date(char* buffer, int year, int month, int day);   // YYYY-MM-DD
+    static size_t date(char* buffer, const std::tm& time);
+
+    static std::string integer(long long value);
+    static std::string fixed(double value, int decimals);
+    static std::string date(const std::tm& time);
+
+    // Right-aligned in width columns when width > 0; wider text is kept whole
+    static void appendInteger(std::string& out, long long value, int width = 0);
+    static void appendFixed(std::string& out, double value, int decimals, int width = 0);
+    static void appendMoney(std::string& out, Money amount, int width = 0);
+    static void appendRight(std::string& out, const char* text, size_t length, int width);
+    static void appendRight(std::string& out, const std::string& text, int width);
+
+    // Left-aligned, padded with spaces to width columns
+    static void appendLeft(std::string& out, const char* text, size_t length, int width);
+    static void appendLeft(std::string& out, const std::string& text, int width);
+};
+
+#endif
@@ -0,0 +1,149 @@
+#ifndef HTTPSERVER_H
+#define HTTPSERVER_H
+
+#include "AuthManager.h"
+#include "AvailabilityCalendar.h"
+#include "DressCatalog.h"
+#include "EventLoop.h"
+#include "SharedSnapshot.h"
+#include "WorkerPool.h"
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// Embedded HTTP/1.1 server for the JSON API (rental_system --http), for the
+// web front-end and the customer kiosk.
+//
+// Like RentalServer, one EventLoop thread owns every socket: it parses
+// requests (keep-alive and pipelining included) and writes responses, and
+// the managers run on a WorkerPool with a database connection per thread.
+// Catalogue and availability reads come from SharedSnapshots, and their
+// rendered JSON is cached per URL and snapshot generation: a repeat of a
+// cached GET is answered on the loop thread without touching a worker, and
+// the cached body is shared by every response that sends it (headers and
+// bodies are queued as separate buffers and written with one sendmsg).
+//
+// Browsing (GET /api/dresses, /api/dresses/{id}, /api/availability) is open;
+// everything else needs "Authorization: Bearer <token>" from POST /api/login
+// with a Staff or Administrator account, and reports need Administrator.
+class HttpServer {
+public:
+    struct Request {
+        std::string method;
+        std::string path;                           // without the query string
+        std::map<std::string, std::string> query;   // decoded parameters
+        std::string authorization;
+        std::string body;
+        bool keepAlive;
+    };
+
+    struct Response {
+        int status;
+        std::shared_ptr<const std::string> body;    // JSON, possibly shared with the cache
+        bool cacheable;                             // public catalogue data
+    };
+
+    struct Stats {
+        long connectionsAccepted;
+        int connectionsOpen;
+        long requests;
+        long cacheHits;             // answered on the loop thread
+        long errors;                // 4xx and 5xx responses
+        int workers;
+        int workersBusy;
+        size_t requestsQueued;
+        size_t cachedResponses;
+    };
+
+    HttpServer(const std::string& address, int port, int workerCount);
+    ~HttpServer();
+
+    // Binds and listens, and starts the workers; false (reported on
+    // std::cerr) if the address cannot be bound
+    bool start();
+    // Serves until stop()
+    void run();
+    // Any thread, and safe in a signal handler
+    void stop();
+
+    Stats getStats();
+
+    // http_address (default 127.0.0.1: put a proxy in front for other hosts)
+    static std::string addressFromConfig();
+    // http_port (default 8080)
+    static int portFromConfig();
+
+    // Parses one request at the start of data. Returns the bytes it took, 0
+    // if more are needed, or -1 with the status to answer (400, 413, 431,
+    // 501 or 505) if it is not a request this server accepts.
+    static long parseRequest(const char* data, size_t size, Request& request, int& errorStatus);
+    // GET /api/dresses: matching dresses, up to limit, with facet counts
+    static std::string renderDresses(const DressCatalog& catalog, const DressCatalog::Query& query, size_t limit);
+
+private:
+    struct Connection;
+
+    struct Session {
+        User user;
+        std::chrono::steady_clock::time_point expiresAt;
+    };
+
+    struct CachedBody {
+        std::shared_ptr<const std::string> body;
+        unsigned long generation;   // of the snapshot it was rendered from
+    };
+
+    HttpServer(const HttpServer&) = delete;
+    HttpServer& operator=(const HttpServer&) = delete;
+
+    void onAccept();
+    void onEvent(const std::shared_ptr<Connection>& connection, uint32_t events);
+    void dispatch(const std::shared_ptr<Connection>& connection);
+    void queueResponse(const std::shared_ptr<Connection>& connection, const Response& response, bool keepAlive);
+    bool flush(const std::shared_ptr<Connection>& connection);
+    void closeConnection(const std::shared_ptr<Connection>& connection);
+
+    // Loop thread: the cached body of a public GET, if still current
+    bool lookupCache(const Request& request, Response& response);
+    void storeCache(const Request& request, const Response& response, unsigned long generation);
+    // Cache key of a public GET, and the snapshot it depends on; empty if the
+    // request is not cacheable
+    static std::string cacheKey(const Request& request, bool& usesCalendar);
+
+    // Worker threads
+    void handle(const Request& request, Response& response);
+    void handlePublic(const Request& request, Response& response, bool& handled);
+    void handleLogin(const Request& request, Response& response);
+    // The session of a Bearer token, refreshing its expiry; false if none
+    bool authenticate(const Request& request, User& user);
+
+    std::string address;
+    int port;
+    int workerCount;
+    int listenFD;
+    EventLoop loop;
+    WorkerPool workers;
+
+    // Loop thread only
+    std::unordered_map<int, std::shared_ptr<Connection>> connections;
+
+    SharedSnapshot<DressCatalog> catalog;
+    SharedSnapshot<AvailabilityCalendar> calendar;
+    int cacheSeconds;
+
+    std::mutex cacheMutex;
+    std::unordered_map<std::string, CachedBody> responseCache;
+
+    std::mutex sessionsMutex;
+    std::unordered_map<std::string, Session> sessions;
+    std::chrono::minutes sessionLength;
+
+    std::mutex statsMutex;
+    Stats stats;
+};
+
+#endif
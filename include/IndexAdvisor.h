@@ -0,0 +1,46 @@
+#ifndef INDEXADVISOR_H
+#define INDEXADVISOR_H
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Runs EXPLAIN on the application's hot queries (the lookups and lists the
+// managers run on every screen, the sweeper and the reports) and reports the
+// ones that scan a whole table or index instead of using an index. Scans of
+// tables estimated below smallTableRows are not counted: on a tiny database
+// the optimizer scans on purpose, so check against realistic data
+// (tools/datagen).
+class IndexAdvisor {
+public:
+    struct Finding {
+        std::string query;          // hot query name, e.g. "rental.overdueList"
+        std::string table;
+        std::string accessType;     // EXPLAIN type: const, ref, range, index, ALL...
+        std::string key;            // index used, empty if none
+        long long rows;             // estimated rows examined
+        std::string extra;
+        bool fullScan;              // ALL or index on a table that is not small
+        bool expected;              // the query has to scan (leading-wildcard search, whole-table report)
+        std::string error;          // EXPLAIN failed, e.g. a missing column
+    };
+
+    explicit IndexAdvisor(long long smallTableRows = 1000);
+
+    // Explains every hot query; false if the database could not be reached
+    bool analyze();
+
+    const std::vector<Finding>& getFindings() const { return findings; }
+
+    // Unexpected full scans plus queries that could not be explained
+    int problemCount() const;
+
+    void printReport(std::ostream& out);
+    void printReport();
+
+private:
+    long long smallTableRows;
+    std::vector<Finding> findings;
+};
+
+#endif
@@ -1,6 +1,7 @@
 #ifndef INPUTVALIDATOR_H
 #define INPUTVALIDATOR_H
 
+#include "Money.h"
 #include <string>
 #include <iostream>
 #include <sstream>
@@ -17,6 +18,9 @@ public:
     static double getDouble(const std::string& prompt, double min = (std::numeric_limits<double>::lowest()), 
                            double max = (std::numeric_limits<double>::max)(), bool allowRetry = true);
     
+    // Amount in RM with at most two decimals, between min and max inclusive
+    static Money getMoney(const std::string& prompt, Money min, Money max, bool allowRetry = true);
+    
     // String input with validation
     static std::string getString(const std::string& prompt, bool required = true, 
                                  size_t minLength = 0, size_t maxLength = 255);
@@ -71,6 +75,7 @@ private:
     static void printTip(const std::string& tip);
     static std::string formatRangeTip(int min, int max);
     static std::string formatRangeTip(double min, double max);
+    static std::string formatRangeTip(Money min, Money max);
 };
 
 #endif
@@ -0,0 +1,34 @@
+#ifndef JSON_H
+#define JSON_H
+
+#include "Money.h"
+#include <map>
+#include <string>
+#include <vector>
+
+// Just enough JSON for the HTTP API. Writing appends to a caller's string
+// like Format, so a response is built in one buffer; amounts are written as
+// numbers with two decimals, exactly as stored.
+//
+// Reading accepts one flat object whose values are strings, numbers, true,
+// false, null or arrays of those (request bodies like
+// {"customerID": 12, "days": 3, "dressIDs": [40, 41]}). Strings come back
+// unescaped; other values, arrays included, as their JSON text.
+class Json {
+public:
+    static void appendString(std::string& out, const std::string& text);
+    static void appendInteger(std::string& out, long long value);
+    static void appendMoney(std::string& out, Money amount);
+    // "name": with the comma before it unless it is the first in its object
+    static void appendKey(std::string& out, const char* name, bool first = false);
+
+    // {"error": message}
+    static std::string error(const std::string& message);
+
+    // False if text is not a flat object as above
+    static bool parseObject(const std::string& text, std::map<std::string, std::string>& fields);
+    // An array of integers, as parseObject returns it
+    static bool parseIntArray(const std::string& text, std::vector<int>& values);
+};
+
+#endif
@@ -0,0 +1,42 @@
+#ifndef LATEFEEPOLICY_H
+#define LATEFEEPOLICY_H
+
+#include "Money.h"
+#include <string>
+
+// How late fees are charged. The fee of a rental is derived from its DueDate
+// and ReturnDate whenever it is read; it is only written to Rentals.LateFee when
+// the rental is returned or by RentalManager::sweepLateFees().
+//
+// Days late count whole calendar days, matching the SQL test DueDate < CURDATE():
+// a rental returned (or still out) on its due date is 0 days late, the day after
+// is 1 day late.
+class LateFeePolicy {
+public:
+    explicit LateFeePolicy(Money dailyRate = Money::fromCents(1000));
+
+    // The shop's policy: RM 10 per day
+    static const LateFeePolicy& standard();
+
+    Money getDailyRate() const { return dailyRate; }
+
+    // Days between dueDate and asOf (both YYYY-MM-DD); 0 if not late or unparseable
+    int daysLate(const std::string& dueDate, const std::string& asOf) const;
+    Money feeForDays(int days) const;
+
+    // Fee owed on a rental: up to its return date, or up to today if still out
+    Money lateFee(const std::string& dueDate, const std::string& returnDate, const std::string& today) const;
+
+    // Local date as YYYY-MM-DD
+    static std::string today();
+
+    // Parses YYYY-MM-DD into a day number (days since 1970-01-01)
+    static bool parseDate(const std::string& date, long& dayNumber);
+    // The reverse: a day number as YYYY-MM-DD
+    static std::string dateOf(long dayNumber);
+
+private:
+    Money dailyRate;
+};
+
+#endif
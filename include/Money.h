@@ -0,0 +1,74 @@
+#ifndef MONEY_H
+#define MONEY_H
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+
+// An amount of money held as a whole number of sen, so totals and balances
+// are exact. DECIMAL(.., 2) columns are read with getString() and bound with
+// setString(toString()); MySQL converts the text without a double in between.
+// Formatting writes the digits straight into a buffer, without iostream
+// number formatting or locale lookups.
+class Money {
+public:
+    // Room for the longest text format() can produce plus a terminator
+    static const size_t MAX_TEXT = 24;
+
+    Money() : cents(0) {}
+
+    static Money fromCents(long long cents) {
+        Money amount;
+        amount.cents = cents;
+        return amount;
+    }
+
+    // Nearest sen, halves away from zero. Only for values that start out as
+    // doubles, such as a percentage of an amount.
+    static Money fromDouble(double value);
+
+    // Strict parse for user input: "12", "12.5", "-12.34". False for anything
+    // else, including a third decimal.
+    static bool parse(const std::string& text, Money& amount);
+
+    // Database values: empty (NULL) is zero, extra decimals (AVG) are rounded
+    static Money fromString(const std::string& text);
+
+    long long getCents() const { return cents; }
+    // For charts and ratios; never feed the result back into an amount
+    double toDouble() const { return cents / 100.0; }
+
+    // Writes "-1234.50" without a terminator and returns its length;
+    // buffer must hold MAX_TEXT characters
+    size_t format(char* buffer) const;
+    std::string toString() const;           // "1234.50"
+    std::string toDisplay() const;          // "RM 1234.50"
+
+    Money operator+(Money other) const { return fromCents(cents + other.cents); }
+    Money operator-(Money other) const { return fromCents(cents - other.cents); }
+    Money operator-() const { return fromCents(-cents); }
+    Money operator*(long long count) const { return fromCents(cents * count); }
+    Money& operator+=(Money other) { cents += other.cents; return *this; }
+    Money& operator-=(Money other) { cents -= other.cents; return *this; }
+
+    // Amount split count ways, rounded to the sen (averages); zero if count is 0
+    Money dividedBy(long long count) const;
+
+    bool operator==(Money other) const { return cents == other.cents; }
+    bool operator!=(Money other) const { return cents != other.cents; }
+    bool operator<(Money other) const { return cents < other.cents; }
+    bool operator<=(Money other) const { return cents <= other.cents; }
+    bool operator>(Money other) const { return cents > other.cents; }
+    bool operator>=(Money other) const { return cents >= other.cents; }
+
+    bool isZero() const { return cents == 0; }
+    bool isPositive() const { return cents > 0; }
+
+private:
+    long long cents;
+};
+
+// Same text as format(); honours the stream's width and fill
+std::ostream& operator<<(std::ostream& out, const Money& amount);
+
+#endif
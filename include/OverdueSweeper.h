@@ -0,0 +1,66 @@
+#ifndef OVERDUESWEEPER_H
+#define OVERDUESWEEPER_H
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// Background job that keeps derived rental data current so interactive
+// screens never have to compute it. Every interval it refreshes the
+// SystemCounters table read by the dashboard; on the first run of each day it
+// also persists the late fees of overdue rentals (RentalManager::sweepLateFees),
+// extends their stock holds through today (RentalManager::sweepOverdueHolds)
+// and queues Reminders for rentals that are overdue or due tomorrow.
+// Several application instances may share a database: each run holds a
+// GET_LOCK, and the daily part is skipped if another instance already did it.
+class OverdueSweeper {
+public:
+    struct Stats {
+        int runs;                   // completed runs since start
+        std::string lastRunAt;      // "YYYY-MM-DD HH:MM:SS", empty if never run
+        double lastDurationMs;
+        int rowsTouched;            // rows written by the last run
+        std::string lastDailyRunAt; // last run that swept fees and reminders
+        int lateFeesUpdated;        // by the last daily run
+        int remindersQueued;        // by the last daily run
+        std::string lastError;      // empty if the last run succeeded
+    };
+
+    static OverdueSweeper& getInstance();
+
+    // Starts the thread; it runs straight away and then every intervalSeconds
+    void start(int intervalSeconds);
+    void stop();
+    bool isRunning();
+
+    // Runs a full sweep on the calling thread, including the daily part even if
+    // it already ran today; false if another instance holds the lock or a
+    // statement failed
+    bool runOnce();
+
+    Stats getStats();
+
+    // Interval from the sweep_interval setting (seconds, default 300; 0 disables)
+    static int intervalFromConfig();
+
+private:
+    OverdueSweeper();
+    ~OverdueSweeper();
+    OverdueSweeper(const OverdueSweeper&) = delete;
+    OverdueSweeper& operator=(const OverdueSweeper&) = delete;
+
+    void threadMain();
+    bool sweep(bool forceDaily);
+
+    std::thread worker;
+    std::mutex mutex;
+    std::condition_variable wakeUp;
+    bool stopRequested;
+    bool running;
+    int intervalSeconds;
+    std::string lastDailyDate;      // local date the daily part last completed
+    Stats stats;
+};
+
+#endif
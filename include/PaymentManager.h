@@ -3,29 +3,48 @@
 
 #include "DatabaseManager.h"
 #include "RentalManager.h"
+#include "Money.h"
 #include <string>
 #include <vector>
 
 struct Payment {
     int PaymentID;
     int RentalID;
-    double Amount;
+    Money Amount;
     std::string PaymentMethod;
     std::string PaymentDate;
     std::string Status;
     std::string TransactionReference;
 };
 
+// A rental's entry in the RentalBalances ledger, kept up to date by the
+// payment and late fee updates so nothing has to sum Payments to read it.
+// AmountDue includes the late fee, as of today for rentals still out.
+struct RentalBalance {
+    int RentalID;
+    std::string CustomerName;
+    std::string DueDate;
+    std::string Status;
+    Money AmountDue;
+    Money AmountPaid;           // completed payments
+    Money Outstanding;          // AmountDue - AmountPaid; negative if overpaid
+};
+
 class PaymentManager {
 public:
-    bool createPayment(int rentalID, double amount, const std::string& paymentMethod, 
+    bool createPayment(int rentalID, Money amount, const std::string& paymentMethod, 
                       const std::string& paymentDate, const std::string& transactionRef = "");
     Payment* getPaymentByID(int paymentID);
     std::vector<Payment> getPaymentsByRental(int rentalID);
     std::vector<Payment> getAllPayments();
     bool updatePaymentStatus(int paymentID, const std::string& status);
     bool isRentalPaid(int rentalID);
-    double getTotalPaid(int rentalID);
+    Money getTotalPaid(int rentalID);
+    // Balances of these rentals in one query, in the order given; unknown IDs are skipped
+    std::vector<RentalBalance> getBalances(const std::vector<int>& rentalIDs);
+    // Balances of every active rental, soonest due first
+    std::vector<RentalBalance> getActiveBalances();
+    void displayBalances(const std::vector<RentalBalance>& balances);
     void generateReceipt(int paymentID);
     void displayPayment(const Payment& payment);
     void displayAllPayments(const std::vector<Payment>& payments);
@@ -0,0 +1,50 @@
+#ifndef QUERYSTATS_H
+#define QUERYSTATS_H
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+// Per-statement latency histograms for every query run through DatabaseManager.
+//
+// Each thread records into its own buckets (single writer, relaxed atomics), so
+// recording takes no locks; dump() sums the buckets of all threads. Buckets are
+// log-linear like an HDR histogram: 8 sub-buckets per power of two, which keeps
+// percentiles within ~12% from a microsecond up to minutes.
+class QueryStats {
+public:
+    static const int BUCKET_COUNT = 320;
+    static const int MAX_STATEMENTS = 512;
+
+    struct Histogram {
+        std::atomic<uint64_t> buckets[BUCKET_COUNT];
+        std::atomic<uint64_t> count;
+        std::atomic<uint64_t> totalNs;
+        std::atomic<uint64_t> maxNs;
+        Histogram();
+    };
+
+    // Returns a stable id for the statement text; numeric literals are folded
+    // so "... YEAR(PaymentDate) = 2024" and "= 2025" share one histogram.
+    static int statementId(const std::string& sql);
+    static std::string statementText(int id);
+
+    static void record(int statementId, uint64_t elapsedNs);
+
+    static bool enabled();
+    static void setEnabled(bool on);
+    static uint64_t slowQueryThresholdNs();
+
+    static int bucketFor(uint64_t ns);
+    static uint64_t bucketValue(int bucket);
+
+    static void dump(std::ostream& out);
+    static void reset();
+
+private:
+    static std::atomic<bool> enabledFlag;
+    static void logSlowQuery(int statementId, uint64_t elapsedNs);
+};
+
+#endif
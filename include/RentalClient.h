@@ -0,0 +1,46 @@
+#ifndef RENTALCLIENT_H
+#define RENTALCLIENT_H
+
+#include <string>
+
+// Connection to a rental_system --server over its Unix socket (see
+// RentalServer for the protocol). One request is in flight at a time.
+class RentalClient {
+public:
+    struct Response {
+        bool ok;                    // false for an ERR reply
+        std::string body;
+    };
+
+    RentalClient();
+    ~RentalClient();
+
+    // False with the reason in getLastError() if nothing is listening
+    bool connect(const std::string& socketPath);
+    void close();
+    bool isConnected() const { return fd >= 0; }
+
+    // Sends one command line and waits for its reply; false (and closed) if
+    // the connection failed or the reply was malformed
+    bool request(const std::string& line, Response& response);
+    const std::string& getLastError() const { return lastError; }
+
+    // Thin terminal for rental_system --client: logs in, then sends each line
+    // typed and prints the reply until quit or end of input. Returns the exit
+    // status.
+    static int runTerminal(const std::string& socketPath);
+
+private:
+    RentalClient(const RentalClient&) = delete;
+    RentalClient& operator=(const RentalClient&) = delete;
+
+    bool fail(const std::string& reason);
+    // Reads until buffer holds at least count bytes
+    bool fill(size_t count);
+
+    int fd;
+    std::string buffer;             // received and not yet consumed
+    std::string lastError;
+};
+
+#endif
@@ -4,6 +4,8 @@
 #include "DatabaseManager.h"
 #include "CustomerManager.h"
 #include "DressManager.h"
+#include "Money.h"
+#include <functional>
 #include <string>
 #include <vector>
 #include <ctime>
@@ -14,8 +16,8 @@ struct Rental {
     std::string RentalDate;
     std::string DueDate;
     std::string ReturnDate;
-    double TotalAmount;
-    double LateFee;
+    Money TotalAmount;
+    Money LateFee;
     std::string Status;
 };
 
@@ -23,20 +25,49 @@ struct RentalItem {
     int RentalItemID;
     int RentalID;
     int DressID;
-    double RentalPrice;
+    Money RentalPrice;
+};
+
+struct RentalViewItem {
+    int RentalItemID;
+    int DressID;
+    Money RentalPrice;
+    std::string DressName;      // "N/A" if the dress no longer exists
+};
+
+// Everything the rental detail and receipt screens show, loaded in one query
+struct RentalView {
+    Rental rental;              // LateFee is the current fee for active rentals
+    Customer customer;
+    std::vector<RentalViewItem> items;
+    Money TotalPaid;            // sum of completed payments
+    int PaymentCount;
 };
 
 class RentalManager {
 public:
-    int createRental(int customerID, const std::string& rentalDate, int duration, const std::vector<int>& dressIDs);
+    // onCreated, if given, runs in the rental's transaction once the Rentals
+    // row exists; returning false rolls the rental back. It may run again if
+    // the transaction is retried.
+    int createRental(int customerID, const std::string& rentalDate, int duration, const std::vector<int>& dressIDs,
+                     const std::function<bool(int rentalID)>& onCreated = nullptr);
     Rental* getRentalByID(int rentalID);
+    RentalView* getRentalView(int rentalID);
     std::vector<Rental> getRentalsByCustomer(int customerID);
     std::vector<Rental> getActiveRentals();
     std::vector<Rental> getOverdueRentals();
     std::vector<RentalItem> getRentalItems(int rentalID);
     bool returnRental(int rentalID, const std::string& returnDate);
+    // Returns the active rentals among rentalIDs in one transaction; the others
+    // are skipped. Returns how many were returned, or -1 on error.
+    int returnRentals(const std::vector<int>& rentalIDs, const std::string& returnDate);
     bool updateRentalStatus(int rentalID, const std::string& status, const std::string& returnDate = "");
     bool calculateLateFee(int rentalID);
+    int sweepLateFees();
+    // Extends the stock held by overdue active rentals through today, since
+    // their dresses have not come back. Returns how many rentals it extended,
+    // or -1 on error.
+    int sweepOverdueHolds();
     bool canRentDress(int dressID, const std::string& startDate, const std::string& endDate);
     std::string calculateDueDate(const std::string& rentalDate, int duration);
     void displayRental(const Rental& rental);
@@ -0,0 +1,98 @@
+#ifndef RENTALSERVER_H
+#define RENTALSERVER_H
+
+#include "AvailabilityCalendar.h"
+#include "DressCatalog.h"
+#include "EventLoop.h"
+#include "SharedSnapshot.h"
+#include "WorkerPool.h"
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// Daemon mode (rental_system --server): one process holds the managers, the
+// dress catalogue and availability calendar snapshots and the database
+// connections, and counter terminals (rental_system --client) talk to it over
+// a Unix domain socket instead of each running their own copy.
+//
+// One thread runs an EventLoop that accepts terminals and reads and writes
+// their sockets without blocking; commands run on a WorkerPool of
+// server_workers threads, each with its own database connection, so any
+// number of terminals share that many connections.
+//
+// Protocol: the terminal sends one command per line ("search silk",
+// "rent 12 3 40,41"); the server answers each with "OK <length>\n" or
+// "ERR <length>\n" followed by length bytes of text. A terminal's commands
+// run one at a time in the order sent; "help" lists them.
+class RentalServer {
+public:
+    struct Stats {
+        long connectionsAccepted;
+        int connectionsOpen;
+        int connectionsPeak;
+        long requests;
+        long requestErrors;         // ERR replies
+        int workers;
+        int workersBusy;
+        size_t requestsQueued;
+    };
+
+    RentalServer(const std::string& socketPath, int workerCount);
+    ~RentalServer();
+
+    // Binds the socket and starts the workers; false (reported on std::cerr)
+    // if the path is in use by a running server or cannot be bound
+    bool start();
+    // Serves terminals until stop(); the socket file is removed on return
+    void run();
+    // Any thread, and safe in a signal handler
+    void stop();
+
+    Stats getStats();
+
+    // server_socket (default /tmp/dress_rental.sock)
+    static std::string socketPathFromConfig();
+    // server_workers (default 8)
+    static int workersFromConfig();
+    // server_cache_seconds: how old a catalogue or calendar snapshot may get
+    // before a request reloads it (default 60)
+    static int cacheSecondsFromConfig();
+
+private:
+    // Login of one terminal, touched by one worker at a time
+    struct Session;
+    // A terminal's socket and buffers; loop thread only, apart from session
+    struct Connection;
+
+    RentalServer(const RentalServer&) = delete;
+    RentalServer& operator=(const RentalServer&) = delete;
+
+    void onAccept();
+    void onReadable(const std::shared_ptr<Connection>& connection, uint32_t events);
+    void dispatch(const std::shared_ptr<Connection>& connection);
+    void finish(const std::shared_ptr<Connection>& connection, bool ok, const std::string& body);
+    bool flush(const std::shared_ptr<Connection>& connection);
+    void closeConnection(const std::shared_ptr<Connection>& connection);
+
+    // Runs one command line on a worker thread; returns false for ERR
+    bool handle(Session& session, const std::string& line, std::string& reply);
+
+    std::string socketPath;
+    int workerCount;
+    int listenFD;
+    EventLoop loop;
+    WorkerPool workers;
+
+    // Loop thread only
+    std::unordered_map<int, std::shared_ptr<Connection>> connections;
+
+    SharedSnapshot<DressCatalog> catalog;
+    SharedSnapshot<AvailabilityCalendar> calendar;
+
+    std::mutex statsMutex;
+    Stats stats;
+};
+
+#endif
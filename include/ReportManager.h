@@ -2,21 +2,23 @@
 #define REPORTMANAGER_H
 
 #include "DatabaseManager.h"
+#include "Money.h"
+#include <ostream>
 #include <string>
 #include <vector>
 #include <map>
 
 struct MonthlySales {
     std::string Month;
-    double TotalSales;
+    Money TotalSales;
     int RentalCount;
 };
 
 struct InventoryValuation {
     std::string Category;
     int DressCount;
-    double TotalValue;
-    double AveragePrice;
+    Money TotalValue;
+    Money AveragePrice;
 };
 
 struct DressUtilization {
@@ -30,8 +32,8 @@ struct CustomerActivity {
     int CustomerID;
     std::string CustomerName;
     int TotalRentals;
-    double TotalSpent;
-    double AverageRental;
+    Money TotalSpent;
+    Money AverageRental;
 };
 
 class ReportManager {
@@ -45,9 +47,23 @@ public:
     void generateIncomeStatement(const std::string& startDate, const std::string& endDate);
     void generateCustomerLoyaltyReport();
     void generateProfitMarginReport();
+    
+    // Rows behind the tabular reports, one query each; empty on error
+    std::vector<MonthlySales> getMonthlySales(const std::string& year);
+    std::vector<InventoryValuation> getInventoryValuation();
+    std::vector<DressUtilization> getDressUtilization();
+    std::vector<CustomerActivity> getCustomerActivity();
+    
+    // Report tables: each is composed in a string with Format (no per-cell
+    // stream formatting) and written to out in large chunks
+    void renderMonthlySales(std::ostream& out, const std::vector<MonthlySales>& rows);
+    void renderInventoryValuation(std::ostream& out, const std::vector<InventoryValuation>& rows);
+    void renderDressUtilization(std::ostream& out, const std::vector<DressUtilization>& rows);
+    void renderCustomerActivity(std::ostream& out, const std::vector<CustomerActivity>& rows);
+    
     void displayBarChart(const std::string& title, const std::vector<std::pair<std::string, double>>& data);
-    void displayTextChart(const std::string& title, const std::vector<std::pair<std::string, double>>& data);
-    void displayTextGraphSummary(const std::vector<std::pair<std::string, double>>& data);
+    void displayTextChart(const std::string& title, const std::vector<std::pair<std::string, Money>>& data);
+    void displayTextGraphSummary(const std::vector<std::pair<std::string, Money>>& data);
     void displaySummaryList(const std::vector<std::string>& items);
     void displayDashboard();
 };
@@ -0,0 +1,46 @@
+#ifndef RESERVATIONMANAGER_H
+#define RESERVATIONMANAGER_H
+
+#include "DatabaseManager.h"
+#include <string>
+#include <vector>
+
+struct Reservation {
+    int ReservationID;
+    int CustomerID;
+    std::string Category;       // with Size, the group of dresses booked
+    std::string Size;
+    std::string StartDate;      // pickup
+    std::string EndDate;        // return, included
+    std::string Status;         // Booked, Fulfilled or Cancelled
+    int AssignedDressID;        // 0 while no dress of the group is free
+    int RentalID;               // 0 until fulfilled
+};
+
+// Advance bookings for a category and size rather than a dress. Which dress
+// each booked reservation gets is decided by ReservationPlanner and stored in
+// AssignedDressID; every change replans only the group it touches, keeps the
+// dresses already promised where they still fit, and writes back only the
+// reservations whose dress changed. A reservation holds no stock until it is
+// fulfilled into a rental; walk-in rentals are planned around at the next
+// change to the group.
+class ReservationManager {
+public:
+    // Returns the new reservation ID, or -1
+    int createReservation(int customerID, const std::string& category, const std::string& size,
+                          const std::string& startDate, const std::string& endDate);
+    bool cancelReservation(int reservationID);
+    // Rents the assigned dress from StartDate to EndDate and marks the
+    // reservation fulfilled, in one transaction; returns the rental ID, or -1
+    int fulfilReservation(int reservationID);
+    // Replans every group; returns how many reservations changed dress, or -1
+    int replanAll();
+
+    Reservation* getReservationByID(int reservationID);
+    // Booked reservations that have not ended, by start date
+    std::vector<Reservation> getUpcomingReservations();
+    void displayReservations(const std::vector<Reservation>& reservations);
+    bool validateReservationDates(const std::string& startDate, const std::string& endDate);
+};
+
+#endif
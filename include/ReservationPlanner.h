@@ -0,0 +1,105 @@
+#ifndef RESERVATIONPLANNER_H
+#define RESERVATIONPLANNER_H
+
+#include <cstddef>
+#include <map>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Assigns concrete dresses to reservations. A reservation asks for a group
+// (category and size) over a range of days; every unit of every dress in the
+// group can take reservations that do not overlap, around the rentals it is
+// already out on.
+//
+// solve() plans a group from scratch with the interval-scheduling greedy:
+// reservations by earliest last day, each on the free unit whose previous
+// booking ended latest (the tightest fit). For identical units this assigns
+// as many reservations as possible. Day-to-day changes go through
+// addReservation() and removeReservation(), which fit one reservation into
+// the current plan without moving any other, so customers keep the dress they
+// were told about. solve() is only needed when something is left waiting; its
+// plan may move reservations to other dresses, and is only kept if it assigns
+// more without leaving any reservation that had a dress waiting.
+//
+// Days are day numbers (LateFeePolicy::parseDate), both ends included.
+class ReservationPlanner {
+public:
+    struct Booking {
+        int reservationID;          // positive
+        std::string group;
+        long firstDay;
+        long lastDay;
+        int dressID;                // assigned dress, -1 while waiting
+    };
+
+    static std::string groupOf(const std::string& category, const std::string& size);
+
+    void addDress(const std::string& group, int dressID, int units);
+    // A rental holding a unit of the dress; false if the dress is unknown or
+    // has no unit free over those days
+    bool addRental(int dressID, long firstDay, long lastDay);
+
+    // Adds a reservation (replacing one with the same ID) and fits it into the
+    // current plan, trying preferredDressID first; false if it has to wait
+    bool addReservation(int reservationID, const std::string& group, long firstDay, long lastDay,
+                        int preferredDressID = -1);
+    // Removes a reservation and gives its days to waiting ones of its group
+    bool removeReservation(int reservationID);
+
+    // Replans a group from scratch and keeps the result if it assigns more
+    // (see above); returns the group's assigned reservations afterwards
+    size_t solve(const std::string& group);
+    // solve() for every group with a waiting reservation; returns how many
+    // reservations are assigned in total
+    size_t solveAll();
+
+    const Booking* find(int reservationID) const;
+    std::vector<Booking> getBookings() const;      // by reservation ID
+    size_t size() const { return bookings.size(); }
+    size_t assignedCount() const { return assigned.size(); }
+    void clear();
+
+private:
+    static const int RENTAL = 0;        // owner of a busy slot held by a rental
+
+    struct Slot {
+        long firstDay;
+        long lastDay;
+        int reservationID;              // RENTAL for rentals
+    };
+
+    // A unit holds a few dozen bookings a year, so a sorted vector searches
+    // faster than a tree and the scan over a group's units stays in cache
+    struct Unit {
+        int dressID;
+        std::vector<Slot> busy;         // by first day, never overlapping
+    };
+
+    struct Group {
+        std::vector<Unit> units;
+        std::unordered_map<int, std::vector<size_t>> dressUnits;
+        std::set<int> members;          // its reservations
+        std::vector<int> waiting;       // members without a unit, oldest first
+    };
+
+    // Whether the unit is free from firstDay to lastDay; idle gets the days
+    // it would stand empty before firstDay (the tightest fit is the smallest)
+    static bool fits(const Unit& unit, long firstDay, long lastDay, long& idle);
+    static void occupy(Unit& unit, const Slot& slot);
+    // The greedy plan of a group's reservations; with assignedFirst the ones
+    // that have a dress are planned before the waiting ones
+    void planGroup(const Group& group, bool assignedFirst, std::vector<Unit>& plan,
+                   std::vector<std::pair<int, size_t>>& placed) const;
+    bool place(Group& group, Booking& booking, int preferredDressID);
+    void unplace(Group& group, const Booking& booking);
+
+    std::map<std::string, Group> groups;
+    std::unordered_map<int, std::string> dressGroups;
+    std::unordered_map<int, Booking> bookings;
+    std::unordered_map<int, size_t> assigned;      // reservation ID -> unit in its group
+};
+
+#endif
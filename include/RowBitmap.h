@@ -0,0 +1,79 @@
+#ifndef ROWBITMAP_H
+#define ROWBITMAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// A set of row numbers, stored roaring-style. Rows are split into chunks of
+// 65536 by their high 16 bits. A chunk holding up to 4096 rows is a sorted
+// array of the low 16 bits (two bytes per row); a fuller one is a 65536-bit
+// bitset (8 KB, one bit per possible row). Set operations go chunk by chunk
+// using whichever form each side has, so sparse and dense sets both stay
+// small and fast.
+class RowBitmap {
+public:
+    RowBitmap() {}
+
+    // Cheapest when rows arrive in ascending order
+    void add(uint32_t row);
+    bool contains(uint32_t row) const;
+    size_t cardinality() const;
+    bool empty() const { return chunks.empty(); }
+    // Chunks in use; each bounds the work of a set operation by 65536 rows
+    size_t chunkCount() const { return chunks.size(); }
+    void clear() { chunks.clear(); }
+
+    // Rows in both; intersectCount builds nothing
+    static RowBitmap intersect(const RowBitmap& a, const RowBitmap& b);
+    static size_t intersectCount(const RowBitmap& a, const RowBitmap& b);
+    // Rows in either
+    static RowBitmap unite(const RowBitmap& a, const RowBitmap& b);
+
+    // Up to limit rows in ascending order; 0 = all of them
+    std::vector<uint32_t> toRows(size_t limit = 0) const;
+
+    // Calls fn(row) for every row in ascending order
+    template <typename Fn>
+    void forEach(Fn fn) const {
+        for (const Chunk& chunk : chunks) {
+            uint32_t high = static_cast<uint32_t>(chunk.key) << 16;
+            if (chunk.isBitset()) {
+                for (size_t w = 0; w < BITSET_WORDS; ++w) {
+                    for (uint64_t word = chunk.bits[w]; word != 0; word &= word - 1) {
+                        fn(high | static_cast<uint32_t>(w * 64 + trailingZeros(word)));
+                    }
+                }
+            } else {
+                for (uint16_t low : chunk.array) fn(high | low);
+            }
+        }
+    }
+
+    size_t memoryBytes() const;
+
+private:
+    static const uint32_t ARRAY_MAX = 4096;
+    static const size_t BITSET_WORDS = 1024;
+
+    struct Chunk {
+        uint16_t key;                   // high 16 bits of its rows
+        uint32_t count;
+        std::vector<uint16_t> array;    // sorted low bits while count <= ARRAY_MAX
+        std::vector<uint64_t> bits;     // BITSET_WORDS words once larger
+
+        bool isBitset() const { return !bits.empty(); }
+        bool has(uint16_t low) const;
+    };
+
+    static int trailingZeros(uint64_t word);
+    static void toBitset(Chunk& chunk);
+    static void toArrayIfSmall(Chunk& chunk);
+    static Chunk intersectChunks(const Chunk& a, const Chunk& b);
+    static size_t intersectChunkCount(const Chunk& a, const Chunk& b);
+    static Chunk uniteChunks(const Chunk& a, const Chunk& b);
+
+    std::vector<Chunk> chunks;          // sorted by key, none empty
+};
+
+#endif
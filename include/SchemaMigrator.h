@@ -0,0 +1,62 @@
+#ifndef SCHEMAMIGRATOR_H
+#define SCHEMAMIGRATOR_H
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Brings the database schema up to the version this build expects. The
+// migrations are compiled in (SchemaMigrator.cpp), numbered from 1 and applied
+// in order; each applied one is recorded in the SchemaMigrations table with a
+// checksum of its statements, so a migration edited after it shipped is caught
+// instead of silently diverging.
+//
+// MySQL commits DDL implicitly, so a migration cannot be rolled back halfway.
+// Every statement is written to be safe to run again (IF NOT EXISTS and
+// friends) and a failed migration is simply retried on the next start.
+// Migrations run under GET_LOCK so instances starting together take turns,
+// ALTERs ask for ALGORITHM=INPLACE, LOCK=NONE so the tables stay writable,
+// and a short lock_wait_timeout (migration_lock_wait, default 10 s) keeps an
+// ALTER stuck behind a long transaction from stalling every query queued
+// behind it.
+class SchemaMigrator {
+public:
+    struct Entry {
+        int version;
+        std::string name;
+        std::string checksum;       // of the compiled-in statements
+        bool applied;
+        std::string appliedAt;      // empty if pending
+        bool checksumMismatch;      // applied with different statements
+    };
+
+    SchemaMigrator();
+
+    // Applies pending migrations; false if one failed, the lock could not be
+    // taken or an applied migration's checksum no longer matches
+    bool migrate();
+
+    // Reads SchemaMigrations without changing anything; false on error or if
+    // an applied migration's checksum no longer matches
+    bool check();
+
+    const std::vector<Entry>& getEntries() const { return entries; }
+    int pendingCount() const;
+    // Versions recorded in the database that this build does not know about
+    const std::vector<int>& getUnknownVersions() const { return unknownVersions; }
+
+    void printStatus(std::ostream& out);
+
+    static int latestVersion();
+
+private:
+    // Rebuilds entries from SchemaMigrations; throws sql::SQLException
+    void loadApplied();
+    // Reports checksum mismatches (false if any) and unknown newer versions
+    bool verifyApplied();
+
+    std::vector<Entry> entries;
+    std::vector<int> unknownVersions;
+};
+
+#endif
@@ -0,0 +1,97 @@
+#ifndef SHAREDSNAPSHOT_H
+#define SHAREDSNAPSHOT_H
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+
+// An in-memory copy of database data (DressCatalog, AvailabilityCalendar:
+// anything with a bool load()) shared by the worker threads of a server.
+// Readers hold a shared_ptr, so a reload never pulls a snapshot out from under
+// them. When the copy is older than maxAgeSeconds the next get() reloads it;
+// while that one caller loads, the others keep getting the old copy, and only
+// callers that have nothing to serve yet wait.
+//
+// Every successful load gets a new generation number, so results derived from
+// a snapshot (rendered responses) can be cached and recognised as current.
+template <typename T>
+class SharedSnapshot {
+public:
+    explicit SharedSnapshot(int maxAgeSeconds) : maxAge(maxAgeSeconds), loading(false), generation(0) {}
+
+    // Null if the data has never loaded
+    std::shared_ptr<const T> get() {
+        unsigned long ignored = 0;
+        return get(ignored);
+    }
+
+    // Also sets loadedGeneration to the generation of the copy returned
+    std::shared_ptr<const T> get(unsigned long& loadedGeneration) {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            if (data && std::chrono::steady_clock::now() - loadedAt < maxAge) break;
+            if (!loading) {
+                load(lock);
+                break;
+            }
+            if (data) break;
+            loaded.wait(lock);
+        }
+        loadedGeneration = generation;
+        return data;
+    }
+
+    // Generation of the current copy without loading anything; 0 if it is
+    // missing or stale
+    unsigned long currentGeneration() {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!data || std::chrono::steady_clock::now() - loadedAt >= maxAge) return 0;
+        return generation;
+    }
+
+    // Makes the next get() reload, after a change the copy does not show
+    void invalidate() {
+        std::lock_guard<std::mutex> lock(mutex);
+        loadedAt = std::chrono::steady_clock::time_point();
+    }
+
+    // Installs a copy built elsewhere as the current one
+    void replace(std::shared_ptr<const T> fresh) {
+        std::lock_guard<std::mutex> lock(mutex);
+        data = fresh;
+        loadedAt = std::chrono::steady_clock::now();
+        ++generation;
+    }
+
+private:
+    SharedSnapshot(const SharedSnapshot&) = delete;
+    SharedSnapshot& operator=(const SharedSnapshot&) = delete;
+
+    void load(std::unique_lock<std::mutex>& lock) {
+        loading = true;
+        lock.unlock();
+        T* fresh = new T();
+        bool ok = fresh->load();
+        lock.lock();
+        loading = false;
+        if (ok) {
+            data.reset(fresh);
+            loadedAt = std::chrono::steady_clock::now();
+            ++generation;
+        } else {
+            delete fresh;
+        }
+        loaded.notify_all();
+    }
+
+    std::chrono::seconds maxAge;
+    std::mutex mutex;
+    std::condition_variable loaded;
+    std::shared_ptr<const T> data;
+    std::chrono::steady_clock::time_point loadedAt;
+    bool loading;
+    unsigned long generation;
+};
+
+#endif
@@ -0,0 +1,76 @@
+#ifndef TABLERENDERER_H
+#define TABLERENDERER_H
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Bordered console tables.
+//
+// Buffered mode: define the columns, addRow() each row, then render(). Every
+// cell's display width (ANSI escapes skipped, UTF-8 aware) is measured once when
+// the row is added and reused for both column sizing and padding. Columns are
+// sized to their widest cell, then the widest ones are narrowed until the table
+// fits in maxWidth; cells that no longer fit are cut and end in '.'.
+//
+// Streaming mode: beginStream() fixes the widths from the column definitions
+// alone and prints the header, streamRow() writes each row as soon as it is
+// produced (e.g. straight from a result set), endStream() closes the table.
+class TableRenderer {
+public:
+    enum Align { ALIGN_LEFT, ALIGN_RIGHT };
+
+    // maxWidth is the screen width the table is fitted and centered in; 0 = unlimited
+    explicit TableRenderer(int maxWidth = 80);
+
+    // minWidth: never narrowed below this (and the fixed width when streaming);
+    // maxWidth: never wider than this, 0 = no cap. Widths include the one-column gap.
+    void addColumn(const std::string& header, int minWidth = 0, int maxWidth = 0, Align align = ALIGN_LEFT);
+
+    void addRow(const std::vector<std::string>& row);
+    void addRow(std::vector<std::string>&& row);
+    size_t rowCount() const { return columns.empty() ? 0 : cells.size() / columns.size(); }
+    void clearRows() { cells.clear(); }
+
+    void render(std::ostream& os);
+    void render();
+
+    void beginStream(std::ostream& os);
+    void beginStream();
+    void streamRow(const std::vector<std::string>& row);
+    void endStream();
+
+    // Cuts text to at most width visible columns, keeping escape sequences intact
+    static std::string truncate(const std::string& text, int width);
+
+private:
+    struct Column {
+        std::string header;
+        int headerWidth;
+        int minWidth;
+        int maxWidth;
+        Align align;
+        int width;      // resolved width for the current render
+    };
+    struct Cell {
+        std::string text;
+        int width;
+    };
+
+    void storeCell(std::string&& text);
+    void fitColumns();
+    void buildBorder();
+    void writeHeader();
+    void writeRow(const Cell* row);
+    void appendCell(const Column& column, const std::string& text, int width);
+
+    std::vector<Column> columns;
+    std::vector<Cell> cells;        // row-major, columns.size() cells per row
+    int maxWidth;
+    int padding;
+    std::string border;
+    std::string line;               // reused output buffer for one row
+    std::ostream* stream;
+};
+
+#endif
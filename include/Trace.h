@@ -0,0 +1,51 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+// Lightweight scoped tracing for manager operations.
+//
+// Set DRS_TRACE=<file> to enable; on exit the spans are written to that file in
+// Chrome trace format (open it in chrome://tracing or Perfetto). Each thread
+// records into its own preallocated ring buffer, so a span costs two clock reads
+// and no allocation or locking. When the ring wraps, the oldest spans are lost.
+struct TraceBuffer;
+
+class Trace {
+public:
+    static const uint32_t RING_SIZE = 1u << 16; // spans kept per thread
+
+    static bool enabled() { return enabledFlag.load(std::memory_order_relaxed); }
+    static void setEnabled(bool on);
+
+    // Writes every thread's spans to path; call when the recording threads are idle
+    static bool exportChromeTrace(const std::string& path);
+
+private:
+    friend class TraceSpan;
+    static std::atomic<bool> enabledFlag;
+    static TraceBuffer* threadBuffer();
+};
+
+class TraceSpan {
+public:
+    // name must have static storage duration (a string literal); value is an
+    // optional number shown with the span, e.g. the rental ID
+    explicit TraceSpan(const char* name, long long value = -1);
+    ~TraceSpan();
+
+private:
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+    const char* name;
+    long long value;
+    TraceBuffer* buffer;
+    uint64_t id;
+    uint64_t parent;
+    uint64_t startNs;
+};
+
+#endif
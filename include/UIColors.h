@@ -37,6 +37,19 @@ public:
     static void enableColors();
     static void disableColors();
     static bool colorsEnabled();
+    // Turns colors off when stdout is not a terminal or NO_COLOR is set
+    static void configureForTerminal();
+    
+    // Frame rendering: between beginFrame() and endFrame() everything written
+    // through UIColors (and to out()) is composed in a per-thread buffer and
+    // written to stdout in one go. Frames nest; the outermost one flushes.
+    static void beginFrame();
+    static void endFrame();
+    static std::ostream& out();
+    
+    // Display width of text: ANSI escape sequences are skipped and each UTF-8
+    // code point counts as one column
+    static int visibleWidth(const std::string& text);
     
     // Centered Text Functions
     static void printCentered(const std::string& text, int width = 80, const std::string& color = "");
@@ -55,6 +68,18 @@ public:
     
 private:
     static bool colors_enabled;
+    static void writeLine(const std::string& color, const std::string& text);
+};
+
+// Scoped frame: composes everything printed in its lifetime into one write
+class RenderFrame {
+public:
+    RenderFrame() { UIColors::beginFrame(); }
+    ~RenderFrame() { UIColors::endFrame(); }
+    
+private:
+    RenderFrame(const RenderFrame&) = delete;
+    RenderFrame& operator=(const RenderFrame&) = delete;
 };
 
 #endif
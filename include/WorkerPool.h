@@ -0,0 +1,44 @@
+#ifndef WORKERPOOL_H
+#define WORKERPOOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of threads running submitted tasks in FIFO order. Each thread
+// gets its own database connection on first use (DatabaseManager keeps one
+// per thread), so a pool of N threads serves any number of callers over N
+// connections; the connection is closed when the thread exits.
+class WorkerPool {
+public:
+    WorkerPool();
+    ~WorkerPool();
+
+    void start(int threadCount);
+    // Lets the queued tasks finish, then joins the threads
+    void stop();
+
+    void submit(std::function<void()> task);
+
+    int size() const { return static_cast<int>(threads.size()); }
+    size_t queued();
+    int busy();
+
+private:
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    void threadMain();
+
+    std::vector<std::thread> threads;
+    std::mutex mutex;
+    std::condition_variable taskReady;
+    std::deque<std::function<void()>> tasks;
+    int running;                    // tasks being run right now
+    bool stopRequested;
+};
+
+#endif
@@ -0,0 +1,102 @@
+#include "AppConfig.h"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+namespace {
+
+std::string trim(const std::string& text) {
+    size_t first = text.find_first_not_of(" \t\r");
+    if (first == std::string::npos) return "";
+    size_t last = text.find_last_not_of(" \t\r");
+    return text.substr(first, last - first + 1);
+}
+
+std::string envName(const std::string& key) {
+    std::string name = "DRS_";
+    for (char c : key) name += static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+    return name;
+}
+
+} // namespace
+
+AppConfig& AppConfig::getInstance() {
+    static AppConfig instance;
+    return instance;
+}
+
+AppConfig::AppConfig() {
+    const char* path = std::getenv("DRS_CONFIG");
+    if (path && *path) {
+        if (!loadFile(path)) std::cerr << "Config file not found: " << path << std::endl;
+    } else {
+        loadFile("dress_rental.conf");
+    }
+}
+
+bool AppConfig::loadFile(const std::string& path) {
+    std::ifstream in(path.c_str());
+    if (!in) return false;
+    sourcePath = path;
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(in, line)) {
+        ++lineNumber;
+        size_t hash = line.find('#');
+        if (hash != std::string::npos) line.erase(hash);
+        line = trim(line);
+        if (line.empty()) continue;
+        size_t equals = line.find('=');
+        if (equals == std::string::npos) {
+            std::cerr << path << ":" << lineNumber << ": expected key = value" << std::endl;
+            continue;
+        }
+        std::string key = trim(line.substr(0, equals));
+        std::transform(key.begin(), key.end(), key.begin(), ::tolower);
+        fileValues[key] = trim(line.substr(equals + 1));
+    }
+    return true;
+}
+
+bool AppConfig::lookup(const std::string& key, std::string& value) const {
+    const char* env = std::getenv(envName(key).c_str());
+    if (env) {
+        value = env;
+        return true;
+    }
+    std::map<std::string, std::string>::const_iterator it = fileValues.find(key);
+    if (it == fileValues.end()) return false;
+    value = it->second;
+    return true;
+}
+
+std::string AppConfig::getString(const std::string& key, const std::string& fallback) const {
+    std::string value;
+    return lookup(key, value) ? value : fallback;
+}
+
+int AppConfig::getInt(const std::string& key, int fallback) const {
+    std::string value;
+    if (!lookup(key, value) || value.empty()) return fallback;
+    char* end = nullptr;
+    errno = 0;
+    long parsed = std::strtol(value.c_str(), &end, 10);
+    if (errno != 0 || *end != '\0' || parsed < -2147483647L || parsed > 2147483647L) {
+        std::cerr << "Invalid number for " << key << ": " << value << std::endl;
+        return fallback;
+    }
+    return static_cast<int>(parsed);
+}
+
+bool AppConfig::getBool(const std::string& key, bool fallback) const {
+    std::string value;
+    if (!lookup(key, value)) return fallback;
+    std::transform(value.begin(), value.end(), value.begin(), ::tolower);
+    if (value == "1" || value == "true" || value == "yes" || value == "on") return true;
+    if (value == "0" || value == "false" || value == "no" || value == "off") return false;
+    std::cerr << "Invalid boolean for " << key << ": " << value << std::endl;
+    return fallback;
+}
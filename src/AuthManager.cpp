@@ -112,16 +112,16 @@ bool AuthManager::verifyPassword(const std::string& password, const std::string&
     return computedHash == hash;
 }
 
-bool AuthManager::login(const std::string& username, const std::string& password) {
+bool AuthManager::authenticate(const std::string& username, const std::string& password, User& user) {
     try {
         sql::Connection* conn = DatabaseManager::getInstance().getConnection();
         if (!conn) return false;
         
-        sql::PreparedStatement* pstmt = conn->prepareStatement(
+        sql::PreparedStatement* pstmt = DatabaseManager::getInstance().prepare(
             "SELECT * FROM Users WHERE Username = ? AND IsActive = TRUE"
         );
         pstmt->setString(1, username);
-        sql::ResultSet* res = pstmt->executeQuery();
+        sql::ResultSet* res = DatabaseManager::getInstance().executePreparedQuery(pstmt);
         
         if (res && res->next()) {
             std::string storedHash = res->getString("PasswordHash");
@@ -136,27 +136,24 @@ bool AuthManager::login(const std::string& username, const std::string& password
                     return false;
                 }
                 
-                currentUser = new User();
-                currentUser->UserID = res->getInt("UserID");
-                currentUser->Username = res->getString("Username");
-                currentUser->PasswordHash = storedHash;
-                currentUser->Role = userRole;
-                currentUser->FullName = res->getString("FullName");
-                currentUser->Email = res->getString("Email");
-                currentUser->Phone = res->getString("Phone");
-                currentUser->IsActive = res->getBoolean("IsActive");
-                currentUser->LastLogin = res->getString("LastLogin");
+                user.UserID = res->getInt("UserID");
+                user.Username = res->getString("Username");
+                user.PasswordHash = storedHash;
+                user.Role = userRole;
+                user.FullName = res->getString("FullName");
+                user.Email = res->getString("Email");
+                user.Phone = res->getString("Phone");
+                user.IsActive = res->getBoolean("IsActive");
+                user.LastLogin = res->getString("LastLogin");
                 
                 // Update last login
-                sql::PreparedStatement* updateStmt = conn->prepareStatement(
+                sql::PreparedStatement* updateStmt = DatabaseManager::getInstance().prepare(
                     "UPDATE Users SET LastLogin = NOW() WHERE UserID = ?"
                 );
-                updateStmt->setInt(1, currentUser->UserID);
-                updateStmt->executeUpdate();
+                updateStmt->setInt(1, user.UserID);
+                DatabaseManager::getInstance().executePreparedUpdate(updateStmt);
                 delete updateStmt;
                 
-                loggedIn = true;
-                logActivity("User Login", "Users", currentUser->UserID, "Successful login");
                 delete pstmt;
                 delete res;
                 return true;
@@ -172,6 +169,49 @@ bool AuthManager::login(const std::string& username, const std::string& password
     }
 }
 
+bool AuthManager::reloadUser(int userID, User& user) {
+    try {
+        sql::PreparedStatement* pstmt = DatabaseManager::getInstance().prepare(
+            "SELECT UserID, Username, Role, FullName, Email, Phone, IsActive, LastLogin "
+            "FROM Users WHERE UserID = ? AND IsActive = TRUE AND Role <> 'Customer'"
+        );
+        pstmt->setInt(1, userID);
+        sql::ResultSet* res = DatabaseManager::runQuery(pstmt);
+        bool found = res && res->next();
+        if (found) {
+            user.UserID = res->getInt("UserID");
+            user.Username = res->getString("Username");
+            user.PasswordHash.clear();
+            user.Role = res->getString("Role");
+            user.FullName = res->getString("FullName");
+            user.Email = res->getString("Email");
+            user.Phone = res->getString("Phone");
+            user.IsActive = res->getBoolean("IsActive");
+            user.LastLogin = res->getString("LastLogin");
+        }
+        if (res) delete res;
+        delete pstmt;
+        return found;
+    } catch (sql::SQLException& e) {
+        std::cerr << "Error reloading user: " << e.what() << std::endl;
+        return false;
+    } catch (const std::exception& e) {
+        std::cerr << "Error reloading user: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+bool AuthManager::login(const std::string& username, const std::string& password) {
+    User user;
+    if (!authenticate(username, password, user)) return false;
+    
+    delete currentUser;
+    currentUser = new User(user);
+    loggedIn = true;
+    logActivity("User Login", "Users", currentUser->UserID, "Successful login");
+    return true;
+}
+
 bool AuthManager::logout() {
     if (currentUser) {
         logActivity("User Logout", "Users", currentUser->UserID, "User logged out");
@@ -187,11 +227,11 @@ bool AuthManager::changePassword(int userID, const std::string& oldPassword, con
         sql::Connection* conn = DatabaseManager::getInstance().getConnection();
         if (!conn) return false;
         
-        sql::PreparedStatement* pstmt = conn->prepareStatement(
+        sql::PreparedStatement* pstmt = DatabaseManager::getInstance().prepare(
             "SELECT PasswordHash FROM Users WHERE UserID = ?"
         );
         pstmt->setInt(1, userID);
-        sql::ResultSet* res = pstmt->executeQuery();
+        sql::ResultSet* res = DatabaseManager::getInstance().executePreparedQuery(pstmt);
         
         if (res && res->next()) {
             std::string storedHash = res->getString("PasswordHash");
@@ -204,12 +244,12 @@ bool AuthManager::changePassword(int userID, const std::string& oldPassword, con
             
             std::string newHash = hashPassword(newPassword);
             
-            sql::PreparedStatement* updateStmt = conn->prepareStatement(
+            sql::PreparedStatement* updateStmt = DatabaseManager::getInstance().prepare(
                 "UPDATE Users SET PasswordHash = ? WHERE UserID = ?"
             );
             updateStmt->setString(1, newHash);
             updateStmt->setInt(2, userID);
-            updateStmt->executeUpdate();
+            DatabaseManager::getInstance().executePreparedUpdate(updateStmt);
             delete updateStmt;
             
             logActivity("Password Change", "Users", userID, "Password changed successfully");
@@ -232,7 +272,7 @@ bool AuthManager::createUser(const User& user) {
         sql::Connection* conn = DatabaseManager::getInstance().getConnection();
         if (!conn) return false;
         
-        sql::PreparedStatement* pstmt = conn->prepareStatement(
+        sql::PreparedStatement* pstmt = DatabaseManager::getInstance().prepare(
             "INSERT INTO Users (Username, PasswordHash, Role, FullName, Email, Phone) "
             "VALUES (?, ?, ?, ?, ?, ?)"
         );
@@ -246,7 +286,7 @@ bool AuthManager::createUser(const User& user) {
         pstmt->setString(5, user.Email);
         pstmt->setString(6, user.Phone);
         
-        pstmt->executeUpdate();
+        DatabaseManager::getInstance().executePreparedUpdate(pstmt);
         delete pstmt;
         return true;
     } catch (sql::SQLException& e) {
@@ -280,7 +320,7 @@ void AuthManager::logActivity(const std::string& action, const std::string& tabl
         sql::Connection* conn = DatabaseManager::getInstance().getConnection();
         if (!conn) return;
         
-        sql::PreparedStatement* pstmt = conn->prepareStatement(
+        sql::PreparedStatement* pstmt = DatabaseManager::getInstance().prepare(
             "INSERT INTO ActivityLog (UserID, Action, TableName, RecordID, Details) "
             "VALUES (?, ?, ?, ?, ?)"
         );
@@ -292,35 +332,9 @@ void AuthManager::logActivity(const std::string& action, const std::string& tabl
         pstmt->setInt(4, recordID);
         pstmt->setString(5, details);
         
-        pstmt->executeUpdate();
+        DatabaseManager::getInstance().executePreparedUpdate(pstmt);
         delete pstmt;
     } catch (sql::SQLException&) {
         // Silent fail for logging
     }
 }
-
-std::vector<std::pair<int, std::string>> AuthManager::getLowStockDresses(int threshold) {
-    std::vector<std::pair<int, std::string>> lowStock;
-    try {
-        sql::Connection* conn = DatabaseManager::getInstance().getConnection();
-        if (!conn) return lowStock;
-        
-        sql::PreparedStatement* pstmt = conn->prepareStatement(
-            "SELECT DressID, DressName FROM Dresses "
-            "WHERE AvailabilityStatus = 'Available' AND StockQuantity <= ?"
-        );
-        pstmt->setInt(1, threshold);
-        sql::ResultSet* res = pstmt->executeQuery();
-        
-        while (res && res->next()) {
-            lowStock.push_back({res->getInt("DressID"), res->getString("DressName")});
-        }
-        
-        delete pstmt;
-        if (res) delete res;
-    } catch (sql::SQLException& e) {
-        std::cerr << "Error getting low stock: " << e.what() << std::endl;
-    }
-    return lowStock;
-}
-
@@ -0,0 +1,272 @@
+#include "AvailabilityCalendar.h"
+#include "DatabaseManager.h"
+#include "Format.h"
+#include "LateFeePolicy.h"
+#include "MenuHandlers.h"
+#include "UIColors.h"
+#include <algorithm>
+#include <iostream>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+const int GRID_WIDTH = 20;      // "Mo Tu We Th Fr Sa Su"
+const int GRIDS_PER_LINE = 3;
+
+// dst &= src over count words, a vector register at a time where available
+void andWords(uint64_t* dst, const uint64_t* src, size_t count) {
+    size_t i = 0;
+#if defined(__AVX2__)
+    for (; i + 4 <= count; i += 4) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_and_si256(a, b));
+    }
+#elif defined(__SSE2__)
+    for (; i + 2 <= count; i += 2) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_and_si128(a, b));
+    }
+#endif
+    for (; i < count; ++i) dst[i] &= src[i];
+}
+
+int trailingZeros(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(word);
+#else
+    int zeros = 0;
+    while ((word & 1) == 0) {
+        word >>= 1;
+        ++zeros;
+    }
+    return zeros;
+#endif
+}
+
+// Monday = 0; day 0 (1970-01-01) was a Thursday
+int weekday(long dayNumber) {
+    long weekdayIndex = (dayNumber + 3) % 7;
+    return static_cast<int>(weekdayIndex < 0 ? weekdayIndex + 7 : weekdayIndex);
+}
+
+} // namespace
+
+AvailabilityCalendar::AvailabilityCalendar() : startDay(0), days(WINDOW_DAYS) {}
+
+bool AvailabilityCalendar::reset(const std::string& date) {
+    long day = 0;
+    if (!LateFeePolicy::parseDate(date, day)) return false;
+    startDate = date.substr(0, 10);
+    startDay = day;
+    ids.clear();
+    rows.clear();
+    for (std::vector<uint64_t>& column : days) column.clear();
+    return true;
+}
+
+bool AvailabilityCalendar::load(const std::string& date) {
+    if (!reset(date.empty() ? LateFeePolicy::today() : date)) return false;
+    std::string endDate = dateAt(WINDOW_DAYS - 1);
+    try {
+        sql::ResultSet* res = DatabaseManager::getInstance().executeReadSelect(
+            "SELECT DressID, StockQuantity, AvailabilityStatus FROM Dresses ORDER BY DressID"
+        );
+        if (!res) return false;
+        while (res->next()) {
+            addDress(res->getInt("DressID"),
+                     res->getInt("StockQuantity") > 0 && res->getString("AvailabilityStatus") != "Maintenance");
+        }
+        delete res;
+
+        // Only days with every unit reserved are stored as taken
+        sql::PreparedStatement* pstmt = nullptr;
+        res = DatabaseManager::getInstance().executeRead(
+            "SELECT s.DressID, DATEDIFF(s.StockDate, ?) AS Day FROM DressDailyStock s "
+            "JOIN Dresses d ON d.DressID = s.DressID "
+            "WHERE s.StockDate BETWEEN ? AND ? AND s.Reserved >= d.StockQuantity",
+            [&](sql::PreparedStatement* statement) {
+                statement->setString(1, startDate);
+                statement->setString(2, startDate);
+                statement->setString(3, endDate);
+            },
+            pstmt);
+        while (res && res->next()) {
+            markBooked(res->getInt("DressID"), res->getInt("Day"));
+        }
+        delete pstmt;
+        if (res) delete res;
+    } catch (sql::SQLException& e) {
+        std::cerr << "Error loading availability calendar: " << e.what() << std::endl;
+        reset(startDate);
+        return false;
+    }
+    return true;
+}
+
+void AvailabilityCalendar::addDress(int dressID, bool rentable) {
+    size_t row = ids.size();
+    ids.push_back(dressID);
+    for (int w = 0; w < ROW_WORDS; ++w) {
+        uint64_t word = 0;
+        if (rentable) {
+            int bits = std::min(64, WINDOW_DAYS - w * 64);
+            word = bits == 64 ? ~0ULL : (1ULL << bits) - 1;
+        }
+        rows.push_back(word);
+    }
+
+    uint64_t bit = 1ULL << (row & 63);
+    for (std::vector<uint64_t>& column : days) {
+        if (row % 64 == 0) column.push_back(0);
+        if (rentable) column.back() |= bit;
+    }
+}
+
+void AvailabilityCalendar::markBooked(int dressID, int day) {
+    long row = rowOf(dressID);
+    if (row < 0 || day < 0 || day >= WINDOW_DAYS) return;
+    rows[row * ROW_WORDS + day / 64] &= ~(1ULL << (day % 64));
+    days[day][row / 64] &= ~(1ULL << (row % 64));
+}
+
+long AvailabilityCalendar::rowOf(int dressID) const {
+    std::vector<int>::const_iterator found = std::lower_bound(ids.begin(), ids.end(), dressID);
+    if (found == ids.end() || *found != dressID) return -1;
+    return static_cast<long>(found - ids.begin());
+}
+
+int AvailabilityCalendar::dayOf(const std::string& date) const {
+    long day = 0;
+    if (!LateFeePolicy::parseDate(date, day)) return -1;
+    day -= startDay;
+    return day >= 0 && day < WINDOW_DAYS ? static_cast<int>(day) : -1;
+}
+
+std::string AvailabilityCalendar::dateAt(int day) const {
+    return LateFeePolicy::dateOf(startDay + day);
+}
+
+bool AvailabilityCalendar::isFree(int dressID, int day) const {
+    long row = rowOf(dressID);
+    if (row < 0 || day < 0 || day >= WINDOW_DAYS) return false;
+    return (rows[row * ROW_WORDS + day / 64] >> (day % 64)) & 1;
+}
+
+std::vector<int> AvailabilityCalendar::freeDays(const std::vector<int>& dressIDs, int firstDay, int lastDay) const {
+    std::vector<int> free;
+    if (dressIDs.empty()) return free;
+    firstDay = std::max(firstDay, 0);
+    lastDay = std::min(lastDay, WINDOW_DAYS - 1);
+
+    uint64_t common[ROW_WORDS];
+    std::fill(common, common + ROW_WORDS, ~0ULL);
+    for (int dressID : dressIDs) {
+        long row = rowOf(dressID);
+        if (row < 0) return free;
+        for (int w = 0; w < ROW_WORDS; ++w) common[w] &= rows[row * ROW_WORDS + w];
+    }
+    for (int day = firstDay; day <= lastDay; ++day) {
+        if ((common[day / 64] >> (day % 64)) & 1) free.push_back(day);
+    }
+    return free;
+}
+
+std::vector<int> AvailabilityCalendar::freeDresses(int firstDay, int lastDay, size_t limit) const {
+    std::vector<int> free;
+    firstDay = std::max(firstDay, 0);
+    lastDay = std::min(lastDay, WINDOW_DAYS - 1);
+    if (firstDay > lastDay || ids.empty()) return free;
+
+    std::vector<uint64_t> match(days[firstDay]);
+    for (int day = firstDay + 1; day <= lastDay; ++day) andWords(match.data(), days[day].data(), match.size());
+
+    for (size_t w = 0; w < match.size(); ++w) {
+        for (uint64_t word = match[w]; word != 0; word &= word - 1) {
+            free.push_back(ids[w * 64 + trailingZeros(word)]);
+            if (limit != 0 && free.size() == limit) return free;
+        }
+    }
+    return free;
+}
+
+void AvailabilityCalendar::displayCalendar(const std::vector<int>& dressIDs) const {
+    std::vector<int> free = freeDays(dressIDs);
+    std::vector<bool> isFreeDay(WINDOW_DAYS, false);
+    for (int day : free) isFreeDay[day] = true;
+
+    static const char* MONTHS[] = { "January", "February", "March", "April", "May", "June", "July",
+                                    "August", "September", "October", "November", "December" };
+
+    // One 20-column grid per month the window touches: "dd" free, "--" taken,
+    // blank outside the window
+    std::vector<std::vector<std::string>> grids;
+    long monthStart = startDay - (std::stoi(startDate.substr(8, 2)) - 1);
+    while (monthStart < startDay + WINDOW_DAYS) {
+        std::string first = LateFeePolicy::dateOf(monthStart);
+        int year = std::stoi(first.substr(0, 4));
+        int month = std::stoi(first.substr(5, 2));
+        long nextStart = 0;
+        char next[Format::MAX_TEXT];
+        LateFeePolicy::parseDate(std::string(next, Format::date(next, month == 12 ? year + 1 : year,
+                                                                month == 12 ? 1 : month + 1, 1)),
+                                 nextStart);
+
+        std::vector<std::string> grid;
+        std::string title = std::string(MONTHS[month - 1]) + " " + std::to_string(year);
+        int pad = (GRID_WIDTH - static_cast<int>(title.size())) / 2;
+        grid.push_back(std::string(pad, ' ') + title + std::string(GRID_WIDTH - pad - title.size(), ' '));
+        grid.push_back("Mo Tu We Th Fr Sa Su");
+        std::string week(weekday(monthStart) * 3, ' ');
+        for (long dayNumber = monthStart; dayNumber < nextStart; ++dayNumber) {
+            long day = dayNumber - startDay;
+            int dayOfMonth = static_cast<int>(dayNumber - monthStart + 1);
+            if (day < 0 || day >= WINDOW_DAYS) {
+                week += "  ";
+            } else if (isFreeDay[day]) {
+                if (dayOfMonth < 10) week += ' ';
+                week += std::to_string(dayOfMonth);
+            } else {
+                week += "--";
+            }
+            if (weekday(dayNumber) == 6 || dayNumber + 1 == nextStart) {
+                grid.push_back(week + std::string(GRID_WIDTH - week.size(), ' '));
+                week.clear();
+            } else {
+                week += ' ';
+            }
+        }
+        while (grid.size() < 8) grid.push_back(std::string(GRID_WIDTH, ' '));
+        grids.push_back(grid);
+        monthStart = nextStart;
+    }
+
+    RenderFrame frame;
+    const int LINE_WIDTH = GRIDS_PER_LINE * GRID_WIDTH + (GRIDS_PER_LINE - 1) * 4;
+    std::string padStr((SCREEN_WIDTH - LINE_WIDTH) / 2, ' ');
+    for (size_t g = 0; g < grids.size(); g += GRIDS_PER_LINE) {
+        UIColors::out() << '\n';
+        for (size_t line = 0; line < grids[g].size(); ++line) {
+            std::string text = padStr;
+            for (size_t m = g; m < grids.size() && m < g + GRIDS_PER_LINE; ++m) {
+                if (m > g) text += "    ";
+                text += grids[m][line];
+            }
+            UIColors::out() << text << '\n';
+        }
+    }
+    UIColors::out() << '\n' << padStr << free.size() << " of " << WINDOW_DAYS << " days free from " << startDate
+                    << " (-- = not free)\n";
+}
+
+size_t AvailabilityCalendar::memoryBytes() const {
+    size_t bytes = sizeof(AvailabilityCalendar) + ids.capacity() * sizeof(int) + rows.capacity() * sizeof(uint64_t);
+    for (const std::vector<uint64_t>& column : days) bytes += column.capacity() * sizeof(uint64_t);
+    return bytes;
+}
@@ -0,0 +1,443 @@
+#include "CleaningScheduler.h"
+#include "AppConfig.h"
+#include "DatabaseManager.h"
+#include "DressStock.h"
+#include "LateFeePolicy.h"
+#include "MenuHandlers.h"
+#include "TableRenderer.h"
+#include "Trace.h"
+#include "UIColors.h"
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <ctime>
+#include <exception>
+#include <iostream>
+#include <queue>
+
+namespace {
+
+const char* SCHEDULE_LOCK = "SELECT GET_LOCK('dress_rental_cleaning', 0) AS acquired";
+const char* SCHEDULE_UNLOCK = "SELECT RELEASE_LOCK('dress_rental_cleaning')";
+
+// Queued jobs with the first rental or assigned reservation of their dress
+// from today on
+const char* QUEUE_SELECT =
+    "SELECT j.JobID, j.DressID, d.DressName, j.ReturnDate, j.ScheduledDate, j.HeldThrough, nb.NextDate "
+    "FROM CleaningJobs j JOIN Dresses d ON d.DressID = j.DressID "
+    "LEFT JOIN ("
+    "    SELECT b.DressID, MIN(b.StartDate) AS NextDate FROM ("
+    "        SELECT ri.DressID, r.RentalDate AS StartDate FROM Rentals r "
+    "        JOIN RentalItems ri ON ri.RentalID = r.RentalID "
+    "        WHERE r.Status = 'Active' AND r.RentalDate >= CURDATE() "
+    "        UNION ALL "
+    "        SELECT AssignedDressID, StartDate FROM Reservations "
+    "        WHERE Status = 'Booked' AND AssignedDressID IS NOT NULL AND StartDate >= CURDATE()"
+    "    ) b GROUP BY b.DressID"
+    ") nb ON nb.DressID = j.DressID "
+    "WHERE j.Status = 'Queued'";
+
+std::string timestampNow() {
+    std::time_t now = std::time(nullptr);
+    std::tm tmNow;
+#ifdef _WIN32
+    localtime_s(&tmNow, &now);
+#else
+    localtime_r(&now, &tmNow);
+#endif
+    char buffer[32];
+    std::strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", &tmNow);
+    return buffer;
+}
+
+// Day number of a date, or fallback for NULL and malformed values
+long dayOr(const std::string& date, long fallback) {
+    long day = 0;
+    return LateFeePolicy::parseDate(date, day) ? day : fallback;
+}
+
+} // namespace
+
+CleaningScheduler& CleaningScheduler::getInstance() {
+    static CleaningScheduler instance;
+    return instance;
+}
+
+CleaningScheduler::CleaningScheduler()
+    : stopRequested(false), wakeRequested(false), running(false), intervalSeconds(0) {
+    stats.runs = 0;
+    stats.lastDurationMs = 0.0;
+    stats.jobsPlanned = 0;
+    stats.jobsMoved = 0;
+    stats.jobsLate = 0;
+}
+
+CleaningScheduler::~CleaningScheduler() {
+    stop();
+}
+
+int CleaningScheduler::intervalFromConfig() {
+    int seconds = AppConfig::getInstance().getInt("cleaning_interval", 600);
+    return seconds > 0 ? seconds : 0;
+}
+
+int CleaningScheduler::capacityFromConfig() {
+    int capacity = AppConfig::getInstance().getInt("cleaning_capacity", 40);
+    return capacity > 0 ? capacity : 1;
+}
+
+void CleaningScheduler::start(int seconds) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (running || seconds <= 0) return;
+    intervalSeconds = seconds;
+    stopRequested = false;
+    running = true;
+    worker = std::thread(&CleaningScheduler::threadMain, this);
+}
+
+void CleaningScheduler::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!running) return;
+        stopRequested = true;
+    }
+    wakeUp.notify_all();
+    if (worker.joinable()) worker.join();
+    std::lock_guard<std::mutex> lock(mutex);
+    running = false;
+}
+
+bool CleaningScheduler::isRunning() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return running;
+}
+
+void CleaningScheduler::wake() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!running) return;
+        wakeRequested = true;
+    }
+    wakeUp.notify_all();
+}
+
+CleaningScheduler::Stats CleaningScheduler::getStats() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
+
+bool CleaningScheduler::runOnce() {
+    return schedule();
+}
+
+void CleaningScheduler::threadMain() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!stopRequested) {
+        wakeRequested = false;
+        lock.unlock();
+        schedule();
+        lock.lock();
+        wakeUp.wait_for(lock, std::chrono::seconds(intervalSeconds),
+                        [this] { return stopRequested || wakeRequested; });
+    }
+    lock.unlock();
+    // This thread had its own connection; close it before the thread goes away
+    DatabaseManager::getInstance().releaseThreadConnection();
+}
+
+int CleaningScheduler::plan(std::vector<Task>& tasks, long firstDay, int capacityPerDay) {
+    if (capacityPerDay < 1) capacityPerDay = 1;
+    std::vector<size_t> byReturn(tasks.size());
+    for (size_t i = 0; i < tasks.size(); ++i) byReturn[i] = i;
+    std::sort(byReturn.begin(), byReturn.end(), [&tasks](size_t a, size_t b) {
+        return tasks[a].returnDay < tasks[b].returnDay;
+    });
+
+    // Returned tasks not cleaned yet, the soonest next booking on top; ties go
+    // to the longest waiting
+    auto lessUrgent = [&tasks](size_t a, size_t b) {
+        if (tasks[a].nextBookingDay != tasks[b].nextBookingDay) return tasks[a].nextBookingDay > tasks[b].nextBookingDay;
+        if (tasks[a].returnDay != tasks[b].returnDay) return tasks[a].returnDay > tasks[b].returnDay;
+        return tasks[a].jobID > tasks[b].jobID;
+    };
+    std::priority_queue<size_t, std::vector<size_t>, decltype(lessUrgent)> waiting(lessUrgent);
+
+    int late = 0;
+    size_t next = 0;
+    long day = firstDay;
+    while (next < byReturn.size() || !waiting.empty()) {
+        while (next < byReturn.size() && tasks[byReturn[next]].returnDay <= day) waiting.push(byReturn[next++]);
+        if (waiting.empty()) {
+            day = tasks[byReturn[next]].returnDay;
+            continue;
+        }
+        for (int slot = 0; slot < capacityPerDay && !waiting.empty(); ++slot) {
+            Task& task = tasks[waiting.top()];
+            waiting.pop();
+            task.cleanDay = day;
+            if (day >= task.nextBookingDay) ++late;
+        }
+        ++day;
+    }
+    return late;
+}
+
+bool CleaningScheduler::schedule() {
+    TraceSpan span("cleaning.schedule");
+    std::chrono::steady_clock::time_point started = std::chrono::steady_clock::now();
+    DatabaseManager& db = DatabaseManager::getInstance();
+    int planned = 0;
+    int moved = 0;
+    int late = 0;
+    std::string error;
+    bool locked = false;
+    try {
+        if (!db.getConnection()) {
+            error = "Database connection failed";
+        } else {
+            sql::ResultSet* res = db.executeSelect(SCHEDULE_LOCK);
+            locked = res && res->next() && res->getInt("acquired") == 1;
+            if (res) delete res;
+            if (!locked) error = "Another instance is planning the cleaning queue";
+        }
+
+        if (locked) {
+            long today = dayOr(LateFeePolicy::today(), 0);
+            std::vector<Task> tasks;
+            std::vector<int> dressIDs;
+            std::vector<long> scheduledDays;
+            std::vector<long> heldThrough;
+            sql::Connection* conn = db.getConnection();
+            conn->setAutoCommit(false);
+            // Locked so a completion cannot release their days meanwhile
+            sql::PreparedStatement* pstmt = db.prepare(std::string(QUEUE_SELECT) + " FOR UPDATE");
+            sql::ResultSet* res = db.executePreparedQuery(pstmt);
+            while (res && res->next()) {
+                Task task;
+                task.jobID = res->getInt("JobID");
+                task.returnDay = dayOr(res->getString("ReturnDate"), today);
+                task.nextBookingDay = dayOr(res->getString("NextDate"), LONG_MAX);
+                task.cleanDay = 0;
+                tasks.push_back(task);
+                dressIDs.push_back(res->getInt("DressID"));
+                scheduledDays.push_back(dayOr(res->getString("ScheduledDate"), -1));
+                heldThrough.push_back(dayOr(res->getString("HeldThrough"), task.returnDay));
+            }
+            if (res) delete res;
+            delete pstmt;
+
+            {
+                TraceSpan planSpan("cleaning.plan", static_cast<long long>(tasks.size()));
+                late = plan(tasks, today, capacityFromConfig());
+            }
+            planned = static_cast<int>(tasks.size());
+
+            // Move each job's reserved days to end on its cleaning day; days
+            // before today no longer matter and are left as they are
+            TraceSpan applySpan("cleaning.apply");
+            for (size_t i = 0; i < tasks.size(); ++i) {
+                long cleanDay = tasks[i].cleanDay;
+                long held = heldThrough[i];
+                if (cleanDay == scheduledDays[i] && cleanDay == held) continue;
+                long from = std::max(held + 1, today);
+                if (cleanDay > held && cleanDay - from + 1 > DressStock::MAX_RANGE_DAYS) continue;
+                // Only a job that is still queued moves, and only then do its
+                // reserved days change
+                pstmt = db.prepare(
+                    "UPDATE CleaningJobs SET ScheduledDate = ?, HeldThrough = ? WHERE JobID = ? AND Status = 'Queued'"
+                );
+                pstmt->setString(1, LateFeePolicy::dateOf(cleanDay));
+                pstmt->setString(2, LateFeePolicy::dateOf(cleanDay));
+                pstmt->setInt(3, tasks[i].jobID);
+                if (DatabaseManager::runUpdate(pstmt) != 1) continue;
+                if (cleanDay > held) {
+                    DressStock::hold(dressIDs[i], LateFeePolicy::dateOf(from), LateFeePolicy::dateOf(cleanDay), 1);
+                } else if (cleanDay < held) {
+                    DressStock::hold(dressIDs[i], LateFeePolicy::dateOf(cleanDay + 1), LateFeePolicy::dateOf(held), -1);
+                }
+                ++moved;
+            }
+            conn->commit();
+            conn->setAutoCommit(true);
+        }
+    } catch (sql::SQLException& e) {
+        error = e.what();
+        DatabaseManager::rollbackQuietly();
+    } catch (const std::exception& e) {
+        error = e.what();
+        DatabaseManager::rollbackQuietly();
+    }
+
+    if (locked) {
+        try {
+            sql::ResultSet* res = db.executeSelect(SCHEDULE_UNLOCK);
+            if (res) delete res;
+        } catch (sql::SQLException& e) {
+            std::cerr << "Error releasing cleaning lock: " << e.what() << std::endl;
+        }
+    }
+
+    double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+    std::lock_guard<std::mutex> lock(mutex);
+    stats.lastRunAt = timestampNow();
+    stats.lastDurationMs = elapsedMs;
+    stats.lastError = error;
+    if (error.empty()) {
+        stats.runs++;
+        stats.jobsPlanned = planned;
+        stats.jobsMoved = moved;
+        stats.jobsLate = late;
+    }
+    return error.empty();
+}
+
+void CleaningScheduler::enqueue(const std::vector<int>& rentalIDs, const std::string& returnDate) {
+    if (rentalIDs.empty()) return;
+    std::string inList = "(" + DatabaseManager::placeholderList(rentalIDs.size()) + ")";
+
+    sql::PreparedStatement* pstmt = DatabaseManager::getInstance().prepare(
+        "INSERT INTO CleaningJobs (DressID, RentalID, ReturnDate, HeldThrough) "
+        "SELECT DressID, RentalID, ?, ? FROM RentalItems WHERE RentalID IN " + inList
+    );
+    pstmt->setString(1, returnDate);
+    pstmt->setString(2, returnDate);
+    DatabaseManager::bindIDs(pstmt, 3, rentalIDs);
+    DatabaseManager::runUpdate(pstmt);
+
+    // The unit is back but not rentable: it stays reserved until it is cleaned
+    pstmt = DatabaseManager::getInstance().prepare(
+        "INSERT INTO DressDailyStock (DressID, StockDate, Reserved) "
+        "SELECT DressID, ?, COUNT(*) FROM RentalItems WHERE RentalID IN " + inList + " GROUP BY DressID "
+        "ON DUPLICATE KEY UPDATE Reserved = Reserved + VALUES(Reserved)"
+    );
+    pstmt->setString(1, returnDate);
+    DatabaseManager::bindIDs(pstmt, 2, rentalIDs);
+    DatabaseManager::runUpdate(pstmt);
+
+    pstmt = DatabaseManager::getInstance().prepare(
+        "UPDATE Dresses SET CleaningStatus = 'Needs Cleaning' "
+        "WHERE DressID IN (SELECT DressID FROM RentalItems WHERE RentalID IN " + inList + ")"
+    );
+    DatabaseManager::bindIDs(pstmt, 1, rentalIDs);
+    DatabaseManager::runUpdate(pstmt);
+}
+
+int CleaningScheduler::complete(const std::vector<int>& jobIDs, const std::string& date) {
+    long doneDay = 0;
+    if (!LateFeePolicy::parseDate(date, doneDay)) {
+        std::cerr << "Error: Invalid date format. Please use YYYY-MM-DD format." << std::endl;
+        return -1;
+    }
+    if (jobIDs.empty()) return 0;
+    long today = dayOr(LateFeePolicy::today(), doneDay);
+
+    try {
+        sql::Connection* conn = DatabaseManager::getInstance().getConnection();
+        conn->setAutoCommit(false);
+
+        sql::PreparedStatement* pstmt = DatabaseManager::getInstance().prepare(
+            "SELECT JobID, DressID, HeldThrough FROM CleaningJobs "
+            "WHERE Status = 'Queued' AND JobID IN (" + DatabaseManager::placeholderList(jobIDs.size()) + ") FOR UPDATE"
+        );
+        DatabaseManager::bindIDs(pstmt, 1, jobIDs);
+        sql::ResultSet* res = nullptr;
+        try {
+            res = DatabaseManager::getInstance().executePreparedQuery(pstmt);
+        } catch (sql::SQLException&) {
+            delete pstmt;
+            throw;
+        }
+        std::vector<int> queued;
+        std::vector<int> dressIDs;
+        std::vector<long> heldThrough;
+        while (res && res->next()) {
+            queued.push_back(res->getInt("JobID"));
+            dressIDs.push_back(res->getInt("DressID"));
+            heldThrough.push_back(dayOr(res->getString("HeldThrough"), doneDay));
+        }
+        if (res) delete res;
+        delete pstmt;
+        if (queued.empty()) {
+            conn->commit();
+            conn->setAutoCommit(true);
+            return 0;
+        }
+
+        // Free from the day after cleaning, or from today for a date in the past
+        for (size_t i = 0; i < queued.size(); ++i) {
+            long from = std::max(doneDay + 1, today);
+            if (heldThrough[i] >= from) {
+                DressStock::hold(dressIDs[i], LateFeePolicy::dateOf(from), LateFeePolicy::dateOf(heldThrough[i]), -1);
+            }
+        }
+
+        std::string inList = "(" + DatabaseManager::placeholderList(queued.size()) + ")";
+        pstmt = DatabaseManager::getInstance().prepare(
+            "UPDATE CleaningJobs SET Status = 'Done', CompletedDate = ? WHERE JobID IN " + inList
+        );
+        pstmt->setString(1, date);
+        DatabaseManager::bindIDs(pstmt, 2, queued);
+        DatabaseManager::runUpdate(pstmt);
+
+        pstmt = DatabaseManager::getInstance().prepare(
+            "UPDATE Dresses d SET d.CleaningStatus = 'Clean' WHERE d.DressID IN (" +
+            DatabaseManager::placeholderList(dressIDs.size()) + ") AND NOT EXISTS "
+            "(SELECT 1 FROM CleaningJobs j WHERE j.DressID = d.DressID AND j.Status = 'Queued')"
+        );
+        DatabaseManager::bindIDs(pstmt, 1, dressIDs);
+        DatabaseManager::runUpdate(pstmt);
+
+        conn->commit();
+        conn->setAutoCommit(true);
+        return static_cast<int>(queued.size());
+    } catch (sql::SQLException& e) {
+        std::cerr << "Error completing cleaning jobs: " << e.what() << std::endl;
+        DatabaseManager::rollbackQuietly();
+        return -1;
+    }
+}
+
+std::vector<CleaningJob> CleaningScheduler::getQueue() {
+    std::vector<CleaningJob> jobs;
+    try {
+        sql::ResultSet* res = DatabaseManager::getInstance().executeSelect(
+            std::string(QUEUE_SELECT) +
+            " ORDER BY j.ScheduledDate IS NULL, j.ScheduledDate, j.ReturnDate, j.JobID"
+        );
+        while (res && res->next()) {
+            CleaningJob job;
+            job.JobID = res->getInt("JobID");
+            job.DressID = res->getInt("DressID");
+            job.DressName = res->getString("DressName");
+            job.ReturnDate = res->getString("ReturnDate");
+            job.ScheduledDate = res->getString("ScheduledDate");
+            job.NextBookingDate = res->getString("NextDate");
+            jobs.push_back(job);
+        }
+        if (res) delete res;
+    } catch (sql::SQLException& e) {
+        std::cerr << "Error getting cleaning queue: " << e.what() << std::endl;
+    }
+    return jobs;
+}
+
+void CleaningScheduler::displayQueue(const std::vector<CleaningJob>& jobs) {
+    RenderFrame frame;
+    TableRenderer table(SCREEN_WIDTH);
+    table.addColumn("Job", 0, 0, TableRenderer::ALIGN_RIGHT);
+    table.addColumn("Dress ID", 0, 0, TableRenderer::ALIGN_RIGHT);
+    table.addColumn("Dress Name", 10, 24);
+    table.addColumn("Returned");
+    table.addColumn("Cleaning");
+    table.addColumn("Next Booking");
+    for (const CleaningJob& job : jobs) {
+        std::string cleaning = job.ScheduledDate.empty() ? "not planned" : job.ScheduledDate;
+        // Cleaned on the day of the booking is too late: it is free the day after
+        if (!job.ScheduledDate.empty() && !job.NextBookingDate.empty() && job.ScheduledDate >= job.NextBookingDate) {
+            cleaning = UIColors::colorize(cleaning + " LATE", UIColors::RED);
+        }
+        table.addRow({ std::to_string(job.JobID), std::to_string(job.DressID), job.DressName, job.ReturnDate,
+                       cleaning, job.NextBookingDate.empty() ? "-" : job.NextBookingDate });
+    }
+    table.render();
+}
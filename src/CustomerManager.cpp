@@ -1,16 +1,15 @@
 #include "CustomerManager.h"
 #include "UIColors.h"
 #include "MenuHandlers.h"
-#include "RentalManager.h"
-#include "PaymentManager.h"
-#include "DressManager.h"
+#include "TableRenderer.h"
+#include "Trace.h"
 #include <iostream>
 #include <iomanip>
 #include <sstream>
 #include <ctime>
-#include <set>
 
 bool CustomerManager::createCustomer(const Customer& customer) {
+    TraceSpan span("customer.createCustomer");
     if (!validateAge(customer.DateOfBirth)) {
         std::cerr << "Error: Customer must be at least 18 years old." << std::endl;
         return false;
@@ -28,7 +27,7 @@ bool CustomerManager::createCustomer(const Customer& customer) {
             return false;
         }
         
-        sql::PreparedStatement* pstmt = conn->prepareStatement(
+        sql::PreparedStatement* pstmt = DatabaseManager::getInstance().prepare(
             "INSERT INTO Customers (Name, IC_Number, Phone, Email, Address, DateOfBirth) "
             "VALUES (?, ?, ?, ?, ?, ?)"
         );
@@ -40,7 +39,7 @@ bool CustomerManager::createCustomer(const Customer& customer) {
         pstmt->setString(5, customer.Address);
         pstmt->setString(6, customer.DateOfBirth);
         
-        pstmt->executeUpdate();
+        DatabaseManager::getInstance().executePreparedUpdate(pstmt);
         delete pstmt;
         return true;
     } catch (sql::SQLException& e) {
@@ -54,17 +53,18 @@ bool CustomerManager::createCustomer(const Customer& customer) {
 }
 
 Customer* CustomerManager::getCustomerByID(int customerID) {
+    TraceSpan span("customer.getCustomerByID", customerID);
     try {
         sql::Connection* conn = DatabaseManager::getInstance().getConnection();
         if (!conn) {
             std::cerr << "Error: Database connection failed." << std::endl;
             return nullptr;
         }
-        sql::PreparedStatement* pstmt = conn->prepareStatement(
+        sql::PreparedStatement* pstmt = DatabaseManager::getInstance().prepare(
             "SELECT * FROM Customers WHERE CustomerID = ?"
         );
         pstmt->setInt(1, customerID);
-        sql::ResultSet* res = pstmt->executeQuery();
+        sql::ResultSet* res = DatabaseManager::getInstance().executePreparedQuery(pstmt);
         
         if (res && res->next()) {
             Customer* customer = new Customer();
@@ -89,17 +89,18 @@ Customer* CustomerManager::getCustomerByID(int customerID) {
 }
 
 Customer* CustomerManager::getCustomerByIC(const std::string& icNumber) {
+    TraceSpan span("customer.getCustomerByIC");
     try {
         sql::Connection* conn = DatabaseManager::getInstance().getConnection();
         if (!conn) {
             std::cerr << "Error: Database connection failed." << std::endl;
             return nullptr;
         }
-        sql::PreparedStatement* pstmt = conn->prepareStatement(
+        sql::PreparedStatement* pstmt = DatabaseManager::getInstance().prepare(
             "SELECT * FROM Customers WHERE IC_Number = ?"
         );
         pstmt->setString(1, icNumber);
-        sql::ResultSet* res = pstmt->executeQuery();
+        sql::ResultSet* res = DatabaseManager::getInstance().executePreparedQuery(pstmt);
         
         if (res && res->next()) {
             Customer* customer = new Customer();
@@ -124,9 +125,10 @@ Customer* CustomerManager::getCustomerByIC(const std::string& icNumber) {
 }
 
 std::vector<Customer> CustomerManager::getAllCustomers() {
+    TraceSpan span("customer.getAllCustomers");
     std::vector<Customer> customers;
     try {
-        sql::ResultSet* res = DatabaseManager::getInstance().executeSelect(
+        sql::ResultSet* res = DatabaseManager::getInstance().executeReadSelect(
             "SELECT * FROM Customers ORDER BY CustomerID"
         );
         
@@ -149,6 +151,7 @@ std::vector<Customer> CustomerManager::getAllCustomers() {
 }
 
 std::vector<Customer> CustomerManager::searchCustomers(const std::string& searchTerm) {
+    TraceSpan span("customer.searchCustomers");
     std::vector<Customer> customers;
     try {
         sql::Connection* conn = DatabaseManager::getInstance().getConnection();
@@ -156,16 +159,14 @@ std::vector<Customer> CustomerManager::searchCustomers(const std::string& search
             std::cerr << "Error: Database connection failed." << std::endl;
             return customers;
         }
-        sql::PreparedStatement* pstmt = conn->prepareStatement(
-            "SELECT * FROM Customers WHERE Name LIKE ? OR IC_Number LIKE ? OR Phone LIKE ? OR Email LIKE ?"
-        );
         std::string pattern = "%" + searchTerm + "%";
-        pstmt->setString(1, pattern);
-        pstmt->setString(2, pattern);
-        pstmt->setString(3, pattern);
-        pstmt->setString(4, pattern);
-        
-        sql::ResultSet* res = pstmt->executeQuery();
+        sql::PreparedStatement* pstmt = nullptr;
+        sql::ResultSet* res = DatabaseManager::getInstance().executeRead(
+            "SELECT * FROM Customers WHERE Name LIKE ? OR IC_Number LIKE ? OR Phone LIKE ? OR Email LIKE ?",
+            [&](sql::PreparedStatement* statement) {
+                for (int i = 1; i <= 4; ++i) statement->setString(i, pattern);
+            },
+            pstmt);
         while (res && res->next()) {
             Customer customer;
             customer.CustomerID = res->getInt("CustomerID");
@@ -186,6 +187,7 @@ std::vector<Customer> CustomerManager::searchCustomers(const std::string& search
 }
 
 bool CustomerManager::updateCustomer(int customerID, const Customer& customer) {
+    TraceSpan span("customer.updateCustomer", customerID);
     if (!validateAge(customer.DateOfBirth)) {
         std::cerr << "Error: Customer must be at least 18 years old." << std::endl;
         return false;
@@ -197,7 +199,7 @@ bool CustomerManager::updateCustomer(int customerID, const Customer& customer) {
             std::cerr << "Error: Database connection failed." << std::endl;
             return false;
         }
-        sql::PreparedStatement* pstmt = conn->prepareStatement(
+        sql::PreparedStatement* pstmt = DatabaseManager::getInstance().prepare(
             "UPDATE Customers SET Name = ?, IC_Number = ?, Phone = ?, Email = ?, Address = ?, DateOfBirth = ? "
             "WHERE CustomerID = ?"
         );
@@ -210,7 +212,7 @@ bool CustomerManager::updateCustomer(int customerID, const Customer& customer) {
         pstmt->setString(6, customer.DateOfBirth);
         pstmt->setInt(7, customerID);
         
-        int rows = pstmt->executeUpdate();
+        int rows = DatabaseManager::getInstance().executePreparedUpdate(pstmt);
         delete pstmt;
         return rows > 0;
     } catch (sql::SQLException& e) {
@@ -220,17 +222,18 @@ bool CustomerManager::updateCustomer(int customerID, const Customer& customer) {
 }
 
 bool CustomerManager::deleteCustomer(int customerID) {
+    TraceSpan span("customer.deleteCustomer", customerID);
     try {
         sql::Connection* conn = DatabaseManager::getInstance().getConnection();
         if (!conn) {
             std::cerr << "Error: Database connection failed." << std::endl;
             return false;
         }
-        sql::PreparedStatement* pstmt = conn->prepareStatement(
+        sql::PreparedStatement* pstmt = DatabaseManager::getInstance().prepare(
             "DELETE FROM Customers WHERE CustomerID = ?"
         );
         pstmt->setInt(1, customerID);
-        int rows = pstmt->executeUpdate();
+        int rows = DatabaseManager::getInstance().executePreparedUpdate(pstmt);
         delete pstmt;
         return rows > 0;
     } catch (sql::SQLException& e) {
@@ -257,17 +260,18 @@ bool CustomerManager::validateAge(const std::string& dateOfBirth) {
 }
 
 bool CustomerManager::isICExists(const std::string& icNumber) {
+    TraceSpan span("customer.isICExists");
     try {
         sql::Connection* conn = DatabaseManager::getInstance().getConnection();
         if (!conn) {
             std::cerr << "Error: Database connection failed." << std::endl;
             return false;
         }
-        sql::PreparedStatement* pstmt = conn->prepareStatement(
+        sql::PreparedStatement* pstmt = DatabaseManager::getInstance().prepare(
             "SELECT COUNT(*) as count FROM Customers WHERE IC_Number = ?"
         );
         pstmt->setString(1, icNumber);
-        sql::ResultSet* res = pstmt->executeQuery();
+        sql::ResultSet* res = DatabaseManager::getInstance().executePreparedQuery(pstmt);
         
         bool exists = false;
         if (res && res->next()) {
@@ -283,295 +287,155 @@ bool CustomerManager::isICExists(const std::string& icNumber) {
 }
 
 void CustomerManager::displayCustomer(const Customer& customer) {
-    std::cout << std::endl;
-    int tableWidth = 60;
-    int padding = (SCREEN_WIDTH - tableWidth) / 2;
-    if (padding < 0) padding = 0;
-    
-    std::string borderLine = std::string(padding, ' ') + "+" + std::string(tableWidth - 2, '-') + "+";
-    std::cout << borderLine << std::endl;
-    
-    // Helper to get plain text width (strip ANSI codes)
-    auto plainWidth = [](const std::string& text) -> int {
-        int width = 0;
-        bool inEscape = false;
-        for (char c : text) {
-            if (c == '\033') inEscape = true;
-            else if (inEscape && c == 'm') inEscape = false;
-            else if (!inEscape) width++;
-        }
-        return width;
-    };
+    TraceSpan span("customer.displayCustomer", customer.CustomerID);
+    RenderFrame frame;
+    UIColors::out() << '\n';
+    TableRenderer table(SCREEN_WIDTH);
+    table.addColumn("Field", 20);
+    table.addColumn("Information", 37);
+    table.addRow({ "Customer ID:", std::to_string(customer.CustomerID) });
+    table.addRow({ "Name:", customer.Name });
+    table.addRow({ "IC Number:", customer.IC_Number });
+    table.addRow({ "Phone:", customer.Phone });
+    table.addRow({ "Email:", customer.Email });
+    table.addRow({ "Address:", customer.Address });
+    table.addRow({ "Date of Birth:", customer.DateOfBirth });
+    table.render();
     
-    // Helper to pad colored text to exact width
-    auto padColored = [=](const std::string& coloredText, int targetWidth) -> std::string {
-        int actualWidth = plainWidth(coloredText);
-        if (actualWidth >= targetWidth) return coloredText;
-        return coloredText + std::string(targetWidth - actualWidth, ' ');
+    // Rentals with their dress names and the customer's payment methods, one
+    // row per rental item (or one with NULL item columns for a rental without
+    // items); grouped by rental below
+    struct RentalLine {
+        int RentalID;
+        std::string DressNames;
+        std::string RentalDate;
+        std::string DueDate;
+        std::string Status;
     };
-    
-    // Header row
-    std::cout << std::string(padding, ' ') << "|" 
-              << padColored(UIColors::colorize("Field", UIColors::BOLD + UIColors::CYAN), 20)
-              << "|" << padColored(UIColors::colorize("Information", UIColors::BOLD + UIColors::CYAN), 37)
-              << "|" << std::endl;
-    std::cout << borderLine << std::endl;
-    
-    // Data rows with proper alignment
-    std::cout << std::string(padding, ' ') << "|" 
-              << std::setw(20) << std::left << "Customer ID:"
-              << "|" << std::setw(37) << std::left << std::to_string(customer.CustomerID)
-              << "|" << std::endl;
-    std::cout << std::string(padding, ' ') << "|" 
-              << std::setw(20) << std::left << "Name:"
-              << "|" << std::setw(37) << std::left << customer.Name
-              << "|" << std::endl;
-    std::cout << std::string(padding, ' ') << "|" 
-              << std::setw(20) << std::left << "IC Number:"
-              << "|" << std::setw(37) << std::left << customer.IC_Number
-              << "|" << std::endl;
-    std::cout << std::string(padding, ' ') << "|" 
-              << std::setw(20) << std::left << "Phone:"
-              << "|" << std::setw(37) << std::left << customer.Phone
-              << "|" << std::endl;
-    std::cout << std::string(padding, ' ') << "|" 
-              << std::setw(20) << std::left << "Email:"
-              << "|" << std::setw(37) << std::left << customer.Email
-              << "|" << std::endl;
-    std::cout << std::string(padding, ' ') << "|" 
-              << std::setw(20) << std::left << "Address:"
-              << "|" << std::setw(37) << std::left << customer.Address
-              << "|" << std::endl;
-    std::cout << std::string(padding, ' ') << "|" 
-              << std::setw(20) << std::left << "Date of Birth:"
-              << "|" << std::setw(37) << std::left << customer.DateOfBirth
-              << "|" << std::endl;
-    std::cout << borderLine << std::endl;
-    
-    // Get rental and payment information
-    RentalManager rm;
-    PaymentManager pm;
-    DressManager dm;
-    std::vector<Rental> rentals = rm.getRentalsByCustomer(customer.CustomerID);
+    std::vector<RentalLine> rentals;
+    std::string paymentMethods;
+    try {
+        sql::Connection* conn = DatabaseManager::getInstance().getConnection();
+        if (conn) {
+            sql::PreparedStatement* pstmt = DatabaseManager::getInstance().prepare(
+                "SELECT r.RentalID, r.RentalDate, r.DueDate, r.Status, d.DressName, pm.Methods "
+                "FROM Rentals r "
+                "LEFT JOIN RentalItems ri ON ri.RentalID = r.RentalID "
+                "LEFT JOIN Dresses d ON d.DressID = ri.DressID "
+                "CROSS JOIN (SELECT GROUP_CONCAT(DISTINCT p.PaymentMethod ORDER BY p.PaymentMethod "
+                "                                SEPARATOR ', ') AS Methods "
+                "            FROM Payments p JOIN Rentals pr ON pr.RentalID = p.RentalID "
+                "            WHERE pr.CustomerID = ?) pm "
+                "WHERE r.CustomerID = ? "
+                "ORDER BY r.RentalDate DESC, r.RentalID, ri.RentalItemID"
+            );
+            pstmt->setInt(1, customer.CustomerID);
+            pstmt->setInt(2, customer.CustomerID);
+            sql::ResultSet* res = DatabaseManager::getInstance().executePreparedQuery(pstmt);
+            
+            while (res && res->next()) {
+                int rentalID = res->getInt("RentalID");
+                if (rentals.empty() || rentals.back().RentalID != rentalID) {
+                    RentalLine line;
+                    line.RentalID = rentalID;
+                    line.RentalDate = res->getString("RentalDate");
+                    line.DueDate = res->getString("DueDate");
+                    line.Status = res->getString("Status");
+                    rentals.push_back(line);
+                    paymentMethods = res->getString("Methods");
+                }
+                std::string dressName = res->getString("DressName");
+                if (res->wasNull()) continue; // no items, or the dress no longer exists
+                RentalLine& line = rentals.back();
+                if (!line.DressNames.empty()) line.DressNames += ", ";
+                line.DressNames += dressName;
+            }
+            delete pstmt;
+            if (res) delete res;
+        }
+    } catch (sql::SQLException& e) {
+        std::cerr << "Error getting customer rentals: " << e.what() << std::endl;
+    }
     
     if (!rentals.empty()) {
-        std::cout << std::endl;
+        UIColors::out() << '\n';
         UIColors::printCentered("=== RENTAL INFORMATION ===", SCREEN_WIDTH, UIColors::BOLD + UIColors::CYAN);
-        std::cout << std::endl;
-        
-        int rentalTableWidth = 70;
-        int rentalPadding = (SCREEN_WIDTH - rentalTableWidth) / 2;
-        if (rentalPadding < 0) rentalPadding = 0;
-        
-        std::string rentalBorderLine = std::string(rentalPadding, ' ') + "+" + std::string(rentalTableWidth - 2, '-') + "+";
-        
-        // Helper to get plain text width (strip ANSI codes)
-        auto plainWidth = [](const std::string& text) -> int {
-            int width = 0;
-            bool inEscape = false;
-            for (char c : text) {
-                if (c == '\033') inEscape = true;
-                else if (inEscape && c == 'm') inEscape = false;
-                else if (!inEscape) width++;
-            }
-            return width;
-        };
-        
-        // Helper to pad colored text to exact width
-        auto padColored = [=](const std::string& coloredText, int targetWidth) -> std::string {
-            int actualWidth = plainWidth(coloredText);
-            if (actualWidth >= targetWidth) return coloredText;
-            return coloredText + std::string(targetWidth - actualWidth, ' ');
-        };
-        
-        // Print header for rental table
-        std::cout << rentalBorderLine << std::endl;
-        std::cout << std::string(rentalPadding, ' ') << "|"
-                  << padColored(UIColors::colorize("Rental ID", UIColors::BOLD + UIColors::CYAN), 10) << "|"
-                  << padColored(UIColors::colorize("Dresses Rented", UIColors::BOLD + UIColors::CYAN), 25) << "|"
-                  << padColored(UIColors::colorize("Rental Date", UIColors::BOLD + UIColors::CYAN), 12) << "|"
-                  << padColored(UIColors::colorize("Due Date", UIColors::BOLD + UIColors::CYAN), 12) << "|"
-                  << padColored(UIColors::colorize("Status", UIColors::BOLD + UIColors::CYAN), 8) << "|"
-                  << std::endl;
-        std::cout << rentalBorderLine << std::endl;
+        UIColors::out() << '\n';
         
-        // Display each rental with dress and payment info
-        for (const auto& rental : rentals) {
-            // Get dresses for this rental
-            std::vector<int> dressIDs;
-            try {
-                sql::Connection* conn = DatabaseManager::getInstance().getConnection();
-                if (conn) {
-                    sql::PreparedStatement* pstmt = conn->prepareStatement(
-                        "SELECT DressID FROM RentalItems WHERE RentalID = ?"
-                    );
-                    pstmt->setInt(1, rental.RentalID);
-                    sql::ResultSet* res = pstmt->executeQuery();
-                    
-                    while (res && res->next()) {
-                        dressIDs.push_back(res->getInt("DressID"));
-                    }
-                    delete pstmt;
-                    if (res) delete res;
-                }
-            } catch (sql::SQLException& e) {
-                // Continue if error
-            }
-            
-            // Build dress names string
-            std::string dressNames = "";
-            if (!dressIDs.empty()) {
-                for (size_t i = 0; i < dressIDs.size(); ++i) {
-                    Dress* dress = dm.getDressByID(dressIDs[i]);
-                    if (dress) {
-                        if (i > 0) dressNames += ", ";
-                        dressNames += dress->DressName;
-                        delete dress;
-                    }
-                }
-                if (dressNames.length() > 23) {
-                    dressNames = dressNames.substr(0, 20) + "...";
-                }
-            } else {
-                dressNames = "N/A";
-            }
-            
-            // Get payment method for this rental
-            std::vector<Payment> payments = pm.getPaymentsByRental(rental.RentalID);
-            std::string paymentMethod = "N/A";
-            if (!payments.empty()) {
-                paymentMethod = payments[0].PaymentMethod;
-                if (paymentMethod.length() > 8) {
-                    paymentMethod = paymentMethod.substr(0, 8);
-                }
-            }
-            
-            std::cout << std::string(rentalPadding, ' ') << "|"
-                      << std::setw(10) << std::left << rental.RentalID
-                      << "|" << std::setw(25) << std::left << dressNames
-                      << "|" << std::setw(12) << std::left << rental.RentalDate
-                      << "|" << std::setw(12) << std::left << rental.DueDate
-                      << "|" << std::setw(8) << std::left << (rental.Status.length() > 6 ? rental.Status.substr(0, 6) : rental.Status)
-                      << "|" << std::endl;
+        TableRenderer rentalTable(SCREEN_WIDTH);
+        rentalTable.addColumn("Rental ID", 10);
+        rentalTable.addColumn("Dresses Rented", 25);
+        rentalTable.addColumn("Rental Date", 12);
+        rentalTable.addColumn("Due Date", 12);
+        rentalTable.addColumn("Status", 9);
+        rentalTable.beginStream();
+        for (const auto& line : rentals) {
+            rentalTable.streamRow({ std::to_string(line.RentalID), line.DressNames.empty() ? "N/A" : line.DressNames,
+                                    line.RentalDate, line.DueDate, line.Status });
         }
-        std::cout << rentalBorderLine << std::endl;
+        rentalTable.endStream();
         
         // Display payment methods summary
-        std::cout << std::endl;
+        UIColors::out() << '\n';
         UIColors::printCentered("=== PAYMENT METHODS USED ===", SCREEN_WIDTH, UIColors::BOLD + UIColors::CYAN);
-        std::cout << std::endl;
-        
-        std::set<std::string> paymentMethods;
-        for (const auto& rental : rentals) {
-            std::vector<Payment> payments = pm.getPaymentsByRental(rental.RentalID);
-            for (const auto& payment : payments) {
-                paymentMethods.insert(payment.PaymentMethod);
-            }
-        }
+        UIColors::out() << '\n';
         
         if (!paymentMethods.empty()) {
-            std::string methodsStr = "";
-            for (const auto& method : paymentMethods) {
-                if (!methodsStr.empty()) methodsStr += ", ";
-                methodsStr += method;
-            }
-            UIColors::printCentered(methodsStr, SCREEN_WIDTH, UIColors::WHITE);
+            UIColors::printCentered(paymentMethods, SCREEN_WIDTH, UIColors::WHITE);
         } else {
             UIColors::printCentered("No payments recorded", SCREEN_WIDTH, UIColors::YELLOW);
         }
-        std::cout << std::endl;
+        UIColors::out() << '\n';
     } else {
-        std::cout << std::endl;
+        UIColors::out() << '\n';
         UIColors::printCentered("=== RENTAL INFORMATION ===", SCREEN_WIDTH, UIColors::BOLD + UIColors::CYAN);
-        std::cout << std::endl;
+        UIColors::out() << '\n';
         UIColors::printCentered("No rentals found for this customer", SCREEN_WIDTH, UIColors::YELLOW);
-        std::cout << std::endl;
+        UIColors::out() << '\n';
     }
 }
 
 void CustomerManager::displayAllCustomers(const std::vector<Customer>& customers) {
+    TraceSpan span("customer.displayAllCustomers", static_cast<long long>(customers.size()));
+    RenderFrame frame;
     if (customers.empty()) {
         UIColors::printInfo("No customers found.");
         return;
     }
     
-    std::cout << std::endl;
+    UIColors::out() << '\n';
     UIColors::printCentered("CUSTOMER LIST", SCREEN_WIDTH, UIColors::BOLD + UIColors::CYAN);
     UIColors::printSeparator(SCREEN_WIDTH);
     
-    // Calculate column widths to fit within SCREEN_WIDTH with proper spacing and borders
-    int col1 = 6, col2 = 20, col3 = 14, col4 = 14, col5 = 20, col6 = 12;
-    int totalWidth = col1 + col2 + col3 + col4 + col5 + col6 + 7; // +7 for 6 separators + 1
-    int padding = (SCREEN_WIDTH - totalWidth) / 2;
-    if (padding < 0) padding = 0;
-    
-    // Helper to get plain text width (strip ANSI codes)
-    auto plainWidth = [](const std::string& text) -> int {
-        int width = 0;
-        bool inEscape = false;
-        for (char c : text) {
-            if (c == '\033') inEscape = true;
-            else if (inEscape && c == 'm') inEscape = false;
-            else if (!inEscape) width++;
-        }
-        return width;
-    };
-    
-    // Helper to pad colored text to exact width
-    auto padColored = [=](const std::string& coloredText, int targetWidth) -> std::string {
-        int actualWidth = plainWidth(coloredText);
-        if (actualWidth >= targetWidth) return coloredText;
-        return coloredText + std::string(targetWidth - actualWidth, ' ');
-    };
-    
-    // Create border line
-    std::string borderLine = std::string(padding, ' ') + "+" + std::string(totalWidth - 2, '-') + "+";
-    
-    // Print top border
-    std::cout << borderLine << std::endl;
+    TableRenderer table(SCREEN_WIDTH);
+    table.addColumn("ID", 6);
+    table.addColumn("Name", 20);
+    table.addColumn("IC Number", 14);
+    table.addColumn("Phone", 12);
+    table.addColumn("Email", 20);
+    table.addColumn("DOB", 11);
     
-    // Print header with proper spacing and borders
-    std::cout << std::string(padding, ' ') << "|"
-              << padColored(UIColors::colorize("ID", UIColors::BOLD + UIColors::CYAN), col1) << "|"
-              << padColored(UIColors::colorize("Name", UIColors::BOLD + UIColors::CYAN), col2) << "|"
-              << padColored(UIColors::colorize("IC Number", UIColors::BOLD + UIColors::CYAN), col3) << "|"
-              << padColored(UIColors::colorize("Phone", UIColors::BOLD + UIColors::CYAN), col4) << "|"
-              << padColored(UIColors::colorize("Email", UIColors::BOLD + UIColors::CYAN), col5) << "|"
-              << padColored(UIColors::colorize("DOB", UIColors::BOLD + UIColors::CYAN), col6) << "|"
-              << std::endl;
-    
-    // Print separator after header
-    std::cout << borderLine << std::endl;
-    
-    // Print data rows with proper spacing and borders
     for (const auto& customer : customers) {
-        std::cout << std::string(padding, ' ') << "|"
-                  << std::setw(col1) << std::left << customer.CustomerID
-                  << "|" << std::setw(col2) << std::left << (customer.Name.length() > col2 - 1 ? customer.Name.substr(0, col2 - 1) : customer.Name)
-                  << "|" << std::setw(col3) << std::left << (customer.IC_Number.length() > col3 - 1 ? customer.IC_Number.substr(0, col3 - 1) : customer.IC_Number)
-                  << "|" << std::setw(col4) << std::left << (customer.Phone.length() > col4 - 1 ? customer.Phone.substr(0, col4 - 1) : customer.Phone)
-                  << "|" << std::setw(col5) << std::left << (customer.Email.length() > col5 - 1 ? customer.Email.substr(0, col5 - 1) : customer.Email)
-                  << "|" << std::setw(col6) << std::left << customer.DateOfBirth
-                  << "|" << std::endl;
+        table.addRow({ std::to_string(customer.CustomerID), customer.Name, customer.IC_Number, customer.Phone,
+                       customer.Email, customer.DateOfBirth });
     }
-    
-    // Print bottom border
-    std::cout << borderLine << std::endl;
+    table.render();
     UIColors::printSeparator(SCREEN_WIDTH);
 }
 
 int CustomerManager::getActiveRentalCount(int customerID) {
+    TraceSpan span("customer.getActiveRentalCount", customerID);
     try {
         sql::Connection* conn = DatabaseManager::getInstance().getConnection();
         if (!conn) {
             std::cerr << "Error: Database connection failed." << std::endl;
             return 0;
         }
-        sql::PreparedStatement* pstmt = conn->prepareStatement(
+        sql::PreparedStatement* pstmt = DatabaseManager::getInstance().prepare(
             "SELECT COUNT(*) as count FROM Rentals WHERE CustomerID = ? AND Status = 'Active'"
         );
         pstmt->setInt(1, customerID);
-        sql::ResultSet* res = pstmt->executeQuery();
+        sql::ResultSet* res = DatabaseManager::getInstance().executePreparedQuery(pstmt);
         
         int count = 0;
         if (res && res->next()) {
@@ -1,13 +1,118 @@
 #include "DatabaseManager.h"
+#include "AppConfig.h"
+#include "QueryStats.h"
+#include "Trace.h"
+#include <algorithm>
+#include <chrono>
 #include <iostream>
+#include <sstream>
 #include <stdexcept>
 
-DatabaseManager::DatabaseManager() 
-    : driver(nullptr), connection(nullptr),
-      host("tcp://127.0.0.1:3306"),
-      user("root"),
-      password(""),
-      database("dress_rental_db") {
+namespace {
+
+// Recently prepared statements of this thread and their QueryStats ids.
+// Statements are deleted right after use, so a small ring is enough.
+struct PreparedEntry {
+    const sql::PreparedStatement* statement;
+    int statementId;
+};
+const int PREPARED_RING_SIZE = 32;
+thread_local PreparedEntry preparedRing[PREPARED_RING_SIZE];
+thread_local int preparedNext = 0;
+
+int preparedStatementId(const sql::PreparedStatement* pstmt) {
+    for (int i = 1; i <= PREPARED_RING_SIZE; ++i) {
+        const PreparedEntry& entry = preparedRing[(preparedNext - i + PREPARED_RING_SIZE) % PREPARED_RING_SIZE];
+        if (entry.statement == pstmt) return entry.statementId;
+    }
+    return 0;
+}
+
+void rememberPrepared(const sql::PreparedStatement* pstmt, const std::string& query) {
+    if (!QueryStats::enabled()) return;
+    PreparedEntry& entry = preparedRing[preparedNext];
+    entry.statement = pstmt;
+    entry.statementId = QueryStats::statementId(query);
+    preparedNext = (preparedNext + 1) % PREPARED_RING_SIZE;
+}
+
+// When this thread last wrote through DatabaseManager; reads shortly after a
+// write stay on the primary so a screen shows what was just saved
+thread_local std::chrono::steady_clock::time_point lastWriteAt;
+
+// How often a replica's lag is re-read, and how long to stay on the primary
+// after every replica failed
+const std::chrono::seconds REPLICA_LAG_RECHECK(1);
+const std::chrono::seconds REPLICA_RETRY_DELAY(5);
+
+// Client errors that mean the connection itself is gone (server has gone away,
+// lost connection during query, lost connection to server)
+bool isConnectionLost(int errorCode) {
+    return errorCode == 2006 || errorCode == 2013 || errorCode == 2055;
+}
+
+// Times one query and records it on scope exit, including when it throws.
+// Also shows up as a "db.query" span (value = QueryStats id) when tracing.
+class QueryTimer {
+public:
+    explicit QueryTimer(int statementId)
+        : span("db.query", statementId), statementId(statementId), active(QueryStats::enabled()) {
+        if (active) start = std::chrono::steady_clock::now();
+    }
+    ~QueryTimer() {
+        if (!active) return;
+        std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - start;
+        QueryStats::record(statementId, static_cast<uint64_t>(elapsed.count()));
+    }
+
+private:
+    TraceSpan span;
+    int statementId;
+    bool active;
+    std::chrono::steady_clock::time_point start;
+};
+
+} // namespace
+
+DatabaseManager::DatabaseManager()
+    : driver(nullptr),
+      host(AppConfig::getInstance().getString("db_host", "tcp://127.0.0.1:3306")),
+      user(AppConfig::getInstance().getString("db_user", "root")),
+      password(AppConfig::getInstance().getString("db_password", "")),
+      database(AppConfig::getInstance().getString("db_name", "dress_rental_db")),
+      connectTimeoutSeconds(AppConfig::getInstance().getInt("db_connect_timeout", 5)),
+      readTimeoutSeconds(AppConfig::getInstance().getInt("db_read_timeout", 30)),
+      writeTimeoutSeconds(AppConfig::getInstance().getInt("db_write_timeout", 30)),
+      compress(AppConfig::getInstance().getBool("db_compress", false)),
+      breakerThreshold(std::max(1, AppConfig::getInstance().getInt("db_breaker_threshold", 3))),
+      retryBaseMs(std::max(1, AppConfig::getInstance().getInt("db_retry_base_ms", 500))),
+      retryMaxMs(std::max(1, AppConfig::getInstance().getInt("db_retry_max_ms", 30000))),
+      connectFailures(0),
+      probeInFlight(false),
+      jitter(std::random_device()()),
+      maxReplicaLagSeconds(std::max(0, AppConfig::getInstance().getInt("replica_max_lag", 5))),
+      readYourWritesMs(std::max(0, AppConfig::getInstance().getInt("read_your_writes_ms", 2000))),
+      nextReplica(0),
+      replicaReads(0),
+      primaryReads(0),
+      replicaFallbacks(0) {
+    // A local server is faster over its Unix socket than over TCP loopback
+    std::string socket = AppConfig::getInstance().getString("db_socket", "");
+    if (!socket.empty()) host = "unix://" + socket;
+
+    // replicas: comma separated hosts, e.g. "tcp://10.0.0.2:3306,tcp://10.0.0.3:3306".
+    // Replicas use the primary's user, password, schema and timeouts.
+    std::string list = AppConfig::getInstance().getString("replicas", "");
+    if (!list.empty()) {
+        std::stringstream ss(list);
+        std::string endpoint;
+        while (std::getline(ss, endpoint, ',')) {
+            size_t first = endpoint.find_first_not_of(" \t");
+            size_t last = endpoint.find_last_not_of(" \t");
+            if (first == std::string::npos) continue;
+            replicaHosts.push_back(endpoint.substr(first, last - first + 1));
+        }
+    }
 }
 
 DatabaseManager::~DatabaseManager() {
@@ -19,67 +124,448 @@ DatabaseManager& DatabaseManager::getInstance() {
     return instance;
 }
 
+sql::Connection* DatabaseManager::threadConnection() {
+    std::lock_guard<std::mutex> lock(connectionsMutex);
+    std::map<std::thread::id, sql::Connection*>::iterator it = connections.find(std::this_thread::get_id());
+    return it != connections.end() ? it->second : nullptr;
+}
+
+sql::Connection* DatabaseManager::openConnection(const std::string& hostName) {
+    if (!driver) driver = sql::mysql::get_mysql_driver_instance();
+    sql::ConnectOptionsMap options;
+    options["hostName"] = hostName;
+    options["userName"] = user;
+    options["password"] = password;
+    options["schema"] = database;
+    // Without these a dead server or network hangs a call for minutes
+    options["OPT_CONNECT_TIMEOUT"] = connectTimeoutSeconds;
+    options["OPT_READ_TIMEOUT"] = readTimeoutSeconds;
+    options["OPT_WRITE_TIMEOUT"] = writeTimeoutSeconds;
+    if (compress) options["CLIENT_COMPRESS"] = true;
+    return driver->connect(options);
+}
+
 bool DatabaseManager::connect() {
     try {
-        driver = sql::mysql::get_mysql_driver_instance();
-        connection = driver->connect(host, user, password);
-        connection->setSchema(database);
+        sql::Connection* conn = openConnection(host);
+
+        sql::Connection* previous = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(connectionsMutex);
+            sql::Connection*& slot = connections[std::this_thread::get_id()];
+            previous = slot;
+            slot = conn;
+        }
+        delete previous;
+        recordConnectResult(true, "");
         return true;
     } catch (sql::SQLException& e) {
         std::cerr << "Database Connection Error: " << e.what() << std::endl;
         std::cerr << "MySQL Error Code: " << e.getErrorCode() << std::endl;
+        recordConnectResult(false, e.what());
+        return false;
+    } catch (const std::exception& e) {
+        // Anything else must still end the probe, or the breaker never closes
+        std::cerr << "Database Connection Error: " << e.what() << std::endl;
+        recordConnectResult(false, e.what());
+        return false;
+    }
+}
+
+bool DatabaseManager::reconnectAllowed(std::string& reason) {
+    std::lock_guard<std::mutex> lock(breakerMutex);
+    if (connectFailures < breakerThreshold) return true;
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    if (now < retryAt || probeInFlight) {
+        long long waitMs = std::chrono::duration_cast<std::chrono::milliseconds>(retryAt - now).count();
+        std::ostringstream message;
+        message << "Database unavailable (" << lastConnectError << "), next retry in "
+                << (waitMs > 0 ? (waitMs + 999) / 1000 : 1) << "s";
+        reason = message.str();
         return false;
     }
+    // Half open: this caller probes, everyone else fails fast until it is done
+    probeInFlight = true;
+    return true;
+}
+
+void DatabaseManager::recordConnectResult(bool connected, const std::string& error) {
+    std::lock_guard<std::mutex> lock(breakerMutex);
+    probeInFlight = false;
+    if (connected) {
+        connectFailures = 0;
+        return;
+    }
+    ++connectFailures;
+    lastConnectError = error;
+    if (connectFailures < breakerThreshold) return;
+
+    // Exponential backoff with equal jitter: half the delay is fixed, the other
+    // half random, so clients that lost the server together do not retry together
+    int doublings = std::min(connectFailures - breakerThreshold, 20);
+    long long delayMs = std::min(static_cast<long long>(retryBaseMs) << doublings, static_cast<long long>(retryMaxMs));
+    std::uniform_int_distribution<long long> spread(0, delayMs / 2);
+    delayMs = delayMs - delayMs / 2 + spread(jitter);
+    retryAt = std::chrono::steady_clock::now() + std::chrono::milliseconds(delayMs);
+}
+
+sql::Connection* DatabaseManager::usableConnection(std::string& error) {
+    sql::Connection* connection = threadConnection();
+    if (connection && !connection->isClosed()) return connection;
+    if (!reconnectAllowed(error)) return nullptr;
+    if (!connect()) {
+        error = "Database connection failed. Please check your MySQL server.";
+        return nullptr;
+    }
+    return threadConnection();
+}
+
+void DatabaseManager::noteConnectionError(const sql::SQLException& e) {
+    // Close a dead connection so the next call reconnects through the breaker
+    // instead of failing on it again
+    if (!isConnectionLost(e.getErrorCode())) return;
+    sql::Connection* connection = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(connectionsMutex);
+        std::map<std::thread::id, sql::Connection*>::iterator it = connections.find(std::this_thread::get_id());
+        if (it != connections.end()) connection = it->second;
+    }
+    if (!connection) return;
+    try {
+        connection->close();
+    } catch (sql::SQLException&) {
+    }
 }
 
 void DatabaseManager::disconnect() {
-    if (connection) {
-        delete connection;
-        connection = nullptr;
+    std::lock_guard<std::mutex> lock(connectionsMutex);
+    for (auto& entry : connections) {
+        delete entry.second;
+    }
+    connections.clear();
+    for (auto& entry : replicas) {
+        delete entry.second.connection;
     }
+    replicas.clear();
 }
 
-sql::Connection* DatabaseManager::getConnection() {
-    if (!connection || connection->isClosed()) {
-        if (!connect()) {
-            throw std::runtime_error("Database connection failed. Please check your MySQL server.");
+void DatabaseManager::releaseThreadConnection() {
+    // Worker threads call this before exiting so their connections are not leaked
+    sql::Connection* conn = nullptr;
+    sql::Connection* replica = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(connectionsMutex);
+        std::map<std::thread::id, sql::Connection*>::iterator it = connections.find(std::this_thread::get_id());
+        if (it != connections.end()) {
+            conn = it->second;
+            connections.erase(it);
+        }
+        std::map<std::thread::id, ReplicaConnection>::iterator rit = replicas.find(std::this_thread::get_id());
+        if (rit != replicas.end()) {
+            replica = rit->second.connection;
+            replicas.erase(rit);
+        }
+    }
+    if (!conn && !replica) return;
+    delete conn;
+    delete replica;
+    if (driver) driver->threadEnd();
+}
+
+bool DatabaseManager::replicaLagOk(sql::Connection* connection) {
+    // MySQL 8.0.22+ knows SHOW REPLICA STATUS, older servers only the SLAVE
+    // spelling. No row means the server is not replicating at all (a plain
+    // second instance used for testing) and counts as current; a NULL lag means
+    // replication is stopped or broken.
+    sql::Statement* stmt = nullptr;
+    sql::ResultSet* res = nullptr;
+    try {
+        stmt = connection->createStatement();
+        std::string lagColumn = "Seconds_Behind_Source";
+        try {
+            res = stmt->executeQuery("SHOW REPLICA STATUS");
+        } catch (sql::SQLException&) {
+            lagColumn = "Seconds_Behind_Master";
+            res = stmt->executeQuery("SHOW SLAVE STATUS");
+        }
+        bool ok = true;
+        if (res->next()) {
+            int lag = res->getInt(lagColumn);
+            ok = !res->wasNull() && lag <= maxReplicaLagSeconds;
+        }
+        delete res;
+        delete stmt;
+        return ok;
+    } catch (sql::SQLException& e) {
+        std::cerr << "Replica Status Error: " << e.what() << std::endl;
+        delete res;
+        delete stmt;
+        return false;
+    }
+}
+
+sql::Connection* DatabaseManager::replicaConnection() {
+    if (replicaHosts.empty()) return nullptr;
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    if (now - lastWriteAt < std::chrono::milliseconds(readYourWritesMs)) return nullptr;
+
+    ReplicaConnection replica = { nullptr, 0, {}, {}, false };
+    {
+        std::lock_guard<std::mutex> lock(connectionsMutex);
+        std::map<std::thread::id, ReplicaConnection>::iterator it = replicas.find(std::this_thread::get_id());
+        if (it != replicas.end()) replica = it->second;
+    }
+    if (replica.connection && now - replica.lagCheckedAt < REPLICA_LAG_RECHECK) return replica.connection;
+    if (!replica.connection && now < replica.retryAfter) return nullptr;
+
+    // Keep the current replica while it is healthy, otherwise try the others
+    // round robin and fall back to the primary if none is usable
+    if (replica.connection && (replica.connection->isClosed() || !replicaLagOk(replica.connection))) {
+        delete replica.connection;
+        replica.connection = nullptr;
+    }
+    std::string lastError;
+    for (size_t attempt = 0; !replica.connection && attempt < replicaHosts.size(); ++attempt) {
+        size_t endpoint = nextReplica++ % replicaHosts.size();
+        try {
+            sql::Connection* conn = openConnection(replicaHosts[endpoint]);
+            if (replicaLagOk(conn)) {
+                replica.connection = conn;
+                replica.endpoint = endpoint;
+            } else {
+                lastError = replicaHosts[endpoint] + " is more than " + std::to_string(maxReplicaLagSeconds) +
+                            "s behind";
+                delete conn;
+            }
+        } catch (sql::SQLException& e) {
+            lastError = replicaHosts[endpoint] + ": " + e.what();
+        }
+    }
+
+    if (replica.connection) {
+        replica.lagCheckedAt = now;
+        replica.degraded = false;
+    } else {
+        replica.retryAfter = now + REPLICA_RETRY_DELAY;
+        if (!replica.degraded) {
+            std::cerr << "No usable read replica, reading from primary (" << lastError << ")" << std::endl;
+            replica.degraded = true;
         }
     }
+    {
+        std::lock_guard<std::mutex> lock(connectionsMutex);
+        replicas[std::this_thread::get_id()] = replica;
+    }
+    return replica.connection;
+}
+
+void DatabaseManager::dropReplicaConnection() {
+    // After a failed replica query: close it and recheck on the next read
+    sql::Connection* conn = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(connectionsMutex);
+        std::map<std::thread::id, ReplicaConnection>::iterator it = replicas.find(std::this_thread::get_id());
+        if (it == replicas.end()) return;
+        conn = it->second.connection;
+        it->second.connection = nullptr;
+    }
+    delete conn;
+    ++replicaFallbacks;
+}
+
+sql::Connection* DatabaseManager::getConnection() {
+    std::string error;
+    sql::Connection* connection = usableConnection(error);
+    if (!connection) throw std::runtime_error(error);
     return connection;
 }
 
 bool DatabaseManager::executeQuery(const std::string& query) {
     try {
-        if (!connection || connection->isClosed()) {
-            if (!connect()) return false;
+        std::string error;
+        sql::Connection* connection = usableConnection(error);
+        if (!connection) {
+            std::cerr << error << std::endl;
+            return false;
         }
+        noteWrite();
         sql::Statement* stmt = connection->createStatement();
-        stmt->execute(query);
+        {
+            QueryTimer timer(QueryStats::enabled() ? QueryStats::statementId(query) : 0);
+            stmt->execute(query);
+        }
         delete stmt;
         return true;
     } catch (sql::SQLException& e) {
         std::cerr << "Query Execution Error: " << e.what() << std::endl;
+        noteConnectionError(e);
         return false;
     }
 }
 
 sql::ResultSet* DatabaseManager::executeSelect(const std::string& query) {
     try {
-        if (!connection || connection->isClosed()) {
-            if (!connect()) return nullptr;
+        std::string error;
+        sql::Connection* connection = usableConnection(error);
+        if (!connection) {
+            std::cerr << error << std::endl;
+            return nullptr;
         }
-        sql::Statement* stmt = connection->createStatement();
-        sql::ResultSet* res = stmt->executeQuery(query);
-        // Note: Statement will be deleted when ResultSet is deleted
-        // The ResultSet maintains ownership of the Statement
-        return res;
+        // The result set is fully buffered and outlives its statement, which
+        // the caller never sees, so the statement goes as soon as it has run
+        std::unique_ptr<sql::Statement> stmt(connection->createStatement());
+        QueryTimer timer(QueryStats::enabled() ? QueryStats::statementId(query) : 0);
+        return stmt->executeQuery(query);
     } catch (sql::SQLException& e) {
         std::cerr << "Select Query Error: " << e.what() << std::endl;
+        noteConnectionError(e);
         return nullptr;
     }
 }
 
+sql::ResultSet* DatabaseManager::executeReadSelect(const std::string& query) {
+    sql::Connection* replica = replicaConnection();
+    if (replica) {
+        try {
+            // Freed once it has run, as in executeSelect
+            std::unique_ptr<sql::Statement> stmt(replica->createStatement());
+            QueryTimer timer(QueryStats::enabled() ? QueryStats::statementId(query) : 0);
+            sql::ResultSet* res = stmt->executeQuery(query);
+            ++replicaReads;
+            return res;
+        } catch (sql::SQLException& e) {
+            std::cerr << "Replica Query Error, retrying on primary: " << e.what() << std::endl;
+            dropReplicaConnection();
+        }
+    }
+    ++primaryReads;
+    return executeSelect(query);
+}
+
+sql::PreparedStatement* DatabaseManager::prepare(const std::string& query) {
+    sql::PreparedStatement* pstmt = getConnection()->prepareStatement(query);
+    rememberPrepared(pstmt, query);
+    return pstmt;
+}
+
+sql::ResultSet* DatabaseManager::executeRead(const std::string& query,
+                                             const std::function<void(sql::PreparedStatement*)>& bind,
+                                             sql::PreparedStatement*& pstmt) {
+    pstmt = nullptr;
+    sql::Connection* replica = replicaConnection();
+    if (replica) {
+        // Failures here are the replica's: drop it and leave the primary (and
+        // any transaction open on it) alone
+        sql::PreparedStatement* onReplica = nullptr;
+        try {
+            onReplica = replica->prepareStatement(query);
+            rememberPrepared(onReplica, query);
+            bind(onReplica);
+            sql::ResultSet* res = nullptr;
+            {
+                QueryTimer timer(QueryStats::enabled() ? preparedStatementId(onReplica) : 0);
+                res = onReplica->executeQuery();
+            }
+            ++replicaReads;
+            pstmt = onReplica;
+            return res;
+        } catch (sql::SQLException& e) {
+            std::cerr << "Replica Query Error, retrying on primary: " << e.what() << std::endl;
+            delete onReplica;
+            dropReplicaConnection();
+        }
+    }
+    ++primaryReads;
+    pstmt = prepare(query);
+    bind(pstmt);
+    return executePreparedQuery(pstmt);
+}
+
+sql::ResultSet* DatabaseManager::executePreparedQuery(sql::PreparedStatement* pstmt) {
+    QueryTimer timer(QueryStats::enabled() ? preparedStatementId(pstmt) : 0);
+    try {
+        return pstmt->executeQuery();
+    } catch (sql::SQLException& e) {
+        noteConnectionError(e);
+        throw;
+    }
+}
+
+int DatabaseManager::executePreparedUpdate(sql::PreparedStatement* pstmt) {
+    noteWrite();
+    QueryTimer timer(QueryStats::enabled() ? preparedStatementId(pstmt) : 0);
+    try {
+        return pstmt->executeUpdate();
+    } catch (sql::SQLException& e) {
+        noteConnectionError(e);
+        throw;
+    }
+}
+
+std::string DatabaseManager::placeholderList(size_t count) {
+    std::string list;
+    for (size_t i = 0; i < count; ++i) list += i == 0 ? "?" : ", ?";
+    return list;
+}
+
+void DatabaseManager::bindIDs(sql::PreparedStatement* pstmt, int firstIndex, const std::vector<int>& ids) {
+    for (size_t i = 0; i < ids.size(); ++i) {
+        pstmt->setInt(firstIndex + static_cast<int>(i), ids[i]);
+    }
+}
+
+sql::ResultSet* DatabaseManager::runQuery(sql::PreparedStatement* pstmt) {
+    try {
+        return getInstance().executePreparedQuery(pstmt);
+    } catch (sql::SQLException&) {
+        delete pstmt;
+        throw;
+    }
+}
+
+int DatabaseManager::runUpdate(sql::PreparedStatement* pstmt) {
+    int rows = 0;
+    try {
+        rows = getInstance().executePreparedUpdate(pstmt);
+    } catch (sql::SQLException&) {
+        delete pstmt;
+        throw;
+    }
+    delete pstmt;
+    return rows;
+}
+
+void DatabaseManager::rollbackQuietly() {
+    try {
+        sql::Connection* conn = getInstance().getConnection();
+        if (conn && !conn->isClosed()) {
+            conn->rollback();
+            conn->setAutoCommit(true);
+        }
+    } catch (...) {}
+}
+
 bool DatabaseManager::isConnected() {
+    sql::Connection* connection = threadConnection();
     return connection != nullptr && !connection->isClosed();
 }
 
+std::string DatabaseManager::describeTarget() const {
+    return database + " on " + host + " as " + user;
+}
+
+void DatabaseManager::noteWrite() {
+    lastWriteAt = std::chrono::steady_clock::now();
+}
+
+void DatabaseManager::printReadRouting(std::ostream& out) {
+    if (replicaHosts.empty()) {
+        out << "Read replicas: none configured (set replicas to enable)\n";
+        return;
+    }
+    out << "Read replicas: " << replicaHosts.size() << " endpoint(s), max lag " << maxReplicaLagSeconds
+        << "s, read-your-writes window " << readYourWritesMs << "ms\n";
+    out << "  Reads on replicas: " << replicaReads.load()
+        << "   on primary: " << primaryReads.load()
+        << "   replica failures: " << replicaFallbacks.load() << "\n";
+}
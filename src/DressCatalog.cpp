@@ -0,0 +1,221 @@
+#include "DressCatalog.h"
+#include <algorithm>
+#include <iostream>
+
+DressCatalog::DressCatalog() {}
+
+const char* DressCatalog::facetName(Facet facet) {
+    static const char* NAMES[FACET_COUNT] = { "Category", "Size", "Color", "Condition", "Availability", "Cleaning" };
+    return facet >= 0 && facet < FACET_COUNT ? NAMES[facet] : "";
+}
+
+bool DressCatalog::load() {
+    clear();
+    try {
+        sql::ResultSet* res = DatabaseManager::getInstance().executeReadSelect(
+            "SELECT DressID, DressName, Category, Size, Color, RentalPrice, ConditionStatus, "
+            "AvailabilityStatus, CleaningStatus, Version FROM Dresses ORDER BY DressID"
+        );
+        if (!res) return false;
+
+        Dress dress;
+        while (res->next()) {
+            dress.DressID = res->getInt("DressID");
+            dress.DressName = res->getString("DressName");
+            dress.Category = res->getString("Category");
+            dress.Size = res->getString("Size");
+            dress.Color = res->getString("Color");
+            dress.RentalPrice = Money::fromString(res->getString("RentalPrice"));
+            dress.ConditionStatus = res->getString("ConditionStatus");
+            dress.AvailabilityStatus = res->getString("AvailabilityStatus");
+            dress.CleaningStatus = res->getString("CleaningStatus");
+            dress.Version = res->getInt("Version");
+            add(dress);
+        }
+        delete res;
+    } catch (sql::SQLException& e) {
+        std::cerr << "Error loading dress catalogue: " << e.what() << std::endl;
+        clear();
+        return false;
+    }
+    return true;
+}
+
+void DressCatalog::add(const Dress& dress) {
+    uint32_t row = static_cast<uint32_t>(ids.size());
+    ids.push_back(dress.DressID);
+    names += dress.DressName;
+    nameEnds.push_back(static_cast<uint32_t>(names.size()));
+    prices.push_back(dress.RentalPrice);
+    versions.push_back(dress.Version);
+
+    const std::string* attributes[FACET_COUNT] = { &dress.Category, &dress.Size, &dress.Color,
+                                                   &dress.ConditionStatus, &dress.AvailabilityStatus,
+                                                   &dress.CleaningStatus };
+    for (int f = 0; f < FACET_COUNT; ++f) {
+        uint16_t code = encode(static_cast<Facet>(f), *attributes[f]);
+        codes[f].push_back(code);
+        dictionaries[f].rows[code].add(row);
+    }
+    allRows.add(row);
+}
+
+void DressCatalog::clear() {
+    ids.clear();
+    nameEnds.clear();
+    names.clear();
+    prices.clear();
+    versions.clear();
+    for (int f = 0; f < FACET_COUNT; ++f) {
+        codes[f].clear();
+        dictionaries[f] = Dictionary();
+    }
+    allRows.clear();
+}
+
+uint16_t DressCatalog::encode(Facet facet, const std::string& value) {
+    Dictionary& dictionary = dictionaries[facet];
+    std::unordered_map<std::string, uint16_t>::const_iterator found = dictionary.codes.find(value);
+    if (found != dictionary.codes.end()) return found->second;
+
+    uint16_t code = static_cast<uint16_t>(dictionary.values.size());
+    dictionary.values.push_back(value);
+    dictionary.codes[value] = code;
+    dictionary.rows.push_back(RowBitmap());
+    return code;
+}
+
+const RowBitmap* DressCatalog::facetFilter(const Query& query, Facet facet, RowBitmap& storage) const {
+    const std::vector<std::string>& accepted = query.accepted[facet];
+    if (accepted.empty()) return nullptr;
+
+    const Dictionary& dictionary = dictionaries[facet];
+    const RowBitmap* filter = nullptr;
+    storage.clear();
+    for (const std::string& value : accepted) {
+        std::unordered_map<std::string, uint16_t>::const_iterator code = dictionary.codes.find(value);
+        if (code == dictionary.codes.end()) continue;   // no dress has it
+        const RowBitmap& rows = dictionary.rows[code->second];
+        if (!filter) {
+            filter = &rows;     // a single value is used in place
+        } else {
+            storage = RowBitmap::unite(*filter, rows);
+            filter = &storage;
+        }
+    }
+    return filter ? filter : &storage;
+}
+
+DressCatalog::Result DressCatalog::search(const Query& query, size_t limit) const {
+    RowBitmap unions[FACET_COUNT];
+    const RowBitmap* filters[FACET_COUNT];
+    int filtered[FACET_COUNT];
+    int filteredCount = 0;
+    for (int f = 0; f < FACET_COUNT; ++f) {
+        filters[f] = facetFilter(query, static_cast<Facet>(f), unions[f]);
+        if (filters[f]) filtered[filteredCount++] = f;
+    }
+
+    // Intersection of two filters, where nullptr stands for every dress
+    auto both = [](const RowBitmap* a, const RowBitmap* b, RowBitmap& storage) -> const RowBitmap* {
+        if (!a) return b;
+        if (!b) return a;
+        storage = RowBitmap::intersect(*a, *b);
+        return &storage;
+    };
+
+    // before[i] combines the first i filtered facets and after[i] the rest,
+    // so each facet's "all the others" is one more intersection, not n - 1
+    RowBitmap beforeRows[FACET_COUNT + 1];
+    RowBitmap afterRows[FACET_COUNT + 1];
+    const RowBitmap* before[FACET_COUNT + 1];
+    const RowBitmap* after[FACET_COUNT + 1];
+    before[0] = nullptr;
+    after[filteredCount] = nullptr;
+    for (int i = 0; i < filteredCount; ++i) {
+        before[i + 1] = both(before[i], filters[filtered[i]], beforeRows[i + 1]);
+    }
+    for (int i = filteredCount - 1; i > 0; --i) {
+        after[i] = both(filters[filtered[i]], after[i + 1], afterRows[i]);
+    }
+
+    const RowBitmap& matched = before[filteredCount] ? *before[filteredCount] : allRows;
+
+    Result result;
+    result.total = matched.cardinality();
+    for (uint32_t row : matched.toRows(limit)) result.dressIDs.push_back(ids[row]);
+
+    for (int f = 0; f < FACET_COUNT; ++f) {
+        // An unfiltered facet is counted within the full match; a filtered
+        // one within the other facets' match, so its alternatives show too
+        RowBitmap others;
+        const RowBitmap* scope = before[filteredCount];
+        for (int i = 0; i < filteredCount; ++i) {
+            if (filtered[i] == f) scope = both(before[i], after[i + 1], others);
+        }
+
+        const Dictionary& dictionary = dictionaries[f];
+        std::vector<size_t> byCode(dictionary.values.size(), 0);
+        if (!scope) {
+            for (size_t code = 0; code < byCode.size(); ++code) byCode[code] = dictionary.rows[code].cardinality();
+        } else if (scope->cardinality() < byCode.size() * scope->chunkCount() * 1024) {
+            // A small scope is cheaper to tally through the codes, one step
+            // per dress, than with one bitmap pass per value
+            const std::vector<uint16_t>& facetCodes = codes[f];
+            scope->forEach([&](uint32_t row) { ++byCode[facetCodes[row]]; });
+        } else {
+            for (size_t code = 0; code < byCode.size(); ++code) {
+                byCode[code] = RowBitmap::intersectCount(*scope, dictionary.rows[code]);
+            }
+        }
+
+        std::vector<FacetCount>& counts = result.facets[f];
+        for (size_t code = 0; code < byCode.size(); ++code) {
+            if (byCode[code] == 0) continue;
+            FacetCount facetCount;
+            facetCount.value = dictionary.values[code];
+            facetCount.count = byCode[code];
+            counts.push_back(facetCount);
+        }
+        std::sort(counts.begin(), counts.end(), [](const FacetCount& a, const FacetCount& b) {
+            return a.count != b.count ? a.count > b.count : a.value < b.value;
+        });
+    }
+    return result;
+}
+
+bool DressCatalog::getDress(int dressID, Dress& dress) const {
+    std::vector<int>::const_iterator found = std::lower_bound(ids.begin(), ids.end(), dressID);
+    if (found == ids.end() || *found != dressID) return false;
+
+    size_t row = found - ids.begin();
+    uint32_t nameStart = row == 0 ? 0 : nameEnds[row - 1];
+    dress.DressID = dressID;
+    dress.DressName = names.substr(nameStart, nameEnds[row] - nameStart);
+    dress.Category = dictionaries[CATEGORY].values[codes[CATEGORY][row]];
+    dress.Size = dictionaries[SIZE].values[codes[SIZE][row]];
+    dress.Color = dictionaries[COLOR].values[codes[COLOR][row]];
+    dress.RentalPrice = prices[row];
+    dress.ConditionStatus = dictionaries[CONDITION].values[codes[CONDITION][row]];
+    dress.AvailabilityStatus = dictionaries[AVAILABILITY].values[codes[AVAILABILITY][row]];
+    dress.CleaningStatus = dictionaries[CLEANING].values[codes[CLEANING][row]];
+    dress.Version = versions[row];
+    return true;
+}
+
+size_t DressCatalog::memoryBytes() const {
+    size_t bytes = sizeof(DressCatalog);
+    bytes += ids.capacity() * sizeof(int) + nameEnds.capacity() * sizeof(uint32_t) + names.capacity();
+    bytes += prices.capacity() * sizeof(Money) + versions.capacity() * sizeof(int);
+    bytes += allRows.memoryBytes();
+    for (int f = 0; f < FACET_COUNT; ++f) {
+        bytes += codes[f].capacity() * sizeof(uint16_t);
+        const Dictionary& dictionary = dictionaries[f];
+        for (size_t code = 0; code < dictionary.values.size(); ++code) {
+            // Each value is held twice: by code and as the lookup key
+            bytes += 2 * (sizeof(std::string) + dictionary.values[code].capacity());
+            bytes += dictionary.rows[code].memoryBytes();
+        }
+    }
+    return bytes;
+}
@@ -0,0 +1,268 @@
+#include "DressStock.h"
+#include "LateFeePolicy.h"
+#include <iostream>
+
+namespace {
+
+// Day offsets 0-999, for expanding a rental into the days it covers; an
+// overdue rental can hold far more than MAX_RANGE_DAYS
+const char* DAY_OFFSETS =
+    "(SELECT h.n * 100 + t.n * 10 + u.n AS n FROM "
+    " (SELECT 0 AS n UNION ALL SELECT 1 UNION ALL SELECT 2 UNION ALL SELECT 3 UNION ALL SELECT 4 "
+    "  UNION ALL SELECT 5 UNION ALL SELECT 6 UNION ALL SELECT 7 UNION ALL SELECT 8 UNION ALL SELECT 9) h "
+    " CROSS JOIN "
+    " (SELECT 0 AS n UNION ALL SELECT 1 UNION ALL SELECT 2 UNION ALL SELECT 3 UNION ALL SELECT 4 "
+    "  UNION ALL SELECT 5 UNION ALL SELECT 6 UNION ALL SELECT 7 UNION ALL SELECT 8 UNION ALL SELECT 9) t "
+    " CROSS JOIN "
+    " (SELECT 0 AS n UNION ALL SELECT 1 UNION ALL SELECT 2 UNION ALL SELECT 3 UNION ALL SELECT 4 "
+    "  UNION ALL SELECT 5 UNION ALL SELECT 6 UNION ALL SELECT 7 UNION ALL SELECT 8 UNION ALL SELECT 9) u)";
+
+// Recomputes the flags derived from UnitsOut and StockQuantity. A single-table
+// UPDATE assigns left to right, so placed after the change to either column
+// these see the new value.
+const char* STOCK_FLAGS =
+    "LowStock = (StockQuantity - UnitsOut < MinimumStockLevel), "
+    "AvailabilityStatus = CASE "
+    "    WHEN AvailabilityStatus = 'Available' AND UnitsOut >= StockQuantity THEN 'Rented' "
+    "    WHEN AvailabilityStatus = 'Rented' AND UnitsOut < StockQuantity THEN 'Available' "
+    "    ELSE AvailabilityStatus END, "
+    "Version = Version + 1";
+
+StockLevel readLevel(sql::ResultSet* res) {
+    StockLevel level;
+    level.DressID = res->getInt("DressID");
+    level.DressName = res->getString("DressName");
+    level.StockQuantity = res->getInt("StockQuantity");
+    level.MinimumStockLevel = res->getInt("MinimumStockLevel");
+    level.UnitsOut = res->getInt("UnitsOut");
+    return level;
+}
+
+} // namespace
+
+bool DressStock::reserve(int dressID, const std::string& startDate, const std::string& endDate) {
+    long startDay = 0;
+    long endDay = 0;
+    if (!LateFeePolicy::parseDate(startDate, startDay) || !LateFeePolicy::parseDate(endDate, endDay)) return false;
+    long days = endDay - startDay + 1;
+    if (days < 1 || days > MAX_RANGE_DAYS) return false;
+
+    // Day rows start at zero the first time a day is booked
+    sql::PreparedStatement* pstmt = DatabaseManager::getInstance().prepare(
+        std::string("INSERT IGNORE INTO DressDailyStock (DressID, StockDate) "
+                    "SELECT ?, DATE_ADD(?, INTERVAL o.n DAY) FROM ") + DAY_OFFSETS + " o WHERE o.n < ?"
+    );
+    pstmt->setInt(1, dressID);
+    pstmt->setString(2, startDate);
+    pstmt->setInt(3, static_cast<int>(days));
+    DatabaseManager::runUpdate(pstmt);
+
+    // The reservation itself: every day with a unit to spare takes one, so it
+    // succeeded only if every day of the range changed
+    pstmt = DatabaseManager::getInstance().prepare(
+        "UPDATE DressDailyStock s JOIN Dresses d ON d.DressID = s.DressID "
+        "SET s.Reserved = s.Reserved + 1 "
+        "WHERE s.DressID = ? AND s.StockDate BETWEEN ? AND ? "
+        "AND s.Reserved < d.StockQuantity AND d.AvailabilityStatus <> 'Maintenance'"
+    );
+    pstmt->setInt(1, dressID);
+    pstmt->setString(2, startDate);
+    pstmt->setString(3, endDate);
+    if (DatabaseManager::runUpdate(pstmt) != days) return false;
+
+    pstmt = DatabaseManager::getInstance().prepare(
+        std::string("UPDATE Dresses SET UnitsOut = UnitsOut + 1, ") + STOCK_FLAGS + " WHERE DressID = ?"
+    );
+    pstmt->setInt(1, dressID);
+    DatabaseManager::runUpdate(pstmt);
+    return true;
+}
+
+void DressStock::release(const std::vector<int>& rentalIDs) {
+    if (rentalIDs.empty()) return;
+    std::string inList = "(" + DatabaseManager::placeholderList(rentalIDs.size()) + ")";
+
+    // Rentals sharing a dress and a day are summed first: a multi-table UPDATE
+    // changes each row once however many rows it joins to
+    sql::PreparedStatement* pstmt = DatabaseManager::getInstance().prepare(
+        std::string("UPDATE DressDailyStock s JOIN ("
+                    "    SELECT ri.DressID, DATE_ADD(r.RentalDate, INTERVAL o.n DAY) AS StockDate, COUNT(*) AS Units "
+                    "    FROM Rentals r JOIN RentalItems ri ON ri.RentalID = r.RentalID "
+                    "    JOIN ") + DAY_OFFSETS + " o ON o.n <= DATEDIFF(r.HeldThrough, r.RentalDate) "
+        "    WHERE r.RentalID IN " + inList + " GROUP BY ri.DressID, StockDate"
+        ") x ON x.DressID = s.DressID AND x.StockDate = s.StockDate "
+        "SET s.Reserved = GREATEST(s.Reserved - x.Units, 0)"
+    );
+    DatabaseManager::bindIDs(pstmt, 1, rentalIDs);
+    DatabaseManager::runUpdate(pstmt);
+
+    pstmt = DatabaseManager::getInstance().prepare(
+        "UPDATE Dresses d JOIN ("
+        "    SELECT DressID, COUNT(*) AS Units FROM RentalItems WHERE RentalID IN " + inList + " GROUP BY DressID"
+        ") x ON x.DressID = d.DressID "
+        "SET d.UnitsOut = GREATEST(d.UnitsOut - x.Units, 0)"
+    );
+    DatabaseManager::bindIDs(pstmt, 1, rentalIDs);
+    DatabaseManager::runUpdate(pstmt);
+
+    // Multi-table assignments have no defined order, so the flags follow in
+    // a statement of their own
+    pstmt = DatabaseManager::getInstance().prepare(
+        std::string("UPDATE Dresses SET ") + STOCK_FLAGS +
+        " WHERE DressID IN (SELECT DressID FROM RentalItems WHERE RentalID IN " + inList + ")"
+    );
+    DatabaseManager::bindIDs(pstmt, 1, rentalIDs);
+    DatabaseManager::runUpdate(pstmt);
+}
+
+void DressStock::holdThroughToday(const std::vector<int>& rentalIDs) {
+    if (rentalIDs.empty()) return;
+    std::string inList = "(" + DatabaseManager::placeholderList(rentalIDs.size()) + ")";
+    // The days after HeldThrough up to today, one row per item and day
+    std::string days =
+        std::string("SELECT ri.DressID, DATE_ADD(r.HeldThrough, INTERVAL o.n + 1 DAY) AS StockDate "
+                    "FROM Rentals r JOIN RentalItems ri ON ri.RentalID = r.RentalID "
+                    "JOIN ") + DAY_OFFSETS + " o ON o.n < DATEDIFF(CURDATE(), r.HeldThrough) "
+        "WHERE r.RentalID IN " + inList;
+
+    sql::PreparedStatement* pstmt = DatabaseManager::getInstance().prepare(
+        "INSERT IGNORE INTO DressDailyStock (DressID, StockDate) " + days
+    );
+    DatabaseManager::bindIDs(pstmt, 1, rentalIDs);
+    DatabaseManager::runUpdate(pstmt);
+
+    pstmt = DatabaseManager::getInstance().prepare(
+        "UPDATE DressDailyStock s JOIN (SELECT DressID, StockDate, COUNT(*) AS Units FROM (" + days + ") d "
+        "                               GROUP BY DressID, StockDate) x "
+        "ON x.DressID = s.DressID AND x.StockDate = s.StockDate "
+        "SET s.Reserved = s.Reserved + x.Units"
+    );
+    DatabaseManager::bindIDs(pstmt, 1, rentalIDs);
+    DatabaseManager::runUpdate(pstmt);
+
+    pstmt = DatabaseManager::getInstance().prepare(
+        "UPDATE Rentals SET HeldThrough = CURDATE() WHERE HeldThrough < CURDATE() AND RentalID IN " + inList
+    );
+    DatabaseManager::bindIDs(pstmt, 1, rentalIDs);
+    DatabaseManager::runUpdate(pstmt);
+}
+
+bool DressStock::hold(int dressID, const std::string& firstDate, const std::string& lastDate, int units) {
+    long firstDay = 0;
+    long lastDay = 0;
+    if (!LateFeePolicy::parseDate(firstDate, firstDay) || !LateFeePolicy::parseDate(lastDate, lastDay)) return false;
+    long days = lastDay - firstDay + 1;
+    if (days < 1 || days > MAX_RANGE_DAYS) return false;
+
+    sql::PreparedStatement* pstmt = nullptr;
+    if (units > 0) {
+        pstmt = DatabaseManager::getInstance().prepare(
+            std::string("INSERT IGNORE INTO DressDailyStock (DressID, StockDate) "
+                        "SELECT ?, DATE_ADD(?, INTERVAL o.n DAY) FROM ") + DAY_OFFSETS + " o WHERE o.n < ?"
+        );
+        pstmt->setInt(1, dressID);
+        pstmt->setString(2, firstDate);
+        pstmt->setInt(3, static_cast<int>(days));
+        DatabaseManager::runUpdate(pstmt);
+    }
+
+    pstmt = DatabaseManager::getInstance().prepare(
+        "UPDATE DressDailyStock SET Reserved = GREATEST(Reserved + ?, 0) "
+        "WHERE DressID = ? AND StockDate BETWEEN ? AND ?"
+    );
+    pstmt->setInt(1, units);
+    pstmt->setInt(2, dressID);
+    pstmt->setString(3, firstDate);
+    pstmt->setString(4, lastDate);
+    DatabaseManager::runUpdate(pstmt);
+    return true;
+}
+
+int DressStock::freeUnits(int dressID, const std::string& startDate, const std::string& endDate) {
+    try {
+        sql::PreparedStatement* pstmt = DatabaseManager::getInstance().prepare(
+            "SELECT d.StockQuantity - COALESCE(MAX(s.Reserved), 0) AS FreeUnits "
+            "FROM Dresses d "
+            "LEFT JOIN DressDailyStock s ON s.DressID = d.DressID AND s.StockDate BETWEEN ? AND ? "
+            "WHERE d.DressID = ? GROUP BY d.DressID, d.StockQuantity"
+        );
+        pstmt->setString(1, startDate);
+        pstmt->setString(2, endDate);
+        pstmt->setInt(3, dressID);
+        sql::ResultSet* res = DatabaseManager::getInstance().executePreparedQuery(pstmt);
+
+        int units = 0;
+        if (res && res->next()) {
+            units = res->getInt("FreeUnits");
+            if (units < 0) units = 0;
+        }
+        delete pstmt;
+        if (res) delete res;
+        return units;
+    } catch (sql::SQLException& e) {
+        std::cerr << "Error checking stock: " << e.what() << std::endl;
+        return -1;
+    }
+}
+
+bool DressStock::getLevel(int dressID, StockLevel& level) {
+    try {
+        sql::PreparedStatement* pstmt = DatabaseManager::getInstance().prepare(
+            "SELECT DressID, DressName, StockQuantity, MinimumStockLevel, UnitsOut FROM Dresses WHERE DressID = ?"
+        );
+        pstmt->setInt(1, dressID);
+        sql::ResultSet* res = DatabaseManager::getInstance().executePreparedQuery(pstmt);
+
+        bool found = res && res->next();
+        if (found) level = readLevel(res);
+        delete pstmt;
+        if (res) delete res;
+        return found;
+    } catch (sql::SQLException& e) {
+        std::cerr << "Error getting stock level: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+bool DressStock::setStockQuantity(int dressID, int quantity, int minimumLevel) {
+    if (quantity < 0 || minimumLevel < 0) return false;
+    try {
+        // The check against existing reservations is part of the statement, so
+        // a rental booking meanwhile cannot slip under the new quantity
+        sql::PreparedStatement* pstmt = DatabaseManager::getInstance().prepare(
+            std::string("UPDATE Dresses SET StockQuantity = ?, MinimumStockLevel = ?, ") + STOCK_FLAGS +
+            " WHERE DressID = ? AND ? >= (SELECT COALESCE(MAX(Reserved), 0) FROM DressDailyStock "
+            "                            WHERE DressID = ? AND StockDate >= CURDATE())"
+        );
+        pstmt->setInt(1, quantity);
+        pstmt->setInt(2, minimumLevel);
+        pstmt->setInt(3, dressID);
+        pstmt->setInt(4, quantity);
+        pstmt->setInt(5, dressID);
+        int rows = DatabaseManager::getInstance().executePreparedUpdate(pstmt);
+        delete pstmt;
+        if (rows == 0) {
+            std::cerr << "Error: Dress ID " << dressID << " not found, or more than " << quantity
+                      << " units are already booked on some day." << std::endl;
+        }
+        return rows > 0;
+    } catch (sql::SQLException& e) {
+        std::cerr << "Error updating stock: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+std::vector<StockLevel> DressStock::getLowStock() {
+    std::vector<StockLevel> levels;
+    try {
+        sql::ResultSet* res = DatabaseManager::getInstance().executeReadSelect(
+            "SELECT DressID, DressName, StockQuantity, MinimumStockLevel, UnitsOut FROM Dresses "
+            "WHERE LowStock = TRUE ORDER BY DressID"
+        );
+        while (res && res->next()) levels.push_back(readLevel(res));
+        if (res) delete res;
+    } catch (sql::SQLException& e) {
+        std::cerr << "Error getting low stock: " << e.what() << std::endl;
+    }
+    return levels;
+}
@@ -0,0 +1,161 @@
+#include "EventLoop.h"
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+const int MAX_EVENTS = 64;
+
+} // namespace
+
+EventLoop::EventLoop() : epollFD(-1), wakeFD(-1), stopRequested(false) {}
+
+EventLoop::~EventLoop() {
+#ifdef __linux__
+    if (wakeFD >= 0) close(wakeFD);
+    if (epollFD >= 0) close(epollFD);
+#endif
+}
+
+#ifdef __linux__
+
+bool EventLoop::open() {
+    if (epollFD >= 0) return true;
+    epollFD = epoll_create1(EPOLL_CLOEXEC);
+    if (epollFD < 0) {
+        std::cerr << "epoll_create1: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    wakeFD = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wakeFD < 0) {
+        std::cerr << "eventfd: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    epoll_event event;
+    std::memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.fd = wakeFD;
+    if (epoll_ctl(epollFD, EPOLL_CTL_ADD, wakeFD, &event) != 0) {
+        std::cerr << "epoll_ctl: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool EventLoop::add(int fd, uint32_t events, Handler handler) {
+    epoll_event event;
+    std::memset(&event, 0, sizeof(event));
+    event.events = events;
+    event.data.fd = fd;
+    if (epoll_ctl(epollFD, EPOLL_CTL_ADD, fd, &event) != 0) {
+        std::cerr << "epoll_ctl add: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    handlers[fd] = std::make_shared<Handler>(std::move(handler));
+    return true;
+}
+
+bool EventLoop::modify(int fd, uint32_t events) {
+    epoll_event event;
+    std::memset(&event, 0, sizeof(event));
+    event.events = events;
+    event.data.fd = fd;
+    return epoll_ctl(epollFD, EPOLL_CTL_MOD, fd, &event) == 0;
+}
+
+void EventLoop::remove(int fd) {
+    if (handlers.erase(fd) == 0) return;
+    epoll_ctl(epollFD, EPOLL_CTL_DEL, fd, nullptr);
+}
+
+void EventLoop::wake() {
+    uint64_t one = 1;
+    ssize_t written = write(wakeFD, &one, sizeof(one));
+    (void)written;      // already pending if the counter is full
+}
+
+bool EventLoop::run() {
+    stopRequested.store(false);
+    epoll_event events[MAX_EVENTS];
+    while (!stopRequested.load()) {
+        int ready = epoll_wait(epollFD, events, MAX_EVENTS, -1);
+        if (ready < 0) {
+            if (errno == EINTR) continue;
+            std::cerr << "epoll_wait: " << std::strerror(errno) << std::endl;
+            return false;
+        }
+        for (int i = 0; i < ready; ++i) {
+            int fd = events[i].data.fd;
+            if (fd == wakeFD) {
+                uint64_t count;
+                while (read(wakeFD, &count, sizeof(count)) > 0) {
+                }
+                runPosted();
+                continue;
+            }
+            // An earlier handler in this batch may have removed this one
+            std::unordered_map<int, std::shared_ptr<Handler>>::iterator found = handlers.find(fd);
+            if (found == handlers.end()) continue;
+            std::shared_ptr<Handler> handler = found->second;
+            (*handler)(events[i].events);
+        }
+    }
+    runPosted();
+    return true;
+}
+
+#else
+
+bool EventLoop::open() {
+    std::cerr << "The event loop needs epoll, which this platform does not have." << std::endl;
+    return false;
+}
+
+bool EventLoop::add(int, uint32_t, Handler) {
+    return false;
+}
+
+bool EventLoop::modify(int, uint32_t) {
+    return false;
+}
+
+void EventLoop::remove(int fd) {
+    handlers.erase(fd);
+}
+
+void EventLoop::wake() {}
+
+bool EventLoop::run() {
+    return false;
+}
+
+#endif
+
+void EventLoop::post(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(postedMutex);
+        posted.push_back(std::move(task));
+    }
+    wake();
+}
+
+void EventLoop::stop() {
+    stopRequested.store(true);
+    wake();
+}
+
+void EventLoop::runPosted() {
+    std::vector<std::function<void()>> tasks;
+    {
+        std::lock_guard<std::mutex> lock(postedMutex);
+        tasks.swap(posted);
+    }
+    for (size_t i = 0; i < tasks.size(); ++i) tasks[i]();
+}
@@ -0,0 +1,119 @@
+#include "Format.h"
+#include <cmath>
+#include <cstdio>
+
+namespace {
+
+const long long POW10[] = { 1LL, 10LL, 100LL, 1000LL, 10000LL, 100000LL, 1000000LL };
+
+// Writes magnitude with a decimal point before the last decimals digits,
+// keeping at least one whole digit
+size_t writeScaled(char* buffer, bool negative, unsigned long long magnitude, int decimals) {
+    char reversed[Format::MAX_TEXT];
+    size_t count = 0;
+    for (int i = 0; i < decimals; ++i) {
+        reversed[count++] = static_cast<char>('0' + magnitude % 10);
+        magnitude /= 10;
+    }
+    if (decimals > 0) reversed[count++] = '.';
+    do {
+        reversed[count++] = static_cast<char>('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude != 0);
+
+    size_t length = 0;
+    if (negative) buffer[length++] = '-';
+    while (count > 0) buffer[length++] = reversed[--count];
+    return length;
+}
+
+void writeTwoDigits(char* buffer, int value) {
+    buffer[0] = static_cast<char>('0' + value / 10 % 10);
+    buffer[1] = static_cast<char>('0' + value % 10);
+}
+
+} // namespace
+
+size_t Format::integer(char* buffer, long long value) {
+    unsigned long long magnitude = value < 0 ? 0ULL - static_cast<unsigned long long>(value)
+                                             : static_cast<unsigned long long>(value);
+    return writeScaled(buffer, value < 0, magnitude, 0);
+}
+
+size_t Format::fixed(char* buffer, double value, int decimals) {
+    if (decimals < 0) decimals = 0;
+    if (decimals > 6) decimals = 6;
+    double scaled = value * POW10[decimals];
+    if (!std::isfinite(scaled) || std::fabs(scaled) >= 9e18) {
+        int length = std::snprintf(buffer, MAX_TEXT, "%.*f", decimals, value);
+        if (length < 0) return 0;
+        return static_cast<size_t>(length) < MAX_TEXT ? static_cast<size_t>(length) : MAX_TEXT - 1;
+    }
+
+    long long rounded = std::llround(scaled);
+    unsigned long long magnitude = rounded < 0 ? 0ULL - static_cast<unsigned long long>(rounded)
+                                               : static_cast<unsigned long long>(rounded);
+    return writeScaled(buffer, rounded < 0, magnitude, decimals);
+}
+
+size_t Format::date(char* buffer, int year, int month, int day) {
+    writeTwoDigits(buffer, year / 100);
+    writeTwoDigits(buffer + 2, year);
+    buffer[4] = '-';
+    writeTwoDigits(buffer + 5, month);
+    buffer[7] = '-';
+    writeTwoDigits(buffer + 8, day);
+    return 10;
+}
+
+size_t Format::date(char* buffer, const std::tm& time) {
+    return date(buffer, time.tm_year + 1900, time.tm_mon + 1, time.tm_mday);
+}
+
+std::string Format::integer(long long value) {
+    char buffer[MAX_TEXT];
+    return std::string(buffer, integer(buffer, value));
+}
+
+std::string Format::fixed(double value, int decimals) {
+    char buffer[MAX_TEXT];
+    return std::string(buffer, fixed(buffer, value, decimals));
+}
+
+std::string Format::date(const std::tm& time) {
+    char buffer[MAX_TEXT];
+    return std::string(buffer, date(buffer, time));
+}
+
+void Format::appendInteger(std::string& out, long long value, int width) {
+    char buffer[MAX_TEXT];
+    appendRight(out, buffer, integer(buffer, value), width);
+}
+
+void Format::appendFixed(std::string& out, double value, int decimals, int width) {
+    char buffer[MAX_TEXT];
+    appendRight(out, buffer, fixed(buffer, value, decimals), width);
+}
+
+void Format::appendMoney(std::string& out, Money amount, int width) {
+    char buffer[Money::MAX_TEXT];
+    appendRight(out, buffer, amount.format(buffer), width);
+}
+
+void Format::appendRight(std::string& out, const char* text, size_t length, int width) {
+    if (width > 0 && static_cast<size_t>(width) > length) out.append(width - length, ' ');
+    out.append(text, length);
+}
+
+void Format::appendRight(std::string& out, const std::string& text, int width) {
+    appendRight(out, text.data(), text.size(), width);
+}
+
+void Format::appendLeft(std::string& out, const char* text, size_t length, int width) {
+    out.append(text, length);
+    if (width > 0 && static_cast<size_t>(width) > length) out.append(width - length, ' ');
+}
+
+void Format::appendLeft(std::string& out, const std::string& text, int width) {
+    appendLeft(out, text.data(), text.size(), width);
+}
@@ -0,0 +1,1252 @@
+#include "HttpServer.h"
+#include "AppConfig.h"
+#include "CustomerManager.h"
+#include "DressManager.h"
+#include "Format.h"
+#include "Json.h"
+#include "LateFeePolicy.h"
+#include "PaymentManager.h"
+#include "RentalManager.h"
+#include "RentalServer.h"
+#include "ReportManager.h"
+#include "Trace.h"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <iostream>
+#include <vector>
+
+#ifdef __linux__
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/random.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+struct HttpServer::Connection {
+    // A buffer queued for writing; cached bodies are shared, not copied
+    struct Segment {
+        std::shared_ptr<const std::string> data;
+        size_t offset;
+    };
+
+    int fd;
+    std::string input;
+    size_t inputStart;              // bytes of input already parsed
+    std::deque<Segment> output;
+    size_t queuedBytes;
+    bool busy;                      // a request is on a worker
+    bool closing;                   // close once output is written
+    bool closed;
+    bool watchingWrites;
+    explicit Connection(int fd)
+        : fd(fd), inputStart(0), queuedBytes(0), busy(false), closing(false), closed(false), watchingWrites(false) {}
+};
+
+namespace {
+
+const size_t MAX_HEADER = 8192;
+const size_t MAX_BODY = 64 * 1024;
+// Unparsed input a connection may hold, pipelined requests included
+const size_t MAX_INPUT = 256 * 1024;
+// Responses queued for a slow reader before its next requests wait
+const size_t MAX_QUEUED = 1024 * 1024;
+const size_t MAX_CACHED = 4096;
+const size_t DEFAULT_LIMIT = 50;
+const size_t MAX_LIMIT = 200;
+const size_t MAX_FREE_IDS = 5000;
+const int MAX_IOV = 64;
+
+const char* statusText(int status) {
+    switch (status) {
+        case 200: return "OK";
+        case 201: return "Created";
+        case 400: return "Bad Request";
+        case 401: return "Unauthorized";
+        case 403: return "Forbidden";
+        case 404: return "Not Found";
+        case 405: return "Method Not Allowed";
+        case 409: return "Conflict";
+        case 413: return "Payload Too Large";
+        case 431: return "Request Header Fields Too Large";
+        case 501: return "Not Implemented";
+        case 503: return "Service Unavailable";
+        case 505: return "HTTP Version Not Supported";
+        default: return "Internal Server Error";
+    }
+}
+
+void reply(HttpServer::Response& response, int status, const std::string& body) {
+    response.status = status;
+    response.body = std::make_shared<const std::string>(body);
+}
+
+void fail(HttpServer::Response& response, int status, const std::string& message) {
+    response.cacheable = false;
+    reply(response, status, Json::error(message));
+}
+
+std::string lower(std::string text) {
+    for (size_t i = 0; i < text.size(); ++i) text[i] = static_cast<char>(std::tolower(static_cast<unsigned char>(text[i])));
+    return text;
+}
+
+std::string trim(const std::string& text) {
+    size_t first = text.find_first_not_of(" \t");
+    if (first == std::string::npos) return "";
+    return text.substr(first, text.find_last_not_of(" \t") - first + 1);
+}
+
+int hexValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+std::string percentDecode(const std::string& text) {
+    std::string out;
+    out.reserve(text.size());
+    for (size_t i = 0; i < text.size(); ++i) {
+        if (text[i] == '+') {
+            out += ' ';
+        } else if (text[i] == '%' && i + 2 < text.size() && hexValue(text[i + 1]) >= 0 && hexValue(text[i + 2]) >= 0) {
+            out += static_cast<char>(hexValue(text[i + 1]) * 16 + hexValue(text[i + 2]));
+            i += 2;
+        } else {
+            out += text[i];
+        }
+    }
+    return out;
+}
+
+bool parsePositive(const std::string& text, long maximum, long& value) {
+    char* end = nullptr;
+    value = std::strtol(text.c_str(), &end, 10);
+    return !text.empty() && *end == '\0' && value > 0 && value <= maximum;
+}
+
+// The value of an optional parameter, or fallback
+std::string param(const HttpServer::Request& request, const char* name, const std::string& fallback = "") {
+    std::map<std::string, std::string>::const_iterator found = request.query.find(name);
+    return found == request.query.end() ? fallback : found->second;
+}
+
+// "limit" within 1..maximum; false if present and invalid
+bool readLimit(const HttpServer::Request& request, size_t fallback, size_t maximum, size_t& limit) {
+    std::string text = param(request, "limit");
+    limit = fallback;
+    if (text.empty()) return true;
+    long value = 0;
+    if (!parsePositive(text, static_cast<long>(maximum), value)) return false;
+    limit = static_cast<size_t>(value);
+    return true;
+}
+
+std::vector<std::string> splitPath(const std::string& path) {
+    std::vector<std::string> parts;
+    size_t start = 1;
+    while (start <= path.size()) {
+        size_t slash = path.find('/', start);
+        if (slash == std::string::npos) slash = path.size();
+        if (slash > start) parts.push_back(path.substr(start, slash - start));
+        start = slash + 1;
+    }
+    return parts;
+}
+
+void appendDress(std::string& out, const Dress& dress) {
+    out += '{';
+    Json::appendKey(out, "id", true);
+    Json::appendInteger(out, dress.DressID);
+    Json::appendKey(out, "name");
+    Json::appendString(out, dress.DressName);
+    Json::appendKey(out, "category");
+    Json::appendString(out, dress.Category);
+    Json::appendKey(out, "size");
+    Json::appendString(out, dress.Size);
+    Json::appendKey(out, "color");
+    Json::appendString(out, dress.Color);
+    Json::appendKey(out, "price");
+    Json::appendMoney(out, dress.RentalPrice);
+    Json::appendKey(out, "condition");
+    Json::appendString(out, dress.ConditionStatus);
+    Json::appendKey(out, "availability");
+    Json::appendString(out, dress.AvailabilityStatus);
+    Json::appendKey(out, "cleaning");
+    Json::appendString(out, dress.CleaningStatus);
+    out += '}';
+}
+
+void appendCustomer(std::string& out, const Customer& customer) {
+    out += '{';
+    Json::appendKey(out, "id", true);
+    Json::appendInteger(out, customer.CustomerID);
+    Json::appendKey(out, "name");
+    Json::appendString(out, customer.Name);
+    Json::appendKey(out, "icNumber");
+    Json::appendString(out, customer.IC_Number);
+    Json::appendKey(out, "phone");
+    Json::appendString(out, customer.Phone);
+    Json::appendKey(out, "email");
+    Json::appendString(out, customer.Email);
+    out += '}';
+}
+
+std::string renderRental(const RentalView& view) {
+    const Rental& rental = view.rental;
+    std::string out = "{";
+    Json::appendKey(out, "rentalID", true);
+    Json::appendInteger(out, rental.RentalID);
+    Json::appendKey(out, "customerID");
+    Json::appendInteger(out, rental.CustomerID);
+    Json::appendKey(out, "customerName");
+    Json::appendString(out, view.customer.Name);
+    Json::appendKey(out, "status");
+    Json::appendString(out, rental.Status);
+    Json::appendKey(out, "rentalDate");
+    Json::appendString(out, rental.RentalDate);
+    Json::appendKey(out, "dueDate");
+    Json::appendString(out, rental.DueDate);
+    Json::appendKey(out, "returnDate");
+    if (rental.ReturnDate.empty()) {
+        out += "null";
+    } else {
+        Json::appendString(out, rental.ReturnDate);
+    }
+    Json::appendKey(out, "total");
+    Json::appendMoney(out, rental.TotalAmount);
+    Json::appendKey(out, "lateFee");
+    Json::appendMoney(out, rental.LateFee);
+    Json::appendKey(out, "paid");
+    Json::appendMoney(out, view.TotalPaid);
+    Json::appendKey(out, "payments");
+    Json::appendInteger(out, view.PaymentCount);
+    Json::appendKey(out, "items");
+    out += '[';
+    for (size_t i = 0; i < view.items.size(); ++i) {
+        if (i > 0) out += ',';
+        out += '{';
+        Json::appendKey(out, "dressID", true);
+        Json::appendInteger(out, view.items[i].DressID);
+        Json::appendKey(out, "name");
+        Json::appendString(out, view.items[i].DressName);
+        Json::appendKey(out, "price");
+        Json::appendMoney(out, view.items[i].RentalPrice);
+        out += '}';
+    }
+    out += "]}";
+    return out;
+}
+
+// GET /api/reports/<name>; false if there is no such report
+bool renderReport(const std::string& name, const HttpServer::Request& request, HttpServer::Response& response) {
+    ReportManager reports;
+    std::string out = "[";
+    if (name == "monthly-sales") {
+        std::string year = param(request, "year", LateFeePolicy::today().substr(0, 4));
+        long number = 0;
+        if (year.size() != 4 || !parsePositive(year, 9999, number)) {
+            fail(response, 400, "year must be YYYY");
+            return true;
+        }
+        std::vector<MonthlySales> rows = reports.getMonthlySales(year);
+        for (size_t i = 0; i < rows.size(); ++i) {
+            out += i > 0 ? ",{" : "{";
+            Json::appendKey(out, "month", true);
+            Json::appendString(out, rows[i].Month);
+            Json::appendKey(out, "totalSales");
+            Json::appendMoney(out, rows[i].TotalSales);
+            Json::appendKey(out, "rentalCount");
+            Json::appendInteger(out, rows[i].RentalCount);
+            out += '}';
+        }
+    } else if (name == "inventory") {
+        std::vector<InventoryValuation> rows = reports.getInventoryValuation();
+        for (size_t i = 0; i < rows.size(); ++i) {
+            out += i > 0 ? ",{" : "{";
+            Json::appendKey(out, "category", true);
+            Json::appendString(out, rows[i].Category);
+            Json::appendKey(out, "dressCount");
+            Json::appendInteger(out, rows[i].DressCount);
+            Json::appendKey(out, "totalValue");
+            Json::appendMoney(out, rows[i].TotalValue);
+            Json::appendKey(out, "averagePrice");
+            Json::appendMoney(out, rows[i].AveragePrice);
+            out += '}';
+        }
+    } else if (name == "utilization") {
+        std::vector<DressUtilization> rows = reports.getDressUtilization();
+        for (size_t i = 0; i < rows.size(); ++i) {
+            out += i > 0 ? ",{" : "{";
+            Json::appendKey(out, "dressID", true);
+            Json::appendInteger(out, rows[i].DressID);
+            Json::appendKey(out, "name");
+            Json::appendString(out, rows[i].DressName);
+            Json::appendKey(out, "rentalCount");
+            Json::appendInteger(out, rows[i].RentalCount);
+            Json::appendKey(out, "utilizationRate");
+            Format::appendFixed(out, rows[i].UtilizationRate, 2);
+            out += '}';
+        }
+    } else if (name == "customer-activity") {
+        std::vector<CustomerActivity> rows = reports.getCustomerActivity();
+        for (size_t i = 0; i < rows.size(); ++i) {
+            out += i > 0 ? ",{" : "{";
+            Json::appendKey(out, "customerID", true);
+            Json::appendInteger(out, rows[i].CustomerID);
+            Json::appendKey(out, "name");
+            Json::appendString(out, rows[i].CustomerName);
+            Json::appendKey(out, "totalRentals");
+            Json::appendInteger(out, rows[i].TotalRentals);
+            Json::appendKey(out, "totalSpent");
+            Json::appendMoney(out, rows[i].TotalSpent);
+            Json::appendKey(out, "averageRental");
+            Json::appendMoney(out, rows[i].AverageRental);
+            out += '}';
+        }
+    } else {
+        return false;
+    }
+    out += ']';
+    reply(response, 200, out);
+    return true;
+}
+
+// Fills out with bytes from the kernel's CSPRNG, falling back to /dev/urandom
+// where getrandom() is missing; false if neither works
+bool randomBytes(unsigned char* out, size_t length) {
+    size_t filled = 0;
+    while (filled < length) {
+        ssize_t got = getrandom(out + filled, length - filled, 0);
+        if (got < 0 && errno == EINTR) continue;
+        if (got < 0) break;
+        filled += static_cast<size_t>(got);
+    }
+    if (filled == length) return true;
+
+    int fd = open("/dev/urandom", O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+    while (filled < length) {
+        ssize_t got = read(fd, out + filled, length - filled);
+        if (got < 0 && errno == EINTR) continue;
+        if (got <= 0) break;
+        filled += static_cast<size_t>(got);
+    }
+    close(fd);
+    return filled == length;
+}
+
+} // namespace
+
+HttpServer::HttpServer(const std::string& address, int port, int workerCount)
+    : address(address), port(port), workerCount(workerCount > 0 ? workerCount : 1), listenFD(-1),
+      catalog(RentalServer::cacheSecondsFromConfig()), calendar(RentalServer::cacheSecondsFromConfig()),
+      cacheSeconds(RentalServer::cacheSecondsFromConfig()),
+      sessionLength(std::max(1, AppConfig::getInstance().getInt("http_session_minutes", 480))) {
+    stats.connectionsAccepted = 0;
+    stats.connectionsOpen = 0;
+    stats.requests = 0;
+    stats.cacheHits = 0;
+    stats.errors = 0;
+    stats.workers = this->workerCount;
+    stats.workersBusy = 0;
+    stats.requestsQueued = 0;
+    stats.cachedResponses = 0;
+}
+
+HttpServer::~HttpServer() {
+    workers.stop();
+#ifdef __linux__
+    if (listenFD >= 0) close(listenFD);
+#endif
+}
+
+std::string HttpServer::addressFromConfig() {
+    return AppConfig::getInstance().getString("http_address", "127.0.0.1");
+}
+
+int HttpServer::portFromConfig() {
+    return AppConfig::getInstance().getInt("http_port", 8080);
+}
+
+HttpServer::Stats HttpServer::getStats() {
+    Stats current;
+    {
+        std::lock_guard<std::mutex> lock(statsMutex);
+        current = stats;
+    }
+    current.workersBusy = workers.busy();
+    current.requestsQueued = workers.queued();
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    current.cachedResponses = responseCache.size();
+    return current;
+}
+
+void HttpServer::stop() {
+    loop.stop();
+}
+
+long HttpServer::parseRequest(const char* data, size_t size, Request& request, int& errorStatus) {
+    static const char TERMINATOR[] = "\r\n\r\n";
+    const char* headerEnd = std::search(data, data + size, TERMINATOR, TERMINATOR + 4);
+    if (headerEnd == data + size) {
+        if (size > MAX_HEADER) {
+            errorStatus = 431;
+            return -1;
+        }
+        return 0;
+    }
+    size_t headerLength = static_cast<size_t>(headerEnd - data) + 4;
+    if (headerLength > MAX_HEADER) {
+        errorStatus = 431;
+        return -1;
+    }
+
+    // Request line: METHOD SP target SP version
+    errorStatus = 400;
+    const char* lineEnd = std::search(data, headerEnd + 2, TERMINATOR, TERMINATOR + 2);
+    std::string line(data, lineEnd);
+    size_t firstSpace = line.find(' ');
+    size_t secondSpace = firstSpace == std::string::npos ? std::string::npos : line.find(' ', firstSpace + 1);
+    if (secondSpace == std::string::npos) return -1;
+    request.method = line.substr(0, firstSpace);
+    std::string target = line.substr(firstSpace + 1, secondSpace - firstSpace - 1);
+    std::string version = line.substr(secondSpace + 1);
+    if (version != "HTTP/1.1" && version != "HTTP/1.0") {
+        if (version.compare(0, 5, "HTTP/") == 0) errorStatus = 505;
+        return -1;
+    }
+    if (request.method.empty() || target.empty() || target[0] != '/') return -1;
+    request.keepAlive = version == "HTTP/1.1";
+    request.authorization.clear();
+    request.body.clear();
+    request.query.clear();
+
+    size_t contentLength = 0;
+    const char* cursor = lineEnd + 2;
+    while (cursor < headerEnd + 2) {
+        const char* next = std::search(cursor, headerEnd + 2, TERMINATOR, TERMINATOR + 2);
+        const char* colon = std::find(cursor, next, ':');
+        if (colon == next) return -1;
+        std::string name = lower(std::string(cursor, colon));
+        std::string value = trim(std::string(colon + 1, next));
+        if (name == "content-length") {
+            long length = 0;
+            if (value != "0" && !parsePositive(value, 2147483647L, length)) return -1;
+            if (static_cast<size_t>(length) > MAX_BODY) {
+                errorStatus = 413;
+                return -1;
+            }
+            contentLength = static_cast<size_t>(length);
+        } else if (name == "transfer-encoding") {
+            // Chunked request bodies are not supported; clients send Content-Length
+            errorStatus = 501;
+            return -1;
+        } else if (name == "connection") {
+            std::string option = lower(value);
+            if (option.find("close") != std::string::npos) request.keepAlive = false;
+            if (option.find("keep-alive") != std::string::npos) request.keepAlive = true;
+        } else if (name == "authorization") {
+            request.authorization = value;
+        }
+        cursor = next + 2;
+    }
+    if (size - headerLength < contentLength) return 0;
+    request.body.assign(data + headerLength, contentLength);
+
+    size_t question = target.find('?');
+    request.path = target.substr(0, question);
+    if (question != std::string::npos) {
+        size_t start = question + 1;
+        while (start < target.size()) {
+            size_t amp = target.find('&', start);
+            if (amp == std::string::npos) amp = target.size();
+            std::string pair = target.substr(start, amp - start);
+            size_t equals = pair.find('=');
+            if (!pair.empty()) {
+                request.query[percentDecode(pair.substr(0, equals))] =
+                    equals == std::string::npos ? "" : percentDecode(pair.substr(equals + 1));
+            }
+            start = amp + 1;
+        }
+    }
+    return static_cast<long>(headerLength + contentLength);
+}
+
+std::string HttpServer::renderDresses(const DressCatalog& catalog, const DressCatalog::Query& query, size_t limit) {
+    DressCatalog::Result result = catalog.search(query, limit);
+    std::string out = "{";
+    Json::appendKey(out, "total", true);
+    Json::appendInteger(out, static_cast<long long>(result.total));
+    Json::appendKey(out, "dresses");
+    out += '[';
+    Dress dress;
+    for (size_t i = 0; i < result.dressIDs.size(); ++i) {
+        if (!catalog.getDress(result.dressIDs[i], dress)) continue;
+        if (out[out.size() - 1] != '[') out += ',';
+        appendDress(out, dress);
+    }
+    out += "]";
+    Json::appendKey(out, "facets");
+    out += '{';
+    for (int f = 0; f < DressCatalog::FACET_COUNT; ++f) {
+        Json::appendKey(out, DressCatalog::facetName(static_cast<DressCatalog::Facet>(f)), f == 0);
+        out += '[';
+        const std::vector<DressCatalog::FacetCount>& counts = result.facets[f];
+        for (size_t i = 0; i < counts.size(); ++i) {
+            out += i > 0 ? ",{" : "{";
+            Json::appendKey(out, "value", true);
+            Json::appendString(out, counts[i].value);
+            Json::appendKey(out, "count");
+            Json::appendInteger(out, static_cast<long long>(counts[i].count));
+            out += '}';
+        }
+        out += ']';
+    }
+    out += "}}";
+    return out;
+}
+
+std::string HttpServer::cacheKey(const Request& request, bool& usesCalendar) {
+    usesCalendar = false;
+    if (request.method != "GET") return "";
+    if (request.path == "/api/availability") {
+        usesCalendar = true;
+    } else if (request.path == "/api/dresses") {
+        // Text search goes to the database every time
+        if (request.query.count("q")) return "";
+    } else if (request.path.compare(0, 13, "/api/dresses/") != 0) {
+        return "";
+    }
+    // Parameters are sorted, so the same query always gets the same key
+    std::string key = request.path;
+    for (std::map<std::string, std::string>::const_iterator it = request.query.begin(); it != request.query.end(); ++it) {
+        key += it == request.query.begin() ? '?' : '&';
+        key += it->first;
+        key += '=';
+        key += it->second;
+    }
+    return key;
+}
+
+bool HttpServer::lookupCache(const Request& request, Response& response) {
+    bool usesCalendar = false;
+    std::string key = cacheKey(request, usesCalendar);
+    if (key.empty()) return false;
+    unsigned long generation = usesCalendar ? calendar.currentGeneration() : catalog.currentGeneration();
+    if (generation == 0) return false;
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    std::unordered_map<std::string, CachedBody>::const_iterator found = responseCache.find(key);
+    if (found == responseCache.end() || found->second.generation != generation) return false;
+    response.status = 200;
+    response.body = found->second.body;
+    response.cacheable = true;
+    return true;
+}
+
+void HttpServer::storeCache(const Request& request, const Response& response, unsigned long generation) {
+    bool usesCalendar = false;
+    std::string key = cacheKey(request, usesCalendar);
+    if (key.empty() || response.status != 200 || !response.cacheable) return;
+    CachedBody cached;
+    cached.body = response.body;
+    cached.generation = generation;
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    // Bounded by dropping everything; the popular pages come straight back
+    if (responseCache.size() >= MAX_CACHED) responseCache.clear();
+    responseCache[key] = cached;
+}
+
+#ifdef __linux__
+
+bool HttpServer::start() {
+    sockaddr_in socketAddress;
+    std::memset(&socketAddress, 0, sizeof(socketAddress));
+    socketAddress.sin_family = AF_INET;
+    socketAddress.sin_port = htons(static_cast<uint16_t>(port));
+    if (port <= 0 || port > 65535 || inet_pton(AF_INET, address.c_str(), &socketAddress.sin_addr) != 1) {
+        std::cerr << "Invalid HTTP address " << address << ":" << port << std::endl;
+        return false;
+    }
+    listenFD = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    int on = 1;
+    if (listenFD >= 0) setsockopt(listenFD, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+    if (listenFD < 0 || bind(listenFD, reinterpret_cast<sockaddr*>(&socketAddress), sizeof(socketAddress)) != 0 ||
+        listen(listenFD, SOMAXCONN) != 0) {
+        std::cerr << "Cannot listen on " << address << ":" << port << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    if (!loop.open() || !loop.add(listenFD, EPOLLIN, [this](uint32_t) { onAccept(); })) return false;
+    workers.start(workerCount);
+    return true;
+}
+
+void HttpServer::run() {
+    loop.run();
+
+    std::vector<std::shared_ptr<Connection>> open;
+    for (std::unordered_map<int, std::shared_ptr<Connection>>::iterator it = connections.begin();
+         it != connections.end(); ++it) {
+        open.push_back(it->second);
+    }
+    for (size_t i = 0; i < open.size(); ++i) closeConnection(open[i]);
+    workers.stop();
+    loop.remove(listenFD);
+    close(listenFD);
+    listenFD = -1;
+}
+
+void HttpServer::onAccept() {
+    while (true) {
+        int fd = accept4(listenFD, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR) continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK) std::cerr << "accept: " << std::strerror(errno) << std::endl;
+            return;
+        }
+        // Responses go out whole in one sendmsg; don't hold their tails back
+        int on = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+        std::shared_ptr<Connection> connection = std::make_shared<Connection>(fd);
+        if (!loop.add(fd, EPOLLIN, [this, connection](uint32_t events) { onEvent(connection, events); })) {
+            close(fd);
+            continue;
+        }
+        connections[fd] = connection;
+        std::lock_guard<std::mutex> lock(statsMutex);
+        stats.connectionsAccepted++;
+        stats.connectionsOpen++;
+    }
+}
+
+void HttpServer::onEvent(const std::shared_ptr<Connection>& connection, uint32_t events) {
+    if (events & EPOLLERR) {
+        closeConnection(connection);
+        return;
+    }
+    if ((events & EPOLLOUT) && !flush(connection)) return;
+    if (events & (EPOLLIN | EPOLLHUP)) {
+        char buffer[16384];
+        while (true) {
+            ssize_t received = recv(connection->fd, buffer, sizeof(buffer), 0);
+            if (received > 0) {
+                connection->input.append(buffer, static_cast<size_t>(received));
+                if (connection->input.size() - connection->inputStart > MAX_INPUT) {
+                    closeConnection(connection);
+                    return;
+                }
+                continue;
+            }
+            if (received < 0 && errno == EINTR) continue;
+            if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+            closeConnection(connection);
+            return;
+        }
+    }
+    dispatch(connection);
+}
+
+void HttpServer::dispatch(const std::shared_ptr<Connection>& connection) {
+    // Pipelined requests are answered in order: cached ones straight away,
+    // the next uncached one on a worker, and the rest wait for it
+    while (!connection->closed && !connection->closing && !connection->busy &&
+           connection->queuedBytes < MAX_QUEUED) {
+        Request request;
+        int errorStatus = 400;
+        long used = parseRequest(connection->input.data() + connection->inputStart,
+                                 connection->input.size() - connection->inputStart, request, errorStatus);
+        if (used == 0) break;
+        if (used < 0) {
+            Response response;
+            fail(response, errorStatus, statusText(errorStatus));
+            queueResponse(connection, response, false);
+            break;
+        }
+        connection->inputStart += static_cast<size_t>(used);
+
+        Response response;
+        if (lookupCache(request, response)) {
+            {
+                std::lock_guard<std::mutex> lock(statsMutex);
+                stats.cacheHits++;
+            }
+            queueResponse(connection, response, request.keepAlive);
+            continue;
+        }
+
+        connection->busy = true;
+        workers.submit([this, connection, request]() {
+            Response response;
+            response.cacheable = false;
+            try {
+                handle(request, response);
+            } catch (const std::exception& e) {
+                std::cerr << "HTTP " << request.method << " " << request.path << " failed: " << e.what() << std::endl;
+                fail(response, 500, "Internal error");
+            }
+            bool keepAlive = request.keepAlive;
+            loop.post([this, connection, response, keepAlive]() {
+                connection->busy = false;
+                if (connection->closed) return;
+                queueResponse(connection, response, keepAlive);
+                dispatch(connection);
+            });
+        });
+    }
+    if (connection->inputStart > 0 && !connection->closed) {
+        connection->input.erase(0, connection->inputStart);
+        connection->inputStart = 0;
+    }
+    flush(connection);
+}
+
+void HttpServer::queueResponse(const std::shared_ptr<Connection>& connection, const Response& response,
+                               bool keepAlive) {
+    size_t length = response.body ? response.body->size() : 0;
+    std::string header = "HTTP/1.1 ";
+    Format::appendInteger(header, response.status);
+    header += ' ';
+    header += statusText(response.status);
+    header += "\r\nContent-Type: application/json\r\nContent-Length: ";
+    Format::appendInteger(header, static_cast<long long>(length));
+    if (response.cacheable) {
+        header += "\r\nCache-Control: public, max-age=";
+        Format::appendInteger(header, cacheSeconds);
+    } else {
+        header += "\r\nCache-Control: no-store";
+    }
+    header += keepAlive ? "\r\nConnection: keep-alive\r\n\r\n" : "\r\nConnection: close\r\n\r\n";
+
+    Connection::Segment segment;
+    segment.offset = 0;
+    segment.data = std::make_shared<const std::string>(header);
+    connection->output.push_back(segment);
+    connection->queuedBytes += header.size();
+    if (length > 0) {
+        segment.data = response.body;
+        connection->output.push_back(segment);
+        connection->queuedBytes += length;
+    }
+    if (!keepAlive) connection->closing = true;
+
+    std::lock_guard<std::mutex> lock(statsMutex);
+    stats.requests++;
+    if (response.status >= 400) stats.errors++;
+}
+
+bool HttpServer::flush(const std::shared_ptr<Connection>& connection) {
+    if (connection->closed) return false;
+    while (!connection->output.empty()) {
+        iovec parts[MAX_IOV];
+        int count = 0;
+        for (std::deque<Connection::Segment>::const_iterator it = connection->output.begin();
+             it != connection->output.end() && count < MAX_IOV; ++it) {
+            parts[count].iov_base = const_cast<char*>(it->data->data() + it->offset);
+            parts[count].iov_len = it->data->size() - it->offset;
+            ++count;
+        }
+        msghdr message;
+        std::memset(&message, 0, sizeof(message));
+        message.msg_iov = parts;
+        message.msg_iovlen = static_cast<size_t>(count);
+        ssize_t sent = sendmsg(connection->fd, &message, MSG_NOSIGNAL);
+        if (sent < 0 && errno == EINTR) continue;
+        if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            if (!connection->watchingWrites) {
+                loop.modify(connection->fd, EPOLLIN | EPOLLOUT);
+                connection->watchingWrites = true;
+            }
+            return true;
+        }
+        if (sent < 0) {
+            closeConnection(connection);
+            return false;
+        }
+        size_t left = static_cast<size_t>(sent);
+        connection->queuedBytes -= left;
+        while (left > 0) {
+            Connection::Segment& front = connection->output.front();
+            size_t remaining = front.data->size() - front.offset;
+            if (left < remaining) {
+                front.offset += left;
+                break;
+            }
+            left -= remaining;
+            connection->output.pop_front();
+        }
+    }
+    if (connection->watchingWrites) {
+        loop.modify(connection->fd, EPOLLIN);
+        connection->watchingWrites = false;
+    }
+    if (connection->closing && !connection->busy) {
+        closeConnection(connection);
+        return false;
+    }
+    return true;
+}
+
+void HttpServer::closeConnection(const std::shared_ptr<Connection>& connection) {
+    if (connection->closed) return;
+    connection->closed = true;
+    loop.remove(connection->fd);
+    close(connection->fd);
+    connections.erase(connection->fd);
+    std::lock_guard<std::mutex> lock(statsMutex);
+    stats.connectionsOpen--;
+}
+
+#else
+
+bool HttpServer::start() {
+    std::cerr << "The HTTP server needs Linux (epoll)." << std::endl;
+    return false;
+}
+
+void HttpServer::run() {}
+void HttpServer::onAccept() {}
+void HttpServer::onEvent(const std::shared_ptr<Connection>&, uint32_t) {}
+void HttpServer::dispatch(const std::shared_ptr<Connection>&) {}
+void HttpServer::queueResponse(const std::shared_ptr<Connection>&, const Response&, bool) {}
+bool HttpServer::flush(const std::shared_ptr<Connection>&) { return false; }
+void HttpServer::closeConnection(const std::shared_ptr<Connection>&) {}
+
+#endif
+
+bool HttpServer::authenticate(const Request& request, User& user) {
+    if (request.authorization.compare(0, 7, "Bearer ") != 0) return false;
+    std::string token = trim(request.authorization.substr(7));
+    int userID = 0;
+    {
+        std::lock_guard<std::mutex> lock(sessionsMutex);
+        std::unordered_map<std::string, Session>::iterator found = sessions.find(token);
+        if (found == sessions.end()) return false;
+        if (found->second.expiresAt <= std::chrono::steady_clock::now()) {
+            sessions.erase(found);
+            return false;
+        }
+        userID = found->second.user.UserID;
+    }
+
+    // The account may have been deactivated or its role changed since login;
+    // the lookup runs outside the lock so sessions do not wait on the database
+    User current;
+    bool active = AuthManager::reloadUser(userID, current);
+    std::lock_guard<std::mutex> lock(sessionsMutex);
+    std::unordered_map<std::string, Session>::iterator found = sessions.find(token);
+    if (found == sessions.end()) return false;
+    if (!active) {
+        sessions.erase(found);
+        return false;
+    }
+    found->second.user = current;
+    found->second.expiresAt = std::chrono::steady_clock::now() + sessionLength;
+    user = current;
+    return true;
+}
+
+void HttpServer::handleLogin(const Request& request, Response& response) {
+    std::map<std::string, std::string> fields;
+    if (!Json::parseObject(request.body, fields) || !fields.count("username") || !fields.count("password")) {
+        fail(response, 400, "Expected {\"username\": ..., \"password\": ...}");
+        return;
+    }
+    User user;
+    if (!AuthManager::authenticate(fields["username"], fields["password"], user)) {
+        fail(response, 401, "Invalid username or password");
+        return;
+    }
+
+    // 128 random bits, hex-encoded
+    static const char HEX[] = "0123456789abcdef";
+    unsigned char bytes[16];
+    if (!randomBytes(bytes, sizeof(bytes))) {
+        fail(response, 500, "Could not create a session");
+        return;
+    }
+    std::string token;
+    for (size_t i = 0; i < sizeof(bytes); ++i) {
+        token += HEX[bytes[i] >> 4];
+        token += HEX[bytes[i] & 0xF];
+    }
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    {
+        std::lock_guard<std::mutex> lock(sessionsMutex);
+        for (std::unordered_map<std::string, Session>::iterator it = sessions.begin(); it != sessions.end();) {
+            if (it->second.expiresAt <= now) {
+                it = sessions.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        Session session;
+        session.user = user;
+        session.expiresAt = now + sessionLength;
+        sessions[token] = session;
+    }
+
+    std::string out = "{";
+    Json::appendKey(out, "token", true);
+    Json::appendString(out, token);
+    Json::appendKey(out, "username");
+    Json::appendString(out, user.Username);
+    Json::appendKey(out, "role");
+    Json::appendString(out, user.Role);
+    Json::appendKey(out, "fullName");
+    Json::appendString(out, user.FullName);
+    Json::appendKey(out, "expiresInSeconds");
+    Json::appendInteger(out, static_cast<long long>(sessionLength.count()) * 60);
+    out += '}';
+    reply(response, 200, out);
+}
+
+void HttpServer::handlePublic(const Request& request, Response& response, bool& handled) {
+    std::vector<std::string> parts = splitPath(request.path);
+    handled = parts.size() >= 2 && parts[0] == "api" && (parts[1] == "dresses" || parts[1] == "availability");
+    if (!handled) return;
+    if (request.method != "GET") {
+        fail(response, 405, "Use GET");
+        return;
+    }
+
+    size_t limit = 0;
+    if (parts[1] == "dresses" && parts.size() == 2 && request.query.count("q")) {
+        // Live text search in the Dresses table
+        if (!readLimit(request, DEFAULT_LIMIT, MAX_LIMIT, limit)) {
+            fail(response, 400, "limit must be 1-" + std::to_string(MAX_LIMIT));
+            return;
+        }
+        DressManager dresses;
+        std::vector<Dress> found = dresses.searchDresses(param(request, "q"));
+        std::string out = "{";
+        Json::appendKey(out, "total", true);
+        Json::appendInteger(out, static_cast<long long>(found.size()));
+        Json::appendKey(out, "dresses");
+        out += '[';
+        for (size_t i = 0; i < found.size() && i < limit; ++i) {
+            if (i > 0) out += ',';
+            appendDress(out, found[i]);
+        }
+        out += "]}";
+        reply(response, 200, out);
+        return;
+    }
+
+    if (parts[1] == "dresses") {
+        TraceSpan span("http.catalog");
+        unsigned long generation = 0;
+        std::shared_ptr<const DressCatalog> snapshot = catalog.get(generation);
+        if (!snapshot) {
+            fail(response, 503, "The dress catalogue is unavailable");
+            return;
+        }
+        if (parts.size() == 2) {
+            DressCatalog::Query query;
+            for (int f = 0; f < DressCatalog::FACET_COUNT; ++f) {
+                DressCatalog::Facet facet = static_cast<DressCatalog::Facet>(f);
+                std::string values = param(request, lower(DressCatalog::facetName(facet)).c_str());
+                size_t start = 0;
+                while (!values.empty() && start <= values.size()) {
+                    size_t comma = values.find(',', start);
+                    if (comma == std::string::npos) comma = values.size();
+                    std::string value = trim(values.substr(start, comma - start));
+                    if (!value.empty()) query.require(facet, value);
+                    start = comma + 1;
+                }
+            }
+            if (!readLimit(request, DEFAULT_LIMIT, MAX_LIMIT, limit)) {
+                fail(response, 400, "limit must be 1-" + std::to_string(MAX_LIMIT));
+                return;
+            }
+            reply(response, 200, renderDresses(*snapshot, query, limit));
+        } else {
+            long dressID = 0;
+            Dress dress;
+            if (parts.size() != 3 || !parsePositive(parts[2], 2147483647L, dressID) ||
+                !snapshot->getDress(static_cast<int>(dressID), dress)) {
+                fail(response, 404, "No such dress");
+                return;
+            }
+            std::string out;
+            appendDress(out, dress);
+            reply(response, 200, out);
+        }
+        response.cacheable = true;
+        storeCache(request, response, generation);
+        return;
+    }
+
+    // GET /api/availability?from=YYYY-MM-DD[&to=YYYY-MM-DD][&dressID=N][&limit=N]
+    if (parts.size() != 2) {
+        fail(response, 404, "Not found");
+        return;
+    }
+    TraceSpan span("http.availability");
+    unsigned long generation = 0;
+    std::shared_ptr<const AvailabilityCalendar> days = calendar.get(generation);
+    if (!days) {
+        fail(response, 503, "The availability calendar is unavailable");
+        return;
+    }
+    std::string from = param(request, "from");
+    int firstDay = days->dayOf(from);
+    int lastDay = days->dayOf(param(request, "to", from));
+    if (firstDay < 0 || lastDay < firstDay) {
+        fail(response, 400, "from and to must be YYYY-MM-DD within " + std::to_string(AvailabilityCalendar::WINDOW_DAYS) +
+                             " days from " + days->getStartDate() + ", to not before from");
+        return;
+    }
+    std::string out = "{";
+    Json::appendKey(out, "from", true);
+    Json::appendString(out, days->dateAt(firstDay));
+    Json::appendKey(out, "to");
+    Json::appendString(out, days->dateAt(lastDay));
+    std::string dressParam = param(request, "dressID");
+    if (!dressParam.empty()) {
+        long dressID = 0;
+        if (!parsePositive(dressParam, 2147483647L, dressID) || !days->contains(static_cast<int>(dressID))) {
+            fail(response, 404, "No such dress");
+            return;
+        }
+        std::vector<int> dressIDs(1, static_cast<int>(dressID));
+        std::vector<int> freeDays = days->freeDays(dressIDs, firstDay, lastDay);
+        Json::appendKey(out, "dressID");
+        Json::appendInteger(out, dressID);
+        Json::appendKey(out, "freeDays");
+        out += '[';
+        for (size_t i = 0; i < freeDays.size(); ++i) {
+            if (i > 0) out += ',';
+            Json::appendString(out, days->dateAt(freeDays[i]));
+        }
+        out += "]}";
+    } else {
+        if (!readLimit(request, MAX_LIMIT, MAX_FREE_IDS, limit)) {
+            fail(response, 400, "limit must be 1-" + std::to_string(MAX_FREE_IDS));
+            return;
+        }
+        std::vector<int> freeIDs = days->freeDresses(firstDay, lastDay);
+        Json::appendKey(out, "total");
+        Json::appendInteger(out, static_cast<long long>(freeIDs.size()));
+        Json::appendKey(out, "dressIDs");
+        out += '[';
+        for (size_t i = 0; i < freeIDs.size() && i < limit; ++i) {
+            if (i > 0) out += ',';
+            Json::appendInteger(out, freeIDs[i]);
+        }
+        out += "]}";
+    }
+    reply(response, 200, out);
+    response.cacheable = true;
+    storeCache(request, response, generation);
+}
+
+void HttpServer::handle(const Request& request, Response& response) {
+    TraceSpan span("http.request");
+    bool handled = false;
+    handlePublic(request, response, handled);
+    if (handled) return;
+
+    std::vector<std::string> parts = splitPath(request.path);
+    if (parts.size() < 2 || parts[0] != "api") {
+        fail(response, 404, "Not found");
+        return;
+    }
+    const std::string& resource = parts[1];
+    if (resource == "login") {
+        if (request.method != "POST") {
+            fail(response, 405, "Use POST");
+            return;
+        }
+        handleLogin(request, response);
+        return;
+    }
+
+    User user;
+    if (!authenticate(request, user)) {
+        fail(response, 401, "Log in with POST /api/login and send Authorization: Bearer <token>");
+        return;
+    }
+    bool get = request.method == "GET";
+    bool post = request.method == "POST";
+    long id = 0;
+    bool hasID = parts.size() >= 3 && parsePositive(parts[2], 2147483647L, id);
+    std::map<std::string, std::string> fields;
+    if (post && !request.body.empty() && !Json::parseObject(request.body, fields)) {
+        fail(response, 400, "The body must be a flat JSON object");
+        return;
+    }
+
+    if (resource == "logout" && parts.size() == 2 && post) {
+        std::lock_guard<std::mutex> lock(sessionsMutex);
+        sessions.erase(trim(request.authorization.substr(7)));
+        reply(response, 200, "{\"loggedOut\":true}");
+        return;
+    }
+
+    if (resource == "customers" && get && parts.size() == 2) {
+        std::string term = param(request, "q");
+        size_t limit = 0;
+        if (term.empty() || !readLimit(request, DEFAULT_LIMIT, MAX_LIMIT, limit)) {
+            fail(response, 400, "Search with ?q=<text>[&limit=1-" + std::to_string(MAX_LIMIT) + "]");
+            return;
+        }
+        CustomerManager customers;
+        std::vector<Customer> found = customers.searchCustomers(term);
+        std::string out = "{";
+        Json::appendKey(out, "total", true);
+        Json::appendInteger(out, static_cast<long long>(found.size()));
+        Json::appendKey(out, "customers");
+        out += '[';
+        for (size_t i = 0; i < found.size() && i < limit; ++i) {
+            if (i > 0) out += ',';
+            appendCustomer(out, found[i]);
+        }
+        out += "]}";
+        reply(response, 200, out);
+        return;
+    }
+    if (resource == "customers" && get && parts.size() == 3) {
+        CustomerManager customers;
+        Customer* customer = hasID ? customers.getCustomerByID(static_cast<int>(id)) : nullptr;
+        if (!customer) {
+            fail(response, 404, "No such customer");
+            return;
+        }
+        std::string out;
+        appendCustomer(out, *customer);
+        out.erase(out.size() - 1);
+        Json::appendKey(out, "activeRentals");
+        Json::appendInteger(out, customers.getActiveRentalCount(customer->CustomerID));
+        out += '}';
+        delete customer;
+        reply(response, 200, out);
+        return;
+    }
+
+    if (resource == "rentals" && post && parts.size() == 2) {
+        std::vector<int> dressIDs;
+        long customerID = 0;
+        long days = 0;
+        if (!parsePositive(fields["customerID"], 2147483647L, customerID) || !parsePositive(fields["days"], 365, days) ||
+            !Json::parseIntArray(fields["dressIDs"], dressIDs) || dressIDs.empty()) {
+            fail(response, 400, "Expected {\"customerID\": N, \"days\": N, \"dressIDs\": [N, ...]}");
+            return;
+        }
+        RentalManager rentals;
+        // Rentals start today; the counter's clock, not the client's, decides
+        int rentalID = rentals.createRental(static_cast<int>(customerID), LateFeePolicy::today(),
+                                            static_cast<int>(days), dressIDs);
+        if (rentalID <= 0) {
+            fail(response, 409, "Rental not created: check the customer's active rentals, the duration (1-14 days) "
+                                "and that every dress is available");
+            return;
+        }
+        calendar.invalidate();
+        RentalView* view = rentals.getRentalView(rentalID);
+        if (!view) {
+            reply(response, 201, "{\"rentalID\":" + std::to_string(rentalID) + "}");
+            return;
+        }
+        reply(response, 201, renderRental(*view));
+        delete view;
+        return;
+    }
+    if (resource == "rentals" && get && parts.size() == 3) {
+        RentalManager rentals;
+        RentalView* view = hasID ? rentals.getRentalView(static_cast<int>(id)) : nullptr;
+        if (!view) {
+            fail(response, 404, "No such rental");
+            return;
+        }
+        reply(response, 200, renderRental(*view));
+        delete view;
+        return;
+    }
+    if (resource == "rentals" && post && parts.size() == 4 && parts[3] == "return" && hasID) {
+        RentalManager rentals;
+        if (!rentals.returnRental(static_cast<int>(id), LateFeePolicy::today())) {
+            fail(response, 409, "Not an active rental");
+            return;
+        }
+        calendar.invalidate();
+        reply(response, 200, "{\"rentalID\":" + std::to_string(id) + ",\"returned\":true}");
+        return;
+    }
+
+    if (resource == "payments" && post && parts.size() == 2) {
+        long rentalID = 0;
+        Money amount;
+        PaymentManager payments;
+        std::string method = fields["method"];
+        if (!parsePositive(fields["rentalID"], 2147483647L, rentalID) || !Money::parse(fields["amount"], amount) ||
+            !amount.isPositive() || !payments.validatePaymentMethod(method)) {
+            fail(response, 400, "Expected {\"rentalID\": N, \"amount\": 12.50, "
+                                "\"method\": \"Cash|Credit Card|Debit Card|Online\"}");
+            return;
+        }
+        if (!payments.createPayment(static_cast<int>(rentalID), amount, method, LateFeePolicy::today(),
+                                    fields["transactionRef"])) {
+            fail(response, 409, "Payment not recorded");
+            return;
+        }
+        std::string out = "{";
+        Json::appendKey(out, "rentalID", true);
+        Json::appendInteger(out, rentalID);
+        Json::appendKey(out, "amount");
+        Json::appendMoney(out, amount);
+        Json::appendKey(out, "paid");
+        Json::appendMoney(out, payments.getTotalPaid(static_cast<int>(rentalID)));
+        out += '}';
+        reply(response, 201, out);
+        return;
+    }
+
+    if (resource == "reports" || resource == "server") {
+        if (user.Role != "Administrator") {
+            fail(response, 403, "Administrator role required");
+            return;
+        }
+        if (!get) {
+            fail(response, 405, "Use GET");
+            return;
+        }
+        if (resource == "reports" && parts.size() == 3 && renderReport(parts[2], request, response)) return;
+        if (resource == "server" && parts.size() == 3 && parts[2] == "stats") {
+            Stats current = getStats();
+            std::string out = "{";
+            Json::appendKey(out, "connectionsOpen", true);
+            Json::appendInteger(out, current.connectionsOpen);
+            Json::appendKey(out, "connectionsAccepted");
+            Json::appendInteger(out, current.connectionsAccepted);
+            Json::appendKey(out, "requests");
+            Json::appendInteger(out, current.requests);
+            Json::appendKey(out, "cacheHits");
+            Json::appendInteger(out, current.cacheHits);
+            Json::appendKey(out, "errors");
+            Json::appendInteger(out, current.errors);
+            Json::appendKey(out, "cachedResponses");
+            Json::appendInteger(out, static_cast<long long>(current.cachedResponses));
+            Json::appendKey(out, "workers");
+            Json::appendInteger(out, current.workers);
+            Json::appendKey(out, "workersBusy");
+            Json::appendInteger(out, current.workersBusy);
+            Json::appendKey(out, "requestsQueued");
+            Json::appendInteger(out, static_cast<long long>(current.requestsQueued));
+            out += '}';
+            reply(response, 200, out);
+            return;
+        }
+    }
+
+    fail(response, 404, "Not found");
+}
@@ -0,0 +1,213 @@
+#include "IndexAdvisor.h"
+#include "DatabaseManager.h"
+#include "TableRenderer.h"
+#include "UIColors.h"
+#include "MenuHandlers.h"
+#include <cstdlib>
+#include <iostream>
+
+namespace {
+
+// The queries that run on every screen or on large tables, with sample values
+// in place of their parameters. Keep them in step with the managers when a
+// query changes.
+struct HotQuery {
+    const char* name;
+    const char* sql;
+    bool scanExpected;
+};
+
+const HotQuery HOT_QUERIES[] = {
+    { "auth.login",
+      "SELECT * FROM Users WHERE Username = 'admin' AND IsActive = TRUE", false },
+    { "customer.byID",
+      "SELECT * FROM Customers WHERE CustomerID = 1", false },
+    { "customer.byIC",
+      "SELECT * FROM Customers WHERE IC_Number = '900101-14-5678'", false },
+    { "customer.activeCount",
+      "SELECT COUNT(*) as count FROM Rentals WHERE CustomerID = 1 AND Status = 'Active'", false },
+    { "customer.search",
+      "SELECT * FROM Customers WHERE Name LIKE '%Tan%' OR IC_Number LIKE '%Tan%' "
+      "OR Phone LIKE '%Tan%' OR Email LIKE '%Tan%'", true },
+    { "dress.available",
+      "SELECT * FROM Dresses WHERE AvailabilityStatus = 'Available' ORDER BY DressID", false },
+    { "dress.byCategory",
+      "SELECT * FROM Dresses WHERE Category = 'Gown' AND AvailabilityStatus = 'Available'", false },
+    { "dress.freeUnits",
+      "SELECT d.StockQuantity - COALESCE(MAX(s.Reserved), 0) AS FreeUnits "
+      "FROM Dresses d "
+      "LEFT JOIN DressDailyStock s ON s.DressID = d.DressID "
+      "AND s.StockDate BETWEEN CURDATE() AND CURDATE() + INTERVAL 7 DAY "
+      "WHERE d.DressID = 1 GROUP BY d.DressID, d.StockQuantity", false },
+    { "dress.search",
+      "SELECT * FROM Dresses WHERE DressName LIKE '%Red%' OR Category LIKE '%Red%' "
+      "OR Color LIKE '%Red%' OR Size LIKE '%Red%'", true },
+    { "dress.lowStock",
+      "SELECT DressID, DressName, StockQuantity, MinimumStockLevel, UnitsOut FROM Dresses "
+      "WHERE LowStock = TRUE ORDER BY DressID", false },
+    { "rental.byID",
+      "SELECT * FROM Rentals WHERE RentalID = 1", false },
+    { "rental.view",
+      "SELECT r.RentalID, c.Name, ri.DressID, d.DressName, p.TotalPaid "
+      "FROM Rentals r "
+      "JOIN Customers c ON c.CustomerID = r.CustomerID "
+      "LEFT JOIN RentalItems ri ON ri.RentalID = r.RentalID "
+      "LEFT JOIN Dresses d ON d.DressID = ri.DressID "
+      "CROSS JOIN (SELECT COALESCE(SUM(Amount), 0) AS TotalPaid, COUNT(*) AS PaymentCount "
+      "            FROM Payments WHERE RentalID = 1 AND Status = 'Completed') p "
+      "WHERE r.RentalID = 1 ORDER BY ri.RentalItemID", false },
+    { "rental.items",
+      "SELECT * FROM RentalItems WHERE RentalID = 1", false },
+    { "rental.byCustomer",
+      "SELECT * FROM Rentals WHERE CustomerID = 1 ORDER BY RentalDate DESC", false },
+    { "rental.activeList",
+      "SELECT * FROM Rentals WHERE Status = 'Active' ORDER BY DueDate", false },
+    { "rental.overdueList",
+      "SELECT * FROM Rentals WHERE Status = 'Active' AND DueDate < CURDATE() ORDER BY DueDate", false },
+    { "reservation.group",
+      "SELECT v.ReservationID, v.Category, v.Size, v.StartDate, v.EndDate, v.AssignedDressID "
+      "FROM Reservations v WHERE v.Status = 'Booked' AND v.EndDate >= CURDATE() "
+      "AND v.Category = 'Gown' AND v.Size = 'M'", false },
+    { "reservation.groupDresses",
+      "SELECT d.DressID, d.Category, d.Size, d.StockQuantity FROM Dresses d "
+      "WHERE d.AvailabilityStatus <> 'Maintenance' AND d.StockQuantity > 0 "
+      "AND d.Category = 'Gown' AND d.Size = 'M' ORDER BY d.DressID", false },
+    { "reservation.upcoming",
+      "SELECT * FROM Reservations WHERE Status = 'Booked' AND EndDate >= CURDATE() "
+      "ORDER BY StartDate, ReservationID", false },
+    { "sweeper.dueTomorrow",
+      "SELECT RentalID, CustomerID FROM Rentals "
+      "WHERE Status = 'Active' AND DueDate = CURDATE() + INTERVAL 1 DAY", false },
+    { "payment.byRental",
+      "SELECT * FROM Payments WHERE RentalID = 1 ORDER BY PaymentDate DESC", false },
+    { "payment.totalPaid",
+      "SELECT AmountPaid FROM RentalBalances WHERE RentalID = 1", false },
+    { "payment.activeBalances",
+      "SELECT r.RentalID, c.Name, r.DueDate, r.Status, r.TotalAmount, b.AmountDue, b.AmountPaid "
+      "FROM Rentals r JOIN Customers c ON c.CustomerID = r.CustomerID "
+      "JOIN RentalBalances b ON b.RentalID = r.RentalID "
+      "WHERE r.Status = 'Active' ORDER BY r.DueDate, r.RentalID", false },
+    { "report.monthlySales",
+      "SELECT DATE_FORMAT(r.RentalDate, '%Y-%m') as Month, SUM(r.TotalAmount + r.LateFee) as TotalSales "
+      "FROM Rentals r WHERE r.RentalDate >= '2025-01-01' AND r.RentalDate < '2026-01-01' "
+      "GROUP BY DATE_FORMAT(r.RentalDate, '%Y-%m')", false },
+    { "report.incomeRange",
+      "SELECT SUM(p.Amount) as TotalRevenue FROM Payments p "
+      "JOIN Rentals r ON p.RentalID = r.RentalID "
+      "WHERE p.Status = 'Completed' AND p.PaymentDate BETWEEN '2025-01-01' AND '2025-01-31'", false },
+    { "report.monthRevenue",
+      "SELECT SUM(p.Amount) as total FROM Payments p "
+      "WHERE p.Status = 'Completed' AND p.PaymentDate >= DATE_FORMAT(CURDATE(), '%Y-%m-01') "
+      "AND p.PaymentDate < DATE_FORMAT(CURDATE(), '%Y-%m-01') + INTERVAL 1 MONTH", false },
+    { "report.inventory",
+      "SELECT Category, COUNT(*), SUM(RentalPrice) FROM Dresses GROUP BY Category", true },
+    { "report.utilization",
+      "SELECT d.DressID, COUNT(ri.RentalItemID) FROM Dresses d "
+      "LEFT JOIN RentalItems ri ON d.DressID = ri.DressID "
+      "LEFT JOIN Rentals r ON ri.RentalID = r.RentalID GROUP BY d.DressID", true },
+};
+
+const size_t HOT_QUERY_COUNT = sizeof(HOT_QUERIES) / sizeof(HOT_QUERIES[0]);
+
+} // namespace
+
+IndexAdvisor::IndexAdvisor(long long smallTableRows) : smallTableRows(smallTableRows) {}
+
+bool IndexAdvisor::analyze() {
+    findings.clear();
+    DatabaseManager& db = DatabaseManager::getInstance();
+    try {
+        db.getConnection();
+    } catch (const std::exception& e) {
+        std::cerr << "Index advisor: " << e.what() << std::endl;
+        return false;
+    }
+
+    for (size_t q = 0; q < HOT_QUERY_COUNT; ++q) {
+        const HotQuery& hot = HOT_QUERIES[q];
+        sql::Statement* stmt = nullptr;
+        sql::ResultSet* res = nullptr;
+        try {
+            stmt = db.getConnection()->createStatement();
+            res = stmt->executeQuery(std::string("EXPLAIN ") + hot.sql);
+            while (res->next()) {
+                Finding finding;
+                finding.query = hot.name;
+                finding.table = res->getString("table");
+                // Derived tables and unions are judged by the rows that feed them
+                if (finding.table.empty() || finding.table[0] == '<') continue;
+                finding.accessType = res->getString("type");
+                finding.key = res->getString("key");
+                if (res->wasNull()) finding.key.clear();
+                finding.rows = std::atoll(res->getString("rows").c_str());
+                finding.extra = res->getString("Extra");
+                bool scan = finding.accessType == "ALL" || finding.accessType == "index";
+                finding.fullScan = scan && finding.rows >= smallTableRows;
+                finding.expected = hot.scanExpected;
+                findings.push_back(finding);
+            }
+        } catch (sql::SQLException& e) {
+            Finding finding;
+            finding.query = hot.name;
+            finding.rows = 0;
+            finding.fullScan = false;
+            finding.expected = false;
+            finding.error = e.what();
+            findings.push_back(finding);
+        }
+        delete res;
+        delete stmt;
+    }
+    return true;
+}
+
+int IndexAdvisor::problemCount() const {
+    int problems = 0;
+    for (const Finding& finding : findings) {
+        if (!finding.error.empty() || (finding.fullScan && !finding.expected)) ++problems;
+    }
+    return problems;
+}
+
+void IndexAdvisor::printReport(std::ostream& out) {
+    TableRenderer table(SCREEN_WIDTH);
+    table.addColumn("Query", 12);
+    table.addColumn("Table", 6);
+    table.addColumn("Access", 6);
+    table.addColumn("Index", 6);
+    table.addColumn("Rows", 0, 0, TableRenderer::ALIGN_RIGHT);
+    table.addColumn("Verdict", 8);
+    for (const Finding& finding : findings) {
+        std::string verdict;
+        if (!finding.error.empty()) {
+            verdict = UIColors::colorize("ERROR: " + finding.error, UIColors::RED);
+        } else if (finding.fullScan && finding.expected) {
+            verdict = UIColors::colorize("scan (expected)", UIColors::YELLOW);
+        } else if (finding.fullScan) {
+            verdict = UIColors::colorize("FULL SCAN", UIColors::BOLD + UIColors::RED);
+        } else if (finding.extra.find("filesort") != std::string::npos) {
+            verdict = UIColors::colorize("ok, filesort", UIColors::YELLOW);
+        } else {
+            verdict = UIColors::colorize("ok", UIColors::GREEN);
+        }
+        table.addRow({ finding.query, finding.table, finding.accessType, finding.key,
+                       finding.error.empty() ? std::to_string(finding.rows) : std::string(), verdict });
+    }
+    table.render(out);
+
+    int problems = problemCount();
+    out << '\n';
+    if (problems == 0) {
+        out << UIColors::colorize("No unexpected full scans in " + std::to_string(HOT_QUERY_COUNT) +
+                                  " hot queries.", UIColors::GREEN) << '\n';
+    } else {
+        out << UIColors::colorize(std::to_string(problems) + " problem(s) in " + std::to_string(HOT_QUERY_COUNT) +
+                                  " hot queries. Check ./rental_system --migrate is up to date.",
+                                  UIColors::RED) << '\n';
+    }
+    out << "Scans of tables under " << smallTableRows << " estimated rows are not counted." << '\n';
+}
+
+void IndexAdvisor::printReport() {
+    printReport(UIColors::out());
+}
@@ -50,6 +50,10 @@ std::string InputValidator::formatRangeTip(double min, double max) {
     return oss.str();
 }
 
+std::string InputValidator::formatRangeTip(Money min, Money max) {
+    return "Enter an amount between " + min.toString() + " and " + max.toString() + ", e.g. 10.50.";
+}
+
 int InputValidator::getInt(const std::string& prompt, int min, int max, bool allowRetry) {
     int value;
     std::string input;
@@ -158,6 +162,42 @@ double InputValidator::getDouble(const std::string& prompt, double min, double m
     }
 }
 
+Money InputValidator::getMoney(const std::string& prompt, Money min, Money max, bool allowRetry) {
+    Money value;
+    std::string input;
+    
+    while (true) {
+        if (!prompt.empty()) {
+            UIColors::printCenteredInput(prompt, SCREEN_WIDTH, UIColors::WHITE);
+        }
+        std::getline(std::cin, input);
+        
+        if (input.empty()) {
+            UIColors::printCentered("Input cannot be empty. Please enter an amount.", SCREEN_WIDTH, UIColors::RED);
+            printTip(formatRangeTip(min, max));
+            if (!allowRetry) return Money();
+            continue;
+        }
+        
+        // Parsed as sen directly, so "0.1" is exactly ten sen
+        if (!Money::parse(input, value)) {
+            UIColors::printCentered("Invalid amount. Use digits with at most two decimal places.", SCREEN_WIDTH, UIColors::RED);
+            printTip("Enter an amount such as 10.50 (avoid letters, commas and the RM prefix).");
+            if (!allowRetry) return Money();
+            continue;
+        }
+        
+        if (value < min || value > max) {
+            UIColors::printCentered("Amount must be between " + min.toString() + " and " + max.toString() + ".", SCREEN_WIDTH, UIColors::RED);
+            printTip(formatRangeTip(min, max));
+            if (!allowRetry) return Money();
+            continue;
+        }
+        
+        return value;
+    }
+}
+
 std::string InputValidator::getString(const std::string& prompt, bool required, size_t minLength, size_t maxLength) {
     std::string input;
     
@@ -0,0 +1,214 @@
+#include "Json.h"
+#include "Format.h"
+#include <cctype>
+#include <cstdlib>
+
+namespace {
+
+const char HEX[] = "0123456789abcdef";
+
+void skipSpace(const std::string& text, size_t& pos) {
+    while (pos < text.size() && std::isspace(static_cast<unsigned char>(text[pos]))) ++pos;
+}
+
+void appendUtf8(std::string& out, unsigned long code) {
+    if (code < 0x80) {
+        out += static_cast<char>(code);
+    } else if (code < 0x800) {
+        out += static_cast<char>(0xC0 | (code >> 6));
+        out += static_cast<char>(0x80 | (code & 0x3F));
+    } else {
+        out += static_cast<char>(0xE0 | (code >> 12));
+        out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (code & 0x3F));
+    }
+}
+
+// A string starting at the opening quote; pos ends after the closing one
+bool readString(const std::string& text, size_t& pos, std::string& value) {
+    if (pos >= text.size() || text[pos] != '"') return false;
+    ++pos;
+    value.clear();
+    while (pos < text.size()) {
+        char c = text[pos++];
+        if (c == '"') return true;
+        if (static_cast<unsigned char>(c) < 0x20) return false;
+        if (c != '\\') {
+            value += c;
+            continue;
+        }
+        if (pos >= text.size()) return false;
+        char escape = text[pos++];
+        switch (escape) {
+            case '"': value += '"'; break;
+            case '\\': value += '\\'; break;
+            case '/': value += '/'; break;
+            case 'b': value += '\b'; break;
+            case 'f': value += '\f'; break;
+            case 'n': value += '\n'; break;
+            case 'r': value += '\r'; break;
+            case 't': value += '\t'; break;
+            case 'u': {
+                if (pos + 4 > text.size()) return false;
+                char* end = nullptr;
+                std::string digits = text.substr(pos, 4);
+                unsigned long code = std::strtoul(digits.c_str(), &end, 16);
+                if (*end != '\0') return false;
+                appendUtf8(value, code);
+                pos += 4;
+                break;
+            }
+            default:
+                return false;
+        }
+    }
+    return false;
+}
+
+// A number, true, false or null; returned as its text
+bool readScalar(const std::string& text, size_t& pos, std::string& value) {
+    size_t start = pos;
+    while (pos < text.size() && (std::isalnum(static_cast<unsigned char>(text[pos])) || text[pos] == '-' ||
+                                 text[pos] == '+' || text[pos] == '.')) {
+        ++pos;
+    }
+    value = text.substr(start, pos - start);
+    if (value == "true" || value == "false" || value == "null") return true;
+    char* end = nullptr;
+    std::strtod(value.c_str(), &end);
+    return !value.empty() && *end == '\0';
+}
+
+bool readValue(const std::string& text, size_t& pos, std::string& value, bool inArray) {
+    skipSpace(text, pos);
+    if (pos >= text.size()) return false;
+    if (text[pos] == '"') {
+        if (!inArray) return readString(text, pos, value);
+        size_t start = pos;
+        std::string ignored;
+        if (!readString(text, pos, ignored)) return false;
+        value = text.substr(start, pos - start);
+        return true;
+    }
+    if (text[pos] == '[' && !inArray) {
+        size_t start = pos++;
+        skipSpace(text, pos);
+        if (pos < text.size() && text[pos] == ']') {
+            value = text.substr(start, ++pos - start);
+            return true;
+        }
+        while (true) {
+            std::string item;
+            if (!readValue(text, pos, item, true)) return false;
+            skipSpace(text, pos);
+            if (pos >= text.size()) return false;
+            if (text[pos] == ']') break;
+            if (text[pos++] != ',') return false;
+        }
+        value = text.substr(start, ++pos - start);
+        return true;
+    }
+    return readScalar(text, pos, value);
+}
+
+} // namespace
+
+void Json::appendString(std::string& out, const std::string& text) {
+    out += '"';
+    for (size_t i = 0; i < text.size(); ++i) {
+        unsigned char c = static_cast<unsigned char>(text[i]);
+        switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (c < 0x20) {
+                    out += "\\u00";
+                    out += HEX[c >> 4];
+                    out += HEX[c & 0xF];
+                } else {
+                    out += static_cast<char>(c);
+                }
+        }
+    }
+    out += '"';
+}
+
+void Json::appendInteger(std::string& out, long long value) {
+    Format::appendInteger(out, value);
+}
+
+void Json::appendMoney(std::string& out, Money amount) {
+    Format::appendMoney(out, amount);
+}
+
+void Json::appendKey(std::string& out, const char* name, bool first) {
+    if (!first) out += ',';
+    out += '"';
+    out += name;
+    out += "\":";
+}
+
+std::string Json::error(const std::string& message) {
+    std::string out = "{\"error\":";
+    appendString(out, message);
+    out += "}";
+    return out;
+}
+
+bool Json::parseObject(const std::string& text, std::map<std::string, std::string>& fields) {
+    fields.clear();
+    size_t pos = 0;
+    skipSpace(text, pos);
+    if (pos >= text.size() || text[pos++] != '{') return false;
+    skipSpace(text, pos);
+    if (pos < text.size() && text[pos] == '}') {
+        ++pos;
+    } else {
+        while (true) {
+            std::string name;
+            std::string value;
+            skipSpace(text, pos);
+            if (!readString(text, pos, name)) return false;
+            skipSpace(text, pos);
+            if (pos >= text.size() || text[pos++] != ':') return false;
+            if (!readValue(text, pos, value, false)) return false;
+            fields[name] = value;
+            skipSpace(text, pos);
+            if (pos >= text.size()) return false;
+            if (text[pos] == '}') {
+                ++pos;
+                break;
+            }
+            if (text[pos++] != ',') return false;
+        }
+    }
+    skipSpace(text, pos);
+    return pos == text.size();
+}
+
+bool Json::parseIntArray(const std::string& text, std::vector<int>& values) {
+    values.clear();
+    if (text.size() < 2 || text[0] != '[' || text[text.size() - 1] != ']') return false;
+    size_t pos = 1;
+    bool afterComma = false;
+    while (true) {
+        skipSpace(text, pos);
+        if (pos == text.size() - 1) return !afterComma;
+        char* end = nullptr;
+        long value = std::strtol(text.c_str() + pos, &end, 10);
+        size_t next = static_cast<size_t>(end - text.c_str());
+        if (next == pos || value < -2147483647L - 1 || value > 2147483647L) return false;
+        values.push_back(static_cast<int>(value));
+        pos = next;
+        skipSpace(text, pos);
+        afterComma = text[pos] == ',';
+        if (afterComma) {
+            ++pos;
+        } else if (pos != text.size() - 1) {
+            return false;
+        }
+    }
+}
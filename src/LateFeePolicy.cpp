@@ -0,0 +1,82 @@
+#include "LateFeePolicy.h"
+#include "Format.h"
+#include <ctime>
+
+LateFeePolicy::LateFeePolicy(Money dailyRate) : dailyRate(dailyRate) {}
+
+const LateFeePolicy& LateFeePolicy::standard() {
+    static const LateFeePolicy policy(Money::fromCents(1000));
+    return policy;
+}
+
+bool LateFeePolicy::parseDate(const std::string& date, long& dayNumber) {
+    // Accepts "YYYY-MM-DD" optionally followed by a time part
+    if (date.size() < 10 || date[4] != '-' || date[7] != '-') return false;
+    int fields[3] = { 0, 0, 0 };
+    const int starts[3] = { 0, 5, 8 };
+    const int lengths[3] = { 4, 2, 2 };
+    for (int f = 0; f < 3; ++f) {
+        for (int i = 0; i < lengths[f]; ++i) {
+            char c = date[starts[f] + i];
+            if (c < '0' || c > '9') return false;
+            fields[f] = fields[f] * 10 + (c - '0');
+        }
+    }
+    int year = fields[0];
+    int month = fields[1];
+    int day = fields[2];
+    if (month < 1 || month > 12 || day < 1 || day > 31) return false;
+
+    // Days from civil date (proleptic Gregorian), no time zone involved
+    year -= month <= 2 ? 1 : 0;
+    long era = (year >= 0 ? year : year - 399) / 400;
+    long yearOfEra = year - era * 400;
+    long dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    long dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    dayNumber = era * 146097 + dayOfEra - 719468;
+    return true;
+}
+
+std::string LateFeePolicy::dateOf(long dayNumber) {
+    // Civil date from days, the inverse of parseDate
+    long z = dayNumber + 719468;
+    long era = (z >= 0 ? z : z - 146096) / 146097;
+    long dayOfEra = z - era * 146097;
+    long yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    long dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    long monthIndex = (5 * dayOfYear + 2) / 153;
+    int day = static_cast<int>(dayOfYear - (153 * monthIndex + 2) / 5 + 1);
+    int month = static_cast<int>(monthIndex < 10 ? monthIndex + 3 : monthIndex - 9);
+    int year = static_cast<int>(yearOfEra + era * 400 + (month <= 2 ? 1 : 0));
+
+    char buffer[Format::MAX_TEXT];
+    return std::string(buffer, Format::date(buffer, year, month, day));
+}
+
+int LateFeePolicy::daysLate(const std::string& dueDate, const std::string& asOf) const {
+    long due = 0;
+    long until = 0;
+    if (!parseDate(dueDate, due) || !parseDate(asOf, until)) return 0;
+    return until > due ? static_cast<int>(until - due) : 0;
+}
+
+Money LateFeePolicy::feeForDays(int days) const {
+    return days > 0 ? dailyRate * days : Money();
+}
+
+Money LateFeePolicy::lateFee(const std::string& dueDate, const std::string& returnDate,
+                             const std::string& today) const {
+    bool returned = !returnDate.empty() && returnDate != "NULL";
+    return feeForDays(daysLate(dueDate, returned ? returnDate : today));
+}
+
+std::string LateFeePolicy::today() {
+    std::time_t now = std::time(nullptr);
+    std::tm tmNow;
+#ifdef _WIN32
+    localtime_s(&tmNow, &now);
+#else
+    localtime_r(&now, &tmNow);
+#endif
+    return Format::date(tmNow);
+}
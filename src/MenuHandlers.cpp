@@ -8,7 +8,19 @@
 #include "InputValidator.h"
 #include "UIColors.h"
 #include "AuthManager.h"
+#include "QueryStats.h"
+#include "TableRenderer.h"
+#include "IndexAdvisor.h"
+#include "DressCatalog.h"
+#include "DressStock.h"
+#include "AvailabilityCalendar.h"
+#include "ReservationManager.h"
+#include "CleaningScheduler.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
 #include <iostream>
+#include <sstream>
 #include <string>
 #include <vector>
 
@@ -47,11 +59,11 @@ bool showLoginScreen() {
             try {
                 sql::Connection* conn = DatabaseManager::getInstance().getConnection();
                 if (conn) {
-                    sql::PreparedStatement* pstmt = conn->prepareStatement(
+                    sql::PreparedStatement* pstmt = DatabaseManager::getInstance().prepare(
                         "SELECT COUNT(*) as count FROM Users WHERE Username = ?"
                     );
                     pstmt->setString(1, newUser.Username);
-                    sql::ResultSet* res = pstmt->executeQuery();
+                    sql::ResultSet* res = DatabaseManager::getInstance().executePreparedQuery(pstmt);
                     if (res && res->next() && res->getInt("count") > 0) {
                         UIColors::printCentered("Username already exists! Please choose another username.", SCREEN_WIDTH, UIColors::RED);
                         delete pstmt;
@@ -122,14 +134,17 @@ bool showLoginScreen() {
             std::cout << std::endl;
             
             // Show low stock alert
-            std::vector<std::pair<int, std::string>> lowStock = auth.getLowStockDresses(3);
+            std::vector<StockLevel> lowStock = DressStock::getLowStock();
             if (!lowStock.empty()) {
                 std::cout << std::endl;
                 UIColors::printCentered("*** LOW STOCK ALERT ***", SCREEN_WIDTH, UIColors::YELLOW + UIColors::BOLD);
                 UIColors::printSeparator(SCREEN_WIDTH);
                 UIColors::printCentered("The following dresses have low stock:", SCREEN_WIDTH, UIColors::YELLOW);
                 for (const auto& item : lowStock) {
-                    std::string itemText = "- Dress ID " + std::to_string(item.first) + ": " + item.second;
+                    int freeUnits = std::max(item.StockQuantity - item.UnitsOut, 0);
+                    std::string itemText = "- Dress ID " + std::to_string(item.DressID) + ": " + item.DressName + " (" +
+                                           std::to_string(freeUnits) + " of " + std::to_string(item.StockQuantity) +
+                                           " units free)";
                     UIColors::printCentered(itemText, SCREEN_WIDTH, UIColors::WHITE);
                 }
                 UIColors::printSeparator(SCREEN_WIDTH);
@@ -195,11 +210,12 @@ void displayMainMenu() {
     User* user = auth.getCurrentUser();
     std::string role = user ? user->Role : "Guest";
     
+    RenderFrame frame;
     UIColors::printSeparator(SCREEN_WIDTH);
     UIColors::printCentered("DRESS RENTAL MANAGEMENT SYSTEM", SCREEN_WIDTH, UIColors::BOLD + UIColors::CYAN);
     UIColors::printCentered("Logged in as: " + (user ? user->FullName : "Guest") + " (" + role + ")", SCREEN_WIDTH, UIColors::GREEN);
     UIColors::printSeparator(SCREEN_WIDTH);
-    std::cout << std::endl;
+    UIColors::out() << '\n';
     
     int menuNum = 1;
     
@@ -218,7 +234,7 @@ void displayMainMenu() {
     }
     
     // Change Password (always option 7)
-    std::cout << std::endl;
+    UIColors::out() << '\n';
     UIColors::printMenuOption(7, "Change Password");
     UIColors::printMenuOption(0, "Logout");
     UIColors::printSeparator(SCREEN_WIDTH);
@@ -332,7 +348,7 @@ void customerManagementMenu() {
                     int duration = InputValidator::getInt("Rental Duration (1-14 days)*: ", 1, 14);
                     
                     // Calculate total price
-                    double totalPrice = selectedDress->RentalPrice * duration;
+                    Money totalPrice = selectedDress->RentalPrice * duration;
                     
                     // Display order summary
                     std::cout << std::endl;
@@ -340,9 +356,7 @@ void customerManagementMenu() {
                     std::cout << std::endl;
                     UIColors::printCentered("Customer: " + customer.Name, SCREEN_WIDTH, UIColors::WHITE);
                     UIColors::printCentered("Dress: " + selectedDress->DressName, SCREEN_WIDTH, UIColors::WHITE);
-                    std::ostringstream priceStream;
-                    priceStream << std::fixed << std::setprecision(2) << totalPrice;
-                    UIColors::printCentered("Total Price: RM " + priceStream.str(), SCREEN_WIDTH, UIColors::GREEN + UIColors::BOLD);
+                    UIColors::printCentered("Total Price: " + totalPrice.toDisplay(), SCREEN_WIDTH, UIColors::GREEN + UIColors::BOLD);
                     UIColors::printCentered("Rental Date: " + rentalDate + ", Duration: " + std::to_string(duration) + " days", SCREEN_WIDTH, UIColors::WHITE);
                     std::cout << std::endl;
                     
@@ -579,12 +593,16 @@ void dressManagementMenu() {
         UIColors::printMenuOption(5, "Update Dress");
         UIColors::printMenuOption(6, "Delete Dress");
         UIColors::printMenuOption(7, "View Dress Details");
+        UIColors::printMenuOption(8, "Browse by Attribute");
+        UIColors::printMenuOption(9, "Update Stock Level");
+        UIColors::printMenuOption(10, "Availability Calendar");
+        UIColors::printMenuOption(11, "Cleaning Queue");
         std::cout << std::endl;
         UIColors::printMenuOption(0, "Back to Main Menu");
         UIColors::printSeparator(SCREEN_WIDTH);
         
         UIColors::printCenteredInput("Enter your choice: ", SCREEN_WIDTH, UIColors::WHITE);
-        choice = InputValidator::getInt("", 0, 7);
+        choice = InputValidator::getInt("", 0, 11);
         
         if (choice == 0) break;
         
@@ -600,7 +618,7 @@ void dressManagementMenu() {
                 dress.Category = InputValidator::getString("Category*: ", true, 2, 50);
                 dress.Size = InputValidator::getString("Size*: ", true, 1, 10);
                 dress.Color = InputValidator::getString("Color*: ", true, 2, 30);
-                dress.RentalPrice = InputValidator::getDouble("Rental Price (RM)*: ", 0.01, 10000.0);
+                dress.RentalPrice = InputValidator::getMoney("Rental Price (RM)*: ", Money::fromCents(1), Money::fromCents(1000000));
                 
                 std::string condPrompt = "Condition Status (Good/Fair/Poor) [Good]: ";
                 UIColors::printCenteredInput(condPrompt, SCREEN_WIDTH, UIColors::YELLOW);
@@ -608,11 +626,12 @@ void dressManagementMenu() {
                 std::getline(std::cin, cond);
                 dress.ConditionStatus = cond.empty() ? "Good" : cond;
                 
-                std::string availPrompt = "Availability Status (Available/Rented/Maintenance) [Available]: ";
+                // A new dress has no units out; only Maintenance is set by hand
+                std::string availPrompt = "Under Maintenance (y/n) [n]: ";
                 UIColors::printCenteredInput(availPrompt, SCREEN_WIDTH, UIColors::YELLOW);
                 std::string avail;
                 std::getline(std::cin, avail);
-                dress.AvailabilityStatus = avail.empty() ? "Available" : avail;
+                dress.AvailabilityStatus = (avail == "y" || avail == "Y") ? "Maintenance" : "Available";
                 
                 std::string cleanPrompt = "Cleaning Status (Clean/Needs Cleaning) [Clean]: ";
                 UIColors::printCenteredInput(cleanPrompt, SCREEN_WIDTH, UIColors::YELLOW);
@@ -717,25 +736,34 @@ void dressManagementMenu() {
                 std::getline(std::cin, input);
                 dress.Color = input.empty() ? existing->Color : input;
                 
-                std::string dPrompt5 = "Rental Price [" + std::to_string(existing->RentalPrice) + "]: ";
+                std::string dPrompt5 = "Rental Price [" + existing->RentalPrice.toString() + "]: ";
                 UIColors::printCenteredInput(dPrompt5, SCREEN_WIDTH, UIColors::YELLOW);
                 std::getline(std::cin, input);
-                dress.RentalPrice = input.empty() ? existing->RentalPrice : std::stod(input);
+                dress.RentalPrice = existing->RentalPrice;
+                if (!input.empty() && !Money::parse(input, dress.RentalPrice)) {
+                    InputValidator::showWarning("Invalid price; keeping RM " + existing->RentalPrice.toString() + ".");
+                    dress.RentalPrice = existing->RentalPrice;
+                }
                 
                 std::string dPrompt6 = "Condition Status [" + existing->ConditionStatus + "]: ";
                 UIColors::printCenteredInput(dPrompt6, SCREEN_WIDTH, UIColors::YELLOW);
                 std::getline(std::cin, input);
                 dress.ConditionStatus = input.empty() ? existing->ConditionStatus : input;
                 
-                std::string availPrompt7 = "Availability Status [" + existing->AvailabilityStatus + "]: ";
+                // Available and Rented follow the stock; only Maintenance is set by hand
+                bool inMaintenance = existing->AvailabilityStatus == "Maintenance";
+                std::string availPrompt7 = std::string("Under Maintenance (y/n) [") + (inMaintenance ? "y" : "n") + "]: ";
                 UIColors::printCenteredInput(availPrompt7, SCREEN_WIDTH, UIColors::YELLOW);
                 std::getline(std::cin, input);
-                dress.AvailabilityStatus = input.empty() ? existing->AvailabilityStatus : input;
+                if (input == "y" || input == "Y") inMaintenance = true;
+                if (input == "n" || input == "N") inMaintenance = false;
+                dress.AvailabilityStatus = inMaintenance ? "Maintenance" : "Available";
                 
                 std::string cleanPrompt8 = "Cleaning Status [" + existing->CleaningStatus + "]: ";
                 UIColors::printCenteredInput(cleanPrompt8, SCREEN_WIDTH, UIColors::YELLOW);
                 std::getline(std::cin, input);
                 dress.CleaningStatus = input.empty() ? existing->CleaningStatus : input;
+                dress.Version = existing->Version;
                 
                 if (InputValidator::confirm("Are you sure you want to update this dress?")) {
                     if (dm.updateDress(dressID, dress)) {
@@ -825,6 +853,234 @@ void dressManagementMenu() {
                 InputValidator::pause();
                 break;
             }
+            case 8: {
+                DressCatalog catalog;
+                if (!catalog.load() || catalog.size() == 0) {
+                    UIColors::printInfo("No dresses found. Please add dresses first.");
+                    InputValidator::pause();
+                    break;
+                }
+                
+                DressCatalog::Query query;
+                while (true) {
+                    DressCatalog::Result result = catalog.search(query, 20);
+                    
+                    UIColors::printHeader("BROWSE DRESSES BY ATTRIBUTE", SCREEN_WIDTH);
+                    {
+                        RenderFrame frame;
+                        TableRenderer table(SCREEN_WIDTH);
+                        table.addColumn("#", 3);
+                        table.addColumn("Attribute", 14);
+                        table.addColumn("Values (matching dresses), [selected]");
+                        for (int f = 0; f < DressCatalog::FACET_COUNT; ++f) {
+                            const std::vector<std::string>& accepted = query.accepted[f];
+                            std::string values;
+                            for (const auto& facetCount : result.facets[f]) {
+                                bool selected = std::find(accepted.begin(), accepted.end(), facetCount.value) != accepted.end();
+                                if (!values.empty()) values += ", ";
+                                values += (selected ? "[" + facetCount.value + "]" : facetCount.value) +
+                                          " (" + std::to_string(facetCount.count) + ")";
+                            }
+                            table.addRow({ std::to_string(f + 1), DressCatalog::facetName(static_cast<DressCatalog::Facet>(f)),
+                                           values.empty() ? "-" : values });
+                        }
+                        table.render();
+                    }
+                    
+                    std::vector<Dress> matches;
+                    for (int id : result.dressIDs) {
+                        Dress match;
+                        if (catalog.getDress(id, match)) matches.push_back(match);
+                    }
+                    dm.displayAllDresses(matches);
+                    UIColors::printInfo("Showing " + std::to_string(matches.size()) + " of " +
+                                        std::to_string(result.total) + " matching dresses.");
+                    
+                    UIColors::printCenteredInput("Attribute to filter (1-6), 7 to clear filters, 0 to go back: ", SCREEN_WIDTH, UIColors::WHITE);
+                    int facetChoice = InputValidator::getInt("", 0, 7);
+                    if (facetChoice == 0) break;
+                    if (facetChoice == 7) {
+                        query = DressCatalog::Query();
+                        continue;
+                    }
+                    
+                    // Toggle one value of the chosen attribute
+                    DressCatalog::Facet facet = static_cast<DressCatalog::Facet>(facetChoice - 1);
+                    const std::vector<DressCatalog::FacetCount>& counts = result.facets[facet];
+                    if (counts.empty()) continue;
+                    for (size_t v = 0; v < counts.size(); ++v) {
+                        UIColors::printMenuOption(static_cast<int>(v + 1),
+                                                  counts[v].value + " (" + std::to_string(counts[v].count) + ")");
+                    }
+                    UIColors::printCenteredInput("Value to add or remove (0 to cancel): ", SCREEN_WIDTH, UIColors::WHITE);
+                    int valueChoice = InputValidator::getInt("", 0, static_cast<int>(counts.size()));
+                    if (valueChoice == 0) continue;
+                    
+                    std::vector<std::string>& accepted = query.accepted[facet];
+                    const std::string& value = counts[valueChoice - 1].value;
+                    std::vector<std::string>::iterator found = std::find(accepted.begin(), accepted.end(), value);
+                    if (found != accepted.end()) {
+                        accepted.erase(found);
+                    } else {
+                        accepted.push_back(value);
+                    }
+                }
+                break;
+            }
+            case 9: {
+                // Show list first
+                std::vector<Dress> dresses = dm.getAllDresses();
+                if (dresses.empty()) {
+                    UIColors::printInfo("No dresses found. Please add dresses first.");
+                    InputValidator::pause();
+                    break;
+                }
+                
+                UIColors::printHeader("UPDATE STOCK LEVEL", SCREEN_WIDTH);
+                UIColors::printInfo("Please select a dress from the list below:");
+                dm.displayAllDresses(dresses);
+                
+                UIColors::printCenteredInput("Enter Dress ID (0 to cancel): ", SCREEN_WIDTH, UIColors::WHITE);
+                dressID = InputValidator::getInt("", 0);
+                if (dressID == 0) {
+                    UIColors::printInfo("Update cancelled.");
+                    InputValidator::pause();
+                    break;
+                }
+                
+                StockLevel level;
+                if (!DressStock::getLevel(dressID, level)) {
+                    InputValidator::showError("Dress not found.");
+                    InputValidator::pause();
+                    break;
+                }
+                
+                UIColors::printInfo(level.DressName + ": " + std::to_string(level.StockQuantity) + " units, " +
+                                    std::to_string(level.UnitsOut) + " on active rentals, low stock below " +
+                                    std::to_string(level.MinimumStockLevel) + " free.");
+                int quantity = InputValidator::getInt("Units owned*: ", 0, 1000);
+                int minimumLevel = InputValidator::getInt("Low stock below (free units)*: ", 0, 1000);
+                
+                if (InputValidator::confirm("Are you sure you want to update the stock level?")) {
+                    if (DressStock::setStockQuantity(dressID, quantity, minimumLevel)) {
+                        InputValidator::showSuccess("Stock level updated successfully!");
+                    } else {
+                        InputValidator::showError("Failed to update stock level.");
+                    }
+                } else {
+                    UIColors::printInfo("Update cancelled.");
+                }
+                InputValidator::pause();
+                break;
+            }
+            case 10: {
+                AvailabilityCalendar calendar;
+                if (!calendar.load() || calendar.size() == 0) {
+                    UIColors::printInfo("No dresses found. Please add dresses first.");
+                    InputValidator::pause();
+                    break;
+                }
+                
+                UIColors::printHeader("AVAILABILITY CALENDAR", SCREEN_WIDTH);
+                UIColors::printMenuOption(1, "Free Days of Dresses");
+                UIColors::printMenuOption(2, "Dresses Free on a Date");
+                std::cout << std::endl;
+                UIColors::printMenuOption(0, "Back");
+                UIColors::printCenteredInput("Enter your choice: ", SCREEN_WIDTH, UIColors::WHITE);
+                int calendarChoice = InputValidator::getInt("", 0, 2);
+                
+                if (calendarChoice == 1) {
+                    // Several dresses (e.g. a bridal party) show the days they are all free
+                    std::string idList = InputValidator::getString("Dress IDs (comma separated)*: ", true, 1, 200);
+                    std::vector<int> dressIDs;
+                    std::stringstream ss(idList);
+                    std::string item;
+                    bool valid = true;
+                    while (std::getline(ss, item, ',')) {
+                        int id = std::atoi(item.c_str());
+                        if (!calendar.contains(id)) {
+                            InputValidator::showError("Dress ID " + item + " not found.");
+                            valid = false;
+                            break;
+                        }
+                        dressIDs.push_back(id);
+                    }
+                    if (valid && !dressIDs.empty()) calendar.displayCalendar(dressIDs);
+                } else if (calendarChoice == 2) {
+                    std::string date = InputValidator::getDate("Date needed*");
+                    int dayCount = InputValidator::getInt("Number of days (1-14)*: ", 1, 14);
+                    int firstDay = calendar.dayOf(date);
+                    if (firstDay < 0 || firstDay + dayCount > AvailabilityCalendar::WINDOW_DAYS) {
+                        InputValidator::showError("Dates must fall within the next " +
+                                                  std::to_string(AvailabilityCalendar::WINDOW_DAYS) + " days.");
+                    } else {
+                        std::vector<int> free = calendar.freeDresses(firstDay, firstDay + dayCount - 1);
+                        std::vector<Dress> matches;
+                        for (size_t i = 0; i < free.size() && i < 20; ++i) {
+                            Dress* match = dm.getDressByID(free[i]);
+                            if (match) {
+                                matches.push_back(*match);
+                                delete match;
+                            }
+                        }
+                        if (matches.empty()) {
+                            UIColors::printInfo("No dress is free on those dates.");
+                        } else {
+                            dm.displayAllDresses(matches);
+                            UIColors::printInfo("Showing " + std::to_string(matches.size()) + " of " +
+                                                std::to_string(free.size()) + " dresses free from " + date + ".");
+                        }
+                    }
+                }
+                if (calendarChoice != 0) InputValidator::pause();
+                break;
+            }
+            case 11: {
+                UIColors::printHeader("CLEANING QUEUE", SCREEN_WIDTH);
+                std::vector<CleaningJob> jobs = CleaningScheduler::getQueue();
+                if (jobs.empty()) {
+                    UIColors::printInfo("No dresses are waiting for cleaning.");
+                } else {
+                    CleaningScheduler::displayQueue(jobs);
+                    UIColors::printInfo(std::to_string(jobs.size()) + " dress(es) waiting; up to " +
+                                        std::to_string(CleaningScheduler::capacityFromConfig()) + " cleaned per day.");
+                }
+                
+                UIColors::printMenuOption(1, "Mark Jobs Cleaned");
+                UIColors::printMenuOption(2, "Replan Queue Now");
+                std::cout << std::endl;
+                UIColors::printMenuOption(0, "Back");
+                UIColors::printCenteredInput("Enter your choice: ", SCREEN_WIDTH, UIColors::WHITE);
+                int cleaningChoice = InputValidator::getInt("", 0, 2);
+                
+                if (cleaningChoice == 1) {
+                    std::string idList = InputValidator::getString("Job IDs (comma separated)*: ", true, 1, 500);
+                    std::vector<int> jobIDs;
+                    std::stringstream ss(idList);
+                    std::string item;
+                    while (std::getline(ss, item, ',')) {
+                        int id = std::atoi(item.c_str());
+                        if (id > 0) jobIDs.push_back(id);
+                    }
+                    std::string date = InputValidator::getDate("Cleaned on*");
+                    int done = CleaningScheduler::complete(jobIDs, date);
+                    if (done < 0) {
+                        InputValidator::showError("Failed to update the cleaning queue.");
+                    } else {
+                        InputValidator::showSuccess(std::to_string(done) + " dress(es) marked clean.");
+                    }
+                } else if (cleaningChoice == 2) {
+                    if (CleaningScheduler::getInstance().runOnce()) {
+                        CleaningScheduler::Stats plan = CleaningScheduler::getInstance().getStats();
+                        InputValidator::showSuccess("Queue replanned: " + std::to_string(plan.jobsMoved) + " job(s) moved, " +
+                                                    std::to_string(plan.jobsLate) + " late for their next booking.");
+                    } else {
+                        InputValidator::showError("Failed to replan: " + CleaningScheduler::getInstance().getStats().lastError);
+                    }
+                }
+                InputValidator::pause();
+                break;
+            }
             default:
                 InputValidator::showError("Invalid choice!");
         }
@@ -853,12 +1109,14 @@ void rentalManagementMenu() {
         UIColors::printMenuOption(5, "Return Rental");
         UIColors::printMenuOption(6, "View Customer Rentals");
         UIColors::printMenuOption(7, "Change Rental Status");
+        UIColors::printMenuOption(8, "Return Multiple Rentals");
+        UIColors::printMenuOption(9, "Advance Reservations");
         std::cout << std::endl;
         UIColors::printMenuOption(0, "Back to Main Menu");
         UIColors::printSeparator(SCREEN_WIDTH);
         
         UIColors::printCenteredInput("Enter your choice: ", SCREEN_WIDTH, UIColors::WHITE);
-        choice = InputValidator::getInt("", 0, 7);
+        choice = InputValidator::getInt("", 0, 9);
         
         if (choice == 0) break;
         
@@ -1085,10 +1343,8 @@ void rentalManagementMenu() {
                         rental.RentalDate = res->getString("RentalDate");
                         rental.DueDate = res->getString("DueDate");
                         rental.ReturnDate = res->getString("ReturnDate");
-                        rental.TotalAmount = res->getDouble("TotalAmount");
-                        if (res->wasNull()) rental.TotalAmount = 0.0;
-                        rental.LateFee = res->getDouble("LateFee");
-                        if (res->wasNull()) rental.LateFee = 0.0;
+                        rental.TotalAmount = Money::fromString(res->getString("TotalAmount"));
+                        rental.LateFee = Money::fromString(res->getString("LateFee"));
                         rental.Status = res->getString("Status");
                         returnedRentals.push_back(rental);
                     }
@@ -1176,6 +1432,173 @@ void rentalManagementMenu() {
                 InputValidator::pause();
                 break;
             }
+            case 8: {
+                std::vector<Rental> rentals = rm.getActiveRentals();
+                if (rentals.empty()) {
+                    UIColors::printInfo("No active rentals to return.");
+                    InputValidator::pause();
+                    break;
+                }
+                UIColors::printHeader("RETURN MULTIPLE RENTALS", SCREEN_WIDTH);
+                {
+                    RenderFrame frame;
+                    TableRenderer table(SCREEN_WIDTH);
+                    table.addColumn("Rental ID", 0, 0, TableRenderer::ALIGN_RIGHT);
+                    table.addColumn("Customer ID", 0, 0, TableRenderer::ALIGN_RIGHT);
+                    table.addColumn("Rental Date");
+                    table.addColumn("Due Date");
+                    table.addColumn("Late Fee (RM)", 0, 0, TableRenderer::ALIGN_RIGHT);
+                    for (const auto& rental : rentals) {
+                        table.addRow({ std::to_string(rental.RentalID), std::to_string(rental.CustomerID),
+                                       rental.RentalDate, rental.DueDate, rental.LateFee.toString() });
+                    }
+                    table.render();
+                }
+                
+                std::string idList = InputValidator::getString("Rental IDs, separated by commas (blank to cancel): ", false);
+                std::vector<int> selected;
+                std::stringstream ss(idList);
+                std::string token;
+                bool valid = true;
+                while (std::getline(ss, token, ',')) {
+                    token.erase(0, token.find_first_not_of(" \t"));
+                    token.erase(token.find_last_not_of(" \t") + 1);
+                    if (token.empty()) continue;
+                    if (token.find_first_not_of("0123456789") != std::string::npos) {
+                        InputValidator::showError("Not a rental ID: " + token);
+                        valid = false;
+                        break;
+                    }
+                    int id = std::atoi(token.c_str());
+                    bool isActive = false;
+                    for (const auto& rental : rentals) {
+                        if (rental.RentalID == id) isActive = true;
+                    }
+                    if (!isActive) {
+                        UIColors::printWarning("Rental " + token + " is not active and will be skipped.");
+                        continue;
+                    }
+                    if (std::find(selected.begin(), selected.end(), id) == selected.end()) selected.push_back(id);
+                }
+                if (!valid || selected.empty()) {
+                    UIColors::printInfo("Return cancelled.");
+                    InputValidator::pause();
+                    break;
+                }
+                
+                returnDate = InputValidator::getDate("Return Date*");
+                
+                if (InputValidator::confirm("Are you sure you want to return " + std::to_string(selected.size()) + " rental(s)?")) {
+                    int returned = rm.returnRentals(selected, returnDate);
+                    if (returned < 0) {
+                        InputValidator::showError("Failed to return rentals. Nothing was changed.");
+                    } else if (returned < static_cast<int>(selected.size())) {
+                        UIColors::printWarning(std::to_string(returned) + " of " + std::to_string(selected.size()) +
+                                               " rentals returned; the others were returned elsewhere meanwhile.");
+                    } else {
+                        InputValidator::showSuccess(std::to_string(returned) + " rental(s) returned successfully!");
+                    }
+                } else {
+                    UIColors::printInfo("Return cancelled.");
+                }
+                InputValidator::pause();
+                break;
+            }
+            case 9: {
+                ReservationManager resm;
+                while (true) {
+                    UIColors::printHeader("ADVANCE RESERVATIONS", SCREEN_WIDTH);
+                    UIColors::printMenuOption(1, "New Reservation");
+                    UIColors::printMenuOption(2, "View Upcoming Reservations");
+                    UIColors::printMenuOption(3, "Cancel Reservation");
+                    UIColors::printMenuOption(4, "Start Rental from Reservation");
+                    UIColors::printMenuOption(5, "Replan All Reservations");
+                    std::cout << std::endl;
+                    UIColors::printMenuOption(0, "Back");
+                    UIColors::printSeparator(SCREEN_WIDTH);
+                    
+                    UIColors::printCenteredInput("Enter your choice: ", SCREEN_WIDTH, UIColors::WHITE);
+                    int reservationChoice = InputValidator::getInt("", 0, 5);
+                    if (reservationChoice == 0) break;
+                    
+                    if (reservationChoice == 1) {
+                        UIColors::printHeader("NEW RESERVATION", SCREEN_WIDTH);
+                        UIColors::printCenteredInput("Customer ID* (0 to cancel): ", SCREEN_WIDTH, UIColors::WHITE);
+                        customerID = InputValidator::getInt("", 0);
+                        if (customerID == 0) continue;
+                        Customer* customer = cm.getCustomerByID(customerID);
+                        if (!customer) {
+                            InputValidator::showError("Customer not found. Please create the customer first.");
+                            InputValidator::pause();
+                            continue;
+                        }
+                        delete customer;
+                        
+                        // Customers book a style and size; the dress is assigned by the planner
+                        std::string category = InputValidator::getString("Category*: ", true, 1, 50);
+                        std::string size = InputValidator::getString("Size*: ", true, 1, 10);
+                        std::string startDate = InputValidator::getDate("Pickup Date*");
+                        std::string endDate = InputValidator::getDate("Return Date*");
+                        
+                        int reservationID = resm.createReservation(customerID, category, size, startDate, endDate);
+                        Reservation* reservation = reservationID > 0 ? resm.getReservationByID(reservationID) : nullptr;
+                        if (!reservation) {
+                            InputValidator::showError("Failed to create reservation.");
+                        } else if (reservation->AssignedDressID > 0) {
+                            InputValidator::showSuccess("Reservation " + std::to_string(reservationID) +
+                                                        " booked with dress ID " +
+                                                        std::to_string(reservation->AssignedDressID) + ".");
+                        } else {
+                            UIColors::printWarning("Reservation " + std::to_string(reservationID) +
+                                                   " booked, but no dress of that category and size is free on all"
+                                                   " of those days yet. It will get one when a booking changes.");
+                        }
+                        delete reservation;
+                    } else if (reservationChoice == 5) {
+                        int changed = resm.replanAll();
+                        if (changed < 0) {
+                            InputValidator::showError("Failed to replan reservations.");
+                        } else {
+                            InputValidator::showSuccess("Reservations replanned; " + std::to_string(changed) +
+                                                        " changed dress.");
+                        }
+                    } else {
+                        std::vector<Reservation> upcoming = resm.getUpcomingReservations();
+                        if (upcoming.empty()) {
+                            UIColors::printInfo("No upcoming reservations.");
+                            InputValidator::pause();
+                            continue;
+                        }
+                        UIColors::printHeader("UPCOMING RESERVATIONS", SCREEN_WIDTH);
+                        resm.displayReservations(upcoming);
+                        if (reservationChoice == 2) {
+                            InputValidator::pause();
+                            continue;
+                        }
+                        
+                        UIColors::printCenteredInput("Reservation ID (0 to cancel): ", SCREEN_WIDTH, UIColors::WHITE);
+                        int reservationID = InputValidator::getInt("", 0);
+                        if (reservationID == 0) continue;
+                        if (reservationChoice == 3) {
+                            if (!InputValidator::confirm("Cancel reservation " + std::to_string(reservationID) + "?")) continue;
+                            if (resm.cancelReservation(reservationID)) {
+                                InputValidator::showSuccess("Reservation cancelled.");
+                            } else {
+                                InputValidator::showError("Failed to cancel reservation.");
+                            }
+                        } else {
+                            int newRentalID = resm.fulfilReservation(reservationID);
+                            if (newRentalID < 0) {
+                                InputValidator::showError("Failed to start the rental.");
+                            } else {
+                                InputValidator::showSuccess("Rental " + std::to_string(newRentalID) + " created.");
+                            }
+                        }
+                    }
+                    InputValidator::pause();
+                }
+                break;
+            }
             default:
                 InputValidator::showError("Invalid choice!");
         }
@@ -1191,7 +1614,6 @@ void paymentManagementMenu() {
     }
     
     PaymentManager pm;
-    RentalManager rm;
     int choice;
     
     while (true) {
@@ -1211,24 +1633,22 @@ void paymentManagementMenu() {
         if (choice == 0) break;
         
         int rentalID, paymentID;
-        double amount;
+        Money amount;
         std::string paymentMethod, paymentDate, status, transactionRef;
         
         switch (choice) {
             case 1: {
                 UIColors::printHeader("PROCESS PAYMENT", SCREEN_WIDTH);
                 
-                // Show active rentals first
-                std::vector<Rental> rentals = rm.getActiveRentals();
-                if (rentals.empty()) {
+                // Show what every active rental still owes, read in one query
+                std::vector<RentalBalance> balances = pm.getActiveBalances();
+                if (balances.empty()) {
                     UIColors::printInfo("No active rentals found. Please create a rental first.");
                     InputValidator::pause();
                     break;
                 }
                 UIColors::printInfo("Please select a rental from the list below:");
-                for (const auto& rental : rentals) {
-                    rm.displayRental(rental);
-                }
+                pm.displayBalances(balances);
                 
                 UIColors::printCenteredInput("Rental ID* (0 to cancel): ", SCREEN_WIDTH, UIColors::WHITE);
                 rentalID = InputValidator::getInt("", 0);
@@ -1238,31 +1658,30 @@ void paymentManagementMenu() {
                     break;
                 }
                 
-                Rental* rental = rm.getRentalByID(rentalID);
-                if (!rental) {
+                std::vector<RentalBalance> selected = pm.getBalances(std::vector<int>(1, rentalID));
+                if (selected.empty()) {
                     InputValidator::showError("Rental not found.");
                     InputValidator::pause();
                     break;
                 }
                 
-                double totalDue = rental->TotalAmount + rental->LateFee;
-                double totalPaid = pm.getTotalPaid(rentalID);
-                double remaining = totalDue - totalPaid;
+                Money totalDue = selected[0].AmountDue;
+                Money totalPaid = selected[0].AmountPaid;
+                Money remaining = selected[0].Outstanding;
                 
                 UIColors::printCentered("Payment Summary", SCREEN_WIDTH, UIColors::BOLD + UIColors::CYAN);
-                UIColors::printCentered("Total Due: RM " + std::to_string(totalDue), SCREEN_WIDTH, UIColors::RED);
-                UIColors::printCentered("Total Paid: RM " + std::to_string(totalPaid), SCREEN_WIDTH, UIColors::GREEN);
-                UIColors::printCentered("Remaining: RM " + std::to_string(remaining), SCREEN_WIDTH, UIColors::YELLOW);
+                UIColors::printCentered("Total Due: " + totalDue.toDisplay(), SCREEN_WIDTH, UIColors::RED);
+                UIColors::printCentered("Total Paid: " + totalPaid.toDisplay(), SCREEN_WIDTH, UIColors::GREEN);
+                UIColors::printCentered("Remaining: " + remaining.toDisplay(), SCREEN_WIDTH, UIColors::YELLOW);
                 
-                if (remaining <= 0) {
+                if (!remaining.isPositive()) {
                     UIColors::printInfo("This rental is already fully paid.");
-                    delete rental;
                     InputValidator::pause();
                     break;
                 }
                 
                 UIColors::printCenteredInput("Payment Amount (RM)*: ", SCREEN_WIDTH, UIColors::WHITE);
-                amount = InputValidator::getDouble("", 0.01, remaining);
+                amount = InputValidator::getMoney("", Money::fromCents(1), remaining);
                 UIColors::printCenteredInput("Payment Method (Cash/Credit Card/Debit Card/Online)*: ", SCREEN_WIDTH, UIColors::WHITE);
                 std::getline(std::cin, paymentMethod);
                 paymentDate = InputValidator::getDate("Payment Date*");
@@ -1277,7 +1696,6 @@ void paymentManagementMenu() {
                 } else {
                     UIColors::printInfo("Payment cancelled.");
                 }
-                delete rental;
                 InputValidator::pause();
                 break;
             }
@@ -1293,17 +1711,15 @@ void paymentManagementMenu() {
             }
             case 3: {
                 // Show rentals first
-                std::vector<Rental> rentals = rm.getActiveRentals();
-                if (rentals.empty()) {
+                std::vector<RentalBalance> balances = pm.getActiveBalances();
+                if (balances.empty()) {
                     UIColors::printInfo("No active rentals found.");
                     InputValidator::pause();
                     break;
                 }
                 UIColors::printHeader("VIEW PAYMENTS BY RENTAL", SCREEN_WIDTH);
                 UIColors::printInfo("Please select a rental from the list below:");
-                for (const auto& rental : rentals) {
-                    rm.displayRental(rental);
-                }
+                pm.displayBalances(balances);
                 
                 UIColors::printCentered("Enter Rental ID (0 to cancel): ", SCREEN_WIDTH, UIColors::WHITE);
                 rentalID = InputValidator::getInt("", 0);
@@ -1417,12 +1833,14 @@ void reportsMenu() {
         UIColors::printMenuOption(7, "Income Statement");
         UIColors::printMenuOption(8, "Customer Loyalty Report");
         UIColors::printMenuOption(9, "Profit Margin Report");
+        UIColors::printMenuOption(10, "Query Performance Statistics");
+        UIColors::printMenuOption(11, "Index Advisor (EXPLAIN Hot Queries)");
         std::cout << std::endl;
         UIColors::printMenuOption(0, "Back to Main Menu");
         UIColors::printSeparator(SCREEN_WIDTH);
         
         UIColors::printCenteredInput("Enter your choice: ", SCREEN_WIDTH, UIColors::WHITE);
-        choice = InputValidator::getInt("", 0, 9);
+        choice = InputValidator::getInt("", 0, 11);
         
         if (choice == 0) break;
         
@@ -1477,6 +1895,23 @@ void reportsMenu() {
                 rm.generateProfitMarginReport();
                 InputValidator::pause();
                 break;
+            case 10:
+                QueryStats::dump(std::cout);
+                DatabaseManager::getInstance().printReadRouting(std::cout);
+                InputValidator::pause();
+                break;
+            case 11: {
+                UIColors::printHeader("INDEX ADVISOR", SCREEN_WIDTH);
+                IndexAdvisor advisor;
+                if (advisor.analyze()) {
+                    RenderFrame frame;
+                    advisor.printReport();
+                } else {
+                    InputValidator::showError("Could not run the index advisor.");
+                }
+                InputValidator::pause();
+                break;
+            }
             default:
                 InputValidator::showError("Invalid choice!");
         }
@@ -0,0 +1,123 @@
+#include "Money.h"
+#include <cmath>
+#include <cstdlib>
+
+namespace {
+
+// Parses [-]digits[.digits]. With exact set, more than two decimals is an
+// error; otherwise the third decimal rounds the result (halves away from zero).
+bool parseDecimal(const std::string& text, bool exact, long long& cents) {
+    size_t first = text.find_first_not_of(" \t\r\n");
+    if (first == std::string::npos) return false;
+    size_t last = text.find_last_not_of(" \t\r\n");
+    size_t i = first;
+    bool negative = false;
+    if (text[i] == '-' || text[i] == '+') {
+        negative = text[i] == '-';
+        ++i;
+    }
+
+    long long whole = 0;
+    int wholeDigits = 0;
+    while (i <= last && text[i] >= '0' && text[i] <= '9') {
+        if (whole > 9000000000000000LL) return false;
+        whole = whole * 10 + (text[i] - '0');
+        ++wholeDigits;
+        ++i;
+    }
+
+    long long sen = 0;
+    int decimals = 0;
+    bool roundUp = false;
+    if (i <= last && text[i] == '.') {
+        ++i;
+        while (i <= last && text[i] >= '0' && text[i] <= '9') {
+            if (decimals < 2) {
+                sen = sen * 10 + (text[i] - '0');
+            } else if (exact) {
+                return false;
+            } else if (decimals == 2) {
+                roundUp = text[i] >= '5';
+            }
+            ++decimals;
+            ++i;
+        }
+    }
+    if (i <= last || (wholeDigits == 0 && decimals == 0)) return false;
+
+    if (decimals == 1) sen *= 10;
+    cents = whole * 100 + sen + (roundUp ? 1 : 0);
+    if (negative) cents = -cents;
+    return true;
+}
+
+} // namespace
+
+Money Money::fromDouble(double value) {
+    return fromCents(static_cast<long long>(std::llround(value * 100.0)));
+}
+
+bool Money::parse(const std::string& text, Money& amount) {
+    long long cents = 0;
+    if (!parseDecimal(text, true, cents)) return false;
+    amount = fromCents(cents);
+    return true;
+}
+
+Money Money::fromString(const std::string& text) {
+    long long cents = 0;
+    if (parseDecimal(text, false, cents)) return fromCents(cents);
+    // A DOUBLE expression can come back in exponent form
+    if (text.empty()) return Money();
+    return fromDouble(std::strtod(text.c_str(), nullptr));
+}
+
+size_t Money::format(char* buffer) const {
+    unsigned long long magnitude = cents < 0 ? 0ULL - static_cast<unsigned long long>(cents)
+                                             : static_cast<unsigned long long>(cents);
+    // Digits are produced from the right: two decimals, the point, then at
+    // least one whole digit
+    char reversed[MAX_TEXT];
+    size_t count = 0;
+    reversed[count++] = static_cast<char>('0' + magnitude % 10);
+    magnitude /= 10;
+    reversed[count++] = static_cast<char>('0' + magnitude % 10);
+    magnitude /= 10;
+    reversed[count++] = '.';
+    do {
+        reversed[count++] = static_cast<char>('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude != 0);
+
+    size_t length = 0;
+    if (cents < 0) buffer[length++] = '-';
+    while (count > 0) buffer[length++] = reversed[--count];
+    return length;
+}
+
+std::string Money::toString() const {
+    char buffer[MAX_TEXT];
+    return std::string(buffer, format(buffer));
+}
+
+std::string Money::toDisplay() const {
+    char buffer[MAX_TEXT + 3] = { 'R', 'M', ' ' };
+    return std::string(buffer, 3 + format(buffer + 3));
+}
+
+Money Money::dividedBy(long long count) const {
+    if (count == 0) return Money();
+    long long quotient = cents / count;
+    long long remainder = cents % count;
+    // Round half away from zero
+    if (remainder != 0 && std::llabs(remainder) * 2 >= std::llabs(count)) {
+        quotient += (cents < 0) != (count < 0) ? -1 : 1;
+    }
+    return fromCents(quotient);
+}
+
+std::ostream& operator<<(std::ostream& out, const Money& amount) {
+    char buffer[Money::MAX_TEXT];
+    buffer[amount.format(buffer)] = '\0';
+    return out << buffer;
+}
@@ -0,0 +1,234 @@
+#include "OverdueSweeper.h"
+#include "AppConfig.h"
+#include "DatabaseManager.h"
+#include "RentalManager.h"
+#include "LateFeePolicy.h"
+#include "Trace.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <exception>
+#include <iostream>
+
+namespace {
+
+const char* SWEEP_LOCK = "SELECT GET_LOCK('dress_rental_overdue_sweep', 0) AS acquired";
+const char* SWEEP_UNLOCK = "SELECT RELEASE_LOCK('dress_rental_overdue_sweep')";
+
+std::string timestampNow() {
+    std::time_t now = std::time(nullptr);
+    std::tm tmNow;
+#ifdef _WIN32
+    localtime_s(&tmNow, &now);
+#else
+    localtime_r(&now, &tmNow);
+#endif
+    char buffer[32];
+    std::strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", &tmNow);
+    return buffer;
+}
+
+int runUpdate(const std::string& sql) {
+    sql::PreparedStatement* pstmt = DatabaseManager::getInstance().prepare(sql);
+    int rows = DatabaseManager::getInstance().executePreparedUpdate(pstmt);
+    delete pstmt;
+    return rows;
+}
+
+} // namespace
+
+OverdueSweeper& OverdueSweeper::getInstance() {
+    static OverdueSweeper instance;
+    return instance;
+}
+
+OverdueSweeper::OverdueSweeper() : stopRequested(false), running(false), intervalSeconds(0) {
+    stats.runs = 0;
+    stats.lastDurationMs = 0.0;
+    stats.rowsTouched = 0;
+    stats.lateFeesUpdated = 0;
+    stats.remindersQueued = 0;
+}
+
+OverdueSweeper::~OverdueSweeper() {
+    stop();
+}
+
+int OverdueSweeper::intervalFromConfig() {
+    int seconds = AppConfig::getInstance().getInt("sweep_interval", 300);
+    return seconds > 0 ? seconds : 0;
+}
+
+void OverdueSweeper::start(int seconds) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (running || seconds <= 0) return;
+    intervalSeconds = seconds;
+    stopRequested = false;
+    running = true;
+    worker = std::thread(&OverdueSweeper::threadMain, this);
+}
+
+void OverdueSweeper::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!running) return;
+        stopRequested = true;
+    }
+    wakeUp.notify_all();
+    if (worker.joinable()) worker.join();
+    std::lock_guard<std::mutex> lock(mutex);
+    running = false;
+}
+
+bool OverdueSweeper::isRunning() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return running;
+}
+
+OverdueSweeper::Stats OverdueSweeper::getStats() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
+
+bool OverdueSweeper::runOnce() {
+    return sweep(true);
+}
+
+void OverdueSweeper::threadMain() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!stopRequested) {
+        lock.unlock();
+        sweep(false);
+        lock.lock();
+        wakeUp.wait_for(lock, std::chrono::seconds(intervalSeconds), [this] { return stopRequested; });
+    }
+    lock.unlock();
+    // This thread had its own connection; close it before the thread goes away
+    DatabaseManager::getInstance().releaseThreadConnection();
+}
+
+bool OverdueSweeper::sweep(bool forceDaily) {
+    TraceSpan span("sweeper.run");
+    std::chrono::steady_clock::time_point started = std::chrono::steady_clock::now();
+    std::string today = LateFeePolicy::today();
+    bool daily = forceDaily;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (lastDailyDate != today) daily = true;
+    }
+
+    DatabaseManager& db = DatabaseManager::getInstance();
+    int rowsTouched = 0;
+    int lateFees = 0;
+    int reminders = 0;
+    bool dailyDone = false;
+    std::string error;
+    bool locked = false;
+    try {
+        if (!db.getConnection()) {
+            error = "Database connection failed";
+        } else {
+            sql::ResultSet* res = db.executeSelect(SWEEP_LOCK);
+            locked = res && res->next() && res->getInt("acquired") == 1;
+            if (res) delete res;
+            if (!locked) error = "Another instance is running the sweep";
+        }
+
+        if (locked && daily && !forceDaily) {
+            // Another instance may have done today's part already
+            sql::ResultSet* res = db.executeSelect(
+                "SELECT COUNT(*) AS done FROM SystemCounters "
+                "WHERE CounterName = 'LastDailySweep' AND UpdatedAt >= CURDATE()"
+            );
+            if (res && res->next() && res->getInt("done") > 0) {
+                daily = false;
+                dailyDone = true;
+            }
+            if (res) delete res;
+        }
+
+        if (locked && daily) {
+            TraceSpan dailySpan("sweeper.daily");
+            RentalManager rm;
+            lateFees = rm.sweepLateFees();
+            int holds = rm.sweepOverdueHolds();
+            if (lateFees < 0) {
+                error = "Late fee sweep failed";
+                lateFees = 0;
+            } else if (holds < 0) {
+                error = "Overdue hold sweep failed";
+            } else {
+                reminders = runUpdate(
+                    "INSERT IGNORE INTO Reminders (RentalID, CustomerID, ReminderType, ReminderDate) "
+                    "SELECT RentalID, CustomerID, 'Overdue', CURDATE() FROM Rentals "
+                    "WHERE Status = 'Active' AND DueDate < CURDATE() "
+                    "UNION ALL "
+                    "SELECT RentalID, CustomerID, 'DueTomorrow', CURDATE() FROM Rentals "
+                    "WHERE Status = 'Active' AND DueDate = CURDATE() + INTERVAL 1 DAY"
+                );
+                dailyDone = true;
+            }
+            rowsTouched += lateFees + std::max(holds, 0) + reminders;
+        }
+
+        if (locked) {
+            // Counters the dashboard reads instead of scanning Rentals itself
+            TraceSpan countersSpan("sweeper.counters");
+            runUpdate(
+                "REPLACE INTO SystemCounters (CounterName, CounterValue, UpdatedAt) "
+                "SELECT 'ActiveRentals', COUNT(*), NOW() FROM Rentals WHERE Status = 'Active' "
+                "UNION ALL "
+                "SELECT 'OverdueRentals', COUNT(*), NOW() FROM Rentals "
+                "WHERE Status = 'Active' AND DueDate < CURDATE() "
+                "UNION ALL "
+                "SELECT 'OutstandingLateFees', COALESCE(SUM(LateFee), 0), NOW() FROM Rentals "
+                "WHERE Status = 'Active' AND DueDate < CURDATE() "
+                "UNION ALL "
+                "SELECT 'AvailableDresses', COUNT(*), NOW() FROM Dresses WHERE AvailabilityStatus = 'Available'"
+            );
+            rowsTouched += 4;
+            if (daily && dailyDone) {
+                sql::PreparedStatement* pstmt = db.prepare(
+                    "REPLACE INTO SystemCounters (CounterName, CounterValue, UpdatedAt) "
+                    "VALUES ('LastDailySweep', ?, NOW())"
+                );
+                pstmt->setInt(1, lateFees + reminders);
+                db.executePreparedUpdate(pstmt);
+                delete pstmt;
+            }
+        }
+    } catch (sql::SQLException& e) {
+        error = e.what();
+        dailyDone = false;
+    } catch (const std::exception& e) {
+        error = e.what();
+        dailyDone = false;
+    }
+
+    if (locked) {
+        try {
+            sql::ResultSet* res = db.executeSelect(SWEEP_UNLOCK);
+            if (res) delete res;
+        } catch (sql::SQLException& e) {
+            std::cerr << "Error releasing sweep lock: " << e.what() << std::endl;
+        }
+    }
+
+    double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+    std::lock_guard<std::mutex> lock(mutex);
+    stats.lastRunAt = timestampNow();
+    stats.lastDurationMs = elapsedMs;
+    stats.lastError = error;
+    if (error.empty()) {
+        stats.runs++;
+        stats.rowsTouched = rowsTouched;
+        if (dailyDone) lastDailyDate = today;
+        if (daily && dailyDone) {
+            stats.lastDailyRunAt = stats.lastRunAt;
+            stats.lateFeesUpdated = lateFees;
+            stats.remindersQueued = reminders;
+        }
+    }
+    return error.empty();
+}
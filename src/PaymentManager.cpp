@@ -1,17 +1,63 @@
 #include "PaymentManager.h"
 #include "UIColors.h"
 #include "MenuHandlers.h"
+#include "TableRenderer.h"
+#include "Trace.h"
+#include "LateFeePolicy.h"
 #include <iostream>
 #include <iomanip>
 #include <ctime>
+#include <map>
+
+namespace {
+
+// Rentals with their customer and RentalBalances ledger entry
+const char* BALANCE_SELECT =
+    "SELECT r.RentalID, c.Name, r.DueDate, r.Status, r.TotalAmount, b.AmountDue, b.AmountPaid "
+    "FROM Rentals r "
+    "JOIN Customers c ON c.CustomerID = r.CustomerID "
+    "JOIN RentalBalances b ON b.RentalID = r.RentalID ";
+
+// The ledger holds the late fee as last persisted (at least daily, by the
+// sweeper); a rental still out owes the fee as of today
+RentalBalance readBalance(sql::ResultSet* res, const std::string& today) {
+    RentalBalance balance;
+    balance.RentalID = res->getInt("RentalID");
+    balance.CustomerName = res->getString("Name");
+    balance.DueDate = res->getString("DueDate");
+    balance.Status = res->getString("Status");
+    balance.AmountDue = Money::fromString(res->getString("AmountDue"));
+    balance.AmountPaid = Money::fromString(res->getString("AmountPaid"));
+    if (balance.Status == "Active") {
+        Money current = Money::fromString(res->getString("TotalAmount")) +
+                        LateFeePolicy::standard().lateFee(balance.DueDate, "", today);
+        if (current > balance.AmountDue) balance.AmountDue = current;
+    }
+    balance.Outstanding = balance.AmountDue - balance.AmountPaid;
+    return balance;
+}
+
+// Run inside the transaction that changes the payment
+void addToAmountPaid(int rentalID, Money amount) {
+    sql::PreparedStatement* pstmt = DatabaseManager::getInstance().prepare(
+        "UPDATE RentalBalances SET AmountPaid = AmountPaid + ? WHERE RentalID = ?"
+    );
+    pstmt->setString(1, amount.toString());
+    pstmt->setInt(2, rentalID);
+    DatabaseManager::getInstance().executePreparedUpdate(pstmt);
+    delete pstmt;
+}
+
+} // namespace
 
 bool PaymentManager::validatePaymentMethod(const std::string& method) {
     return method == "Cash" || method == "Credit Card" || 
            method == "Debit Card" || method == "Online";
 }
 
-bool PaymentManager::createPayment(int rentalID, double amount, const std::string& paymentMethod,
+bool PaymentManager::createPayment(int rentalID, Money amount, const std::string& paymentMethod,
                                   const std::string& paymentDate, const std::string& transactionRef) {
+    TraceSpan span("payment.createPayment", rentalID);
     if (!validatePaymentMethod(paymentMethod)) {
         std::cerr << "Error: Invalid payment method. Use: Cash, Credit Card, Debit Card, or Online." << std::endl;
         return false;
@@ -23,49 +69,58 @@ bool PaymentManager::createPayment(int rentalID, double amount, const std::strin
             std::cerr << "Error: Database connection failed." << std::endl;
             return false;
         }
+        conn->setAutoCommit(false);
         
-        sql::PreparedStatement* pstmt = conn->prepareStatement(
+        sql::PreparedStatement* pstmt = DatabaseManager::getInstance().prepare(
             "INSERT INTO Payments (RentalID, Amount, PaymentMethod, PaymentDate, Status, TransactionReference) "
             "VALUES (?, ?, ?, ?, 'Completed', ?)"
         );
         
         pstmt->setInt(1, rentalID);
-        pstmt->setDouble(2, amount);
+        pstmt->setString(2, amount.toString());
         pstmt->setString(3, paymentMethod);
         pstmt->setString(4, paymentDate);
         pstmt->setString(5, transactionRef);
         
-        pstmt->executeUpdate();
+        DatabaseManager::getInstance().executePreparedUpdate(pstmt);
         delete pstmt;
+        
+        addToAmountPaid(rentalID, amount);
+        
+        conn->commit();
+        conn->setAutoCommit(true);
         return true;
     } catch (sql::SQLException& e) {
         std::cerr << "Error creating payment: " << e.what() << std::endl;
         std::cerr << "MySQL Error Code: " << e.getErrorCode() << std::endl;
+        DatabaseManager::rollbackQuietly();
         return false;
     } catch (const std::exception& e) {
         std::cerr << "Error: " << e.what() << std::endl;
+        DatabaseManager::rollbackQuietly();
         return false;
     }
 }
 
 Payment* PaymentManager::getPaymentByID(int paymentID) {
+    TraceSpan span("payment.getPaymentByID", paymentID);
     try {
         sql::Connection* conn = DatabaseManager::getInstance().getConnection();
         if (!conn) {
             std::cerr << "Error: Database connection failed." << std::endl;
             return nullptr;
         }
-        sql::PreparedStatement* pstmt = conn->prepareStatement(
+        sql::PreparedStatement* pstmt = DatabaseManager::getInstance().prepare(
             "SELECT * FROM Payments WHERE PaymentID = ?"
         );
         pstmt->setInt(1, paymentID);
-        sql::ResultSet* res = pstmt->executeQuery();
+        sql::ResultSet* res = DatabaseManager::getInstance().executePreparedQuery(pstmt);
         
         if (res && res->next()) {
             Payment* payment = new Payment();
             payment->PaymentID = res->getInt("PaymentID");
             payment->RentalID = res->getInt("RentalID");
-            payment->Amount = res->getDouble("Amount");
+            payment->Amount = Money::fromString(res->getString("Amount"));
             payment->PaymentMethod = res->getString("PaymentMethod");
             payment->PaymentDate = res->getString("PaymentDate");
             payment->Status = res->getString("Status");
@@ -84,6 +139,7 @@ Payment* PaymentManager::getPaymentByID(int paymentID) {
 }
 
 std::vector<Payment> PaymentManager::getPaymentsByRental(int rentalID) {
+    TraceSpan span("payment.getPaymentsByRental", rentalID);
     std::vector<Payment> payments;
     try {
         sql::Connection* conn = DatabaseManager::getInstance().getConnection();
@@ -91,17 +147,17 @@ std::vector<Payment> PaymentManager::getPaymentsByRental(int rentalID) {
             std::cerr << "Error: Database connection failed." << std::endl;
             return payments;
         }
-        sql::PreparedStatement* pstmt = conn->prepareStatement(
+        sql::PreparedStatement* pstmt = DatabaseManager::getInstance().prepare(
             "SELECT * FROM Payments WHERE RentalID = ? ORDER BY PaymentDate DESC"
         );
         pstmt->setInt(1, rentalID);
-        sql::ResultSet* res = pstmt->executeQuery();
+        sql::ResultSet* res = DatabaseManager::getInstance().executePreparedQuery(pstmt);
         
         while (res && res->next()) {
             Payment payment;
             payment.PaymentID = res->getInt("PaymentID");
             payment.RentalID = res->getInt("RentalID");
-            payment.Amount = res->getDouble("Amount");
+            payment.Amount = Money::fromString(res->getString("Amount"));
             payment.PaymentMethod = res->getString("PaymentMethod");
             payment.PaymentDate = res->getString("PaymentDate");
             payment.Status = res->getString("Status");
@@ -117,9 +173,10 @@ std::vector<Payment> PaymentManager::getPaymentsByRental(int rentalID) {
 }
 
 std::vector<Payment> PaymentManager::getAllPayments() {
+    TraceSpan span("payment.getAllPayments");
     std::vector<Payment> payments;
     try {
-        sql::ResultSet* res = DatabaseManager::getInstance().executeSelect(
+        sql::ResultSet* res = DatabaseManager::getInstance().executeReadSelect(
             "SELECT * FROM Payments ORDER BY PaymentDate DESC"
         );
         
@@ -127,7 +184,7 @@ std::vector<Payment> PaymentManager::getAllPayments() {
             Payment payment;
             payment.PaymentID = res->getInt("PaymentID");
             payment.RentalID = res->getInt("RentalID");
-            payment.Amount = res->getDouble("Amount");
+            payment.Amount = Money::fromString(res->getString("Amount"));
             payment.PaymentMethod = res->getString("PaymentMethod");
             payment.PaymentDate = res->getString("PaymentDate");
             payment.Status = res->getString("Status");
@@ -142,229 +199,271 @@ std::vector<Payment> PaymentManager::getAllPayments() {
 }
 
 bool PaymentManager::updatePaymentStatus(int paymentID, const std::string& status) {
+    TraceSpan span("payment.updatePaymentStatus", paymentID);
     try {
         sql::Connection* conn = DatabaseManager::getInstance().getConnection();
         if (!conn) {
             std::cerr << "Error: Database connection failed." << std::endl;
             return false;
         }
-        sql::PreparedStatement* pstmt = conn->prepareStatement(
+        conn->setAutoCommit(false);
+        
+        // Lock the payment so the ledger sees each status change exactly once
+        sql::PreparedStatement* pstmt = DatabaseManager::getInstance().prepare(
+            "SELECT RentalID, Amount, Status FROM Payments WHERE PaymentID = ? FOR UPDATE"
+        );
+        pstmt->setInt(1, paymentID);
+        sql::ResultSet* res = DatabaseManager::getInstance().executePreparedQuery(pstmt);
+        if (!res || !res->next()) {
+            if (res) delete res;
+            delete pstmt;
+            conn->commit();
+            conn->setAutoCommit(true);
+            return false;
+        }
+        int rentalID = res->getInt("RentalID");
+        Money amount = Money::fromString(res->getString("Amount"));
+        std::string oldStatus = res->getString("Status");
+        delete res;
+        delete pstmt;
+        
+        pstmt = DatabaseManager::getInstance().prepare(
             "UPDATE Payments SET Status = ? WHERE PaymentID = ?"
         );
         pstmt->setString(1, status);
         pstmt->setInt(2, paymentID);
-        int rows = pstmt->executeUpdate();
+        int rows = DatabaseManager::getInstance().executePreparedUpdate(pstmt);
         delete pstmt;
+        
+        // Only completed payments count towards AmountPaid
+        Money change = (status == "Completed" ? amount : Money()) - (oldStatus == "Completed" ? amount : Money());
+        if (!change.isZero()) {
+            addToAmountPaid(rentalID, change);
+        }
+        
+        conn->commit();
+        conn->setAutoCommit(true);
         return rows > 0;
     } catch (sql::SQLException& e) {
         std::cerr << "Error updating payment status: " << e.what() << std::endl;
+        DatabaseManager::rollbackQuietly();
+        return false;
+    } catch (const std::exception& e) {
+        std::cerr << "Error updating payment status: " << e.what() << std::endl;
+        DatabaseManager::rollbackQuietly();
         return false;
     }
 }
 
 bool PaymentManager::isRentalPaid(int rentalID) {
+    TraceSpan span("payment.isRentalPaid", rentalID);
+    std::vector<RentalBalance> balances = getBalances(std::vector<int>(1, rentalID));
+    return !balances.empty() && !balances[0].Outstanding.isPositive();
+}
+
+Money PaymentManager::getTotalPaid(int rentalID) {
+    TraceSpan span("payment.getTotalPaid", rentalID);
     try {
         sql::Connection* conn = DatabaseManager::getInstance().getConnection();
         if (!conn) {
             std::cerr << "Error: Database connection failed." << std::endl;
-            return false;
+            return Money();
         }
-        sql::PreparedStatement* pstmt = conn->prepareStatement(
-            "SELECT SUM(Amount) as total FROM Payments WHERE RentalID = ? AND Status = 'Completed'"
+        sql::PreparedStatement* pstmt = DatabaseManager::getInstance().prepare(
+            "SELECT AmountPaid FROM RentalBalances WHERE RentalID = ?"
         );
         pstmt->setInt(1, rentalID);
-        sql::ResultSet* res = pstmt->executeQuery();
-        
-        RentalManager rm;
-        Rental* rental = rm.getRentalByID(rentalID);
-        double totalDue = rental ? (rental->TotalAmount + rental->LateFee) : 0.0;
-        delete rental;
+        sql::ResultSet* res = DatabaseManager::getInstance().executePreparedQuery(pstmt);
         
-        double totalPaid = 0.0;
+        Money total;
         if (res && res->next()) {
-            totalPaid = res->getDouble("total");
+            total = Money::fromString(res->getString("AmountPaid"));
         }
-        delete pstmt;
         if (res) delete res;
-        return totalPaid >= totalDue;
+        delete pstmt;
+        return total;
     } catch (sql::SQLException& e) {
-        std::cerr << "Error checking payment: " << e.what() << std::endl;
-        return false;
+        std::cerr << "Error getting total paid: " << e.what() << std::endl;
+        return Money();
+    } catch (const std::exception& e) {
+        std::cerr << "Error getting total paid: " << e.what() << std::endl;
+        return Money();
     }
 }
 
-double PaymentManager::getTotalPaid(int rentalID) {
+std::vector<RentalBalance> PaymentManager::getBalances(const std::vector<int>& rentalIDs) {
+    TraceSpan span("payment.getBalances", static_cast<long long>(rentalIDs.size()));
+    std::vector<RentalBalance> balances;
+    if (rentalIDs.empty()) return balances;
     try {
-        sql::Connection* conn = DatabaseManager::getInstance().getConnection();
-        if (!conn) {
-            std::cerr << "Error: Database connection failed." << std::endl;
-            return 0.0;
-        }
-        sql::PreparedStatement* pstmt = conn->prepareStatement(
-            "SELECT SUM(Amount) as total FROM Payments WHERE RentalID = ? AND Status = 'Completed'"
+        sql::PreparedStatement* pstmt = DatabaseManager::getInstance().prepare(
+            std::string(BALANCE_SELECT) + "WHERE r.RentalID IN (" + DatabaseManager::placeholderList(rentalIDs.size()) + ")"
         );
-        pstmt->setInt(1, rentalID);
-        sql::ResultSet* res = pstmt->executeQuery();
+        DatabaseManager::bindIDs(pstmt, 1, rentalIDs);
+        sql::ResultSet* res = DatabaseManager::getInstance().executePreparedQuery(pstmt);
         
-        double total = 0.0;
-        if (res && res->next()) {
-            total = res->getDouble("total");
+        std::map<int, RentalBalance> byID;
+        std::string today = LateFeePolicy::today();
+        while (res && res->next()) {
+            RentalBalance balance = readBalance(res, today);
+            byID[balance.RentalID] = balance;
         }
+        if (res) delete res;
         delete pstmt;
+        
+        for (int rentalID : rentalIDs) {
+            std::map<int, RentalBalance>::iterator it = byID.find(rentalID);
+            if (it == byID.end()) continue;
+            balances.push_back(it->second);
+            byID.erase(it);
+        }
+    } catch (sql::SQLException& e) {
+        std::cerr << "Error getting balances: " << e.what() << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "Error getting balances: " << e.what() << std::endl;
+    }
+    return balances;
+}
+
+std::vector<RentalBalance> PaymentManager::getActiveBalances() {
+    TraceSpan span("payment.getActiveBalances");
+    std::vector<RentalBalance> balances;
+    try {
+        sql::ResultSet* res = DatabaseManager::getInstance().executeSelect(
+            std::string(BALANCE_SELECT) + "WHERE r.Status = 'Active' ORDER BY r.DueDate, r.RentalID"
+        );
+        std::string today = LateFeePolicy::today();
+        while (res && res->next()) {
+            balances.push_back(readBalance(res, today));
+        }
         if (res) delete res;
-        return total;
     } catch (sql::SQLException& e) {
-        std::cerr << "Error getting total paid: " << e.what() << std::endl;
-        return 0.0;
+        std::cerr << "Error getting balances: " << e.what() << std::endl;
     }
+    return balances;
 }
 
 void PaymentManager::generateReceipt(int paymentID) {
+    TraceSpan span("payment.generateReceipt", paymentID);
+    RenderFrame frame;
     Payment* payment = getPaymentByID(paymentID);
     if (!payment) {
-        std::cout << "Payment not found." << std::endl;
+        UIColors::out() << "Payment not found.\n";
         return;
     }
     
     RentalManager rm;
-    Rental* rental = rm.getRentalByID(payment->RentalID);
-    if (!rental) {
+    RentalView* view = rm.getRentalView(payment->RentalID);
+    if (!view) {
         delete payment;
         return;
     }
     
-    CustomerManager cm;
-    Customer* customer = cm.getCustomerByID(rental->CustomerID);
-    
-    std::cout << "\n" << std::string(60, '=') << std::endl;
-    std::cout << "           DRESS RENTAL RECEIPT" << std::endl;
-    std::cout << std::string(60, '=') << std::endl;
-    std::cout << "Payment ID: " << payment->PaymentID << std::endl;
-    std::cout << "Rental ID: " << payment->RentalID << std::endl;
-    if (customer) {
-        std::cout << "Customer: " << customer->Name << std::endl;
-        std::cout << "IC Number: " << customer->IC_Number << std::endl;
-    }
-    std::cout << "Payment Date: " << payment->PaymentDate << std::endl;
-    std::cout << "Payment Method: " << payment->PaymentMethod << std::endl;
-    std::cout << "Amount: RM " << std::fixed << std::setprecision(2) << payment->Amount << std::endl;
-    std::cout << "Status: " << payment->Status << std::endl;
+    UIColors::out() << "\n" << std::string(60, '=') << '\n';
+    UIColors::out() << "           DRESS RENTAL RECEIPT\n";
+    UIColors::out() << std::string(60, '=') << '\n';
+    UIColors::out() << "Payment ID: " << payment->PaymentID << '\n';
+    UIColors::out() << "Rental ID: " << payment->RentalID << '\n';
+    UIColors::out() << "Customer: " << view->customer.Name << '\n';
+    UIColors::out() << "IC Number: " << view->customer.IC_Number << '\n';
+    UIColors::out() << "Payment Date: " << payment->PaymentDate << '\n';
+    UIColors::out() << "Payment Method: " << payment->PaymentMethod << '\n';
+    UIColors::out() << "Amount: " << payment->Amount.toDisplay() << '\n';
+    UIColors::out() << "Status: " << payment->Status << '\n';
     if (!payment->TransactionReference.empty()) {
-        std::cout << "Transaction Ref: " << payment->TransactionReference << std::endl;
+        UIColors::out() << "Transaction Ref: " << payment->TransactionReference << '\n';
+    }
+    UIColors::out() << std::string(60, '-') << '\n';
+    for (const auto& item : view->items) {
+        UIColors::out() << "  " << std::setw(40) << std::left << TableRenderer::truncate(item.DressName, 40)
+                        << "RM " << std::setw(10) << std::right << item.RentalPrice << '\n';
+    }
+    if (view->rental.LateFee.isPositive()) {
+        UIColors::out() << "  " << std::setw(40) << std::left << "Late fee"
+                        << "RM " << std::setw(10) << std::right << view->rental.LateFee << '\n';
     }
-    std::cout << std::string(60, '=') << std::endl;
+    UIColors::out() << "Total Paid: " << view->TotalPaid.toDisplay() << " of "
+                    << (view->rental.TotalAmount + view->rental.LateFee).toDisplay() << '\n';
+    UIColors::out() << std::string(60, '=') << '\n';
     
     delete payment;
-    delete rental;
-    if (customer) delete customer;
+    delete view;
 }
 
 void PaymentManager::displayPayment(const Payment& payment) {
-    std::cout << "\n+----------------------------------------+" << std::endl;
-    std::cout << "| Payment ID: " << std::setw(25) << std::left << payment.PaymentID << "|" << std::endl;
-    std::cout << "| Rental ID: " << std::setw(27) << std::left << payment.RentalID << "|" << std::endl;
-    std::cout << "| Amount: RM " << std::setw(25) << std::left << std::fixed << std::setprecision(2) << payment.Amount << "|" << std::endl;
-    std::cout << "| Payment Method: " << std::setw(22) << std::left << payment.PaymentMethod << "|" << std::endl;
-    std::cout << "| Payment Date: " << std::setw(24) << std::left << payment.PaymentDate << "|" << std::endl;
-    std::cout << "| Status: " << std::setw(29) << std::left << payment.Status << "|" << std::endl;
+    RenderFrame frame;
+    UIColors::out() << "\n+----------------------------------------+\n";
+    UIColors::out() << "| Payment ID: " << std::setw(25) << std::left << payment.PaymentID << "|\n";
+    UIColors::out() << "| Rental ID: " << std::setw(27) << std::left << payment.RentalID << "|\n";
+    UIColors::out() << "| Amount: RM " << std::setw(25) << std::left << payment.Amount << "|\n";
+    UIColors::out() << "| Payment Method: " << std::setw(22) << std::left << payment.PaymentMethod << "|\n";
+    UIColors::out() << "| Payment Date: " << std::setw(24) << std::left << payment.PaymentDate << "|\n";
+    UIColors::out() << "| Status: " << std::setw(29) << std::left << payment.Status << "|\n";
     if (!payment.TransactionReference.empty()) {
-        std::cout << "| Transaction Ref: " << std::setw(21) << std::left << payment.TransactionReference << "|" << std::endl;
+        UIColors::out() << "| Transaction Ref: " << std::setw(21) << std::left << payment.TransactionReference << "|\n";
     }
-    std::cout << "+----------------------------------------+" << std::endl;
+    UIColors::out() << "+----------------------------------------+\n";
+}
+
+void PaymentManager::displayBalances(const std::vector<RentalBalance>& balances) {
+    TraceSpan span("payment.displayBalances", static_cast<long long>(balances.size()));
+    RenderFrame frame;
+    if (balances.empty()) {
+        UIColors::printInfo("No rentals found.");
+        return;
+    }
+    
+    UIColors::out() << '\n';
+    UIColors::printCentered("RENTAL BALANCES", SCREEN_WIDTH, UIColors::BOLD + UIColors::CYAN);
+    UIColors::printSeparator(SCREEN_WIDTH);
+    
+    TableRenderer table(SCREEN_WIDTH);
+    table.addColumn("Rental ID", 9);
+    table.addColumn("Customer", 16);
+    table.addColumn("Due Date", 10);
+    table.addColumn("Amount Due", 0, 0, TableRenderer::ALIGN_RIGHT);
+    table.addColumn("Paid", 0, 0, TableRenderer::ALIGN_RIGHT);
+    table.addColumn("Outstanding", 0, 0, TableRenderer::ALIGN_RIGHT);
+    
+    Money totalOutstanding;
+    for (const auto& balance : balances) {
+        std::string outstandingText = balance.Outstanding.isPositive()
+            ? UIColors::colorize(balance.Outstanding.toDisplay(), UIColors::YELLOW)
+            : UIColors::colorize(balance.Outstanding.toDisplay(), UIColors::GREEN);
+        table.addRow({ std::to_string(balance.RentalID), balance.CustomerName, balance.DueDate,
+                       balance.AmountDue.toDisplay(), balance.AmountPaid.toDisplay(), outstandingText });
+        if (balance.Outstanding.isPositive()) totalOutstanding += balance.Outstanding;
+    }
+    table.render();
+    UIColors::out() << "\nTotal outstanding: " << totalOutstanding.toDisplay() << '\n';
 }
 
 void PaymentManager::displayAllPayments(const std::vector<Payment>& payments) {
+    TraceSpan span("payment.displayAllPayments", static_cast<long long>(payments.size()));
+    RenderFrame frame;
     if (payments.empty()) {
         UIColors::printInfo("No payments found.");
         return;
     }
     
-    std::cout << std::endl;
+    UIColors::out() << '\n';
     UIColors::printCentered("PAYMENT LIST", SCREEN_WIDTH, UIColors::BOLD + UIColors::CYAN);
     UIColors::printSeparator(SCREEN_WIDTH);
     
-    // Column widths
-    const int col1 = 8;   // Pay ID
-    const int col2 = 10;  // Rental ID
-    const int col3 = 12;  // Amount
-    const int col4 = 15;  // Method
-    const int col5 = 12;  // Date
-    const int col6 = 12;  // Status
-    const int col7 = 18;  // Transaction Ref
-    const int numCols = 7;
-    
-    auto fit = [](const std::string& value, int width) {
-        if (static_cast<int>(value.size()) <= width) return value;
-        if (width <= 1) return value.substr(0, width);
-        return value.substr(0, width - 1) + ".";
-    };
+    TableRenderer table(SCREEN_WIDTH);
+    table.addColumn("Pay ID", 8);
+    table.addColumn("Rental ID", 10);
+    table.addColumn("Amount", 12);
+    table.addColumn("Method", 14);
+    table.addColumn("Date", 11);
+    table.addColumn("Status", 10);
+    table.addColumn("Transaction Ref", 16);
     
-    // Helper to get plain text width (strip ANSI codes)
-    auto plainWidth = [](const std::string& text) -> int {
-        int width = 0;
-        bool inEscape = false;
-        for (char c : text) {
-            if (c == '\033') inEscape = true;
-            else if (inEscape && c == 'm') inEscape = false;
-            else if (!inEscape) width++;
-        }
-        return width;
-    };
-    
-    // Helper to pad colored text to exact width
-    auto padColored = [=](const std::string& coloredText, int targetWidth) -> std::string {
-        int actualWidth = plainWidth(coloredText);
-        if (actualWidth >= targetWidth) return coloredText;
-        return coloredText + std::string(targetWidth - actualWidth, ' ');
-    };
-    
-    // Build border line
-    int totalWidth = col1 + col2 + col3 + col4 + col5 + col6 + col7 + numCols + 1; // separators + ends
-    int padding = (SCREEN_WIDTH - totalWidth) / 2;
-    if (padding < 0) padding = 0;
-    auto border = [=]() {
-        std::ostringstream oss;
-        oss << std::string(padding, ' ') << "+";
-        const int widths[] = {col1, col2, col3, col4, col5, col6, col7};
-        for (int w : widths) {
-            oss << std::string(w, '-') << "+";
-        }
-        return oss.str();
-    };
-    
-    std::string borderLine = border();
-    std::cout << borderLine << std::endl;
-    
-    // Header row with proper padding for colored text
-    std::cout << std::string(padding, ' ') << "|"
-              << padColored(UIColors::colorize("Pay ID", UIColors::BOLD + UIColors::CYAN), col1) << "|"
-              << padColored(UIColors::colorize("Rental ID", UIColors::BOLD + UIColors::CYAN), col2) << "|"
-              << padColored(UIColors::colorize("Amount", UIColors::BOLD + UIColors::CYAN), col3) << "|"
-              << padColored(UIColors::colorize("Method", UIColors::BOLD + UIColors::CYAN), col4) << "|"
-              << padColored(UIColors::colorize("Date", UIColors::BOLD + UIColors::CYAN), col5) << "|"
-              << padColored(UIColors::colorize("Status", UIColors::BOLD + UIColors::CYAN), col6) << "|"
-              << padColored(UIColors::colorize("Transaction Ref", UIColors::BOLD + UIColors::CYAN), col7) << "|"
-              << std::endl;
-    
-    std::cout << borderLine << std::endl;
-    
-    // Rows
     for (const auto& payment : payments) {
-        std::ostringstream amountStream;
-        amountStream << std::fixed << std::setprecision(2) << "RM " << payment.Amount;
-        
-        std::cout << std::string(padding, ' ') << "|"
-                  << std::setw(col1) << std::left << payment.PaymentID << "|"
-                  << std::setw(col2) << std::left << payment.RentalID << "|"
-                  << std::setw(col3) << std::left << amountStream.str() << "|"
-                  << std::setw(col4) << std::left << fit(payment.PaymentMethod, col4) << "|"
-                  << std::setw(col5) << std::left << fit(payment.PaymentDate, col5) << "|"
-                  << std::setw(col6) << std::left << fit(payment.Status, col6) << "|"
-                  << std::setw(col7) << std::left << fit(payment.TransactionReference, col7) << "|"
-                  << std::endl;
+        table.addRow({ std::to_string(payment.PaymentID), std::to_string(payment.RentalID), payment.Amount.toDisplay(),
+                       payment.PaymentMethod, payment.PaymentDate, payment.Status, payment.TransactionReference });
     }
-    
-    std::cout << borderLine << std::endl;
-    std::cout << std::endl;
+    table.render();
+    UIColors::out() << '\n';
 }
 
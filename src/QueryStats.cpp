@@ -0,0 +1,298 @@
+#include "QueryStats.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <deque>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+// One slot per statement id; a thread only allocates histograms for the
+// statements it actually runs
+struct ThreadBuckets {
+    std::atomic<QueryStats::Histogram*> slots[QueryStats::MAX_STATEMENTS];
+    ThreadBuckets() {
+        for (int i = 0; i < QueryStats::MAX_STATEMENTS; ++i) slots[i].store(nullptr, std::memory_order_relaxed);
+    }
+};
+
+std::mutex& registryMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+// Buckets of every thread that ever recorded, kept after the thread exits so
+// its samples still show up in dump()
+std::vector<ThreadBuckets*>& allThreadBuckets() {
+    static std::vector<ThreadBuckets*> threads;
+    return threads;
+}
+
+// Statement id -> normalized text; id 0 collects anything past MAX_STATEMENTS
+std::deque<std::string>& statementTexts() {
+    static std::deque<std::string> texts(1, "(other statements)");
+    return texts;
+}
+
+std::unordered_map<std::string, int>& statementIds() {
+    static std::unordered_map<std::string, int> ids;
+    return ids;
+}
+
+ThreadBuckets& localBuckets() {
+    static thread_local ThreadBuckets* buckets = nullptr;
+    if (!buckets) {
+        buckets = new ThreadBuckets();
+        std::lock_guard<std::mutex> lock(registryMutex());
+        allThreadBuckets().push_back(buckets);
+    }
+    return *buckets;
+}
+
+std::string normalize(const std::string& sql) {
+    std::string out;
+    out.reserve(sql.size());
+    for (size_t i = 0; i < sql.size(); ++i) {
+        char c = sql[i];
+        bool inIdentifier = !out.empty() && (std::isalnum(static_cast<unsigned char>(out.back())) || out.back() == '_');
+        if (std::isdigit(static_cast<unsigned char>(c)) && !inIdentifier) {
+            while (i + 1 < sql.size() && (std::isdigit(static_cast<unsigned char>(sql[i + 1])) || sql[i + 1] == '.')) ++i;
+            out += '?';
+        } else if (std::isspace(static_cast<unsigned char>(c))) {
+            if (!out.empty() && out.back() != ' ') out += ' ';
+        } else {
+            out += c;
+        }
+    }
+    return out;
+}
+
+bool readEnabledFromEnv() {
+    const char* value = std::getenv("DRS_QUERY_STATS");
+    return !(value && std::string(value) == "0");
+}
+
+inline void increment(std::atomic<uint64_t>& counter, uint64_t amount) {
+    // Single writer per thread, so a plain load/store pair is enough
+    counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+inline int highestBit(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+    return 63 - __builtin_clzll(value);
+#else
+    int bit = 0;
+    while (value >>= 1) ++bit;
+    return bit;
+#endif
+}
+
+} // namespace
+
+std::atomic<bool> QueryStats::enabledFlag(readEnabledFromEnv());
+
+QueryStats::Histogram::Histogram() : count(0), totalNs(0), maxNs(0) {
+    for (int i = 0; i < BUCKET_COUNT; ++i) buckets[i].store(0, std::memory_order_relaxed);
+}
+
+int QueryStats::statementId(const std::string& sql) {
+    // Per-thread cache so repeated statements skip normalization and the lock
+    static thread_local std::unordered_map<std::string, int> cache;
+    std::unordered_map<std::string, int>::const_iterator cached = cache.find(sql);
+    if (cached != cache.end()) return cached->second;
+
+    std::string text = normalize(sql);
+    int id = 0;
+    {
+        std::lock_guard<std::mutex> lock(registryMutex());
+        std::unordered_map<std::string, int>::const_iterator it = statementIds().find(text);
+        if (it != statementIds().end()) {
+            id = it->second;
+        } else if (statementTexts().size() < static_cast<size_t>(MAX_STATEMENTS)) {
+            id = static_cast<int>(statementTexts().size());
+            statementTexts().push_back(text);
+            statementIds()[text] = id;
+        }
+    }
+    if (cache.size() > 1024) cache.clear();
+    cache[sql] = id;
+    return id;
+}
+
+std::string QueryStats::statementText(int id) {
+    std::lock_guard<std::mutex> lock(registryMutex());
+    if (id < 0 || static_cast<size_t>(id) >= statementTexts().size()) return "";
+    return statementTexts()[id];
+}
+
+bool QueryStats::enabled() {
+    return enabledFlag.load(std::memory_order_relaxed);
+}
+
+void QueryStats::setEnabled(bool on) {
+    enabledFlag.store(on, std::memory_order_relaxed);
+}
+
+uint64_t QueryStats::slowQueryThresholdNs() {
+    static const uint64_t threshold = []() -> uint64_t {
+        const char* value = std::getenv("DRS_SLOW_QUERY_MS");
+        double ms = value ? std::atof(value) : 500.0;
+        return ms > 0.0 ? static_cast<uint64_t>(ms * 1e6) : 0;
+    }();
+    return threshold;
+}
+
+int QueryStats::bucketFor(uint64_t ns) {
+    uint64_t units = ns >> 10; // ~1us resolution at the bottom
+    if (units < 8) return static_cast<int>(units);
+    int exponent = highestBit(units);
+    int bucket = (exponent - 2) * 8 + static_cast<int>((units >> (exponent - 3)) & 7);
+    return bucket < BUCKET_COUNT ? bucket : BUCKET_COUNT - 1;
+}
+
+uint64_t QueryStats::bucketValue(int bucket) {
+    // Midpoint of the bucket's range, in nanoseconds
+    if (bucket < 8) return (static_cast<uint64_t>(bucket) << 10) + 512;
+    int exponent = bucket / 8 + 2;
+    uint64_t width = static_cast<uint64_t>(1) << (exponent - 3);
+    uint64_t lower = (8 + static_cast<uint64_t>(bucket % 8)) * width;
+    return (lower << 10) + (width << 9);
+}
+
+void QueryStats::record(int statementId, uint64_t elapsedNs) {
+    if (statementId < 0 || statementId >= MAX_STATEMENTS) statementId = 0;
+    ThreadBuckets& local = localBuckets();
+    Histogram* histogram = local.slots[statementId].load(std::memory_order_relaxed);
+    if (!histogram) {
+        histogram = new Histogram();
+        local.slots[statementId].store(histogram, std::memory_order_release);
+    }
+    increment(histogram->buckets[bucketFor(elapsedNs)], 1);
+    increment(histogram->count, 1);
+    increment(histogram->totalNs, elapsedNs);
+    if (elapsedNs > histogram->maxNs.load(std::memory_order_relaxed)) {
+        histogram->maxNs.store(elapsedNs, std::memory_order_relaxed);
+    }
+
+    uint64_t threshold = slowQueryThresholdNs();
+    if (threshold > 0 && elapsedNs >= threshold) logSlowQuery(statementId, elapsedNs);
+}
+
+void QueryStats::logSlowQuery(int statementId, uint64_t elapsedNs) {
+    static std::mutex logMutex;
+    const char* path = std::getenv("DRS_SLOW_QUERY_LOG");
+    std::time_t now = std::time(nullptr);
+    std::tm tmNow;
+#ifdef _WIN32
+    localtime_s(&tmNow, &now);
+#else
+    localtime_r(&now, &tmNow);
+#endif
+    char timestamp[32];
+    std::strftime(timestamp, sizeof(timestamp), "%Y-%m-%d %H:%M:%S", &tmNow);
+    std::string text = statementText(statementId);
+
+    std::lock_guard<std::mutex> lock(logMutex);
+    std::ofstream log(path ? path : "slow_queries.log", std::ios::app);
+    if (log) {
+        log << timestamp << '\t' << std::fixed << std::setprecision(2) << elapsedNs / 1e6 << " ms\t" << text << '\n';
+    }
+}
+
+void QueryStats::dump(std::ostream& out) {
+    struct Summary {
+        int id;
+        uint64_t count;
+        uint64_t totalNs;
+        uint64_t maxNs;
+        std::vector<uint64_t> buckets;
+    };
+    std::vector<Summary> summaries;
+    std::vector<ThreadBuckets*> threads;
+    {
+        std::lock_guard<std::mutex> lock(registryMutex());
+        threads = allThreadBuckets();
+    }
+
+    for (int id = 0; id < MAX_STATEMENTS; ++id) {
+        Summary summary;
+        summary.id = id;
+        summary.count = summary.totalNs = summary.maxNs = 0;
+        summary.buckets.assign(BUCKET_COUNT, 0);
+        for (ThreadBuckets* thread : threads) {
+            Histogram* histogram = thread->slots[id].load(std::memory_order_acquire);
+            if (!histogram) continue;
+            summary.count += histogram->count.load(std::memory_order_relaxed);
+            summary.totalNs += histogram->totalNs.load(std::memory_order_relaxed);
+            summary.maxNs = std::max(summary.maxNs, histogram->maxNs.load(std::memory_order_relaxed));
+            for (int b = 0; b < BUCKET_COUNT; ++b) {
+                summary.buckets[b] += histogram->buckets[b].load(std::memory_order_relaxed);
+            }
+        }
+        if (summary.count > 0) summaries.push_back(summary);
+    }
+    std::sort(summaries.begin(), summaries.end(),
+              [](const Summary& a, const Summary& b) { return a.totalNs > b.totalNs; });
+
+    out << "\n" << std::string(100, '=') << "\n";
+    out << "Query Statistics (slow query threshold: ";
+    if (slowQueryThresholdNs() > 0) out << slowQueryThresholdNs() / 1000000 << " ms)\n";
+    else out << "off)\n";
+    out << std::string(100, '=') << "\n";
+    if (summaries.empty()) {
+        out << "No queries recorded" << (enabled() ? "." : " (statistics are disabled).") << "\n";
+        return;
+    }
+
+    out << std::right << std::setw(8) << "Count" << std::setw(10) << "p50 ms" << std::setw(10) << "p95 ms"
+        << std::setw(10) << "p99 ms" << std::setw(11) << "Max ms" << std::setw(12) << "Total ms"
+        << "  " << std::left << "Statement" << "\n";
+    out << std::string(100, '-') << "\n";
+    out << std::fixed << std::setprecision(2);
+    for (const Summary& summary : summaries) {
+        const double percentiles[] = { 0.50, 0.95, 0.99 };
+        double values[3];
+        for (int p = 0; p < 3; ++p) {
+            uint64_t target = static_cast<uint64_t>(percentiles[p] * summary.count + 0.5);
+            if (target == 0) target = 1;
+            uint64_t seen = 0;
+            int bucket = 0;
+            for (; bucket < BUCKET_COUNT; ++bucket) {
+                seen += summary.buckets[bucket];
+                if (seen >= target) break;
+            }
+            values[p] = std::min(bucketValue(std::min(bucket, BUCKET_COUNT - 1)), summary.maxNs) / 1e6;
+        }
+        std::string text = statementText(summary.id);
+        if (text.length() > 46) text = text.substr(0, 43) + "...";
+        out << std::right << std::setw(8) << summary.count << std::setw(10) << values[0]
+            << std::setw(10) << values[1] << std::setw(10) << values[2]
+            << std::setw(11) << summary.maxNs / 1e6 << std::setw(12) << summary.totalNs / 1e6
+            << "  " << std::left << text << "\n";
+    }
+    out << std::string(100, '=') << std::endl;
+}
+
+void QueryStats::reset() {
+    std::vector<ThreadBuckets*> threads;
+    {
+        std::lock_guard<std::mutex> lock(registryMutex());
+        threads = allThreadBuckets();
+    }
+    for (ThreadBuckets* thread : threads) {
+        for (int id = 0; id < MAX_STATEMENTS; ++id) {
+            Histogram* histogram = thread->slots[id].load(std::memory_order_acquire);
+            if (!histogram) continue;
+            for (int b = 0; b < BUCKET_COUNT; ++b) histogram->buckets[b].store(0, std::memory_order_relaxed);
+            histogram->count.store(0, std::memory_order_relaxed);
+            histogram->totalNs.store(0, std::memory_order_relaxed);
+            histogram->maxNs.store(0, std::memory_order_relaxed);
+        }
+    }
+}
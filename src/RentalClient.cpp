@@ -0,0 +1,176 @@
+#include "RentalClient.h"
+#include "InputValidator.h"
+#include "UIColors.h"
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#ifdef __linux__
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+RentalClient::RentalClient() : fd(-1) {}
+
+RentalClient::~RentalClient() {
+    close();
+}
+
+bool RentalClient::fail(const std::string& reason) {
+    lastError = reason;
+    close();
+    return false;
+}
+
+#ifdef __linux__
+
+bool RentalClient::connect(const std::string& socketPath) {
+    close();
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (socketPath.empty() || socketPath.size() >= sizeof(address.sun_path)) {
+        lastError = "socket path is empty or too long";
+        return false;
+    }
+    std::memcpy(address.sun_path, socketPath.c_str(), socketPath.size());
+    fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) return fail(std::strerror(errno));
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) return fail(std::strerror(errno));
+    buffer.clear();
+    return true;
+}
+
+void RentalClient::close() {
+    if (fd >= 0) ::close(fd);
+    fd = -1;
+}
+
+bool RentalClient::fill(size_t count) {
+    char chunk[4096];
+    while (buffer.size() < count) {
+        ssize_t received = recv(fd, chunk, sizeof(chunk), 0);
+        if (received > 0) {
+            buffer.append(chunk, static_cast<size_t>(received));
+        } else if (received < 0 && errno == EINTR) {
+            continue;
+        } else {
+            return fail(received == 0 ? "server closed the connection" : std::strerror(errno));
+        }
+    }
+    return true;
+}
+
+bool RentalClient::request(const std::string& line, Response& response) {
+    if (fd < 0) {
+        lastError = "not connected";
+        return false;
+    }
+    std::string message = line + "\n";
+    size_t sent = 0;
+    while (sent < message.size()) {
+        ssize_t n = send(fd, message.data() + sent, message.size() - sent, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return fail(std::strerror(errno));
+        sent += static_cast<size_t>(n);
+    }
+
+    // "OK <length>\n" or "ERR <length>\n", then the body
+    size_t end;
+    while ((end = buffer.find('\n')) == std::string::npos) {
+        if (buffer.size() > 64) return fail("malformed reply");
+        if (!fill(buffer.size() + 1)) return false;
+    }
+    std::string header = buffer.substr(0, end);
+    size_t space = header.find(' ');
+    std::string status = header.substr(0, space);
+    char* last = nullptr;
+    unsigned long length = space == std::string::npos ? 0 : std::strtoul(header.c_str() + space + 1, &last, 10);
+    if ((status != "OK" && status != "ERR") || space == std::string::npos || *last != '\0') {
+        return fail("malformed reply");
+    }
+    if (!fill(end + 1 + length)) return false;
+    response.ok = status == "OK";
+    response.body = buffer.substr(end + 1, length);
+    buffer.erase(0, end + 1 + length);
+    return true;
+}
+
+#else
+
+bool RentalClient::connect(const std::string&) {
+    lastError = "terminal mode needs Linux (Unix domain sockets)";
+    return false;
+}
+
+void RentalClient::close() {
+    fd = -1;
+}
+
+bool RentalClient::fill(size_t) {
+    return false;
+}
+
+bool RentalClient::request(const std::string&, Response&) {
+    lastError = "not connected";
+    return false;
+}
+
+#endif
+
+int RentalClient::runTerminal(const std::string& socketPath) {
+    RentalClient client;
+    if (!client.connect(socketPath)) {
+        UIColors::printError("Cannot reach the rental server at " + socketPath + ": " + client.getLastError());
+        UIColors::printInfo("Start it with ./rental_system --server, or set server_socket.");
+        return 1;
+    }
+    UIColors::printSeparator(80);
+    UIColors::printCentered("DRESS RENTAL MANAGEMENT SYSTEM - TERMINAL", 80, UIColors::BOLD + UIColors::CYAN);
+    UIColors::printCentered("Connected to " + socketPath, 80, UIColors::DIM + UIColors::WHITE);
+    UIColors::printSeparator(80);
+
+    Response response;
+    const int MAX_ATTEMPTS = 3;
+    bool loggedIn = false;
+    for (int attempt = 0; attempt < MAX_ATTEMPTS && !loggedIn; ++attempt) {
+        std::string username = InputValidator::getString("Username: ", true, 1, 50);
+        std::string password = InputValidator::getPassword("Password: ", false, true);
+        if (!client.request("login " + username + " " + password, response)) {
+            UIColors::printError("Connection lost: " + client.getLastError());
+            return 1;
+        }
+        loggedIn = response.ok;
+        if (response.ok) {
+            UIColors::printSuccess(response.body.substr(0, response.body.find('\n')));
+        } else {
+            UIColors::printError(response.body.substr(0, response.body.find('\n')));
+        }
+    }
+    if (!loggedIn) return 1;
+    UIColors::printInfo("Type help for the commands, quit to leave.");
+
+    std::string line;
+    while (true) {
+        std::cout << "rental> " << std::flush;
+        if (!std::getline(std::cin, line)) line = "quit";
+        size_t first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos) continue;
+        line = line.substr(first, line.find_last_not_of(" \t\r") - first + 1);
+        if (!client.request(line, response)) {
+            UIColors::printError("Connection lost: " + client.getLastError());
+            return 1;
+        }
+        if (response.ok) {
+            std::cout << response.body << std::flush;
+        } else if (UIColors::colorsEnabled()) {
+            std::cout << UIColors::RED << response.body << UIColors::RESET << std::flush;
+        } else {
+            std::cout << response.body << std::flush;
+        }
+        if (line == "quit") break;
+    }
+    return 0;
+}
@@ -1,12 +1,150 @@
 #include "RentalManager.h"
 #include "UIColors.h"
 #include "MenuHandlers.h"
+#include "TableRenderer.h"
+#include "LateFeePolicy.h"
+#include "Trace.h"
+#include "Format.h"
+#include "DressStock.h"
+#include "CleaningScheduler.h"
 #include <iostream>
 #include <iomanip>
 #include <sstream>
 #include <ctime>
 #include <algorithm>
+#include <chrono>
 #include <cmath>
+#include <functional>
+#include <random>
+#include <thread>
+
+namespace {
+
+// Rentals still out owe the fee as of today; returned ones keep the fee that
+// was persisted when they came back
+void applyCurrentLateFee(Rental& rental, const std::string& today) {
+    if (rental.Status == "Active") {
+        rental.LateFee = LateFeePolicy::standard().lateFee(rental.DueDate, rental.ReturnDate, today);
+    }
+}
+
+const int MAX_RENTAL_ATTEMPTS = 3;
+
+// ER_LOCK_DEADLOCK and ER_LOCK_WAIT_TIMEOUT: the transaction was rolled back
+// or can be, and running it again normally succeeds
+bool isTransientLockError(int errorCode) {
+    return errorCode == 1213 || errorCode == 1205;
+}
+
+// 10ms, 20ms, ... plus up to 10ms of jitter so colliding terminals do not
+// collide again on the retry
+std::chrono::milliseconds retryDelay(int attempt) {
+    static thread_local std::minstd_rand rng(static_cast<unsigned>(
+        std::hash<std::thread::id>()(std::this_thread::get_id())));
+    return std::chrono::milliseconds(10 * attempt + static_cast<int>(rng() % 10));
+}
+
+// Copies TotalAmount + LateFee of these rentals into the RentalBalances ledger.
+// Call it in the same transaction as the change to the fee.
+void syncAmountDue(const std::vector<int>& ids) {
+    sql::PreparedStatement* pstmt = DatabaseManager::getInstance().prepare(
+        "UPDATE RentalBalances b JOIN Rentals r ON r.RentalID = b.RentalID "
+        "SET b.AmountDue = r.TotalAmount + r.LateFee "
+        "WHERE b.RentalID IN (" + DatabaseManager::placeholderList(ids.size()) + ")"
+    );
+    DatabaseManager::bindIDs(pstmt, 1, ids);
+    DatabaseManager::getInstance().executePreparedUpdate(pstmt);
+    delete pstmt;
+}
+
+// One attempt at the createRental transaction. Returns the new rental ID, or -1
+// after rolling back if a dress could not be claimed; SQL errors are thrown to
+// the caller, which rolls back and decides whether to retry.
+int insertRental(DressManager& dm, int customerID, const std::string& rentalDate, const std::string& dueDate,
+                 Money totalAmount, const std::vector<int>& dressIDs,
+                 const std::function<bool(int rentalID)>& onCreated) {
+    sql::Connection* conn = DatabaseManager::getInstance().getConnection();
+    conn->setAutoCommit(false);
+    
+    // Create rental record
+    int rentalID = -1;
+    {
+        TraceSpan insertSpan("rental.insertRental");
+        sql::PreparedStatement* pstmt = DatabaseManager::getInstance().prepare(
+            "INSERT INTO Rentals (CustomerID, RentalDate, DueDate, HeldThrough, TotalAmount, Status) "
+            "VALUES (?, ?, ?, ?, ?, 'Active')"
+        );
+        pstmt->setInt(1, customerID);
+        pstmt->setString(2, rentalDate);
+        pstmt->setString(3, dueDate);
+        pstmt->setString(4, dueDate);
+        pstmt->setString(5, totalAmount.toString());
+        DatabaseManager::getInstance().executePreparedUpdate(pstmt);
+        
+        // Get the rental ID
+        sql::Statement* stmt = conn->createStatement();
+        sql::ResultSet* res = stmt->executeQuery("SELECT LAST_INSERT_ID() as id");
+        if (res && res->next()) {
+            rentalID = res->getInt("id");
+        }
+        if (res) delete res;
+        delete stmt;
+        delete pstmt;
+        
+        // Open the rental's ledger entry; payments add to AmountPaid
+        pstmt = DatabaseManager::getInstance().prepare(
+            "INSERT INTO RentalBalances (RentalID, AmountDue) VALUES (?, ?)"
+        );
+        pstmt->setInt(1, rentalID);
+        pstmt->setString(2, totalAmount.toString());
+        DatabaseManager::getInstance().executePreparedUpdate(pstmt);
+        delete pstmt;
+    }
+    
+    if (onCreated && !onCreated(rentalID)) {
+        conn->rollback();
+        conn->setAutoCommit(true);
+        return -1;
+    }
+    
+    // Reserve a unit of each dress for the rental's days, then record it on the rental
+    for (int dressID : dressIDs) {
+        {
+            TraceSpan claimSpan("rental.claimDress", dressID);
+            if (!DressStock::reserve(dressID, rentalDate, dueDate)) {
+                std::cerr << "Error: Dress ID " << dressID << " has no unit left for those dates." << std::endl;
+                conn->rollback();
+                conn->setAutoCommit(true);
+                return -1;
+            }
+        }
+        
+        TraceSpan itemSpan("rental.insertItem", dressID);
+        Money price = dm.getDressPrice(dressID);
+        if (!price.isPositive()) {
+            std::cerr << "Error: Invalid price for dress ID " << dressID << std::endl;
+            conn->rollback();
+            conn->setAutoCommit(true);
+            return -1;
+        }
+        
+        sql::PreparedStatement* pstmt = DatabaseManager::getInstance().prepare(
+            "INSERT INTO RentalItems (RentalID, DressID, RentalPrice) VALUES (?, ?, ?)"
+        );
+        pstmt->setInt(1, rentalID);
+        pstmt->setInt(2, dressID);
+        pstmt->setString(3, price.toString());
+        DatabaseManager::getInstance().executePreparedUpdate(pstmt);
+        delete pstmt;
+    }
+    
+    TraceSpan commitSpan("rental.commit", rentalID);
+    conn->commit();
+    conn->setAutoCommit(true);
+    return rentalID;
+}
+
+} // namespace
 
 std::string RentalManager::calculateDueDate(const std::string& rentalDate, int duration) {
     std::tm tm = {};
@@ -22,13 +160,10 @@ std::string RentalManager::calculateDueDate(const std::string& rentalDate, int d
 #ifdef _WIN32
     localtime_s(&dueTm, &time);
 #else
-    std::tm* temp = std::localtime(&time);
-    dueTm = *temp;
+    localtime_r(&time, &dueTm); // reentrant: rentals are created from several threads under load
 #endif
     
-    std::ostringstream oss;
-    oss << std::put_time(&dueTm, "%Y-%m-%d");
-    return oss.str();
+    return Format::date(dueTm);
 }
 
 bool RentalManager::validateRentalDuration(int duration) {
@@ -45,7 +180,8 @@ bool RentalManager::validateDressStatus(int dressID) {
     DressManager dm;
     Dress* dress = dm.getDressByID(dressID);
     if (!dress) return false;
-    bool valid = dress->AvailabilityStatus == "Available";
+    // "Rented" only means every unit is out now; the dates decide (canRentDress)
+    bool valid = dress->AvailabilityStatus != "Maintenance";
     delete dress;
     return valid;
 }
@@ -55,130 +191,96 @@ bool RentalManager::canRentDress(int dressID, const std::string& startDate, cons
     return dm.isDressAvailable(dressID, startDate, endDate);
 }
 
-int RentalManager::createRental(int customerID, const std::string& rentalDate, int duration, const std::vector<int>& dressIDs) {
-    // Validate business rules
-    if (!validateRentalDuration(duration)) {
-        std::cerr << "Error: Rental duration must be between 1 and 14 days." << std::endl;
-        return -1;
-    }
-    
-    if (!validateMaxRentals(customerID)) {
-        std::cerr << "Error: Customer already has maximum 3 active rentals." << std::endl;
-        return -1;
-    }
-    
-    if (dressIDs.empty() || dressIDs.size() > 5) {
-        std::cerr << "Error: Must rent between 1 and 5 dresses." << std::endl;
-        return -1;
-    }
-    
-    // Validate all dresses
-    std::string dueDate = calculateDueDate(rentalDate, duration);
-    if (dueDate.empty()) {
-        std::cerr << "Error: Invalid rental date format. Please use YYYY-MM-DD format." << std::endl;
-        return -1;
-    }
-    
-    for (int dressID : dressIDs) {
-        if (!validateDressStatus(dressID)) {
-            std::cerr << "Error: Dress ID " << dressID << " is not available." << std::endl;
+int RentalManager::createRental(int customerID, const std::string& rentalDate, int duration, const std::vector<int>& dressIDs,
+                                const std::function<bool(int rentalID)>& onCreated) {
+    TraceSpan span("rental.createRental", customerID);
+    std::string dueDate;
+    {
+        TraceSpan validateSpan("rental.validate");
+        // Validate business rules
+        if (!validateRentalDuration(duration)) {
+            std::cerr << "Error: Rental duration must be between 1 and 14 days." << std::endl;
             return -1;
         }
-        if (!canRentDress(dressID, rentalDate, dueDate)) {
-            std::cerr << "Error: Dress ID " << dressID << " has overlapping bookings." << std::endl;
+        
+        if (!validateMaxRentals(customerID)) {
+            std::cerr << "Error: Customer already has maximum 3 active rentals." << std::endl;
             return -1;
         }
-    }
-    
-    // Calculate total amount
-    DressManager dm;
-    double totalAmount = 0.0;
-    for (int dressID : dressIDs) {
-        totalAmount += dm.getDressPrice(dressID) * duration;
-    }
-    
-    try {
-        sql::Connection* conn = DatabaseManager::getInstance().getConnection();
-        if (!conn) {
-            std::cerr << "Error: Database connection failed." << std::endl;
+        
+        if (dressIDs.empty() || dressIDs.size() > 5) {
+            std::cerr << "Error: Must rent between 1 and 5 dresses." << std::endl;
             return -1;
         }
         
-        conn->setAutoCommit(false);
-        
-        // Create rental record
-        sql::PreparedStatement* pstmt = conn->prepareStatement(
-            "INSERT INTO Rentals (CustomerID, RentalDate, DueDate, TotalAmount, Status) "
-            "VALUES (?, ?, ?, ?, 'Active')"
-        );
-        pstmt->setInt(1, customerID);
-        pstmt->setString(2, rentalDate);
-        pstmt->setString(3, dueDate);
-        pstmt->setDouble(4, totalAmount);
-        pstmt->executeUpdate();
-        
-        // Get the rental ID
-        sql::Statement* stmt = conn->createStatement();
-        sql::ResultSet* res = stmt->executeQuery("SELECT LAST_INSERT_ID() as id");
-        int rentalID = -1;
-        if (res && res->next()) {
-            rentalID = res->getInt("id");
+        // Validate all dresses
+        dueDate = calculateDueDate(rentalDate, duration);
+        if (dueDate.empty()) {
+            std::cerr << "Error: Invalid rental date format. Please use YYYY-MM-DD format." << std::endl;
+            return -1;
         }
-        if (res) delete res;
-        delete stmt;
-        delete pstmt;
         
-        // Create rental items and update dress availability
         for (int dressID : dressIDs) {
-            double price = dm.getDressPrice(dressID);
-            if (price <= 0.0) {
-                std::cerr << "Error: Invalid price for dress ID " << dressID << std::endl;
-                conn->rollback();
-                conn->setAutoCommit(true);
+            if (!validateDressStatus(dressID)) {
+                std::cerr << "Error: Dress ID " << dressID << " is not available." << std::endl;
+                return -1;
+            }
+            if (!canRentDress(dressID, rentalDate, dueDate)) {
+                std::cerr << "Error: Dress ID " << dressID << " has no unit free for those dates." << std::endl;
                 return -1;
             }
-            
-            pstmt = conn->prepareStatement(
-                "INSERT INTO RentalItems (RentalID, DressID, RentalPrice) VALUES (?, ?, ?)"
-            );
-            pstmt->setInt(1, rentalID);
-            pstmt->setInt(2, dressID);
-            pstmt->setDouble(3, price);
-            pstmt->executeUpdate();
-            delete pstmt;
-            
-            // Update dress availability
-            dm.updateAvailability(dressID, "Rented");
         }
-        
-        conn->commit();
-        conn->setAutoCommit(true);
-        return rentalID;
-    } catch (sql::SQLException& e) {
-        std::cerr << "Error creating rental: " << e.what() << std::endl;
+    }
+    
+    // Calculate total amount
+    DressManager dm;
+    Money totalAmount;
+    {
+        TraceSpan pricingSpan("rental.pricing");
+        for (int dressID : dressIDs) {
+            totalAmount += dm.getDressPrice(dressID) * duration;
+        }
+    }
+    
+    // The checks above only give early, friendly errors; the reservations
+    // inside the transaction decide. Dresses are reserved in ID order so
+    // rentals sharing dresses lock them in the same order, and a transaction
+    // that still hits a deadlock or lock wait timeout is retried from the start.
+    std::vector<int> claimOrder(dressIDs);
+    std::sort(claimOrder.begin(), claimOrder.end());
+    for (int attempt = 1; ; ++attempt) {
         try {
-            sql::Connection* conn = DatabaseManager::getInstance().getConnection();
-            if (conn && !conn->isClosed()) {
-                conn->rollback();
-                conn->setAutoCommit(true);
+            return insertRental(dm, customerID, rentalDate, dueDate, totalAmount, claimOrder, onCreated);
+        } catch (sql::SQLException& e) {
+            DatabaseManager::rollbackQuietly();
+            if (isTransientLockError(e.getErrorCode()) && attempt < MAX_RENTAL_ATTEMPTS) {
+                TraceSpan retrySpan("rental.retry", attempt);
+                std::this_thread::sleep_for(retryDelay(attempt));
+                continue;
             }
-        } catch (...) {}
-        return -1;
+            std::cerr << "Error creating rental: " << e.what() << std::endl;
+            return -1;
+        } catch (const std::exception& e) {
+            DatabaseManager::rollbackQuietly();
+            std::cerr << "Error creating rental: " << e.what() << std::endl;
+            return -1;
+        }
     }
 }
 
 Rental* RentalManager::getRentalByID(int rentalID) {
+    TraceSpan span("rental.getRentalByID", rentalID);
     try {
         sql::Connection* conn = DatabaseManager::getInstance().getConnection();
         if (!conn) {
             std::cerr << "Error: Database connection failed." << std::endl;
             return nullptr;
         }
-        sql::PreparedStatement* pstmt = conn->prepareStatement(
+        sql::PreparedStatement* pstmt = DatabaseManager::getInstance().prepare(
             "SELECT * FROM Rentals WHERE RentalID = ?"
         );
         pstmt->setInt(1, rentalID);
-        sql::ResultSet* res = pstmt->executeQuery();
+        sql::ResultSet* res = DatabaseManager::getInstance().executePreparedQuery(pstmt);
         
         if (res && res->next()) {
             Rental* rental = new Rental();
@@ -187,28 +289,13 @@ Rental* RentalManager::getRentalByID(int rentalID) {
             rental->RentalDate = res->getString("RentalDate");
             rental->DueDate = res->getString("DueDate");
             rental->ReturnDate = res->getString("ReturnDate");
-            rental->TotalAmount = res->getDouble("TotalAmount");
-            if (res->wasNull()) rental->TotalAmount = 0.0;
-            rental->LateFee = res->getDouble("LateFee");
-            if (res->wasNull()) rental->LateFee = 0.0;
+            rental->TotalAmount = Money::fromString(res->getString("TotalAmount"));
+            rental->LateFee = Money::fromString(res->getString("LateFee"));
             rental->Status = res->getString("Status");
             delete pstmt;
             delete res;
             
-            // Automatically calculate and update late fee if rental is active and overdue
-            if (rental->Status == "Active") {
-                this->calculateLateFee(rentalID);
-                // Re-fetch to get updated late fee
-                sql::PreparedStatement* feePstmt = conn->prepareStatement("SELECT LateFee FROM Rentals WHERE RentalID = ?");
-                feePstmt->setInt(1, rentalID);
-                sql::ResultSet* feeRes = feePstmt->executeQuery();
-                if (feeRes && feeRes->next()) {
-                    rental->LateFee = feeRes->getDouble("LateFee");
-                    if (feeRes->wasNull()) rental->LateFee = 0.0;
-                }
-                delete feePstmt;
-                if (feeRes) delete feeRes;
-            }
+            applyCurrentLateFee(*rental, LateFeePolicy::today());
             
             return rental;
         }
@@ -221,19 +308,96 @@ Rental* RentalManager::getRentalByID(int rentalID) {
     }
 }
 
+RentalView* RentalManager::getRentalView(int rentalID) {
+    TraceSpan span("rental.getRentalView", rentalID);
+    try {
+        sql::Connection* conn = DatabaseManager::getInstance().getConnection();
+        if (!conn) {
+            std::cerr << "Error: Database connection failed." << std::endl;
+            return nullptr;
+        }
+        // One row per rental item (or one row with NULL item columns if there are
+        // none); the payment totals come from a single-row aggregate
+        sql::PreparedStatement* pstmt = DatabaseManager::getInstance().prepare(
+            "SELECT r.RentalID, r.CustomerID, r.RentalDate, r.DueDate, r.ReturnDate, r.TotalAmount, "
+            "r.LateFee, r.Status, c.Name, c.IC_Number, c.Phone, c.Email, c.Address, c.DateOfBirth, "
+            "ri.RentalItemID, ri.DressID, ri.RentalPrice AS ItemPrice, d.DressName, "
+            "p.TotalPaid, p.PaymentCount "
+            "FROM Rentals r "
+            "JOIN Customers c ON c.CustomerID = r.CustomerID "
+            "LEFT JOIN RentalItems ri ON ri.RentalID = r.RentalID "
+            "LEFT JOIN Dresses d ON d.DressID = ri.DressID "
+            "CROSS JOIN (SELECT COALESCE(SUM(Amount), 0) AS TotalPaid, COUNT(*) AS PaymentCount "
+            "            FROM Payments WHERE RentalID = ? AND Status = 'Completed') p "
+            "WHERE r.RentalID = ? "
+            "ORDER BY ri.RentalItemID"
+        );
+        pstmt->setInt(1, rentalID);
+        pstmt->setInt(2, rentalID);
+        sql::ResultSet* res = DatabaseManager::getInstance().executePreparedQuery(pstmt);
+        
+        RentalView* view = nullptr;
+        while (res && res->next()) {
+            if (!view) {
+                view = new RentalView();
+                Rental& rental = view->rental;
+                rental.RentalID = res->getInt("RentalID");
+                rental.CustomerID = res->getInt("CustomerID");
+                rental.RentalDate = res->getString("RentalDate");
+                rental.DueDate = res->getString("DueDate");
+                rental.ReturnDate = res->getString("ReturnDate");
+                rental.TotalAmount = Money::fromString(res->getString("TotalAmount"));
+                rental.LateFee = Money::fromString(res->getString("LateFee"));
+                rental.Status = res->getString("Status");
+                
+                Customer& customer = view->customer;
+                customer.CustomerID = rental.CustomerID;
+                customer.Name = res->getString("Name");
+                customer.IC_Number = res->getString("IC_Number");
+                customer.Phone = res->getString("Phone");
+                customer.Email = res->getString("Email");
+                customer.Address = res->getString("Address");
+                customer.DateOfBirth = res->getString("DateOfBirth");
+                
+                view->TotalPaid = Money::fromString(res->getString("TotalPaid"));
+                view->PaymentCount = res->getInt("PaymentCount");
+            }
+            
+            RentalViewItem item;
+            item.RentalItemID = res->getInt("RentalItemID");
+            if (res->wasNull()) continue; // rental without items
+            item.DressID = res->getInt("DressID");
+            item.RentalPrice = Money::fromString(res->getString("ItemPrice"));
+            item.DressName = res->getString("DressName");
+            if (res->wasNull()) item.DressName = "N/A";
+            view->items.push_back(item);
+        }
+        delete pstmt;
+        if (res) delete res;
+        
+        if (view) applyCurrentLateFee(view->rental, LateFeePolicy::today());
+        return view;
+    } catch (sql::SQLException& e) {
+        std::cerr << "Error getting rental view: " << e.what() << std::endl;
+        return nullptr;
+    }
+}
+
 std::vector<Rental> RentalManager::getRentalsByCustomer(int customerID) {
+    TraceSpan span("rental.getRentalsByCustomer", customerID);
     std::vector<Rental> rentals;
+    std::string today = LateFeePolicy::today();
     try {
         sql::Connection* conn = DatabaseManager::getInstance().getConnection();
         if (!conn) {
             std::cerr << "Error: Database connection failed." << std::endl;
             return rentals;
         }
-        sql::PreparedStatement* pstmt = conn->prepareStatement(
+        sql::PreparedStatement* pstmt = DatabaseManager::getInstance().prepare(
             "SELECT * FROM Rentals WHERE CustomerID = ? ORDER BY RentalDate DESC"
         );
         pstmt->setInt(1, customerID);
-        sql::ResultSet* res = pstmt->executeQuery();
+        sql::ResultSet* res = DatabaseManager::getInstance().executePreparedQuery(pstmt);
         
         while (res && res->next()) {
             Rental rental;
@@ -242,11 +406,10 @@ std::vector<Rental> RentalManager::getRentalsByCustomer(int customerID) {
             rental.RentalDate = res->getString("RentalDate");
             rental.DueDate = res->getString("DueDate");
             rental.ReturnDate = res->getString("ReturnDate");
-            rental.TotalAmount = res->getDouble("TotalAmount");
-            if (res->wasNull()) rental.TotalAmount = 0.0;
-            rental.LateFee = res->getDouble("LateFee");
-            if (res->wasNull()) rental.LateFee = 0.0;
+            rental.TotalAmount = Money::fromString(res->getString("TotalAmount"));
+            rental.LateFee = Money::fromString(res->getString("LateFee"));
             rental.Status = res->getString("Status");
+            applyCurrentLateFee(rental, today);
             rentals.push_back(rental);
         }
         delete pstmt;
@@ -258,7 +421,9 @@ std::vector<Rental> RentalManager::getRentalsByCustomer(int customerID) {
 }
 
 std::vector<Rental> RentalManager::getActiveRentals() {
+    TraceSpan span("rental.getActiveRentals");
     std::vector<Rental> rentals;
+    std::string today = LateFeePolicy::today();
     try {
         sql::ResultSet* res = DatabaseManager::getInstance().executeSelect(
             "SELECT * FROM Rentals WHERE Status = 'Active' ORDER BY DueDate"
@@ -271,39 +436,11 @@ std::vector<Rental> RentalManager::getActiveRentals() {
             rental.RentalDate = res->getString("RentalDate");
             rental.DueDate = res->getString("DueDate");
             rental.ReturnDate = res->getString("ReturnDate");
-            rental.TotalAmount = res->getDouble("TotalAmount");
-            if (res->wasNull()) rental.TotalAmount = 0.0;
-            rental.LateFee = res->getDouble("LateFee");
-            if (res->wasNull()) rental.LateFee = 0.0;
+            rental.TotalAmount = Money::fromString(res->getString("TotalAmount"));
+            rental.LateFee = Money::fromString(res->getString("LateFee"));
             rental.Status = res->getString("Status");
             
-            // Automatically calculate and update late fee if overdue
-            std::tm dueTm = {};
-            std::istringstream ss(rental.DueDate);
-            ss >> std::get_time(&dueTm, "%Y-%m-%d");
-            if (!ss.fail()) {
-                std::time_t dueTime = std::mktime(&dueTm);
-                if (dueTime == -1) continue; // Invalid time, skip this rental
-                std::time_t now = std::time(nullptr);
-                if (now == -1) continue; // Invalid current time, skip
-                if (now > dueTime) {
-                    this->calculateLateFee(rental.RentalID);
-                    // Re-fetch the updated late fee
-                    sql::Connection* conn = DatabaseManager::getInstance().getConnection();
-                    if (conn) {
-                        sql::PreparedStatement* pstmt = conn->prepareStatement(
-                            "SELECT LateFee FROM Rentals WHERE RentalID = ?"
-                        );
-                        pstmt->setInt(1, rental.RentalID);
-                        sql::ResultSet* feeRes = pstmt->executeQuery();
-                        if (feeRes && feeRes->next()) {
-                            rental.LateFee = feeRes->getDouble("LateFee");
-                        }
-                        delete pstmt;
-                        if (feeRes) delete feeRes;
-                    }
-                }
-            }
+            applyCurrentLateFee(rental, today);
             
             rentals.push_back(rental);
         }
@@ -315,7 +452,9 @@ std::vector<Rental> RentalManager::getActiveRentals() {
 }
 
 std::vector<Rental> RentalManager::getOverdueRentals() {
+    TraceSpan span("rental.getOverdueRentals");
     std::vector<Rental> rentals;
+    std::string today = LateFeePolicy::today();
     try {
         sql::ResultSet* res = DatabaseManager::getInstance().executeSelect(
             "SELECT * FROM Rentals WHERE Status = 'Active' AND DueDate < CURDATE() ORDER BY DueDate"
@@ -328,30 +467,11 @@ std::vector<Rental> RentalManager::getOverdueRentals() {
             rental.RentalDate = res->getString("RentalDate");
             rental.DueDate = res->getString("DueDate");
             rental.ReturnDate = res->getString("ReturnDate");
-            rental.TotalAmount = res->getDouble("TotalAmount");
-            if (res->wasNull()) rental.TotalAmount = 0.0;
-            rental.LateFee = res->getDouble("LateFee");
-            if (res->wasNull()) rental.LateFee = 0.0;
+            rental.TotalAmount = Money::fromString(res->getString("TotalAmount"));
+            rental.LateFee = Money::fromString(res->getString("LateFee"));
             rental.Status = res->getString("Status");
             
-            // Automatically calculate and update late fee for overdue rentals
-            this->calculateLateFee(rental.RentalID);
-            
-            // Re-fetch the updated late fee
-            sql::Connection* conn = DatabaseManager::getInstance().getConnection();
-            if (conn) {
-                sql::PreparedStatement* pstmt = conn->prepareStatement(
-                    "SELECT LateFee FROM Rentals WHERE RentalID = ?"
-                );
-                pstmt->setInt(1, rental.RentalID);
-                sql::ResultSet* feeRes = pstmt->executeQuery();
-                        if (feeRes && feeRes->next()) {
-                            rental.LateFee = feeRes->getDouble("LateFee");
-                            if (feeRes->wasNull()) rental.LateFee = 0.0;
-                        }
-                delete pstmt;
-                if (feeRes) delete feeRes;
-            }
+            applyCurrentLateFee(rental, today);
             
             rentals.push_back(rental);
         }
@@ -363,6 +483,7 @@ std::vector<Rental> RentalManager::getOverdueRentals() {
 }
 
 std::vector<RentalItem> RentalManager::getRentalItems(int rentalID) {
+    TraceSpan span("rental.getRentalItems", rentalID);
     std::vector<RentalItem> items;
     try {
         sql::Connection* conn = DatabaseManager::getInstance().getConnection();
@@ -370,18 +491,18 @@ std::vector<RentalItem> RentalManager::getRentalItems(int rentalID) {
             std::cerr << "Error: Database connection failed." << std::endl;
             return items;
         }
-        sql::PreparedStatement* pstmt = conn->prepareStatement(
+        sql::PreparedStatement* pstmt = DatabaseManager::getInstance().prepare(
             "SELECT * FROM RentalItems WHERE RentalID = ?"
         );
         pstmt->setInt(1, rentalID);
-        sql::ResultSet* res = pstmt->executeQuery();
+        sql::ResultSet* res = DatabaseManager::getInstance().executePreparedQuery(pstmt);
         
         while (res && res->next()) {
             RentalItem item;
             item.RentalItemID = res->getInt("RentalItemID");
             item.RentalID = res->getInt("RentalID");
             item.DressID = res->getInt("DressID");
-            item.RentalPrice = res->getDouble("RentalPrice");
+            item.RentalPrice = Money::fromString(res->getString("RentalPrice"));
             items.push_back(item);
         }
         delete pstmt;
@@ -393,6 +514,7 @@ std::vector<RentalItem> RentalManager::getRentalItems(int rentalID) {
 }
 
 bool RentalManager::calculateLateFee(int rentalID) {
+    TraceSpan span("rental.calculateLateFee", rentalID);
     try {
         // Fetch rental data directly from database to avoid recursion with getRentalByID()
         sql::Connection* conn = DatabaseManager::getInstance().getConnection();
@@ -401,11 +523,11 @@ bool RentalManager::calculateLateFee(int rentalID) {
             return false;
         }
         
-        sql::PreparedStatement* pstmt = conn->prepareStatement(
+        sql::PreparedStatement* pstmt = DatabaseManager::getInstance().prepare(
             "SELECT DueDate, ReturnDate FROM Rentals WHERE RentalID = ?"
         );
         pstmt->setInt(1, rentalID);
-        sql::ResultSet* res = pstmt->executeQuery();
+        sql::ResultSet* res = DatabaseManager::getInstance().executePreparedQuery(pstmt);
         
         if (!res || !res->next()) {
             delete pstmt;
@@ -418,57 +540,21 @@ bool RentalManager::calculateLateFee(int rentalID) {
         delete pstmt;
         delete res;
         
-        // Parse due date
-        std::tm dueTm = {};
-        std::istringstream ss(dueDate);
-        ss >> std::get_time(&dueTm, "%Y-%m-%d");
-        
-        if (ss.fail()) {
+        long dueDay = 0;
+        if (!LateFeePolicy::parseDate(dueDate, dueDay)) {
             return false;
         }
-        
-        std::time_t dueTime = std::mktime(&dueTm);
-        if (dueTime == -1) {
-            return false; // Invalid time
-        }
-        
-        std::time_t compareTime = std::time(nullptr); // Initialize to current time
-        if (compareTime == -1) {
-            return false; // Invalid current time
-        }
-        
-        // Use return date if available, otherwise use current time
-        if (!returnDate.empty() && returnDate != "NULL") {
-            std::tm returnTm = {};
-            std::istringstream returnSs(returnDate);
-            returnSs >> std::get_time(&returnTm, "%Y-%m-%d");
-            if (returnSs.fail()) {
-                return false;
-            }
-            compareTime = std::mktime(&returnTm);
-            if (compareTime == -1) {
-                return false; // Invalid return time
-            }
-        }
-        
-        double lateFee = 0.0;
-        if (compareTime > dueTime) {
-            // Calculate days late and round UP (ceiling) - even 1 hour late = 1 full day
-            double secondsLate = std::difftime(compareTime, dueTime);
-            double daysLate = secondsLate / 86400.0; // 24.0 * 60.0 * 60.0 = 86400.0 seconds per day
-            // Round up to nearest day (ceiling)
-            int daysLateInt = static_cast<int>(std::ceil(daysLate));
-            lateFee = static_cast<double>(daysLateInt) * 10.0; // RM 10 per day
-        }
+        Money lateFee = LateFeePolicy::standard().lateFee(dueDate, returnDate, LateFeePolicy::today());
         
         // Update late fee in database
-        pstmt = conn->prepareStatement(
+        pstmt = DatabaseManager::getInstance().prepare(
             "UPDATE Rentals SET LateFee = ? WHERE RentalID = ?"
         );
-        pstmt->setDouble(1, lateFee);
+        pstmt->setString(1, lateFee.toString());
         pstmt->setInt(2, rentalID);
-        pstmt->executeUpdate();
+        DatabaseManager::getInstance().executePreparedUpdate(pstmt);
         delete pstmt;
+        syncAmountDue(std::vector<int>(1, rentalID));
         return true;
     } catch (sql::SQLException& e) {
         std::cerr << "Error calculating late fee: " << e.what() << std::endl;
@@ -479,62 +565,169 @@ bool RentalManager::calculateLateFee(int rentalID) {
     }
 }
 
-bool RentalManager::returnRental(int rentalID, const std::string& returnDate) {
+// Persists the current fee of every overdue rental in one statement, so reports
+// that sum Rentals.LateFee and the RentalBalances ledger see up-to-date values.
+// Returns the rentals changed, or -1.
+int RentalManager::sweepLateFees() {
+    TraceSpan span("rental.sweepLateFees");
     try {
-        Rental* rental = this->getRentalByID(rentalID);
-        if (!rental) return false;
-        
         sql::Connection* conn = DatabaseManager::getInstance().getConnection();
         if (!conn) {
             std::cerr << "Error: Database connection failed." << std::endl;
-            delete rental;
-            return false;
+            return -1;
         }
         conn->setAutoCommit(false);
+        std::string rate = LateFeePolicy::standard().getDailyRate().toString();
+        sql::PreparedStatement* pstmt = DatabaseManager::getInstance().prepare(
+            "UPDATE Rentals SET LateFee = DATEDIFF(CURDATE(), DueDate) * ? "
+            "WHERE Status = 'Active' AND DueDate < CURDATE() AND LateFee <> DATEDIFF(CURDATE(), DueDate) * ?"
+        );
+        pstmt->setString(1, rate);
+        pstmt->setString(2, rate);
+        int rows = DatabaseManager::getInstance().executePreparedUpdate(pstmt);
+        delete pstmt;
         
-        // Update rental status with return date FIRST
-        sql::PreparedStatement* pstmt = conn->prepareStatement(
-            "UPDATE Rentals SET ReturnDate = ?, Status = 'Returned' WHERE RentalID = ?"
+        pstmt = DatabaseManager::getInstance().prepare(
+            "UPDATE RentalBalances b JOIN Rentals r ON r.RentalID = b.RentalID "
+            "SET b.AmountDue = r.TotalAmount + r.LateFee "
+            "WHERE r.Status = 'Active' AND r.DueDate < CURDATE() AND b.AmountDue <> r.TotalAmount + r.LateFee"
         );
-        pstmt->setString(1, returnDate);
-        pstmt->setInt(2, rentalID);
-        pstmt->executeUpdate();
+        DatabaseManager::getInstance().executePreparedUpdate(pstmt);
         delete pstmt;
         
-        // Calculate late fee AFTER setting return date (so it uses the actual return date)
-        if (!this->calculateLateFee(rentalID)) {
-            std::cerr << "Warning: Failed to calculate late fee for rental ID " << rentalID << std::endl;
-            // Continue anyway - late fee calculation failure shouldn't prevent return
+        conn->commit();
+        conn->setAutoCommit(true);
+        return rows;
+    } catch (sql::SQLException& e) {
+        std::cerr << "Error sweeping late fees: " << e.what() << std::endl;
+        DatabaseManager::rollbackQuietly();
+        return -1;
+    }
+}
+
+int RentalManager::sweepOverdueHolds() {
+    TraceSpan span("rental.sweepOverdueHolds");
+    try {
+        sql::Connection* conn = DatabaseManager::getInstance().getConnection();
+        if (!conn) {
+            std::cerr << "Error: Database connection failed." << std::endl;
+            return -1;
         }
-        
-        // Get rental items to update dress availability
-        std::vector<RentalItem> items = this->getRentalItems(rentalID);
-        DressManager dm;
-        for (const auto& item : items) {
-            if (!dm.updateAvailability(item.DressID, "Available")) {
-                std::cerr << "Warning: Failed to update availability for dress ID " << item.DressID << std::endl;
-                // Continue with other dresses
-            }
+        conn->setAutoCommit(false);
+        // Lock the rentals so a return cannot release the old range meanwhile
+        sql::PreparedStatement* pstmt = DatabaseManager::getInstance().prepare(
+            "SELECT RentalID FROM Rentals WHERE Status = 'Active' AND HeldThrough < CURDATE() FOR UPDATE"
+        );
+        sql::ResultSet* res = DatabaseManager::getInstance().executePreparedQuery(pstmt);
+        std::vector<int> overdue;
+        while (res && res->next()) {
+            overdue.push_back(res->getInt("RentalID"));
         }
-        
+        if (res) delete res;
+        delete pstmt;
+
+        DressStock::holdThroughToday(overdue);
+
         conn->commit();
         conn->setAutoCommit(true);
-        delete rental;
-        return true;
+        return static_cast<int>(overdue.size());
     } catch (sql::SQLException& e) {
-        std::cerr << "Error returning rental: " << e.what() << std::endl;
-        try {
-            sql::Connection* conn = DatabaseManager::getInstance().getConnection();
-            if (conn && !conn->isClosed()) {
-                conn->rollback();
-                conn->setAutoCommit(true);
+        std::cerr << "Error extending overdue holds: " << e.what() << std::endl;
+        DatabaseManager::rollbackQuietly();
+        return -1;
+    }
+}
+
+bool RentalManager::returnRental(int rentalID, const std::string& returnDate) {
+    TraceSpan span("rental.returnRental", rentalID);
+    return returnRentals(std::vector<int>(1, rentalID), returnDate) == 1;
+}
+
+// Returns any number of rentals in one transaction: lock the rentals that are
+// still out, mark them returned with their late fees, copy the fees to the
+// balance ledger, give back their dress units, commit. Rentals that are not
+// active are skipped.
+int RentalManager::returnRentals(const std::vector<int>& rentalIDs, const std::string& returnDate) {
+    TraceSpan span("rental.returnRentals", static_cast<long long>(rentalIDs.size()));
+    long returnDay = 0;
+    if (!LateFeePolicy::parseDate(returnDate, returnDay)) {
+        std::cerr << "Error: Invalid return date format. Please use YYYY-MM-DD format." << std::endl;
+        return -1;
+    }
+    std::vector<int> ids(rentalIDs);
+    std::sort(ids.begin(), ids.end());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+    if (ids.empty()) return 0;
+    
+    try {
+        sql::Connection* conn = DatabaseManager::getInstance().getConnection();
+        conn->setAutoCommit(false);
+        
+        std::vector<int> active;
+        {
+            TraceSpan lockSpan("rental.lockRentals");
+            sql::PreparedStatement* pstmt = DatabaseManager::getInstance().prepare(
+                "SELECT RentalID FROM Rentals WHERE Status = 'Active' AND RentalID IN (" +
+                DatabaseManager::placeholderList(ids.size()) + ") FOR UPDATE"
+            );
+            DatabaseManager::bindIDs(pstmt, 1, ids);
+            sql::ResultSet* res = DatabaseManager::getInstance().executePreparedQuery(pstmt);
+            while (res && res->next()) {
+                active.push_back(res->getInt("RentalID"));
             }
-        } catch (...) {}
-        return false;
+            if (res) delete res;
+            delete pstmt;
+        }
+        if (active.empty()) {
+            conn->commit();
+            conn->setAutoCommit(true);
+            return 0;
+        }
+        std::string inList = "(" + DatabaseManager::placeholderList(active.size()) + ")";
+        
+        {
+            // Same fee as LateFeePolicy: whole days from the due date to the return date
+            TraceSpan updateSpan("rental.markReturned");
+            sql::PreparedStatement* pstmt = DatabaseManager::getInstance().prepare(
+                "UPDATE Rentals SET ReturnDate = ?, Status = 'Returned', "
+                "LateFee = GREATEST(DATEDIFF(?, DueDate), 0) * ? WHERE RentalID IN " + inList
+            );
+            pstmt->setString(1, returnDate);
+            pstmt->setString(2, returnDate);
+            pstmt->setString(3, LateFeePolicy::standard().getDailyRate().toString());
+            DatabaseManager::bindIDs(pstmt, 4, active);
+            DatabaseManager::getInstance().executePreparedUpdate(pstmt);
+            delete pstmt;
+            syncAmountDue(active);
+        }
+        
+        {
+            TraceSpan dressSpan("rental.releaseDresses");
+            DressStock::release(active);
+            // Back in the shop, but out of stock until cleaned
+            CleaningScheduler::enqueue(active, returnDate);
+        }
+        
+        {
+            TraceSpan commitSpan("rental.commit");
+            conn->commit();
+            conn->setAutoCommit(true);
+        }
+        CleaningScheduler::getInstance().wake();
+        return static_cast<int>(active.size());
+    } catch (sql::SQLException& e) {
+        std::cerr << "Error returning rentals: " << e.what() << std::endl;
+        DatabaseManager::rollbackQuietly();
+        return -1;
+    } catch (const std::exception& e) {
+        std::cerr << "Error returning rentals: " << e.what() << std::endl;
+        DatabaseManager::rollbackQuietly();
+        return -1;
     }
 }
 
 bool RentalManager::updateRentalStatus(int rentalID, const std::string& status, const std::string& returnDate) {
+    TraceSpan span("rental.updateRentalStatus", rentalID);
     try {
         Rental* rental = this->getRentalByID(rentalID);
         if (!rental) {
@@ -550,19 +743,19 @@ bool RentalManager::updateRentalStatus(int rentalID, const std::string& status,
         }
         conn->setAutoCommit(false);
         
-        // Get rental items to update dress availability
+        // Get rental items to update dress stock
         std::vector<RentalItem> items = this->getRentalItems(rentalID);
-        DressManager dm;
+        bool wasActive = rental->Status == "Active";
         
         if (status == "Returned") {
             // Marking as returned
-            sql::PreparedStatement* pstmt = conn->prepareStatement(
+            sql::PreparedStatement* pstmt = DatabaseManager::getInstance().prepare(
                 "UPDATE Rentals SET Status = ?, ReturnDate = ? WHERE RentalID = ?"
             );
             pstmt->setString(1, status);
             pstmt->setString(2, returnDate.empty() ? rental->ReturnDate : returnDate);
             pstmt->setInt(3, rentalID);
-            pstmt->executeUpdate();
+            DatabaseManager::getInstance().executePreparedUpdate(pstmt);
             delete pstmt;
             
             // Calculate late fee
@@ -573,67 +766,77 @@ bool RentalManager::updateRentalStatus(int rentalID, const std::string& status,
                 }
             }
             
-            // Update dress availability to Available
-            for (const auto& item : items) {
-                if (!dm.updateAvailability(item.DressID, "Available")) {
-                    std::cerr << "Warning: Failed to update availability for dress ID " << item.DressID << std::endl;
-                    // Continue with other dresses
-                }
+            // Give back the dress units; they wait for cleaning
+            if (wasActive) {
+                DressStock::release(std::vector<int>(1, rentalID));
+                CleaningScheduler::enqueue(std::vector<int>(1, rentalID),
+                                           returnDate.empty() ? LateFeePolicy::today() : returnDate);
             }
         } else if (status == "Active") {
-            // Changing back to Active
-            sql::PreparedStatement* pstmt = conn->prepareStatement(
-                "UPDATE Rentals SET Status = ?, ReturnDate = NULL WHERE RentalID = ?"
+            // Changing back to Active; a rental that was not active holds
+            // nothing, and is reserved to its due date again below
+            sql::PreparedStatement* pstmt = DatabaseManager::getInstance().prepare(
+                "UPDATE Rentals SET HeldThrough = IF(Status = 'Active', HeldThrough, DueDate), Status = ?, "
+                "ReturnDate = NULL WHERE RentalID = ?"
             );
             pstmt->setString(1, status);
             pstmt->setInt(2, rentalID);
-            pstmt->executeUpdate();
+            DatabaseManager::getInstance().executePreparedUpdate(pstmt);
             delete pstmt;
             
             // Reset late fee
-            sql::PreparedStatement* feePstmt = conn->prepareStatement(
+            sql::PreparedStatement* feePstmt = DatabaseManager::getInstance().prepare(
                 "UPDATE Rentals SET LateFee = 0.0 WHERE RentalID = ?"
             );
             feePstmt->setInt(1, rentalID);
-            feePstmt->executeUpdate();
+            DatabaseManager::getInstance().executePreparedUpdate(feePstmt);
             delete feePstmt;
+            syncAmountDue(std::vector<int>(1, rentalID));
             
-            // Update dress availability to Rented
-            for (const auto& item : items) {
-                if (!dm.updateAvailability(item.DressID, "Rented")) {
-                    std::cerr << "Warning: Failed to update availability for dress ID " << item.DressID << std::endl;
-                    // Continue with other dresses
+            // Reserve the dresses again unless the rental still holds them; one
+            // fully booked meanwhile cancels the change
+            std::vector<RentalItem> unreserved = wasActive ? std::vector<RentalItem>() : items;
+            for (const auto& item : unreserved) {
+                if (!DressStock::reserve(item.DressID, rental->RentalDate, rental->DueDate)) {
+                    std::cerr << "Error: Dress ID " << item.DressID << " has no unit left for those dates." << std::endl;
+                    conn->rollback();
+                    conn->setAutoCommit(true);
+                    delete rental;
+                    return false;
                 }
             }
         } else {
             // Other status updates
-            sql::PreparedStatement* pstmt = conn->prepareStatement(
+            sql::PreparedStatement* pstmt = DatabaseManager::getInstance().prepare(
                 "UPDATE Rentals SET Status = ? WHERE RentalID = ?"
             );
             pstmt->setString(1, status);
             pstmt->setInt(2, rentalID);
-            pstmt->executeUpdate();
+            DatabaseManager::getInstance().executePreparedUpdate(pstmt);
             delete pstmt;
+            
+            // A rental that is no longer active holds no units
+            if (wasActive) DressStock::release(std::vector<int>(1, rentalID));
         }
         
         conn->commit();
         conn->setAutoCommit(true);
+        if (status == "Returned" && wasActive) CleaningScheduler::getInstance().wake();
         delete rental;
         return true;
     } catch (sql::SQLException& e) {
         std::cerr << "Error updating rental status: " << e.what() << std::endl;
-        try {
-            sql::Connection* conn = DatabaseManager::getInstance().getConnection();
-            if (conn && !conn->isClosed()) {
-                conn->rollback();
-                conn->setAutoCommit(true);
-            }
-        } catch (...) {}
+        DatabaseManager::rollbackQuietly();
+        return false;
+    } catch (const std::exception& e) {
+        std::cerr << "Error updating rental status: " << e.what() << std::endl;
+        DatabaseManager::rollbackQuietly();
         return false;
     }
 }
 
 void RentalManager::displayRental(const Rental& rental) {
+    RenderFrame frame;
     // Use plain ASCII (no ANSI) to keep widths accurate in all consoles
     const int BOX_WIDTH = 64;       // total width including borders
     const int LABEL_WIDTH = 15;     // width allocated to labels
@@ -650,112 +853,58 @@ void RentalManager::displayRental(const Rental& rental) {
     };
     
     auto line = [=](const std::string& label, const std::string& value) {
-        std::ostringstream oss;
-        oss << "|" << " "
-            << std::setw(LABEL_WIDTH) << std::left << label
-            << " "
-            << std::setw(VALUE_WIDTH) << std::left << value
-            << "|";
-        return oss.str();
-    };
-    
-    auto amountFmt = [](double v) {
-        std::ostringstream oss;
-        oss << "RM " << std::fixed << std::setprecision(2) << v;
-        return oss.str();
+        std::string text = "| ";
+        Format::appendLeft(text, label, LABEL_WIDTH);
+        text += ' ';
+        Format::appendLeft(text, value, VALUE_WIDTH);
+        text += '|';
+        return text;
     };
     
     int padding = padCenter(BOX_WIDTH);
     std::string padStr(padding, ' ');
     
-    std::cout << "\n" << padStr << borderLine() << std::endl;
-    std::cout << padStr << line("Rental ID:", std::to_string(rental.RentalID)) << std::endl;
-    std::cout << padStr << line("Customer ID:", std::to_string(rental.CustomerID)) << std::endl;
-    std::cout << padStr << line("Rental Date:", rental.RentalDate) << std::endl;
-    std::cout << padStr << line("Due Date:", rental.DueDate) << std::endl;
-    std::cout << padStr << line("Return Date:", rental.ReturnDate.empty() ? "Not Returned" : rental.ReturnDate) << std::endl;
-    std::cout << padStr << line("Total Amount:", amountFmt(rental.TotalAmount)) << std::endl;
-    std::cout << padStr << line("Late Fee:", amountFmt(rental.LateFee)) << std::endl;
-    std::cout << padStr << line("Status:", rental.Status) << std::endl;
-    std::cout << padStr << borderLine() << std::endl;
+    UIColors::out() << "\n" << padStr << borderLine() << '\n';
+    UIColors::out() << padStr << line("Rental ID:", std::to_string(rental.RentalID)) << '\n';
+    UIColors::out() << padStr << line("Customer ID:", std::to_string(rental.CustomerID)) << '\n';
+    UIColors::out() << padStr << line("Rental Date:", rental.RentalDate) << '\n';
+    UIColors::out() << padStr << line("Due Date:", rental.DueDate) << '\n';
+    UIColors::out() << padStr << line("Return Date:", rental.ReturnDate.empty() ? "Not Returned" : rental.ReturnDate) << '\n';
+    UIColors::out() << padStr << line("Total Amount:", rental.TotalAmount.toDisplay()) << '\n';
+    UIColors::out() << padStr << line("Late Fee:", rental.LateFee.toDisplay()) << '\n';
+    UIColors::out() << padStr << line("Status:", rental.Status) << '\n';
+    UIColors::out() << padStr << borderLine() << '\n';
 }
 
 void RentalManager::displayRentalDetails(int rentalID) {
-    Rental* rental = this->getRentalByID(rentalID);
-    if (!rental) {
-        std::cout << "Rental not found." << std::endl;
+    TraceSpan span("rental.displayRentalDetails", rentalID);
+    RenderFrame frame;
+    RentalView* view = this->getRentalView(rentalID);
+    if (!view) {
+        UIColors::out() << "Rental not found.\n";
         return;
     }
     
-    this->displayRental(*rental);
+    this->displayRental(view->rental);
     
-    std::vector<RentalItem> items = this->getRentalItems(rentalID);
-    if (!items.empty()) {
-        std::cout << std::endl;
+    if (!view->items.empty()) {
+        UIColors::out() << '\n';
         UIColors::printCentered("Rental Items", SCREEN_WIDTH, UIColors::BOLD + UIColors::CYAN);
         UIColors::printSeparator(SCREEN_WIDTH);
         
-        // Calculate column widths with borders
-        int col1 = 10, col2 = 12, col3 = 15, col4 = 35;
-        int totalWidth = col1 + col2 + col3 + col4 + 5; // +5 for 4 separators + 1
-        int padding = (SCREEN_WIDTH - totalWidth) / 2;
-        if (padding < 0) padding = 0;
-        
-        // Create border line
-        std::string borderLine = std::string(padding, ' ') + "+" + std::string(totalWidth - 2, '-') + "+";
-        
-        // Print top border
-        std::cout << borderLine << std::endl;
-        
-        // Helper to get plain text width (strip ANSI codes)
-        auto plainWidth = [](const std::string& text) -> int {
-            int width = 0;
-            bool inEscape = false;
-            for (char c : text) {
-                if (c == '\033') inEscape = true;
-                else if (inEscape && c == 'm') inEscape = false;
-                else if (!inEscape) width++;
-            }
-            return width;
-        };
-        
-        // Helper to pad colored text to exact width
-        auto padColored = [=](const std::string& coloredText, int targetWidth) -> std::string {
-            int actualWidth = plainWidth(coloredText);
-            if (actualWidth >= targetWidth) return coloredText;
-            return coloredText + std::string(targetWidth - actualWidth, ' ');
-        };
-        
-        // Print header with proper spacing and borders
-        std::cout << std::string(padding, ' ') << "|"
-                  << padColored(UIColors::colorize("Item ID", UIColors::BOLD + UIColors::CYAN), col1) << "|"
-                  << padColored(UIColors::colorize("Dress ID", UIColors::BOLD + UIColors::CYAN), col2) << "|"
-                  << padColored(UIColors::colorize("Rental Price", UIColors::BOLD + UIColors::CYAN), col3) << "|"
-                  << padColored(UIColors::colorize("Dress Name", UIColors::BOLD + UIColors::CYAN), col4) << "|"
-                  << std::endl;
-        
-        // Print separator after header
-        std::cout << borderLine << std::endl;
-        
-        DressManager dm;
-        for (const auto& item : items) {
-            Dress* dress = dm.getDressByID(item.DressID);
-            std::ostringstream priceStream;
-            priceStream << std::fixed << std::setprecision(2) << "RM " << item.RentalPrice;
-            
-            std::cout << std::string(padding, ' ') << "|"
-                      << std::setw(col1) << std::left << item.RentalItemID
-                      << "|" << std::setw(col2) << std::left << item.DressID
-                      << "|" << std::setw(col3) << std::left << priceStream.str()
-                      << "|" << std::setw(col4) << std::left << (dress ? (dress->DressName.length() > col4 - 1 ? dress->DressName.substr(0, col4 - 1) : dress->DressName) : "N/A")
-                      << "|" << std::endl;
-            if (dress) delete dress;
-        }
+        TableRenderer table(SCREEN_WIDTH);
+        table.addColumn("Item ID", 10);
+        table.addColumn("Dress ID", 10);
+        table.addColumn("Rental Price", 15);
+        table.addColumn("Dress Name", 20);
         
-        // Print bottom border
-        std::cout << borderLine << std::endl;
+        for (const auto& item : view->items) {
+            table.addRow({ std::to_string(item.RentalItemID), std::to_string(item.DressID), item.RentalPrice.toDisplay(),
+                           item.DressName });
+        }
+        table.render();
         UIColors::printSeparator(SCREEN_WIDTH);
     }
-    delete rental;
+    delete view;
 }
 
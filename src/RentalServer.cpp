@@ -0,0 +1,741 @@
+#include "RentalServer.h"
+#include "AppConfig.h"
+#include "AuthManager.h"
+#include "CustomerManager.h"
+#include "DressManager.h"
+#include "LateFeePolicy.h"
+#include "PaymentManager.h"
+#include "RentalManager.h"
+#include "TableRenderer.h"
+#include "Trace.h"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+struct RentalServer::Session {
+    bool loggedIn;
+    User user;
+    Session() : loggedIn(false) {}
+};
+
+struct RentalServer::Connection {
+    int fd;
+    std::string input;              // received, not yet dispatched
+    std::string output;             // replies not yet written
+    size_t written;                 // bytes of output already sent
+    bool busy;                      // a command is on a worker
+    bool closing;                   // close once output is written
+    bool closed;
+    bool watchingWrites;
+    Session session;
+    explicit Connection(int fd)
+        : fd(fd), written(0), busy(false), closing(false), closed(false), watchingWrites(false) {}
+};
+
+namespace {
+
+const size_t MAX_LINE = 4096;
+// Commands read ahead of the one running; a terminal that sends more is cut off
+const size_t MAX_INPUT = 64 * 1024;
+const size_t MAX_ROWS = 50;
+const int TABLE_WIDTH = 100;
+
+const char* HELP_TEXT =
+    "login <username> <password>     start a session (Staff or Administrator)\n"
+    "logout | whoami | ping | quit\n"
+    "dress <id>                      one dress\n"
+    "search <text>                   dresses by name, category or color\n"
+    "browse <facet>=<v>[,<v>]; ...   catalogue facets, e.g. browse size=M; color=Red,Black\n"
+    "free <date> [<last date>]       dresses free every day of the range\n"
+    "customer <id> | customers <text>\n"
+    "rental <id>                     rental with its items and payments\n"
+    "rent <customer id> <days> <dress id>[,<dress id>...]   rent from today\n"
+    "return <rental id>              return today\n"
+    "pay <rental id> <amount> <method>   method: Cash, Credit Card, Debit Card or Online\n"
+    "stats                           server statistics (Administrator)\n";
+
+std::vector<std::string> splitWords(const std::string& line) {
+    std::vector<std::string> words;
+    std::istringstream in(line);
+    std::string word;
+    while (in >> word) words.push_back(word);
+    return words;
+}
+
+// The line after its first n words, trimmed
+std::string restOfLine(const std::string& line, int n) {
+    size_t pos = 0;
+    for (int i = 0; i < n; ++i) {
+        pos = line.find_first_not_of(" \t", pos);
+        if (pos == std::string::npos) return "";
+        pos = line.find_first_of(" \t", pos);
+        if (pos == std::string::npos) return "";
+    }
+    size_t first = line.find_first_not_of(" \t", pos);
+    if (first == std::string::npos) return "";
+    size_t last = line.find_last_not_of(" \t");
+    return line.substr(first, last - first + 1);
+}
+
+std::string trim(const std::string& text) {
+    size_t first = text.find_first_not_of(" \t");
+    if (first == std::string::npos) return "";
+    return text.substr(first, text.find_last_not_of(" \t") - first + 1);
+}
+
+std::string lower(std::string text) {
+    for (size_t i = 0; i < text.size(); ++i) text[i] = static_cast<char>(std::tolower(static_cast<unsigned char>(text[i])));
+    return text;
+}
+
+bool parseID(const std::string& text, int& id) {
+    char* end = nullptr;
+    long value = std::strtol(text.c_str(), &end, 10);
+    if (text.empty() || *end != '\0' || value <= 0 || value > 2147483647L) return false;
+    id = static_cast<int>(value);
+    return true;
+}
+
+std::string render(TableRenderer& table) {
+    std::ostringstream out;
+    table.render(out);
+    return out.str();
+}
+
+std::string moreRows(size_t total) {
+    return total > MAX_ROWS ? "... and " + std::to_string(total - MAX_ROWS) + " more\n" : "";
+}
+
+std::string dressTable(const std::vector<Dress>& dresses) {
+    TableRenderer table(TABLE_WIDTH);
+    table.addColumn("ID", 4, 0, TableRenderer::ALIGN_RIGHT);
+    table.addColumn("Name", 16);
+    table.addColumn("Category", 10);
+    table.addColumn("Size", 5);
+    table.addColumn("Color", 8);
+    table.addColumn("Price", 11, 0, TableRenderer::ALIGN_RIGHT);
+    table.addColumn("Status", 12);
+    table.addColumn("Cleaning", 15);
+    for (size_t i = 0; i < dresses.size() && i < MAX_ROWS; ++i) {
+        const Dress& dress = dresses[i];
+        table.addRow({ std::to_string(dress.DressID), dress.DressName, dress.Category, dress.Size, dress.Color,
+                       dress.RentalPrice.toDisplay(), dress.AvailabilityStatus, dress.CleaningStatus });
+    }
+    return render(table) + moreRows(dresses.size());
+}
+
+bool showDress(const std::vector<std::string>& words, std::string& reply) {
+    int dressID = 0;
+    if (words.size() != 2 || !parseID(words[1], dressID)) {
+        reply = "Usage: dress <id>\n";
+        return false;
+    }
+    DressManager dresses;
+    Dress* dress = dresses.getDressByID(dressID);
+    if (!dress) {
+        reply = "Dress #" + words[1] + " not found.\n";
+        return false;
+    }
+    reply = "Dress #" + std::to_string(dress->DressID) + ": " + dress->DressName + "\n"
+            "Category:     " + dress->Category + "\n"
+            "Size:         " + dress->Size + "\n"
+            "Color:        " + dress->Color + "\n"
+            "Price/day:    " + dress->RentalPrice.toDisplay() + "\n"
+            "Condition:    " + dress->ConditionStatus + "\n"
+            "Availability: " + dress->AvailabilityStatus + "\n"
+            "Cleaning:     " + dress->CleaningStatus + "\n";
+    delete dress;
+    return true;
+}
+
+bool showCustomer(const std::vector<std::string>& words, std::string& reply) {
+    int customerID = 0;
+    if (words.size() != 2 || !parseID(words[1], customerID)) {
+        reply = "Usage: customer <id>\n";
+        return false;
+    }
+    CustomerManager customers;
+    Customer* customer = customers.getCustomerByID(customerID);
+    if (!customer) {
+        reply = "Customer #" + words[1] + " not found.\n";
+        return false;
+    }
+    reply = "Customer #" + std::to_string(customer->CustomerID) + ": " + customer->Name + "\n"
+            "IC number:      " + customer->IC_Number + "\n"
+            "Phone:          " + customer->Phone + "\n"
+            "Email:          " + customer->Email + "\n"
+            "Active rentals: " + std::to_string(customers.getActiveRentalCount(customerID)) + "\n";
+    delete customer;
+    return true;
+}
+
+bool searchCustomers(const std::string& term, std::string& reply) {
+    if (term.empty()) {
+        reply = "Usage: customers <text>\n";
+        return false;
+    }
+    CustomerManager customers;
+    std::vector<Customer> found = customers.searchCustomers(term);
+    if (found.empty()) {
+        reply = "No customers match \"" + term + "\".\n";
+        return true;
+    }
+    TableRenderer table(TABLE_WIDTH);
+    table.addColumn("ID", 6, 0, TableRenderer::ALIGN_RIGHT);
+    table.addColumn("Name", 20);
+    table.addColumn("IC Number", 15);
+    table.addColumn("Phone", 13);
+    for (size_t i = 0; i < found.size() && i < MAX_ROWS; ++i) {
+        table.addRow({ std::to_string(found[i].CustomerID), found[i].Name, found[i].IC_Number, found[i].Phone });
+    }
+    reply = render(table) + moreRows(found.size());
+    return true;
+}
+
+bool showRental(const std::vector<std::string>& words, std::string& reply) {
+    int rentalID = 0;
+    if (words.size() != 2 || !parseID(words[1], rentalID)) {
+        reply = "Usage: rental <id>\n";
+        return false;
+    }
+    RentalManager rentals;
+    RentalView* view = rentals.getRentalView(rentalID);
+    if (!view) {
+        reply = "Rental #" + words[1] + " not found.\n";
+        return false;
+    }
+    const Rental& rental = view->rental;
+    reply = "Rental #" + std::to_string(rental.RentalID) + " (" + rental.Status + ") for " + view->customer.Name +
+            " (#" + std::to_string(rental.CustomerID) + ")\n"
+            "Rented " + rental.RentalDate + ", due " + rental.DueDate +
+            (rental.ReturnDate.empty() ? std::string() : ", returned " + rental.ReturnDate) + "\n";
+    TableRenderer table(TABLE_WIDTH);
+    table.addColumn("Dress", 6, 0, TableRenderer::ALIGN_RIGHT);
+    table.addColumn("Name", 24);
+    table.addColumn("Price", 11, 0, TableRenderer::ALIGN_RIGHT);
+    for (const RentalViewItem& item : view->items) {
+        table.addRow({ std::to_string(item.DressID), item.DressName, item.RentalPrice.toDisplay() });
+    }
+    reply += render(table);
+    reply += "Total " + rental.TotalAmount.toDisplay() + ", late fee " + rental.LateFee.toDisplay() + ", paid " +
+             view->TotalPaid.toDisplay() + " in " + std::to_string(view->PaymentCount) + " payment(s)\n";
+    delete view;
+    return true;
+}
+
+bool parseDressIDs(const std::string& list, std::vector<int>& dressIDs) {
+    std::istringstream in(list);
+    std::string item;
+    while (std::getline(in, item, ',')) {
+        int dressID = 0;
+        if (!parseID(trim(item), dressID)) return false;
+        dressIDs.push_back(dressID);
+    }
+    return !dressIDs.empty();
+}
+
+} // namespace
+
+RentalServer::RentalServer(const std::string& socketPath, int workerCount)
+    : socketPath(socketPath), workerCount(workerCount > 0 ? workerCount : 1), listenFD(-1),
+      catalog(cacheSecondsFromConfig()), calendar(cacheSecondsFromConfig()) {
+    stats.connectionsAccepted = 0;
+    stats.connectionsOpen = 0;
+    stats.connectionsPeak = 0;
+    stats.requests = 0;
+    stats.requestErrors = 0;
+    stats.workers = this->workerCount;
+    stats.workersBusy = 0;
+    stats.requestsQueued = 0;
+}
+
+RentalServer::~RentalServer() {
+    workers.stop();
+#ifdef __linux__
+    if (listenFD >= 0) close(listenFD);
+#endif
+}
+
+std::string RentalServer::socketPathFromConfig() {
+    return AppConfig::getInstance().getString("server_socket", "/tmp/dress_rental.sock");
+}
+
+int RentalServer::workersFromConfig() {
+    int count = AppConfig::getInstance().getInt("server_workers", 8);
+    return count > 0 ? count : 1;
+}
+
+int RentalServer::cacheSecondsFromConfig() {
+    int seconds = AppConfig::getInstance().getInt("server_cache_seconds", 60);
+    return seconds > 0 ? seconds : 0;
+}
+
+RentalServer::Stats RentalServer::getStats() {
+    Stats current;
+    {
+        std::lock_guard<std::mutex> lock(statsMutex);
+        current = stats;
+    }
+    current.workersBusy = workers.busy();
+    current.requestsQueued = workers.queued();
+    return current;
+}
+
+void RentalServer::stop() {
+    loop.stop();
+}
+
+#ifdef __linux__
+
+bool RentalServer::start() {
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (socketPath.empty() || socketPath.size() >= sizeof(address.sun_path)) {
+        std::cerr << "Server socket path is empty or too long: " << socketPath << std::endl;
+        return false;
+    }
+    std::memcpy(address.sun_path, socketPath.c_str(), socketPath.size());
+
+    // A socket file nobody listens on is left over from a server that died;
+    // one that answers belongs to a running server
+    int probe = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (probe >= 0) {
+        bool inUse = connect(probe, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0;
+        close(probe);
+        if (inUse) {
+            std::cerr << "Another server is already listening on " << socketPath << std::endl;
+            return false;
+        }
+    }
+    unlink(socketPath.c_str());
+
+    listenFD = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listenFD < 0 || bind(listenFD, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        listen(listenFD, SOMAXCONN) != 0) {
+        std::cerr << "Cannot listen on " << socketPath << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    // Terminals run as users of the server's group
+    chmod(socketPath.c_str(), 0660);
+
+    if (!loop.open() || !loop.add(listenFD, EPOLLIN, [this](uint32_t) { onAccept(); })) return false;
+    workers.start(workerCount);
+    return true;
+}
+
+void RentalServer::run() {
+    loop.run();
+
+    std::vector<std::shared_ptr<Connection>> open;
+    for (std::unordered_map<int, std::shared_ptr<Connection>>::iterator it = connections.begin();
+         it != connections.end(); ++it) {
+        open.push_back(it->second);
+    }
+    for (size_t i = 0; i < open.size(); ++i) closeConnection(open[i]);
+    workers.stop();
+    loop.remove(listenFD);
+    close(listenFD);
+    listenFD = -1;
+    unlink(socketPath.c_str());
+}
+
+void RentalServer::onAccept() {
+    while (true) {
+        int fd = accept4(listenFD, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR) continue;
+            // Out of descriptors: the backlog keeps the rest until some close
+            if (errno != EAGAIN && errno != EWOULDBLOCK) std::cerr << "accept: " << std::strerror(errno) << std::endl;
+            return;
+        }
+        std::shared_ptr<Connection> connection = std::make_shared<Connection>(fd);
+        if (!loop.add(fd, EPOLLIN, [this, connection](uint32_t events) { onReadable(connection, events); })) {
+            close(fd);
+            continue;
+        }
+        connections[fd] = connection;
+        std::lock_guard<std::mutex> lock(statsMutex);
+        stats.connectionsAccepted++;
+        stats.connectionsOpen++;
+        stats.connectionsPeak = std::max(stats.connectionsPeak, stats.connectionsOpen);
+    }
+}
+
+void RentalServer::onReadable(const std::shared_ptr<Connection>& connection, uint32_t events) {
+    if (events & EPOLLERR) {
+        closeConnection(connection);
+        return;
+    }
+    if ((events & EPOLLOUT) && !flush(connection)) return;
+    if (!(events & (EPOLLIN | EPOLLHUP))) return;
+
+    char buffer[4096];
+    while (true) {
+        ssize_t received = recv(connection->fd, buffer, sizeof(buffer), 0);
+        if (received > 0) {
+            connection->input.append(buffer, static_cast<size_t>(received));
+            if (connection->input.size() > MAX_INPUT) {
+                closeConnection(connection);
+                return;
+            }
+            continue;
+        }
+        if (received < 0 && errno == EINTR) continue;
+        if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+        // The terminal went away; whatever it still had queued is dropped
+        closeConnection(connection);
+        return;
+    }
+    dispatch(connection);
+}
+
+void RentalServer::dispatch(const std::shared_ptr<Connection>& connection) {
+    // One command at a time per terminal, and only once its last reply is out
+    if (connection->closed || connection->closing || connection->busy || !connection->output.empty()) return;
+    size_t end = connection->input.find('\n');
+    if (end == std::string::npos) {
+        if (connection->input.size() > MAX_LINE) {
+            connection->closing = true;
+            finish(connection, false, "Command longer than " + std::to_string(MAX_LINE) + " bytes.\n");
+        }
+        return;
+    }
+    std::string line = connection->input.substr(0, end);
+    connection->input.erase(0, end + 1);
+    if (!line.empty() && line[line.size() - 1] == '\r') line.erase(line.size() - 1);
+    {
+        std::lock_guard<std::mutex> lock(statsMutex);
+        stats.requests++;
+    }
+    if (trim(line) == "quit") {
+        connection->closing = true;
+        finish(connection, true, "Bye.\n");
+        return;
+    }
+
+    connection->busy = true;
+    workers.submit([this, connection, line]() {
+        std::string reply;
+        bool ok = false;
+        try {
+            ok = handle(connection->session, line, reply);
+        } catch (const std::exception& e) {
+            reply = std::string("Server error: ") + e.what() + "\n";
+        }
+        loop.post([this, connection, ok, reply]() {
+            connection->busy = false;
+            finish(connection, ok, reply);
+        });
+    });
+}
+
+void RentalServer::finish(const std::shared_ptr<Connection>& connection, bool ok, const std::string& body) {
+    if (connection->closed) return;
+    if (!ok) {
+        std::lock_guard<std::mutex> lock(statsMutex);
+        stats.requestErrors++;
+    }
+    connection->output += (ok ? "OK " : "ERR ") + std::to_string(body.size()) + "\n";
+    connection->output += body;
+    flush(connection);
+}
+
+bool RentalServer::flush(const std::shared_ptr<Connection>& connection) {
+    while (connection->written < connection->output.size()) {
+        ssize_t sent = send(connection->fd, connection->output.data() + connection->written,
+                            connection->output.size() - connection->written, MSG_NOSIGNAL);
+        if (sent > 0) {
+            connection->written += static_cast<size_t>(sent);
+            continue;
+        }
+        if (sent < 0 && errno == EINTR) continue;
+        if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            // The terminal reads slowly: finish when the socket drains
+            if (!connection->watchingWrites) {
+                loop.modify(connection->fd, EPOLLIN | EPOLLOUT);
+                connection->watchingWrites = true;
+            }
+            return true;
+        }
+        closeConnection(connection);
+        return false;
+    }
+    connection->output.clear();
+    connection->written = 0;
+    if (connection->watchingWrites) {
+        loop.modify(connection->fd, EPOLLIN);
+        connection->watchingWrites = false;
+    }
+    if (connection->closing) {
+        closeConnection(connection);
+        return false;
+    }
+    dispatch(connection);
+    return true;
+}
+
+void RentalServer::closeConnection(const std::shared_ptr<Connection>& connection) {
+    if (connection->closed) return;
+    connection->closed = true;
+    loop.remove(connection->fd);
+    close(connection->fd);
+    connections.erase(connection->fd);
+    std::lock_guard<std::mutex> lock(statsMutex);
+    stats.connectionsOpen--;
+}
+
+#else
+
+bool RentalServer::start() {
+    std::cerr << "Server mode needs Linux (epoll and Unix domain sockets)." << std::endl;
+    return false;
+}
+
+void RentalServer::run() {}
+void RentalServer::onAccept() {}
+void RentalServer::onReadable(const std::shared_ptr<Connection>&, uint32_t) {}
+void RentalServer::dispatch(const std::shared_ptr<Connection>&) {}
+void RentalServer::finish(const std::shared_ptr<Connection>&, bool, const std::string&) {}
+bool RentalServer::flush(const std::shared_ptr<Connection>&) { return false; }
+void RentalServer::closeConnection(const std::shared_ptr<Connection>&) {}
+
+#endif
+
+bool RentalServer::handle(Session& session, const std::string& line, std::string& reply) {
+    std::vector<std::string> words = splitWords(line);
+    if (words.empty()) {
+        reply = "Empty command; type help for the list.\n";
+        return false;
+    }
+    std::string command = lower(words[0]);
+    TraceSpan span("server.request");
+
+    if (command == "help") {
+        reply = HELP_TEXT;
+        return true;
+    }
+    if (command == "ping") {
+        reply = "pong\n";
+        return true;
+    }
+    if (command == "login") {
+        std::string password = restOfLine(line, 2);
+        if (words.size() < 3) {
+            reply = "Usage: login <username> <password>\n";
+            return false;
+        }
+        User user;
+        if (!AuthManager::authenticate(words[1], password, user)) {
+            reply = "Invalid username or password.\n";
+            return false;
+        }
+        session.user = user;
+        session.loggedIn = true;
+        reply = "Welcome, " + user.FullName + " (" + user.Role + ").\n";
+        return true;
+    }
+    if (!session.loggedIn) {
+        reply = "Log in first: login <username> <password>\n";
+        return false;
+    }
+
+    if (command == "logout") {
+        session.loggedIn = false;
+        session.user = User();
+        reply = "Logged out.\n";
+        return true;
+    }
+    if (command == "whoami") {
+        reply = session.user.Username + " (" + session.user.Role + ")\n";
+        return true;
+    }
+    if (command == "dress") return showDress(words, reply);
+    if (command == "customer") return showCustomer(words, reply);
+    if (command == "customers") return searchCustomers(restOfLine(line, 1), reply);
+    if (command == "rental") return showRental(words, reply);
+
+    if (command == "search") {
+        std::string term = restOfLine(line, 1);
+        if (term.empty()) {
+            reply = "Usage: search <text>\n";
+            return false;
+        }
+        DressManager dresses;
+        std::vector<Dress> found = dresses.searchDresses(term);
+        reply = found.empty() ? "No dresses match \"" + term + "\".\n" : dressTable(found);
+        return true;
+    }
+
+    if (command == "browse") {
+        // browse size=M; color=Red,Black
+        DressCatalog::Query query;
+        std::istringstream filters(restOfLine(line, 1));
+        std::string filter;
+        while (std::getline(filters, filter, ';')) {
+            filter = trim(filter);
+            if (filter.empty()) continue;
+            size_t equals = filter.find('=');
+            int facet = -1;
+            for (int f = 0; f < DressCatalog::FACET_COUNT && equals != std::string::npos; ++f) {
+                DressCatalog::Facet candidate = static_cast<DressCatalog::Facet>(f);
+                if (lower(trim(filter.substr(0, equals))) == lower(DressCatalog::facetName(candidate))) facet = f;
+            }
+            if (facet < 0) {
+                reply = "Unknown filter \"" + filter + "\"; facets are category, size, color, condition, "
+                        "availability and cleaning.\n";
+                return false;
+            }
+            std::istringstream values(filter.substr(equals + 1));
+            std::string value;
+            while (std::getline(values, value, ',')) {
+                if (!trim(value).empty()) query.require(static_cast<DressCatalog::Facet>(facet), trim(value));
+            }
+        }
+        std::shared_ptr<const DressCatalog> snapshot = catalog.get();
+        if (!snapshot) {
+            reply = "The dress catalogue could not be loaded.\n";
+            return false;
+        }
+        DressCatalog::Result result = snapshot->search(query, MAX_ROWS);
+        std::vector<Dress> found;
+        for (int dressID : result.dressIDs) {
+            Dress dress;
+            if (snapshot->getDress(dressID, dress)) found.push_back(dress);
+        }
+        reply = std::to_string(result.total) + " dress(es) match.\n";
+        for (int f = 0; f < DressCatalog::FACET_COUNT; ++f) {
+            const std::vector<DressCatalog::FacetCount>& counts = result.facets[f];
+            if (counts.empty()) continue;
+            reply += std::string(DressCatalog::facetName(static_cast<DressCatalog::Facet>(f))) + ":";
+            for (size_t i = 0; i < counts.size() && i < 8; ++i) {
+                reply += (i == 0 ? " " : ", ") + counts[i].value + " " + std::to_string(counts[i].count);
+            }
+            reply += "\n";
+        }
+        if (!found.empty()) reply += dressTable(found) + moreRows(result.total);
+        return true;
+    }
+
+    if (command == "free") {
+        if (words.size() < 2 || words.size() > 3) {
+            reply = "Usage: free <date> [<last date>]\n";
+            return false;
+        }
+        std::shared_ptr<const AvailabilityCalendar> days = calendar.get();
+        std::shared_ptr<const DressCatalog> dresses = catalog.get();
+        if (!days || !dresses) {
+            reply = "The availability calendar could not be loaded.\n";
+            return false;
+        }
+        int firstDay = days->dayOf(words[1]);
+        int lastDay = words.size() == 3 ? days->dayOf(words[2]) : firstDay;
+        if (firstDay < 0 || lastDay < firstDay) {
+            reply = "Dates must be YYYY-MM-DD within " + std::to_string(AvailabilityCalendar::WINDOW_DAYS) +
+                    " days from " + days->getStartDate() + ", the last not before the first.\n";
+            return false;
+        }
+        std::vector<int> freeIDs = days->freeDresses(firstDay, lastDay);
+        std::vector<Dress> found;
+        for (size_t i = 0; i < freeIDs.size() && found.size() < MAX_ROWS; ++i) {
+            Dress dress;
+            if (dresses->getDress(freeIDs[i], dress)) found.push_back(dress);
+        }
+        reply = std::to_string(freeIDs.size()) + " dress(es) free from " + days->dateAt(firstDay) + " to " +
+                days->dateAt(lastDay) + ".\n";
+        if (!found.empty()) reply += dressTable(found) + moreRows(freeIDs.size());
+        return true;
+    }
+
+    if (command == "rent") {
+        int customerID = 0;
+        int days = 0;
+        std::vector<int> dressIDs;
+        if (words.size() != 4 || !parseID(words[1], customerID) || !parseID(words[2], days) ||
+            !parseDressIDs(words[3], dressIDs)) {
+            reply = "Usage: rent <customer id> <days> <dress id>[,<dress id>...]\n";
+            return false;
+        }
+        RentalManager rentals;
+        int rentalID = rentals.createRental(customerID, LateFeePolicy::today(), days, dressIDs);
+        if (rentalID <= 0) {
+            reply = "Rental not created: check the customer's active rentals, the duration (1-14 days) and that "
+                    "every dress is available.\n";
+            return false;
+        }
+        calendar.invalidate();
+        Rental* rental = rentals.getRentalByID(rentalID);
+        reply = "Rental #" + std::to_string(rentalID) + " created";
+        if (rental) reply += ", due " + rental->DueDate + ", total " + rental->TotalAmount.toDisplay();
+        reply += ".\n";
+        delete rental;
+        return true;
+    }
+
+    if (command == "return") {
+        int rentalID = 0;
+        if (words.size() != 2 || !parseID(words[1], rentalID)) {
+            reply = "Usage: return <rental id>\n";
+            return false;
+        }
+        RentalManager rentals;
+        if (!rentals.returnRental(rentalID, LateFeePolicy::today())) {
+            reply = "Rental #" + words[1] + " is not an active rental.\n";
+            return false;
+        }
+        calendar.invalidate();
+        reply = "Rental #" + words[1] + " returned.\n";
+        return true;
+    }
+
+    if (command == "pay") {
+        int rentalID = 0;
+        Money amount;
+        std::string method = restOfLine(line, 3);
+        PaymentManager payments;
+        if (words.size() < 4 || !parseID(words[1], rentalID) || !Money::parse(words[2], amount) ||
+            amount <= Money() || !payments.validatePaymentMethod(method)) {
+            reply = "Usage: pay <rental id> <amount> <Cash|Credit Card|Debit Card|Online>\n";
+            return false;
+        }
+        if (!payments.createPayment(rentalID, amount, method, LateFeePolicy::today())) {
+            reply = "Payment for rental #" + words[1] + " not recorded.\n";
+            return false;
+        }
+        reply = "Payment of " + amount.toDisplay() + " recorded for rental #" + words[1] + ".\n";
+        return true;
+    }
+
+    if (command == "stats") {
+        if (session.user.Role != "Administrator") {
+            reply = "Administrator role required.\n";
+            return false;
+        }
+        Stats current = getStats();
+        reply = "Terminals:  " + std::to_string(current.connectionsOpen) + " connected, " +
+                std::to_string(current.connectionsPeak) + " at most, " +
+                std::to_string(current.connectionsAccepted) + " since start\n"
+                "Requests:   " + std::to_string(current.requests) + " (" + std::to_string(current.requestErrors) +
+                " errors), " + std::to_string(current.requestsQueued) + " queued\n"
+                "Workers:    " + std::to_string(current.workersBusy) + " of " + std::to_string(current.workers) +
+                " busy, one database connection each\n";
+        return true;
+    }
+
+    reply = "Unknown command \"" + words[0] + "\"; type help for the list.\n";
+    return false;
+}
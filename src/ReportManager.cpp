@@ -5,15 +5,43 @@
 #include "DressManager.h"
 #include "RentalManager.h"
 #include "PaymentManager.h"
+#include "LateFeePolicy.h"
+#include "OverdueSweeper.h"
+#include "CleaningScheduler.h"
+#include "Trace.h"
+#include "Format.h"
 #include <iostream>
 #include <iomanip>
-#include <sstream>
 #include <algorithm>
 #include <cmath>
+#include <cstdlib>
+
+namespace {
+
+// Report text is built in one string and handed to the stream in chunks of
+// about this size, so a long report costs a few large writes
+const size_t FLUSH_BYTES = 64 * 1024;
+
+void writeText(std::ostream& out, std::string& text) {
+    out.write(text.data(), static_cast<std::streamsize>(text.size()));
+    text.clear();
+}
+
+void flushIfFull(std::ostream& out, std::string& text) {
+    if (text.size() >= FLUSH_BYTES) writeText(out, text);
+}
+
+void appendRule(std::string& text, int width) {
+    text.append(width, '=');
+    text += '\n';
+}
+
+} // namespace
 
 void ReportManager::displayBarChart(const std::string& title, const std::vector<std::pair<std::string, double>>& data) {
+    RenderFrame frame;
     if (data.empty()) {
-        std::cout << "\nNo data available for chart." << std::endl;
+        UIColors::out() << "\nNo data available for chart.\n";
         return;
     }
     
@@ -22,154 +50,188 @@ void ReportManager::displayBarChart(const std::string& title, const std::vector<
         if (pair.second > maxValue) maxValue = pair.second;
     }
     
-    std::cout << "\n" << title << std::endl;
-    std::cout << std::string(80, '=') << std::endl;
+    UIColors::out() << "\n" << title << '\n';
+    UIColors::out() << std::string(80, '=') << '\n';
     
     const int barWidth = 50;
     for (const auto& pair : data) {
         int barLength = maxValue > 0 ? static_cast<int>((pair.second / maxValue) * barWidth) : 0;
-        std::cout << std::setw(20) << std::left << pair.first.substr(0, 18) << " |";
-        std::cout << std::string(barLength, '#');
-        std::cout << " " << std::fixed << std::setprecision(2) << pair.second << std::endl;
+        UIColors::out() << std::setw(20) << std::left << pair.first.substr(0, 18) << " |";
+        UIColors::out() << std::string(barLength, '#');
+        UIColors::out() << " " << Format::fixed(pair.second, 2) << '\n';
     }
-    std::cout << std::string(80, '=') << std::endl;
+    UIColors::out() << std::string(80, '=') << '\n';
 }
 
 void ReportManager::displaySummaryList(const std::vector<std::string>& items) {
+    RenderFrame frame;
     if (items.empty()) return;
     
-    std::cout << "\n" << std::string(60, '=') << std::endl;
-    std::cout << "Helpful Summary" << std::endl;
-    std::cout << std::string(60, '=') << std::endl;
+    UIColors::out() << "\n" << std::string(60, '=') << '\n';
+    UIColors::out() << "Helpful Summary\n";
+    UIColors::out() << std::string(60, '=') << '\n';
     int idx = 1;
     for (const auto& item : items) {
-        std::cout << std::setw(3) << idx++ << ". " << item << std::endl;
+        UIColors::out() << std::setw(3) << idx++ << ". " << item << '\n';
     }
-    std::cout << std::string(60, '=') << std::endl;
+    UIColors::out() << std::string(60, '=') << '\n';
 }
 
-void ReportManager::displayTextChart(const std::string& title, const std::vector<std::pair<std::string, double>>& data) {
+void ReportManager::displayTextChart(const std::string& title, const std::vector<std::pair<std::string, Money>>& data) {
+    RenderFrame frame;
     if (data.empty()) {
-        std::cout << "\nNo data available for text chart." << std::endl;
+        UIColors::out() << "\nNo data available for text chart.\n";
         return;
     }
     
-    double maxValue = 0.0;
+    Money maxValue;
     for (const auto& pair : data) {
         if (pair.second > maxValue) maxValue = pair.second;
     }
     
     const int barWidth = 20;
-    std::cout << "\n" << title << std::endl;
-    std::cout << std::string(60, '-') << std::endl;
+    UIColors::out() << "\n" << title << '\n';
+    UIColors::out() << std::string(60, '-') << '\n';
     
     for (const auto& pair : data) {
-        int barLength = maxValue > 0 ? static_cast<int>(std::round((pair.second / maxValue) * barWidth)) : 0;
-        std::ostringstream amount;
-        amount << " (RM " << std::fixed << std::setprecision(2) << pair.second << ")";
-        std::cout << std::setw(12) << std::left << pair.first.substr(0, 10)
-                  << ": " << std::string(barLength, '*') << amount.str() << std::endl;
+        int barLength = maxValue.isPositive()
+            ? static_cast<int>(std::round(pair.second.toDouble() / maxValue.toDouble() * barWidth)) : 0;
+        UIColors::out() << std::setw(12) << std::left << pair.first.substr(0, 10)
+                  << ": " << std::string(barLength, '*') << " (" << pair.second.toDisplay() << ")" << '\n';
     }
     
-    std::cout << std::string(60, '-') << std::endl;
+    UIColors::out() << std::string(60, '-') << '\n';
 }
 
-void ReportManager::displayTextGraphSummary(const std::vector<std::pair<std::string, double>>& data) {
+void ReportManager::displayTextGraphSummary(const std::vector<std::pair<std::string, Money>>& data) {
+    RenderFrame frame;
     if (data.empty()) return;
     
-    std::cout << "\nSales Summary (Text-Based Trend)" << std::endl;
+    UIColors::out() << "\nSales Summary (Text-Based Trend)\n";
     for (size_t i = 0; i < data.size(); ++i) {
         const auto& entry = data[i];
-        std::ostringstream line;
-        line << "- " << entry.first << " sales: RM " << std::fixed << std::setprecision(2) << entry.second;
-        
-        if (i > 0 && data[i-1].second > 0) {
-            double diff = entry.second - data[i-1].second;
-            double pct = (diff / data[i-1].second) * 100.0;
-            std::ostringstream change;
-            change << " (" << std::fixed << std::setprecision(0) << std::abs(pct) << "% "
-                   << (pct >= 0 ? "increase" : "decrease") << " from " << data[i-1].first << ")";
+        std::string line = "- " + entry.first + " sales: " + entry.second.toDisplay();
+        
+        if (i > 0 && data[i-1].second.isPositive()) {
+            Money diff = entry.second - data[i-1].second;
+            double pct = diff.toDouble() / data[i-1].second.toDouble() * 100.0;
+            std::string change = " (" + Format::fixed(std::abs(pct), 0) + "% " +
+                                 (pct >= 0 ? "increase" : "decrease") + " from " + data[i-1].first + ")";
             std::string color = pct >= 0 ? UIColors::GREEN : UIColors::RED;
-            UIColors::printCentered(line.str() + change.str(), 80, color);
+            UIColors::printCentered(line + change, 80, color);
         } else {
-            UIColors::printCentered(line.str(), 80, UIColors::WHITE);
+            UIColors::printCentered(line, 80, UIColors::WHITE);
         }
     }
 }
 
-void ReportManager::generateMonthlySalesReport(const std::string& year) {
+std::vector<MonthlySales> ReportManager::getMonthlySales(const std::string& year) {
+    std::vector<MonthlySales> rows;
     try {
-        std::string query = 
+        // A date range rather than YEAR(RentalDate) so idx_date_amounts covers it
+        sql::PreparedStatement* pstmt = nullptr;
+        sql::ResultSet* res = DatabaseManager::getInstance().executeRead(
             "SELECT DATE_FORMAT(r.RentalDate, '%Y-%m') as Month, "
             "SUM(r.TotalAmount + r.LateFee) as TotalSales, "
             "COUNT(DISTINCT r.RentalID) as RentalCount "
             "FROM Rentals r "
-            "WHERE YEAR(r.RentalDate) = " + year + " "
+            "WHERE r.RentalDate >= ? AND r.RentalDate < ? "
             "GROUP BY DATE_FORMAT(r.RentalDate, '%Y-%m') "
-            "ORDER BY Month";
-        
-        sql::ResultSet* res = DatabaseManager::getInstance().executeSelect(query);
-        
-        std::cout << std::endl;
-        std::string title = "MONTHLY SALES REPORT - " + year;
-        UIColors::printCentered(title, 80, UIColors::BOLD + UIColors::CYAN);
-        UIColors::printSeparator(80);
-        std::cout << std::setw(15) << "Month" << std::setw(20) << "Total Sales (RM)"
-                  << std::setw(20) << "Rental Count" << std::endl;
-        std::cout << std::string(80, '=') << std::endl;
-        
-        std::vector<std::pair<std::string, double>> chartData;
-        double totalYearSales = 0.0;
-        int totalRentals = 0;
-        std::vector<std::pair<std::string, double>> monthlySales;
-        std::string bestMonth;
-        double bestSales = -1.0;
+            "ORDER BY Month",
+            [&](sql::PreparedStatement* statement) {
+                statement->setString(1, year + "-01-01");
+                statement->setString(2, std::to_string(std::atoi(year.c_str()) + 1) + "-01-01");
+            },
+            pstmt);
         
         while (res && res->next()) {
-            std::string month = res->getString("Month");
-            double sales = res->getDouble("TotalSales");
-            int count = res->getInt("RentalCount");
-            
-            std::cout << std::setw(15) << month
-                      << std::setw(20) << std::fixed << std::setprecision(2) << sales
-                      << std::setw(20) << count << std::endl;
-            
-            chartData.push_back({month, sales});
-            monthlySales.push_back({month, sales});
-            totalYearSales += sales;
-            totalRentals += count;
-            
-            if (sales > bestSales) {
-                bestSales = sales;
-                bestMonth = month;
-            }
+            MonthlySales row;
+            row.Month = res->getString("Month");
+            row.TotalSales = Money::fromString(res->getString("TotalSales"));
+            row.RentalCount = res->getInt("RentalCount");
+            rows.push_back(row);
         }
         
-        std::cout << std::string(80, '=') << std::endl;
-        std::cout << std::setw(15) << "TOTAL" << std::setw(20) << std::fixed << std::setprecision(2) << totalYearSales
-                  << std::setw(20) << totalRentals << std::endl;
-        std::cout << std::string(80, '=') << std::endl;
-        
         if (res) delete res;
-        
-        displayBarChart("\nMonthly Sales Trend", chartData);
-        
-        std::ostringstream totalSalesStr;
-        totalSalesStr << "Total Monthly Sales: RM " << std::fixed << std::setprecision(2) << totalYearSales;
-        std::vector<std::string> summaryItems = {
-            totalSalesStr.str(),
-            "Total Rental Count: " + std::to_string(totalRentals),
-            "Best Month: " + (bestMonth.empty() ? "N/A" : bestMonth)
-        };
-        displaySummaryList(summaryItems);
-        displayTextChart("Text-Based Monthly Sales Chart", monthlySales);
-        displayTextGraphSummary(monthlySales);
+        delete pstmt;
     } catch (sql::SQLException& e) {
         std::cerr << "Error generating monthly sales report: " << e.what() << std::endl;
     }
+    return rows;
 }
 
-void ReportManager::generateInventoryValuationReport() {
+void ReportManager::renderMonthlySales(std::ostream& out, const std::vector<MonthlySales>& rows) {
+    std::string text;
+    text.reserve(FLUSH_BYTES + 256);
+    Format::appendLeft(text, "Month", 15);
+    Format::appendRight(text, "Total Sales (RM)", 20);
+    Format::appendRight(text, "Rental Count", 20);
+    text += '\n';
+    appendRule(text, 80);
+    
+    Money totalSales;
+    long long totalRentals = 0;
+    for (const MonthlySales& row : rows) {
+        Format::appendLeft(text, row.Month, 15);
+        Format::appendMoney(text, row.TotalSales, 20);
+        Format::appendInteger(text, row.RentalCount, 20);
+        text += '\n';
+        totalSales += row.TotalSales;
+        totalRentals += row.RentalCount;
+        flushIfFull(out, text);
+    }
+    
+    appendRule(text, 80);
+    Format::appendLeft(text, "TOTAL", 15);
+    Format::appendMoney(text, totalSales, 20);
+    Format::appendInteger(text, totalRentals, 20);
+    text += '\n';
+    appendRule(text, 80);
+    writeText(out, text);
+}
+
+void ReportManager::generateMonthlySalesReport(const std::string& year) {
+    TraceSpan span("report.monthlySales");
+    RenderFrame frame;
+    std::vector<MonthlySales> rows = getMonthlySales(year);
+    
+    UIColors::out() << '\n';
+    std::string title = "MONTHLY SALES REPORT - " + year;
+    UIColors::printCentered(title, 80, UIColors::BOLD + UIColors::CYAN);
+    UIColors::printSeparator(80);
+    renderMonthlySales(UIColors::out(), rows);
+    
+    std::vector<std::pair<std::string, double>> chartData;
+    std::vector<std::pair<std::string, Money>> monthlySales;
+    Money totalYearSales;
+    int totalRentals = 0;
+    std::string bestMonth;
+    Money bestSales = Money::fromCents(-1);
+    for (const MonthlySales& row : rows) {
+        chartData.push_back({row.Month, row.TotalSales.toDouble()});
+        monthlySales.push_back({row.Month, row.TotalSales});
+        totalYearSales += row.TotalSales;
+        totalRentals += row.RentalCount;
+        if (row.TotalSales > bestSales) {
+            bestSales = row.TotalSales;
+            bestMonth = row.Month;
+        }
+    }
+    
+    displayBarChart("\nMonthly Sales Trend", chartData);
+    
+    std::vector<std::string> summaryItems = {
+        "Total Monthly Sales: " + totalYearSales.toDisplay(),
+        "Total Rental Count: " + std::to_string(totalRentals),
+        "Best Month: " + (bestMonth.empty() ? "N/A" : bestMonth)
+    };
+    displaySummaryList(summaryItems);
+    displayTextChart("Text-Based Monthly Sales Chart", monthlySales);
+    displayTextGraphSummary(monthlySales);
+}
+
+std::vector<InventoryValuation> ReportManager::getInventoryValuation() {
+    std::vector<InventoryValuation> rows;
     try {
         std::string query = 
             "SELECT Category, "
@@ -180,49 +242,75 @@ void ReportManager::generateInventoryValuationReport() {
             "GROUP BY Category "
             "ORDER BY TotalValue DESC";
         
-        sql::ResultSet* res = DatabaseManager::getInstance().executeSelect(query);
-        
-        std::cout << "\n" << std::string(100, '=') << std::endl;
-        std::cout << "           INVENTORY VALUATION REPORT" << std::endl;
-        std::cout << std::string(100, '=') << std::endl;
-        std::cout << std::setw(20) << "Category" << std::setw(15) << "Dress Count"
-                  << std::setw(20) << "Total Value (RM)" << std::setw(20) << "Average Price (RM)" << std::endl;
-        std::cout << std::string(100, '=') << std::endl;
-        
-        std::vector<std::pair<std::string, double>> chartData;
-        double grandTotal = 0.0;
-        int totalDresses = 0;
+        sql::ResultSet* res = DatabaseManager::getInstance().executeReadSelect(query);
         
         while (res && res->next()) {
-            std::string category = res->getString("Category");
-            int count = res->getInt("DressCount");
-            double totalValue = res->getDouble("TotalValue");
-            double avgPrice = res->getDouble("AveragePrice");
-            
-            std::cout << std::setw(20) << category
-                      << std::setw(15) << count
-                      << std::setw(20) << std::fixed << std::setprecision(2) << totalValue
-                      << std::setw(20) << std::fixed << std::setprecision(2) << avgPrice << std::endl;
-            
-            chartData.push_back({category, totalValue});
-            grandTotal += totalValue;
-            totalDresses += count;
+            InventoryValuation row;
+            row.Category = res->getString("Category");
+            row.DressCount = res->getInt("DressCount");
+            row.TotalValue = Money::fromString(res->getString("TotalValue"));
+            row.AveragePrice = Money::fromString(res->getString("AveragePrice"));
+            rows.push_back(row);
         }
         
-        std::cout << std::string(100, '=') << std::endl;
-        std::cout << std::setw(20) << "GRAND TOTAL" << std::setw(15) << totalDresses
-                  << std::setw(20) << std::fixed << std::setprecision(2) << grandTotal << std::endl;
-        std::cout << std::string(100, '=') << std::endl;
-        
         if (res) delete res;
-        
-        displayBarChart("\nInventory Value by Category", chartData);
     } catch (sql::SQLException& e) {
         std::cerr << "Error generating inventory valuation report: " << e.what() << std::endl;
     }
+    return rows;
 }
 
-void ReportManager::generateDressUtilizationReport() {
+void ReportManager::renderInventoryValuation(std::ostream& out, const std::vector<InventoryValuation>& rows) {
+    std::string text;
+    text.reserve(FLUSH_BYTES + 256);
+    Format::appendLeft(text, "Category", 20);
+    Format::appendRight(text, "Dress Count", 15);
+    Format::appendRight(text, "Total Value (RM)", 20);
+    Format::appendRight(text, "Average Price (RM)", 20);
+    text += '\n';
+    appendRule(text, 100);
+    
+    Money grandTotal;
+    long long totalDresses = 0;
+    for (const InventoryValuation& row : rows) {
+        Format::appendLeft(text, row.Category, 20);
+        Format::appendInteger(text, row.DressCount, 15);
+        Format::appendMoney(text, row.TotalValue, 20);
+        Format::appendMoney(text, row.AveragePrice, 20);
+        text += '\n';
+        grandTotal += row.TotalValue;
+        totalDresses += row.DressCount;
+        flushIfFull(out, text);
+    }
+    
+    appendRule(text, 100);
+    Format::appendLeft(text, "GRAND TOTAL", 20);
+    Format::appendInteger(text, totalDresses, 15);
+    Format::appendMoney(text, grandTotal, 20);
+    text += '\n';
+    appendRule(text, 100);
+    writeText(out, text);
+}
+
+void ReportManager::generateInventoryValuationReport() {
+    TraceSpan span("report.inventoryValuation");
+    RenderFrame frame;
+    std::vector<InventoryValuation> rows = getInventoryValuation();
+    
+    UIColors::out() << "\n" << std::string(100, '=') << '\n';
+    UIColors::out() << "           INVENTORY VALUATION REPORT\n";
+    UIColors::out() << std::string(100, '=') << '\n';
+    renderInventoryValuation(UIColors::out(), rows);
+    
+    std::vector<std::pair<std::string, double>> chartData;
+    for (const InventoryValuation& row : rows) {
+        chartData.push_back({row.Category, row.TotalValue.toDouble()});
+    }
+    displayBarChart("\nInventory Value by Category", chartData);
+}
+
+std::vector<DressUtilization> ReportManager::getDressUtilization() {
+    std::vector<DressUtilization> rows;
     try {
         std::string query = 
             "SELECT d.DressID, d.DressName, "
@@ -235,42 +323,68 @@ void ReportManager::generateDressUtilizationReport() {
             "ORDER BY RentalCount DESC, UtilizationRate DESC "
             "LIMIT 20";
         
-        sql::ResultSet* res = DatabaseManager::getInstance().executeSelect(query);
-        
-        std::cout << "\n" << std::string(100, '=') << std::endl;
-        std::cout << "           DRESS UTILIZATION REPORT (Top 20)" << std::endl;
-        std::cout << std::string(100, '=') << std::endl;
-        std::cout << std::setw(10) << "Dress ID" << std::setw(30) << "Dress Name"
-                  << std::setw(15) << "Rental Count" << std::setw(20) << "Utilization Rate (%)" << std::endl;
-        std::cout << std::string(100, '=') << std::endl;
-        
-        std::vector<std::pair<std::string, double>> chartData;
+        sql::ResultSet* res = DatabaseManager::getInstance().executeReadSelect(query);
         
         while (res && res->next()) {
-            int dressID = res->getInt("DressID");
-            std::string dressName = res->getString("DressName");
-            int rentalCount = res->getInt("RentalCount");
-            double utilizationRate = res->getDouble("UtilizationRate");
-            
-            std::cout << std::setw(10) << dressID
-                      << std::setw(30) << dressName.substr(0, 28)
-                      << std::setw(15) << rentalCount
-                      << std::setw(20) << std::fixed << std::setprecision(2) << utilizationRate << std::endl;
-            
-            chartData.push_back({dressName.substr(0, 15), static_cast<double>(rentalCount)});
+            DressUtilization row;
+            row.DressID = res->getInt("DressID");
+            row.DressName = res->getString("DressName");
+            row.RentalCount = res->getInt("RentalCount");
+            row.UtilizationRate = res->getDouble("UtilizationRate");
+            rows.push_back(row);
         }
         
-        std::cout << std::string(100, '=') << std::endl;
-        
         if (res) delete res;
-        
-        displayBarChart("\nTop Dresses by Rental Count", chartData);
     } catch (sql::SQLException& e) {
         std::cerr << "Error generating dress utilization report: " << e.what() << std::endl;
     }
+    return rows;
 }
 
-void ReportManager::generateCustomerActivityReport() {
+void ReportManager::renderDressUtilization(std::ostream& out, const std::vector<DressUtilization>& rows) {
+    std::string text;
+    text.reserve(FLUSH_BYTES + 256);
+    Format::appendRight(text, "Dress ID", 10);
+    text += "  ";
+    Format::appendLeft(text, "Dress Name", 30);
+    Format::appendRight(text, "Rental Count", 15);
+    Format::appendRight(text, "Utilization Rate (%)", 22);
+    text += '\n';
+    appendRule(text, 100);
+    
+    for (const DressUtilization& row : rows) {
+        Format::appendInteger(text, row.DressID, 10);
+        text += "  ";
+        Format::appendLeft(text, row.DressName.data(), std::min<size_t>(row.DressName.size(), 28), 30);
+        Format::appendInteger(text, row.RentalCount, 15);
+        Format::appendFixed(text, row.UtilizationRate, 2, 22);
+        text += '\n';
+        flushIfFull(out, text);
+    }
+    
+    appendRule(text, 100);
+    writeText(out, text);
+}
+
+void ReportManager::generateDressUtilizationReport() {
+    TraceSpan span("report.dressUtilization");
+    RenderFrame frame;
+    std::vector<DressUtilization> rows = getDressUtilization();
+    
+    UIColors::out() << "\n" << std::string(100, '=') << '\n';
+    UIColors::out() << "           DRESS UTILIZATION REPORT (Top 20)\n";
+    UIColors::out() << std::string(100, '=') << '\n';
+    renderDressUtilization(UIColors::out(), rows);
+    
+    std::vector<std::pair<std::string, double>> chartData;
+    for (const DressUtilization& row : rows) {
+        chartData.push_back({row.DressName.substr(0, 15), static_cast<double>(row.RentalCount)});
+    }
+    displayBarChart("\nTop Dresses by Rental Count", chartData);
+}
+
+std::vector<CustomerActivity> ReportManager::getCustomerActivity() {
+    std::vector<CustomerActivity> rows;
     try {
         std::string query = 
             "SELECT c.CustomerID, c.Name as CustomerName, "
@@ -284,110 +398,137 @@ void ReportManager::generateCustomerActivityReport() {
             "ORDER BY TotalSpent DESC "
             "LIMIT 20";
         
-        sql::ResultSet* res = DatabaseManager::getInstance().executeSelect(query);
-        
-        std::cout << "\n" << std::string(120, '=') << std::endl;
-        std::cout << "           CUSTOMER ACTIVITY REPORT (Top 20)" << std::endl;
-        std::cout << std::string(120, '=') << std::endl;
-        std::cout << std::setw(12) << "Customer ID" << std::setw(25) << "Customer Name"
-                  << std::setw(18) << "Total Rentals" << std::setw(20) << "Total Spent (RM)"
-                  << std::setw(20) << "Average Rental (RM)" << std::endl;
-        std::cout << std::string(120, '=') << std::endl;
+        sql::ResultSet* res = DatabaseManager::getInstance().executeReadSelect(query);
         
         while (res && res->next()) {
-            int customerID = res->getInt("CustomerID");
-            std::string name = res->getString("CustomerName");
-            int totalRentals = res->getInt("TotalRentals");
-            double totalSpent = res->getDouble("TotalSpent");
-            double avgRental = res->getDouble("AverageRental");
-            
-            std::cout << std::setw(12) << customerID
-                      << std::setw(25) << name.substr(0, 23)
-                      << std::setw(18) << totalRentals
-                      << std::setw(20) << std::fixed << std::setprecision(2) << totalSpent
-                      << std::setw(20) << std::fixed << std::setprecision(2) << avgRental << std::endl;
+            CustomerActivity row;
+            row.CustomerID = res->getInt("CustomerID");
+            row.CustomerName = res->getString("CustomerName");
+            row.TotalRentals = res->getInt("TotalRentals");
+            row.TotalSpent = Money::fromString(res->getString("TotalSpent"));
+            row.AverageRental = Money::fromString(res->getString("AverageRental"));
+            rows.push_back(row);
         }
         
-        std::cout << std::string(120, '=') << std::endl;
-        
         if (res) delete res;
     } catch (sql::SQLException& e) {
         std::cerr << "Error generating customer activity report: " << e.what() << std::endl;
     }
+    return rows;
+}
+
+void ReportManager::renderCustomerActivity(std::ostream& out, const std::vector<CustomerActivity>& rows) {
+    std::string text;
+    text.reserve(FLUSH_BYTES + 256);
+    Format::appendRight(text, "Customer ID", 12);
+    text += "  ";
+    Format::appendLeft(text, "Customer Name", 25);
+    Format::appendRight(text, "Total Rentals", 18);
+    Format::appendRight(text, "Total Spent (RM)", 20);
+    Format::appendRight(text, "Average Rental (RM)", 22);
+    text += '\n';
+    appendRule(text, 120);
+    
+    for (const CustomerActivity& row : rows) {
+        Format::appendInteger(text, row.CustomerID, 12);
+        text += "  ";
+        Format::appendLeft(text, row.CustomerName.data(), std::min<size_t>(row.CustomerName.size(), 23), 25);
+        Format::appendInteger(text, row.TotalRentals, 18);
+        Format::appendMoney(text, row.TotalSpent, 20);
+        Format::appendMoney(text, row.AverageRental, 22);
+        text += '\n';
+        flushIfFull(out, text);
+    }
+    
+    appendRule(text, 120);
+    writeText(out, text);
+}
+
+void ReportManager::generateCustomerActivityReport() {
+    TraceSpan span("report.customerActivity");
+    RenderFrame frame;
+    std::vector<CustomerActivity> rows = getCustomerActivity();
+    
+    UIColors::out() << "\n" << std::string(120, '=') << '\n';
+    UIColors::out() << "           CUSTOMER ACTIVITY REPORT (Top 20)\n";
+    UIColors::out() << std::string(120, '=') << '\n';
+    renderCustomerActivity(UIColors::out(), rows);
 }
 
 void ReportManager::generateOverdueItemsReport() {
+    TraceSpan span("report.overdueItems");
+    RenderFrame frame;
     RentalManager rm;
     std::vector<Rental> overdueRentals = rm.getOverdueRentals();
     
     if (overdueRentals.empty()) {
-        std::cout << "\nNo overdue rentals found." << std::endl;
+        UIColors::out() << "\nNo overdue rentals found.\n";
         return;
     }
     
-    std::cout << "\n" << std::string(120, '=') << std::endl;
-    std::cout << "           OVERDUE ITEMS REPORT" << std::endl;
-    std::cout << std::string(120, '=') << std::endl;
-    std::cout << std::setw(12) << "Rental ID" << std::setw(15) << "Customer ID"
-              << std::setw(15) << "Rental Date" << std::setw(15) << "Due Date"
-              << std::setw(20) << "Days Overdue" << std::setw(20) << "Late Fee (RM)" << std::endl;
-    std::cout << std::string(120, '=') << std::endl;
+    std::string text = "\n";
+    appendRule(text, 120);
+    text += "           OVERDUE ITEMS REPORT\n";
+    appendRule(text, 120);
+    Format::appendRight(text, "Rental ID", 12);
+    Format::appendRight(text, "Customer ID", 15);
+    text += "  ";
+    Format::appendLeft(text, "Rental Date", 15);
+    Format::appendLeft(text, "Due Date", 15);
+    Format::appendRight(text, "Days Overdue", 14);
+    Format::appendRight(text, "Late Fee (RM)", 20);
+    text += '\n';
+    appendRule(text, 120);
     
+    const LateFeePolicy& policy = LateFeePolicy::standard();
+    std::string today = LateFeePolicy::today();
     for (const auto& rental : overdueRentals) {
-        // Calculate days overdue
-        std::tm dueTm = {};
-        std::istringstream ss(rental.DueDate);
-        ss >> std::get_time(&dueTm, "%Y-%m-%d");
-        std::time_t dueTime = std::mktime(&dueTm);
-        std::time_t now = std::time(nullptr);
-        int daysOverdue = 0;
-        if (dueTime != -1 && now != -1) {
-            daysOverdue = static_cast<int>(std::difftime(now, dueTime) / 86400.0); // 86400.0 seconds per day
-        }
-        
-        rm.calculateLateFee(rental.RentalID);
-        Rental* updatedRental = rm.getRentalByID(rental.RentalID);
-        double lateFee = updatedRental ? updatedRental->LateFee : 0.0;
-        delete updatedRental;
-        
-        std::cout << std::setw(12) << rental.RentalID
-                  << std::setw(15) << rental.CustomerID
-                  << std::setw(15) << rental.RentalDate
-                  << std::setw(15) << rental.DueDate
-                  << std::setw(20) << daysOverdue
-                  << std::setw(20) << std::fixed << std::setprecision(2) << lateFee << std::endl;
+        // LateFee is already derived for today by getOverdueRentals
+        Format::appendInteger(text, rental.RentalID, 12);
+        Format::appendInteger(text, rental.CustomerID, 15);
+        text += "  ";
+        Format::appendLeft(text, rental.RentalDate, 15);
+        Format::appendLeft(text, rental.DueDate, 15);
+        Format::appendInteger(text, policy.daysLate(rental.DueDate, today), 14);
+        Format::appendMoney(text, rental.LateFee, 20);
+        text += '\n';
+        flushIfFull(UIColors::out(), text);
     }
     
-    std::cout << std::string(120, '=') << std::endl;
+    appendRule(text, 120);
+    writeText(UIColors::out(), text);
 }
 
 void ReportManager::generateRentalSummaryReport() {
+    TraceSpan span("report.rentalSummary");
+    RenderFrame frame;
     try {
         std::string query = 
             "SELECT Status, COUNT(*) as Count, SUM(TotalAmount + LateFee) as TotalAmount "
             "FROM Rentals "
             "GROUP BY Status";
         
-        sql::ResultSet* res = DatabaseManager::getInstance().executeSelect(query);
+        sql::ResultSet* res = DatabaseManager::getInstance().executeReadSelect(query);
         
-        std::cout << "\n" << std::string(80, '=') << std::endl;
-        std::cout << "           RENTAL SUMMARY REPORT" << std::endl;
-        std::cout << std::string(80, '=') << std::endl;
-        std::cout << std::setw(20) << "Status" << std::setw(20) << "Count"
-                  << std::setw(20) << "Total Amount (RM)" << std::endl;
-        std::cout << std::string(80, '=') << std::endl;
+        std::string text = "\n";
+        appendRule(text, 80);
+        text += "           RENTAL SUMMARY REPORT\n";
+        appendRule(text, 80);
+        Format::appendLeft(text, "Status", 20);
+        Format::appendRight(text, "Count", 20);
+        Format::appendRight(text, "Total Amount (RM)", 20);
+        text += '\n';
+        appendRule(text, 80);
         
         while (res && res->next()) {
-            std::string status = res->getString("Status");
-            int count = res->getInt("Count");
-            double total = res->getDouble("TotalAmount");
-            
-            std::cout << std::setw(20) << status
-                      << std::setw(20) << count
-                      << std::setw(20) << std::fixed << std::setprecision(2) << total << std::endl;
+            Format::appendLeft(text, res->getString("Status"), 20);
+            Format::appendInteger(text, res->getInt("Count"), 20);
+            Format::appendMoney(text, Money::fromString(res->getString("TotalAmount")), 20);
+            text += '\n';
         }
         
-        std::cout << std::string(80, '=') << std::endl;
+        appendRule(text, 80);
+        writeText(UIColors::out(), text);
         
         if (res) delete res;
     } catch (sql::SQLException& e) {
@@ -396,6 +537,8 @@ void ReportManager::generateRentalSummaryReport() {
 }
 
 void ReportManager::generateIncomeStatement(const std::string& startDate, const std::string& endDate) {
+    TraceSpan span("report.incomeStatement");
+    RenderFrame frame;
     try {
         std::string query = 
             "SELECT SUM(p.Amount) as TotalRevenue "
@@ -403,32 +546,39 @@ void ReportManager::generateIncomeStatement(const std::string& startDate, const
             "JOIN Rentals r ON p.RentalID = r.RentalID "
             "WHERE p.Status = 'Completed' AND p.PaymentDate BETWEEN ? AND ?";
         
-        sql::Connection* conn = DatabaseManager::getInstance().getConnection();
-        sql::PreparedStatement* pstmt = conn->prepareStatement(query);
-        pstmt->setString(1, startDate);
-        pstmt->setString(2, endDate);
-        sql::ResultSet* res = pstmt->executeQuery();
+        sql::PreparedStatement* pstmt = nullptr;
+        sql::ResultSet* res = DatabaseManager::getInstance().executeRead(query,
+            [&](sql::PreparedStatement* statement) {
+                statement->setString(1, startDate);
+                statement->setString(2, endDate);
+            },
+            pstmt);
         
-        double totalRevenue = 0.0;
+        Money totalRevenue;
         if (res && res->next()) {
-            totalRevenue = res->getDouble("TotalRevenue");
+            totalRevenue = Money::fromString(res->getString("TotalRevenue"));
         }
         delete pstmt;
         if (res) delete res;
         
-        std::cout << "\n" << std::string(80, '=') << std::endl;
-        std::cout << "           INCOME STATEMENT" << std::endl;
-        std::cout << "           Period: " << startDate << " to " << endDate << std::endl;
-        std::cout << std::string(80, '=') << std::endl;
-        std::cout << std::setw(40) << "Total Revenue:" << std::setw(20) << std::right 
-                  << std::fixed << std::setprecision(2) << totalRevenue << std::endl;
-        std::cout << std::string(80, '=') << std::endl;
+        std::string text = "\n";
+        appendRule(text, 80);
+        text += "           INCOME STATEMENT\n";
+        text += "           Period: " + startDate + " to " + endDate + '\n';
+        appendRule(text, 80);
+        Format::appendRight(text, "Total Revenue:", 40);
+        Format::appendMoney(text, totalRevenue, 20);
+        text += '\n';
+        appendRule(text, 80);
+        writeText(UIColors::out(), text);
     } catch (sql::SQLException& e) {
         std::cerr << "Error generating income statement: " << e.what() << std::endl;
     }
 }
 
 void ReportManager::generateCustomerLoyaltyReport() {
+    TraceSpan span("report.customerLoyalty");
+    RenderFrame frame;
     try {
         std::string query = 
             "SELECT c.CustomerID, c.Name, "
@@ -441,31 +591,34 @@ void ReportManager::generateCustomerLoyaltyReport() {
             "HAVING RentalCount >= 3 "
             "ORDER BY TotalSpent DESC";
         
-        sql::ResultSet* res = DatabaseManager::getInstance().executeSelect(query);
-        
-        std::cout << "\n" << std::string(120, '=') << std::endl;
-        std::cout << "           CUSTOMER LOYALTY REPORT (3+ Rentals)" << std::endl;
-        std::cout << std::string(120, '=') << std::endl;
-        std::cout << std::setw(12) << "Customer ID" << std::setw(25) << "Name"
-                  << std::setw(18) << "Rental Count" << std::setw(20) << "Total Spent (RM)"
-                  << std::setw(25) << "Days Since First Rental" << std::endl;
-        std::cout << std::string(120, '=') << std::endl;
+        sql::ResultSet* res = DatabaseManager::getInstance().executeReadSelect(query);
+        
+        std::string text = "\n";
+        appendRule(text, 120);
+        text += "           CUSTOMER LOYALTY REPORT (3+ Rentals)\n";
+        appendRule(text, 120);
+        Format::appendRight(text, "Customer ID", 12);
+        text += "  ";
+        Format::appendLeft(text, "Name", 25);
+        Format::appendRight(text, "Rental Count", 18);
+        Format::appendRight(text, "Total Spent (RM)", 20);
+        Format::appendRight(text, "Days Since First Rental", 25);
+        text += '\n';
+        appendRule(text, 120);
         
         while (res && res->next()) {
-            int customerID = res->getInt("CustomerID");
-            std::string name = res->getString("Name");
-            int rentalCount = res->getInt("RentalCount");
-            double totalSpent = res->getDouble("TotalSpent");
-            int days = res->getInt("DaysSinceFirstRental");
-            
-            std::cout << std::setw(12) << customerID
-                      << std::setw(25) << name.substr(0, 23)
-                      << std::setw(18) << rentalCount
-                      << std::setw(20) << std::fixed << std::setprecision(2) << totalSpent
-                      << std::setw(25) << days << std::endl;
+            Format::appendInteger(text, res->getInt("CustomerID"), 12);
+            text += "  ";
+            Format::appendLeft(text, res->getString("Name").substr(0, 23), 25);
+            Format::appendInteger(text, res->getInt("RentalCount"), 18);
+            Format::appendMoney(text, Money::fromString(res->getString("TotalSpent")), 20);
+            Format::appendInteger(text, res->getInt("DaysSinceFirstRental"), 25);
+            text += '\n';
+            flushIfFull(UIColors::out(), text);
         }
         
-        std::cout << std::string(120, '=') << std::endl;
+        appendRule(text, 120);
+        writeText(UIColors::out(), text);
         
         if (res) delete res;
     } catch (sql::SQLException& e) {
@@ -474,6 +627,8 @@ void ReportManager::generateCustomerLoyaltyReport() {
 }
 
 void ReportManager::generateProfitMarginReport() {
+    TraceSpan span("report.profitMargin");
+    RenderFrame frame;
     try {
         std::string query = 
             "SELECT d.Category, "
@@ -487,28 +642,29 @@ void ReportManager::generateProfitMarginReport() {
             "GROUP BY d.Category "
             "ORDER BY TotalRevenue DESC";
         
-        sql::ResultSet* res = DatabaseManager::getInstance().executeSelect(query);
+        sql::ResultSet* res = DatabaseManager::getInstance().executeReadSelect(query);
         
-        std::cout << "\n" << std::string(100, '=') << std::endl;
-        std::cout << "           PROFIT MARGIN REPORT BY CATEGORY" << std::endl;
-        std::cout << std::string(100, '=') << std::endl;
-        std::cout << std::setw(20) << "Category" << std::setw(20) << "Total Revenue (RM)"
-                  << std::setw(20) << "Dresses Rented" << std::setw(20) << "Avg Revenue/Dress" << std::endl;
-        std::cout << std::string(100, '=') << std::endl;
+        std::string text = "\n";
+        appendRule(text, 100);
+        text += "           PROFIT MARGIN REPORT BY CATEGORY\n";
+        appendRule(text, 100);
+        Format::appendLeft(text, "Category", 20);
+        Format::appendRight(text, "Total Revenue (RM)", 20);
+        Format::appendRight(text, "Dresses Rented", 20);
+        Format::appendRight(text, "Avg Revenue/Dress", 20);
+        text += '\n';
+        appendRule(text, 100);
         
         while (res && res->next()) {
-            std::string category = res->getString("Category");
-            double totalRevenue = res->getDouble("TotalRevenue");
-            int dressesRented = res->getInt("DressesRented");
-            double avgRevenue = res->getDouble("AvgRevenuePerDress");
-            
-            std::cout << std::setw(20) << category
-                      << std::setw(20) << std::fixed << std::setprecision(2) << totalRevenue
-                      << std::setw(20) << dressesRented
-                      << std::setw(20) << std::fixed << std::setprecision(2) << avgRevenue << std::endl;
+            Format::appendLeft(text, res->getString("Category"), 20);
+            Format::appendMoney(text, Money::fromString(res->getString("TotalRevenue")), 20);
+            Format::appendInteger(text, res->getInt("DressesRented"), 20);
+            Format::appendMoney(text, Money::fromString(res->getString("AvgRevenuePerDress")), 20);
+            text += '\n';
         }
         
-        std::cout << std::string(100, '=') << std::endl;
+        appendRule(text, 100);
+        writeText(UIColors::out(), text);
         
         if (res) delete res;
     } catch (sql::SQLException& e) {
@@ -517,52 +673,121 @@ void ReportManager::generateProfitMarginReport() {
 }
 
 void ReportManager::displayDashboard() {
+    TraceSpan span("report.dashboard");
+    RenderFrame frame;
     try {
         UIColors::printHeader("SYSTEM DASHBOARD", SCREEN_WIDTH);
         
         // Total Customers
-        sql::ResultSet* res = DatabaseManager::getInstance().executeSelect("SELECT COUNT(*) as count FROM Customers");
+        sql::ResultSet* res = DatabaseManager::getInstance().executeReadSelect("SELECT COUNT(*) as count FROM Customers");
         int totalCustomers = 0;
         if (res && res->next()) totalCustomers = res->getInt("count");
         if (res) delete res;
         
         // Total Dresses
-        res = DatabaseManager::getInstance().executeSelect("SELECT COUNT(*) as count FROM Dresses");
+        res = DatabaseManager::getInstance().executeReadSelect("SELECT COUNT(*) as count FROM Dresses");
         int totalDresses = 0;
         if (res && res->next()) totalDresses = res->getInt("count");
         if (res) delete res;
         
-        // Active Rentals
-        res = DatabaseManager::getInstance().executeSelect("SELECT COUNT(*) as count FROM Rentals WHERE Status = 'Active'");
+        // Rental counts come from the sweeper's counters while it is running,
+        // so the dashboard does not scan Rentals on every visit
         int activeRentals = 0;
-        if (res && res->next()) activeRentals = res->getInt("count");
-        if (res) delete res;
-        
-        // Overdue Rentals
-        res = DatabaseManager::getInstance().executeSelect("SELECT COUNT(*) as count FROM Rentals WHERE Status = 'Active' AND DueDate < CURDATE()");
         int overdueRentals = 0;
-        if (res && res->next()) overdueRentals = res->getInt("count");
-        if (res) delete res;
+        Money outstandingFees;
+        std::string countersAsOf;
+        OverdueSweeper& sweeper = OverdueSweeper::getInstance();
+        if (sweeper.isRunning()) {
+            res = DatabaseManager::getInstance().executeReadSelect(
+                "SELECT CounterName, CounterValue, DATE_FORMAT(UpdatedAt, '%H:%i') AS AsOf FROM SystemCounters "
+                "WHERE CounterName IN ('ActiveRentals', 'OverdueRentals', 'OutstandingLateFees')"
+            );
+            while (res && res->next()) {
+                std::string name = res->getString("CounterName");
+                if (name == "ActiveRentals") activeRentals = static_cast<int>(res->getDouble("CounterValue"));
+                else if (name == "OverdueRentals") overdueRentals = static_cast<int>(res->getDouble("CounterValue"));
+                else outstandingFees = Money::fromString(res->getString("CounterValue"));
+                countersAsOf = res->getString("AsOf");
+            }
+            if (res) delete res;
+        }
+        if (countersAsOf.empty()) {
+            res = DatabaseManager::getInstance().executeReadSelect(
+                "SELECT SUM(Status = 'Active') AS active, "
+                "SUM(Status = 'Active' AND DueDate < CURDATE()) AS overdue, "
+                "SUM(CASE WHEN Status = 'Active' AND DueDate < CURDATE() "
+                "THEN DATEDIFF(CURDATE(), DueDate) ELSE 0 END) AS daysLate "
+                "FROM Rentals WHERE Status = 'Active'"
+            );
+            if (res && res->next()) {
+                activeRentals = res->getInt("active");
+                overdueRentals = res->getInt("overdue");
+                outstandingFees = LateFeePolicy::standard().feeForDays(res->getInt("daysLate"));
+            }
+            if (res) delete res;
+        }
         
         // Monthly Revenue
-        res = DatabaseManager::getInstance().executeSelect(
+        res = DatabaseManager::getInstance().executeReadSelect(
             "SELECT SUM(p.Amount) as total FROM Payments p "
-            "WHERE p.Status = 'Completed' AND MONTH(p.PaymentDate) = MONTH(CURDATE()) "
-            "AND YEAR(p.PaymentDate) = YEAR(CURDATE())"
+            "WHERE p.Status = 'Completed' AND p.PaymentDate >= DATE_FORMAT(CURDATE(), '%Y-%m-01') "
+            "AND p.PaymentDate < DATE_FORMAT(CURDATE(), '%Y-%m-01') + INTERVAL 1 MONTH"
         );
-        double monthlyRevenue = 0.0;
-        if (res && res->next()) monthlyRevenue = res->getDouble("total");
+        Money monthlyRevenue;
+        if (res && res->next()) monthlyRevenue = Money::fromString(res->getString("total"));
         if (res) delete res;
         
-        std::cout << std::endl;
+        UIColors::out() << '\n';
         UIColors::printCentered("1. Total Customers: " + std::to_string(totalCustomers), SCREEN_WIDTH, UIColors::CYAN);
         UIColors::printCentered("2. Total Dresses: " + std::to_string(totalDresses), SCREEN_WIDTH, UIColors::CYAN);
         UIColors::printCentered("3. Active Rentals: " + std::to_string(activeRentals), SCREEN_WIDTH, UIColors::CYAN);
         UIColors::printCentered("4. Overdue Rentals: " + std::to_string(overdueRentals), SCREEN_WIDTH, UIColors::YELLOW);
-        std::ostringstream revenueStream;
-        revenueStream << std::fixed << std::setprecision(2) << monthlyRevenue;
-        UIColors::printCentered("5. Monthly Revenue (RM): " + revenueStream.str(), SCREEN_WIDTH, UIColors::GREEN);
-        std::cout << std::endl;
+        UIColors::printCentered("5. Monthly Revenue (RM): " + monthlyRevenue.toString(), SCREEN_WIDTH, UIColors::GREEN);
+        UIColors::printCentered("6. Outstanding Late Fees (RM): " + outstandingFees.toString(), SCREEN_WIDTH, UIColors::YELLOW);
+        if (!countersAsOf.empty()) {
+            UIColors::printCentered("(rental counts as of " + countersAsOf + ")", SCREEN_WIDTH, UIColors::DIM);
+        }
+        UIColors::out() << '\n';
+        
+        // Background sweeper status
+        OverdueSweeper::Stats sweep = sweeper.getStats();
+        if (!sweeper.isRunning()) {
+            UIColors::printCentered("Overdue sweeper: not running", SCREEN_WIDTH, UIColors::DIM);
+        } else if (sweep.lastRunAt.empty()) {
+            UIColors::printCentered("Overdue sweeper: waiting for first run", SCREEN_WIDTH, UIColors::DIM);
+        } else {
+            UIColors::printCentered("Overdue sweeper: last run " + sweep.lastRunAt + " (" +
+                                    Format::fixed(sweep.lastDurationMs, 1) + " ms, " +
+                                    Format::integer(sweep.rowsTouched) + " rows)", SCREEN_WIDTH, UIColors::DIM);
+            if (!sweep.lastDailyRunAt.empty()) {
+                UIColors::printCentered("Daily sweep " + sweep.lastDailyRunAt + ": " +
+                                        std::to_string(sweep.lateFeesUpdated) + " late fees, " +
+                                        std::to_string(sweep.remindersQueued) + " reminders queued",
+                                        SCREEN_WIDTH, UIColors::DIM);
+            }
+            if (!sweep.lastError.empty()) {
+                UIColors::printCentered("Last error: " + sweep.lastError, SCREEN_WIDTH, UIColors::RED);
+            }
+        }
+        
+        // Cleaning scheduler status
+        CleaningScheduler& cleaning = CleaningScheduler::getInstance();
+        CleaningScheduler::Stats plan = cleaning.getStats();
+        if (!cleaning.isRunning()) {
+            UIColors::printCentered("Cleaning scheduler: not running", SCREEN_WIDTH, UIColors::DIM);
+        } else if (!plan.lastRunAt.empty()) {
+            UIColors::printCentered("Cleaning scheduler: last run " + plan.lastRunAt + " (" +
+                                    std::to_string(plan.jobsPlanned) + " queued, " +
+                                    std::to_string(plan.jobsMoved) + " moved)", SCREEN_WIDTH, UIColors::DIM);
+            if (plan.jobsLate > 0) {
+                UIColors::printCentered(std::to_string(plan.jobsLate) + " dress(es) will not be clean before their next booking",
+                                        SCREEN_WIDTH, UIColors::YELLOW);
+            }
+            if (!plan.lastError.empty()) {
+                UIColors::printCentered("Last error: " + plan.lastError, SCREEN_WIDTH, UIColors::RED);
+            }
+        }
+        UIColors::out() << '\n';
         UIColors::printSeparator(SCREEN_WIDTH);
     } catch (sql::SQLException& e) {
         UIColors::printError("Error displaying dashboard: " + std::string(e.what()));
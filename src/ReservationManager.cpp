@@ -0,0 +1,406 @@
+#include "ReservationManager.h"
+#include "ReservationPlanner.h"
+#include "RentalManager.h"
+#include "LateFeePolicy.h"
+#include "MenuHandlers.h"
+#include "TableRenderer.h"
+#include "Trace.h"
+#include "UIColors.h"
+#include <exception>
+#include <iostream>
+#include <unordered_map>
+
+namespace {
+
+long dayOf(const std::string& date) {
+    long day = 0;
+    LateFeePolicy::parseDate(date, day);
+    return day;
+}
+
+Reservation readReservation(sql::ResultSet* res) {
+    Reservation reservation;
+    reservation.ReservationID = res->getInt("ReservationID");
+    reservation.CustomerID = res->getInt("CustomerID");
+    reservation.Category = res->getString("Category");
+    reservation.Size = res->getString("Size");
+    reservation.StartDate = res->getString("StartDate");
+    reservation.EndDate = res->getString("EndDate");
+    reservation.Status = res->getString("Status");
+    reservation.AssignedDressID = res->getInt("AssignedDressID");
+    reservation.RentalID = res->getInt("RentalID");
+    return reservation;
+}
+
+// Loads the dresses, active rentals and booked reservations of one group, or
+// of every group when category is empty, and plans them. Reservations that
+// already have a dress are added first and ask for it again, so they keep it
+// wherever it is still free; waiting ones follow, and the groups left with a
+// waiting reservation are solved afresh. The reservations are locked until
+// the caller's transaction ends, which keeps two counters from replanning a
+// group at once. previous gets each reservation's stored dress (-1 for none).
+// Throws sql::SQLException.
+void loadPlan(ReservationPlanner& planner, std::unordered_map<int, int>& previous,
+              const std::string& category, const std::string& size) {
+    bool oneGroup = !category.empty();
+    auto groupFilter = [oneGroup](const std::string& table) {
+        return oneGroup ? " AND " + table + ".Category = ? AND " + table + ".Size = ?" : std::string();
+    };
+
+    sql::PreparedStatement* pstmt = DatabaseManager::getInstance().prepare(
+        std::string("SELECT d.DressID, d.Category, d.Size, d.StockQuantity FROM Dresses d "
+                    "WHERE d.AvailabilityStatus <> 'Maintenance' AND d.StockQuantity > 0") +
+        groupFilter("d") + " ORDER BY d.DressID"
+    );
+    if (oneGroup) {
+        pstmt->setString(1, category);
+        pstmt->setString(2, size);
+    }
+    sql::ResultSet* res = DatabaseManager::runQuery(pstmt);
+    while (res && res->next()) {
+        planner.addDress(ReservationPlanner::groupOf(res->getString("Category"), res->getString("Size")),
+                         res->getInt("DressID"), res->getInt("StockQuantity"));
+    }
+    if (res) delete res;
+    delete pstmt;
+
+    // An overdue rental keeps its unit until it comes back, and a returned
+    // one until it has been cleaned
+    pstmt = DatabaseManager::getInstance().prepare(
+        std::string("SELECT ri.DressID, r.RentalDate AS FirstDate, GREATEST(r.DueDate, CURDATE()) AS LastDate "
+                    "FROM Rentals r JOIN RentalItems ri ON ri.RentalID = r.RentalID "
+                    "JOIN Dresses d ON d.DressID = ri.DressID WHERE r.Status = 'Active'") +
+        groupFilter("d") +
+        " UNION ALL "
+        "SELECT j.DressID, j.ReturnDate, j.HeldThrough FROM CleaningJobs j "
+        "JOIN Dresses d ON d.DressID = j.DressID WHERE j.Status = 'Queued'" + groupFilter("d")
+    );
+    if (oneGroup) {
+        pstmt->setString(1, category);
+        pstmt->setString(2, size);
+        pstmt->setString(3, category);
+        pstmt->setString(4, size);
+    }
+    res = DatabaseManager::runQuery(pstmt);
+    while (res && res->next()) {
+        planner.addRental(res->getInt("DressID"), dayOf(res->getString("FirstDate")),
+                          dayOf(res->getString("LastDate")));
+    }
+    if (res) delete res;
+    delete pstmt;
+
+    pstmt = DatabaseManager::getInstance().prepare(
+        std::string("SELECT v.ReservationID, v.Category, v.Size, v.StartDate, v.EndDate, v.AssignedDressID "
+                    "FROM Reservations v WHERE v.Status = 'Booked' AND v.EndDate >= CURDATE()") +
+        groupFilter("v") + " ORDER BY v.AssignedDressID IS NULL, v.ReservationID FOR UPDATE"
+    );
+    if (oneGroup) {
+        pstmt->setString(1, category);
+        pstmt->setString(2, size);
+    }
+    res = DatabaseManager::runQuery(pstmt);
+    while (res && res->next()) {
+        int reservationID = res->getInt("ReservationID");
+        int dressID = res->getInt("AssignedDressID");
+        previous[reservationID] = dressID > 0 ? dressID : -1;
+        planner.addReservation(reservationID,
+                               ReservationPlanner::groupOf(res->getString("Category"), res->getString("Size")),
+                               dayOf(res->getString("StartDate")), dayOf(res->getString("EndDate")),
+                               dressID > 0 ? dressID : -1);
+    }
+    if (res) delete res;
+    delete pstmt;
+
+    planner.solveAll();
+}
+
+// Stores the dress of every reservation whose assignment changed; returns how
+// many did. Throws sql::SQLException.
+int savePlan(const ReservationPlanner& planner, const std::unordered_map<int, int>& previous) {
+    sql::PreparedStatement* pstmt = DatabaseManager::getInstance().prepare(
+        "UPDATE Reservations SET AssignedDressID = NULLIF(?, 0) WHERE ReservationID = ?"
+    );
+    int changed = 0;
+    try {
+        for (const ReservationPlanner::Booking& booking : planner.getBookings()) {
+            std::unordered_map<int, int>::const_iterator before = previous.find(booking.reservationID);
+            if (before != previous.end() && before->second == booking.dressID) continue;
+            pstmt->setInt(1, booking.dressID > 0 ? booking.dressID : 0);
+            pstmt->setInt(2, booking.reservationID);
+            DatabaseManager::getInstance().executePreparedUpdate(pstmt);
+            ++changed;
+        }
+    } catch (sql::SQLException&) {
+        delete pstmt;
+        throw;
+    }
+    delete pstmt;
+    return changed;
+}
+
+// Replans one group (every group when category is empty) in a transaction of
+// its own; returns how many reservations changed dress. Throws.
+int replanGroup(const std::string& category, const std::string& size) {
+    TraceSpan span("reservation.replan");
+    sql::Connection* conn = DatabaseManager::getInstance().getConnection();
+    conn->setAutoCommit(false);
+    ReservationPlanner planner;
+    std::unordered_map<int, int> previous;
+    loadPlan(planner, previous, category, size);
+    int changed = savePlan(planner, previous);
+    conn->commit();
+    conn->setAutoCommit(true);
+    return changed;
+}
+
+} // namespace
+
+bool ReservationManager::validateReservationDates(const std::string& startDate, const std::string& endDate) {
+    long startDay = 0;
+    long endDay = 0;
+    long today = 0;
+    if (!LateFeePolicy::parseDate(startDate, startDay) || !LateFeePolicy::parseDate(endDate, endDay)) {
+        std::cerr << "Error: Invalid date format. Please use YYYY-MM-DD format." << std::endl;
+        return false;
+    }
+    LateFeePolicy::parseDate(LateFeePolicy::today(), today);
+    if (startDay < today) {
+        std::cerr << "Error: A reservation cannot start in the past." << std::endl;
+        return false;
+    }
+    // Fulfilled as a rental, so the rental duration rules apply
+    RentalManager rm;
+    if (!rm.validateRentalDuration(static_cast<int>(endDay - startDay))) {
+        std::cerr << "Error: A reservation must last between 1 and 14 days." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int ReservationManager::createReservation(int customerID, const std::string& category, const std::string& size,
+                                          const std::string& startDate, const std::string& endDate) {
+    TraceSpan span("reservation.create", customerID);
+    if (!validateReservationDates(startDate, endDate)) return -1;
+    try {
+        sql::PreparedStatement* pstmt = DatabaseManager::getInstance().prepare(
+            "SELECT COUNT(*) AS Dresses FROM Dresses WHERE Category = ? AND Size = ?"
+        );
+        pstmt->setString(1, category);
+        pstmt->setString(2, size);
+        sql::ResultSet* res = DatabaseManager::runQuery(pstmt);
+        bool hasDresses = res && res->next() && res->getInt("Dresses") > 0;
+        if (res) delete res;
+        delete pstmt;
+        if (!hasDresses) {
+            std::cerr << "Error: No dresses of category " << category << " in size " << size << "." << std::endl;
+            return -1;
+        }
+
+        sql::Connection* conn = DatabaseManager::getInstance().getConnection();
+        conn->setAutoCommit(false);
+        pstmt = DatabaseManager::getInstance().prepare(
+            "INSERT INTO Reservations (CustomerID, Category, Size, StartDate, EndDate) VALUES (?, ?, ?, ?, ?)"
+        );
+        pstmt->setInt(1, customerID);
+        pstmt->setString(2, category);
+        pstmt->setString(3, size);
+        pstmt->setString(4, startDate);
+        pstmt->setString(5, endDate);
+        try {
+            DatabaseManager::getInstance().executePreparedUpdate(pstmt);
+        } catch (sql::SQLException&) {
+            delete pstmt;
+            throw;
+        }
+        delete pstmt;
+
+        int reservationID = -1;
+        sql::Statement* stmt = conn->createStatement();
+        res = stmt->executeQuery("SELECT LAST_INSERT_ID() AS id");
+        if (res && res->next()) reservationID = res->getInt("id");
+        if (res) delete res;
+        delete stmt;
+
+        // Same transaction, so the reservation is never stored without a plan
+        ReservationPlanner planner;
+        std::unordered_map<int, int> previous;
+        loadPlan(planner, previous, category, size);
+        savePlan(planner, previous);
+        conn->commit();
+        conn->setAutoCommit(true);
+        return reservationID;
+    } catch (sql::SQLException& e) {
+        std::cerr << "Error creating reservation: " << e.what() << std::endl;
+        DatabaseManager::rollbackQuietly();
+        return -1;
+    }
+}
+
+bool ReservationManager::cancelReservation(int reservationID) {
+    Reservation* reservation = getReservationByID(reservationID);
+    if (!reservation) {
+        std::cerr << "Error: Reservation " << reservationID << " not found." << std::endl;
+        return false;
+    }
+    std::string category = reservation->Category;
+    std::string size = reservation->Size;
+    delete reservation;
+
+    try {
+        sql::Connection* conn = DatabaseManager::getInstance().getConnection();
+        conn->setAutoCommit(false);
+        sql::PreparedStatement* pstmt = DatabaseManager::getInstance().prepare(
+            "UPDATE Reservations SET Status = 'Cancelled', AssignedDressID = NULL "
+            "WHERE ReservationID = ? AND Status = 'Booked'"
+        );
+        pstmt->setInt(1, reservationID);
+        int rows = DatabaseManager::getInstance().executePreparedUpdate(pstmt);
+        delete pstmt;
+        if (rows == 0) {
+            std::cerr << "Error: Reservation " << reservationID << " is not booked." << std::endl;
+            conn->rollback();
+            conn->setAutoCommit(true);
+            return false;
+        }
+
+        // Its dress may be what a waiting reservation of the group needs. Same
+        // transaction, so the cancel is saved only together with the new plan
+        ReservationPlanner planner;
+        std::unordered_map<int, int> previous;
+        loadPlan(planner, previous, category, size);
+        savePlan(planner, previous);
+        conn->commit();
+        conn->setAutoCommit(true);
+        return true;
+    } catch (sql::SQLException& e) {
+        std::cerr << "Error cancelling reservation: " << e.what() << std::endl;
+        DatabaseManager::rollbackQuietly();
+        return false;
+    } catch (const std::exception& e) {
+        std::cerr << "Error cancelling reservation: " << e.what() << std::endl;
+        DatabaseManager::rollbackQuietly();
+        return false;
+    }
+}
+
+int ReservationManager::fulfilReservation(int reservationID) {
+    TraceSpan span("reservation.fulfil", reservationID);
+    Reservation* reservation = getReservationByID(reservationID);
+    if (!reservation) {
+        std::cerr << "Error: Reservation " << reservationID << " not found." << std::endl;
+        return -1;
+    }
+    Reservation booked = *reservation;
+    delete reservation;
+    if (booked.Status != "Booked") {
+        std::cerr << "Error: Reservation " << reservationID << " is " << booked.Status << "." << std::endl;
+        return -1;
+    }
+    if (booked.AssignedDressID == 0) {
+        std::cerr << "Error: No dress of the group is free for this reservation yet." << std::endl;
+        return -1;
+    }
+
+    // The rental reserves the unit from here on. The reservation is locked and
+    // checked again in the rental's transaction, so two counters cannot both
+    // fulfil it and a rental never exists without its reservation marked.
+    RentalManager rm;
+    return rm.createRental(booked.CustomerID, booked.StartDate,
+                           static_cast<int>(dayOf(booked.EndDate) - dayOf(booked.StartDate)),
+                           std::vector<int>(1, booked.AssignedDressID),
+                           [&booked](int rentalID) -> bool {
+        sql::PreparedStatement* pstmt = DatabaseManager::getInstance().prepare(
+            "SELECT Status, AssignedDressID FROM Reservations WHERE ReservationID = ? FOR UPDATE"
+        );
+        pstmt->setInt(1, booked.ReservationID);
+        sql::ResultSet* res = DatabaseManager::runQuery(pstmt);
+        bool found = res && res->next();
+        std::string status = found ? std::string(res->getString("Status")) : "";
+        int assignedDressID = found ? res->getInt("AssignedDressID") : 0;
+        if (res) delete res;
+        delete pstmt;
+        if (status != "Booked") {
+            std::cerr << "Error: Reservation " << booked.ReservationID << " is "
+                      << (found ? status : std::string("gone")) << "." << std::endl;
+            return false;
+        }
+        if (assignedDressID != booked.AssignedDressID) {
+            std::cerr << "Error: Reservation " << booked.ReservationID << " was given another dress; try again." << std::endl;
+            return false;
+        }
+
+        pstmt = DatabaseManager::getInstance().prepare(
+            "UPDATE Reservations SET Status = 'Fulfilled', RentalID = ? WHERE ReservationID = ?"
+        );
+        pstmt->setInt(1, rentalID);
+        pstmt->setInt(2, booked.ReservationID);
+        DatabaseManager::getInstance().executePreparedUpdate(pstmt);
+        delete pstmt;
+        return true;
+    });
+}
+
+int ReservationManager::replanAll() {
+    try {
+        return replanGroup("", "");
+    } catch (sql::SQLException& e) {
+        std::cerr << "Error replanning reservations: " << e.what() << std::endl;
+        DatabaseManager::rollbackQuietly();
+        return -1;
+    }
+}
+
+Reservation* ReservationManager::getReservationByID(int reservationID) {
+    try {
+        sql::PreparedStatement* pstmt = DatabaseManager::getInstance().prepare(
+            "SELECT * FROM Reservations WHERE ReservationID = ?"
+        );
+        pstmt->setInt(1, reservationID);
+        sql::ResultSet* res = DatabaseManager::runQuery(pstmt);
+
+        Reservation* reservation = nullptr;
+        if (res && res->next()) reservation = new Reservation(readReservation(res));
+        if (res) delete res;
+        delete pstmt;
+        return reservation;
+    } catch (sql::SQLException& e) {
+        std::cerr << "Error getting reservation: " << e.what() << std::endl;
+        return nullptr;
+    }
+}
+
+std::vector<Reservation> ReservationManager::getUpcomingReservations() {
+    std::vector<Reservation> reservations;
+    try {
+        sql::ResultSet* res = DatabaseManager::getInstance().executeReadSelect(
+            "SELECT * FROM Reservations WHERE Status = 'Booked' AND EndDate >= CURDATE() "
+            "ORDER BY StartDate, ReservationID"
+        );
+        while (res && res->next()) reservations.push_back(readReservation(res));
+        if (res) delete res;
+    } catch (sql::SQLException& e) {
+        std::cerr << "Error getting reservations: " << e.what() << std::endl;
+    }
+    return reservations;
+}
+
+void ReservationManager::displayReservations(const std::vector<Reservation>& reservations) {
+    RenderFrame frame;
+    TableRenderer table(SCREEN_WIDTH);
+    table.addColumn("ID", 0, 0, TableRenderer::ALIGN_RIGHT);
+    table.addColumn("Customer", 0, 0, TableRenderer::ALIGN_RIGHT);
+    table.addColumn("Category", 8, 16);
+    table.addColumn("Size");
+    table.addColumn("Start");
+    table.addColumn("End");
+    table.addColumn("Dress", 0, 0, TableRenderer::ALIGN_RIGHT);
+    table.addColumn("Status");
+    for (const Reservation& reservation : reservations) {
+        std::string dress = reservation.AssignedDressID > 0 ? std::to_string(reservation.AssignedDressID)
+                                                            : UIColors::colorize("waiting", UIColors::YELLOW);
+        table.addRow({ std::to_string(reservation.ReservationID), std::to_string(reservation.CustomerID),
+                       reservation.Category, reservation.Size, reservation.StartDate, reservation.EndDate,
+                       dress, reservation.Status });
+    }
+    table.render();
+}
@@ -0,0 +1,287 @@
+#include "ReservationPlanner.h"
+#include <algorithm>
+#include <climits>
+#include <utility>
+
+std::string ReservationPlanner::groupOf(const std::string& category, const std::string& size) {
+    return category + "/" + size;
+}
+
+void ReservationPlanner::addDress(const std::string& groupName, int dressID, int units) {
+    if (units <= 0 || dressGroups.count(dressID)) return;
+    dressGroups[dressID] = groupName;
+    Group& group = groups[groupName];
+    std::vector<size_t>& indexes = group.dressUnits[dressID];
+    for (int u = 0; u < units; ++u) {
+        indexes.push_back(group.units.size());
+        Unit unit;
+        unit.dressID = dressID;
+        group.units.push_back(unit);
+    }
+}
+
+bool ReservationPlanner::addRental(int dressID, long firstDay, long lastDay) {
+    std::unordered_map<int, std::string>::const_iterator owner = dressGroups.find(dressID);
+    if (owner == dressGroups.end() || firstDay > lastDay) return false;
+    Group& group = groups[owner->second];
+    long idle = 0;
+    for (size_t index : group.dressUnits[dressID]) {
+        Unit& unit = group.units[index];
+        if (!fits(unit, firstDay, lastDay, idle)) continue;
+        Slot slot = { firstDay, lastDay, RENTAL };
+        occupy(unit, slot);
+        return true;
+    }
+    return false;
+}
+
+bool ReservationPlanner::fits(const Unit& unit, long firstDay, long lastDay, long& idle) {
+    std::vector<Slot>::const_iterator next = std::lower_bound(
+        unit.busy.begin(), unit.busy.end(), firstDay,
+        [](const Slot& slot, long day) { return slot.firstDay < day; });
+    if (next != unit.busy.end() && next->firstDay <= lastDay) return false;
+    if (next == unit.busy.begin()) {
+        idle = LONG_MAX;
+        return true;
+    }
+    --next;
+    if (next->lastDay >= firstDay) return false;
+    idle = firstDay - next->lastDay;
+    return true;
+}
+
+void ReservationPlanner::occupy(Unit& unit, const Slot& slot) {
+    std::vector<Slot>::iterator next = std::lower_bound(
+        unit.busy.begin(), unit.busy.end(), slot.firstDay,
+        [](const Slot& busy, long day) { return busy.firstDay < day; });
+    unit.busy.insert(next, slot);
+}
+
+bool ReservationPlanner::place(Group& group, Booking& booking, int preferredDressID) {
+    size_t best = group.units.size();
+    long bestIdle = LONG_MAX;
+    long idle = 0;
+
+    std::unordered_map<int, std::vector<size_t>>::const_iterator preferred = group.dressUnits.find(preferredDressID);
+    if (preferred != group.dressUnits.end()) {
+        for (size_t index : preferred->second) {
+            if (!fits(group.units[index], booking.firstDay, booking.lastDay, idle)) continue;
+            if (best == group.units.size() || idle < bestIdle) {
+                best = index;
+                bestIdle = idle;
+            }
+        }
+    }
+    if (best == group.units.size()) {
+        for (size_t index = 0; index < group.units.size(); ++index) {
+            if (!fits(group.units[index], booking.firstDay, booking.lastDay, idle)) continue;
+            if (best == group.units.size() || idle < bestIdle) {
+                best = index;
+                bestIdle = idle;
+            }
+        }
+    }
+    if (best == group.units.size()) {
+        booking.dressID = -1;
+        return false;
+    }
+
+    Slot slot = { booking.firstDay, booking.lastDay, booking.reservationID };
+    occupy(group.units[best], slot);
+    booking.dressID = group.units[best].dressID;
+    assigned[booking.reservationID] = best;
+    return true;
+}
+
+void ReservationPlanner::unplace(Group& group, const Booking& booking) {
+    std::unordered_map<int, size_t>::iterator unit = assigned.find(booking.reservationID);
+    if (unit != assigned.end()) {
+        std::vector<Slot>& busy = group.units[unit->second].busy;
+        for (std::vector<Slot>::iterator slot = busy.begin(); slot != busy.end(); ++slot) {
+            if (slot->reservationID == booking.reservationID) {
+                busy.erase(slot);
+                break;
+            }
+        }
+        assigned.erase(unit);
+        return;
+    }
+    std::vector<int>::iterator waiting = std::find(group.waiting.begin(), group.waiting.end(), booking.reservationID);
+    if (waiting != group.waiting.end()) group.waiting.erase(waiting);
+}
+
+bool ReservationPlanner::addReservation(int reservationID, const std::string& groupName, long firstDay, long lastDay,
+                                        int preferredDressID) {
+    if (reservationID <= 0 || firstDay > lastDay) return false;
+    removeReservation(reservationID);
+
+    Group& group = groups[groupName];
+    Booking& booking = bookings[reservationID];
+    booking.reservationID = reservationID;
+    booking.group = groupName;
+    booking.firstDay = firstDay;
+    booking.lastDay = lastDay;
+    booking.dressID = -1;
+    group.members.insert(reservationID);
+    if (place(group, booking, preferredDressID)) return true;
+    group.waiting.push_back(reservationID);
+    return false;
+}
+
+bool ReservationPlanner::removeReservation(int reservationID) {
+    std::unordered_map<int, Booking>::iterator found = bookings.find(reservationID);
+    if (found == bookings.end()) return false;
+    Booking removed = found->second;
+    Group& group = groups[removed.group];
+    bool wasAssigned = removed.dressID != -1;
+    unplace(group, removed);
+    group.members.erase(reservationID);
+    bookings.erase(found);
+    if (!wasAssigned) return true;
+
+    // Only waiting reservations overlapping the freed days can fit now
+    std::vector<int> stillWaiting;
+    for (int waitingID : group.waiting) {
+        Booking& booking = bookings[waitingID];
+        bool overlaps = booking.firstDay <= removed.lastDay && booking.lastDay >= removed.firstDay;
+        if (!overlaps || !place(group, booking, -1)) stillWaiting.push_back(waitingID);
+    }
+    group.waiting.swap(stillWaiting);
+    return true;
+}
+
+void ReservationPlanner::planGroup(const Group& group, bool assignedFirst, std::vector<Unit>& plan,
+                                   std::vector<std::pair<int, size_t>>& placed) const {
+    // Rentals stay where they are; reservations are planned around them
+    plan.assign(group.units.size(), Unit());
+    for (size_t index = 0; index < group.units.size(); ++index) {
+        plan[index].dressID = group.units[index].dressID;
+        for (const Slot& slot : group.units[index].busy) {
+            if (slot.reservationID == RENTAL) plan[index].busy.push_back(slot);
+        }
+    }
+
+    std::vector<const Booking*> order;
+    std::vector<const Booking*> rest;
+    for (int reservationID : group.members) {
+        bool later = assignedFirst && !assigned.count(reservationID);
+        (later ? rest : order).push_back(&bookings.at(reservationID));
+    }
+    auto byLastDayFirst = [](const Booking* a, const Booking* b) {
+        if (a->lastDay != b->lastDay) return a->lastDay < b->lastDay;
+        if (a->firstDay != b->firstDay) return a->firstDay < b->firstDay;
+        return a->reservationID < b->reservationID;
+    };
+    std::sort(order.begin(), order.end(), byLastDayFirst);
+    std::sort(rest.begin(), rest.end(), byLastDayFirst);
+
+    // Units by the last day of their latest reservation so far. Taken in
+    // order of last day, a unit whose reservations all end before firstDay is
+    // free unless one of its rentals is in the way; the latest such end is
+    // the tightest fit.
+    std::set<std::pair<long, size_t>> byLastDay;
+    for (size_t index = 0; index < plan.size(); ++index) byLastDay.insert(std::make_pair(LONG_MIN, index));
+    placed.clear();
+    placed.reserve(group.members.size());
+    long idle = 0;
+    for (const Booking* booking : order) {
+        std::set<std::pair<long, size_t>>::iterator candidate =
+            byLastDay.lower_bound(std::make_pair(booking->firstDay, static_cast<size_t>(0)));
+        while (candidate != byLastDay.begin()) {
+            --candidate;
+            size_t index = candidate->second;
+            if (!fits(plan[index], booking->firstDay, booking->lastDay, idle)) continue;
+            Slot slot = { booking->firstDay, booking->lastDay, booking->reservationID };
+            occupy(plan[index], slot);
+            byLastDay.erase(candidate);
+            byLastDay.insert(std::make_pair(booking->lastDay, index));
+            placed.push_back(std::make_pair(booking->reservationID, index));
+            break;
+        }
+    }
+
+    // The rest go into whatever gaps are left, tightest fit first
+    for (const Booking* booking : rest) {
+        size_t best = plan.size();
+        long bestIdle = LONG_MAX;
+        for (size_t index = 0; index < plan.size(); ++index) {
+            if (!fits(plan[index], booking->firstDay, booking->lastDay, idle)) continue;
+            if (best == plan.size() || idle < bestIdle) {
+                best = index;
+                bestIdle = idle;
+            }
+        }
+        if (best == plan.size()) continue;
+        Slot slot = { booking->firstDay, booking->lastDay, booking->reservationID };
+        occupy(plan[best], slot);
+        placed.push_back(std::make_pair(booking->reservationID, best));
+    }
+}
+
+size_t ReservationPlanner::solve(const std::string& groupName) {
+    std::map<std::string, Group>::iterator found = groups.find(groupName);
+    if (found == groups.end()) return 0;
+    Group& group = found->second;
+    size_t current = group.members.size() - group.waiting.size();
+    if (group.waiting.empty()) return current;
+
+    // A reservation that has a dress keeps one, if maybe another. The plain
+    // greedy plan assigns the most; if it drops one of them, plan those first
+    // and fit the waiting ones around them instead.
+    std::vector<Unit> plan;
+    std::vector<std::pair<int, size_t>> placed;
+    auto keepsAssigned = [&]() {
+        size_t kept = 0;
+        for (const std::pair<int, size_t>& assignment : placed) {
+            if (assigned.count(assignment.first)) ++kept;
+        }
+        return kept == current;
+    };
+    planGroup(group, false, plan, placed);
+    if (placed.size() > current && !keepsAssigned()) planGroup(group, true, plan, placed);
+    if (placed.size() <= current || !keepsAssigned()) return current;
+
+    for (int reservationID : group.members) {
+        assigned.erase(reservationID);
+        bookings[reservationID].dressID = -1;
+    }
+    group.units.swap(plan);
+    for (const std::pair<int, size_t>& assignment : placed) {
+        assigned[assignment.first] = assignment.second;
+        bookings[assignment.first].dressID = group.units[assignment.second].dressID;
+    }
+    group.waiting.clear();
+    for (int reservationID : group.members) {
+        if (bookings[reservationID].dressID == -1) group.waiting.push_back(reservationID);
+    }
+    return placed.size();
+}
+
+size_t ReservationPlanner::solveAll() {
+    for (std::map<std::string, Group>::iterator group = groups.begin(); group != groups.end(); ++group) {
+        if (!group->second.waiting.empty()) solve(group->first);
+    }
+    return assigned.size();
+}
+
+const ReservationPlanner::Booking* ReservationPlanner::find(int reservationID) const {
+    std::unordered_map<int, Booking>::const_iterator found = bookings.find(reservationID);
+    return found == bookings.end() ? nullptr : &found->second;
+}
+
+std::vector<ReservationPlanner::Booking> ReservationPlanner::getBookings() const {
+    std::vector<Booking> all;
+    all.reserve(bookings.size());
+    for (const std::pair<const int, Booking>& booking : bookings) all.push_back(booking.second);
+    std::sort(all.begin(), all.end(), [](const Booking& a, const Booking& b) {
+        return a.reservationID < b.reservationID;
+    });
+    return all;
+}
+
+void ReservationPlanner::clear() {
+    groups.clear();
+    dressGroups.clear();
+    bookings.clear();
+    assigned.clear();
+}
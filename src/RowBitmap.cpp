@@ -0,0 +1,274 @@
+#include "RowBitmap.h"
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+namespace {
+
+// The builtin is only a single instruction when the target has POPCNT;
+// otherwise it is a library call, slower than counting inline
+int popCount(uint64_t word) {
+#if defined(__POPCNT__) && (defined(__GNUC__) || defined(__clang__))
+    return __builtin_popcountll(word);
+#else
+    word = word - ((word >> 1) & 0x5555555555555555ULL);
+    word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+    word = (word + (word >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+    return static_cast<int>((word * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+} // namespace
+
+int RowBitmap::trailingZeros(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(word);
+#else
+    int zeros = 0;
+    while ((word & 1) == 0) {
+        word >>= 1;
+        ++zeros;
+    }
+    return zeros;
+#endif
+}
+
+bool RowBitmap::Chunk::has(uint16_t low) const {
+    if (isBitset()) return (bits[low >> 6] >> (low & 63)) & 1;
+    return std::binary_search(array.begin(), array.end(), low);
+}
+
+void RowBitmap::add(uint32_t row) {
+    uint16_t key = static_cast<uint16_t>(row >> 16);
+    uint16_t low = static_cast<uint16_t>(row & 0xffff);
+
+    std::vector<Chunk>::iterator chunk;
+    if (chunks.empty() || chunks.back().key < key) {
+        chunks.push_back(Chunk());
+        chunk = chunks.end() - 1;
+        chunk->key = key;
+        chunk->count = 0;
+    } else {
+        chunk = std::lower_bound(chunks.begin(), chunks.end(), key,
+                                 [](const Chunk& c, uint16_t k) { return c.key < k; });
+        if (chunk == chunks.end() || chunk->key != key) {
+            chunk = chunks.insert(chunk, Chunk());
+            chunk->key = key;
+            chunk->count = 0;
+        }
+    }
+
+    if (chunk->isBitset()) {
+        uint64_t mask = 1ULL << (low & 63);
+        if (chunk->bits[low >> 6] & mask) return;
+        chunk->bits[low >> 6] |= mask;
+        ++chunk->count;
+        return;
+    }
+
+    std::vector<uint16_t>& array = chunk->array;
+    if (array.empty() || array.back() < low) {
+        array.push_back(low);
+    } else {
+        std::vector<uint16_t>::iterator at = std::lower_bound(array.begin(), array.end(), low);
+        if (*at == low) return;
+        array.insert(at, low);
+    }
+    if (++chunk->count > ARRAY_MAX) toBitset(*chunk);
+}
+
+bool RowBitmap::contains(uint32_t row) const {
+    uint16_t key = static_cast<uint16_t>(row >> 16);
+    std::vector<Chunk>::const_iterator chunk =
+        std::lower_bound(chunks.begin(), chunks.end(), key,
+                         [](const Chunk& c, uint16_t k) { return c.key < k; });
+    return chunk != chunks.end() && chunk->key == key && chunk->has(static_cast<uint16_t>(row & 0xffff));
+}
+
+size_t RowBitmap::cardinality() const {
+    size_t total = 0;
+    for (const Chunk& chunk : chunks) total += chunk.count;
+    return total;
+}
+
+void RowBitmap::toBitset(Chunk& chunk) {
+    chunk.bits.assign(BITSET_WORDS, 0);
+    for (uint16_t low : chunk.array) chunk.bits[low >> 6] |= 1ULL << (low & 63);
+    std::vector<uint16_t>().swap(chunk.array);
+}
+
+void RowBitmap::toArrayIfSmall(Chunk& chunk) {
+    if (!chunk.isBitset() || chunk.count > ARRAY_MAX) return;
+    chunk.array.clear();
+    chunk.array.reserve(chunk.count);
+    for (size_t w = 0; w < BITSET_WORDS; ++w) {
+        uint64_t word = chunk.bits[w];
+        while (word != 0) {
+            chunk.array.push_back(static_cast<uint16_t>(w * 64 + trailingZeros(word)));
+            word &= word - 1;
+        }
+    }
+    std::vector<uint64_t>().swap(chunk.bits);
+}
+
+RowBitmap::Chunk RowBitmap::intersectChunks(const Chunk& a, const Chunk& b) {
+    Chunk result;
+    result.key = a.key;
+    result.count = 0;
+    if (a.isBitset() && b.isBitset()) {
+        result.bits.resize(BITSET_WORDS);
+        for (size_t w = 0; w < BITSET_WORDS; ++w) {
+            result.bits[w] = a.bits[w] & b.bits[w];
+            result.count += popCount(result.bits[w]);
+        }
+        toArrayIfSmall(result);
+    } else if (a.isBitset() || b.isBitset()) {
+        const Chunk& array = a.isBitset() ? b : a;
+        const Chunk& bitset = a.isBitset() ? a : b;
+        for (uint16_t low : array.array) {
+            if ((bitset.bits[low >> 6] >> (low & 63)) & 1) result.array.push_back(low);
+        }
+        result.count = static_cast<uint32_t>(result.array.size());
+    } else {
+        std::set_intersection(a.array.begin(), a.array.end(), b.array.begin(), b.array.end(),
+                              std::back_inserter(result.array));
+        result.count = static_cast<uint32_t>(result.array.size());
+    }
+    return result;
+}
+
+size_t RowBitmap::intersectChunkCount(const Chunk& a, const Chunk& b) {
+    size_t count = 0;
+    if (a.isBitset() && b.isBitset()) {
+        for (size_t w = 0; w < BITSET_WORDS; ++w) count += popCount(a.bits[w] & b.bits[w]);
+    } else if (a.isBitset() || b.isBitset()) {
+        const Chunk& array = a.isBitset() ? b : a;
+        const Chunk& bitset = a.isBitset() ? a : b;
+        for (uint16_t low : array.array) count += (bitset.bits[low >> 6] >> (low & 63)) & 1;
+    } else {
+        std::vector<uint16_t>::const_iterator i = a.array.begin();
+        std::vector<uint16_t>::const_iterator j = b.array.begin();
+        while (i != a.array.end() && j != b.array.end()) {
+            if (*i < *j) {
+                ++i;
+            } else if (*j < *i) {
+                ++j;
+            } else {
+                ++count;
+                ++i;
+                ++j;
+            }
+        }
+    }
+    return count;
+}
+
+RowBitmap::Chunk RowBitmap::uniteChunks(const Chunk& a, const Chunk& b) {
+    Chunk result;
+    result.key = a.key;
+    result.count = 0;
+    if (!a.isBitset() && !b.isBitset()) {
+        std::set_union(a.array.begin(), a.array.end(), b.array.begin(), b.array.end(),
+                       std::back_inserter(result.array));
+        result.count = static_cast<uint32_t>(result.array.size());
+        if (result.count > ARRAY_MAX) toBitset(result);
+        return result;
+    }
+
+    const Chunk& bitset = a.isBitset() ? a : b;
+    const Chunk& other = a.isBitset() ? b : a;
+    result.bits = bitset.bits;
+    if (other.isBitset()) {
+        for (size_t w = 0; w < BITSET_WORDS; ++w) result.bits[w] |= other.bits[w];
+    } else {
+        for (uint16_t low : other.array) result.bits[low >> 6] |= 1ULL << (low & 63);
+    }
+    for (size_t w = 0; w < BITSET_WORDS; ++w) result.count += popCount(result.bits[w]);
+    return result;
+}
+
+RowBitmap RowBitmap::intersect(const RowBitmap& a, const RowBitmap& b) {
+    RowBitmap result;
+    size_t i = 0;
+    size_t j = 0;
+    while (i < a.chunks.size() && j < b.chunks.size()) {
+        if (a.chunks[i].key < b.chunks[j].key) {
+            ++i;
+        } else if (b.chunks[j].key < a.chunks[i].key) {
+            ++j;
+        } else {
+            Chunk chunk = intersectChunks(a.chunks[i], b.chunks[j]);
+            if (chunk.count > 0) result.chunks.push_back(std::move(chunk));
+            ++i;
+            ++j;
+        }
+    }
+    return result;
+}
+
+size_t RowBitmap::intersectCount(const RowBitmap& a, const RowBitmap& b) {
+    size_t count = 0;
+    size_t i = 0;
+    size_t j = 0;
+    while (i < a.chunks.size() && j < b.chunks.size()) {
+        if (a.chunks[i].key < b.chunks[j].key) {
+            ++i;
+        } else if (b.chunks[j].key < a.chunks[i].key) {
+            ++j;
+        } else {
+            count += intersectChunkCount(a.chunks[i], b.chunks[j]);
+            ++i;
+            ++j;
+        }
+    }
+    return count;
+}
+
+RowBitmap RowBitmap::unite(const RowBitmap& a, const RowBitmap& b) {
+    RowBitmap result;
+    size_t i = 0;
+    size_t j = 0;
+    while (i < a.chunks.size() || j < b.chunks.size()) {
+        if (j == b.chunks.size() || (i < a.chunks.size() && a.chunks[i].key < b.chunks[j].key)) {
+            result.chunks.push_back(a.chunks[i++]);
+        } else if (i == a.chunks.size() || b.chunks[j].key < a.chunks[i].key) {
+            result.chunks.push_back(b.chunks[j++]);
+        } else {
+            result.chunks.push_back(uniteChunks(a.chunks[i], b.chunks[j]));
+            ++i;
+            ++j;
+        }
+    }
+    return result;
+}
+
+std::vector<uint32_t> RowBitmap::toRows(size_t limit) const {
+    std::vector<uint32_t> rows;
+    for (const Chunk& chunk : chunks) {
+        uint32_t high = static_cast<uint32_t>(chunk.key) << 16;
+        if (chunk.isBitset()) {
+            for (size_t w = 0; w < BITSET_WORDS; ++w) {
+                uint64_t word = chunk.bits[w];
+                while (word != 0) {
+                    if (limit != 0 && rows.size() == limit) return rows;
+                    rows.push_back(high | static_cast<uint32_t>(w * 64 + trailingZeros(word)));
+                    word &= word - 1;
+                }
+            }
+        } else {
+            for (uint16_t low : chunk.array) {
+                if (limit != 0 && rows.size() == limit) return rows;
+                rows.push_back(high | low);
+            }
+        }
+    }
+    return rows;
+}
+
+size_t RowBitmap::memoryBytes() const {
+    size_t bytes = sizeof(RowBitmap) + chunks.capacity() * sizeof(Chunk);
+    for (const Chunk& chunk : chunks) {
+        bytes += chunk.array.capacity() * sizeof(uint16_t) + chunk.bits.capacity() * sizeof(uint64_t);
+    }
+    return bytes;
+}
@@ -0,0 +1,585 @@
+#include "SchemaMigrator.h"
+#include "DatabaseManager.h"
+#include "AppConfig.h"
+#include "TableRenderer.h"
+#include "UIColors.h"
+#include "MenuHandlers.h"
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <thread>
+
+namespace {
+
+const char* MIGRATION_LOCK = "SELECT GET_LOCK('dress_rental_schema_migration', 60) AS acquired";
+const char* MIGRATION_UNLOCK = "SELECT RELEASE_LOCK('dress_rental_schema_migration')";
+const int MAX_STATEMENT_ATTEMPTS = 3;
+
+const char* VERSION_TABLE =
+    "CREATE TABLE IF NOT EXISTS SchemaMigrations ("
+    "    Version INT PRIMARY KEY,"
+    "    Name VARCHAR(100) NOT NULL,"
+    "    Checksum CHAR(16) NOT NULL,"
+    "    DurationMs INT NOT NULL DEFAULT 0,"
+    "    AppliedAt TIMESTAMP DEFAULT CURRENT_TIMESTAMP"
+    ")";
+
+struct Migration {
+    int version;
+    const char* name;
+    std::vector<std::string> statements;
+};
+
+// Append only: never edit a migration that has shipped, add a new one. Every
+// statement must be safe to run twice (see SchemaMigrator.h). Keep
+// database_schema.sql in step with the result.
+const std::vector<Migration>& migrations() {
+    static const std::vector<Migration> list = {
+        { 1, "baseline", {
+            "CREATE TABLE IF NOT EXISTS Users ("
+            "    UserID INT AUTO_INCREMENT PRIMARY KEY,"
+            "    Username VARCHAR(50) UNIQUE NOT NULL,"
+            "    PasswordHash VARCHAR(64) NOT NULL,"
+            "    Role VARCHAR(20) NOT NULL DEFAULT 'Staff',"
+            "    FullName VARCHAR(100) NOT NULL,"
+            "    Email VARCHAR(100),"
+            "    Phone VARCHAR(20),"
+            "    IsActive BOOLEAN DEFAULT TRUE,"
+            "    LastLogin TIMESTAMP NULL,"
+            "    CreatedAt TIMESTAMP DEFAULT CURRENT_TIMESTAMP,"
+            "    INDEX idx_username (Username),"
+            "    INDEX idx_role (Role)"
+            ")",
+            "CREATE TABLE IF NOT EXISTS Customers ("
+            "    CustomerID INT AUTO_INCREMENT PRIMARY KEY,"
+            "    Name VARCHAR(100) NOT NULL,"
+            "    IC_Number VARCHAR(20) UNIQUE NOT NULL,"
+            "    Phone VARCHAR(20) NOT NULL,"
+            "    Email VARCHAR(100),"
+            "    Address TEXT,"
+            "    DateOfBirth DATE NOT NULL,"
+            "    CreatedAt TIMESTAMP DEFAULT CURRENT_TIMESTAMP,"
+            "    INDEX idx_ic (IC_Number),"
+            "    INDEX idx_phone (Phone)"
+            ")",
+            "CREATE TABLE IF NOT EXISTS Dresses ("
+            "    DressID INT AUTO_INCREMENT PRIMARY KEY,"
+            "    DressName VARCHAR(100) NOT NULL,"
+            "    Category VARCHAR(50) NOT NULL,"
+            "    Size VARCHAR(10) NOT NULL,"
+            "    Color VARCHAR(30) NOT NULL,"
+            "    RentalPrice DECIMAL(10, 2) NOT NULL,"
+            "    ConditionStatus VARCHAR(20) DEFAULT 'Good',"
+            "    AvailabilityStatus VARCHAR(20) DEFAULT 'Available',"
+            "    CleaningStatus VARCHAR(20) DEFAULT 'Clean',"
+            "    StockQuantity INT DEFAULT 1,"
+            "    MinimumStockLevel INT DEFAULT 1,"
+            "    CreatedAt TIMESTAMP DEFAULT CURRENT_TIMESTAMP,"
+            "    INDEX idx_category (Category),"
+            "    INDEX idx_availability (AvailabilityStatus)"
+            ")",
+            "CREATE TABLE IF NOT EXISTS Rentals ("
+            "    RentalID INT AUTO_INCREMENT PRIMARY KEY,"
+            "    CustomerID INT NOT NULL,"
+            "    RentalDate DATE NOT NULL,"
+            "    DueDate DATE NOT NULL,"
+            "    ReturnDate DATE,"
+            "    TotalAmount DECIMAL(10, 2) NOT NULL,"
+            "    LateFee DECIMAL(10, 2) DEFAULT 0.00,"
+            "    Status VARCHAR(20) DEFAULT 'Active',"
+            "    CreatedBy INT,"
+            "    CreatedAt TIMESTAMP DEFAULT CURRENT_TIMESTAMP,"
+            "    FOREIGN KEY (CustomerID) REFERENCES Customers(CustomerID) ON DELETE CASCADE,"
+            "    FOREIGN KEY (CreatedBy) REFERENCES Users(UserID) ON DELETE SET NULL,"
+            "    INDEX idx_customer (CustomerID),"
+            "    INDEX idx_status (Status),"
+            "    INDEX idx_due_date (DueDate)"
+            ")",
+            "CREATE TABLE IF NOT EXISTS RentalItems ("
+            "    RentalItemID INT AUTO_INCREMENT PRIMARY KEY,"
+            "    RentalID INT NOT NULL,"
+            "    DressID INT NOT NULL,"
+            "    RentalPrice DECIMAL(10, 2) NOT NULL,"
+            "    FOREIGN KEY (RentalID) REFERENCES Rentals(RentalID) ON DELETE CASCADE,"
+            "    FOREIGN KEY (DressID) REFERENCES Dresses(DressID) ON DELETE CASCADE,"
+            "    INDEX idx_rental (RentalID),"
+            "    INDEX idx_dress (DressID)"
+            ")",
+            "CREATE TABLE IF NOT EXISTS Payments ("
+            "    PaymentID INT AUTO_INCREMENT PRIMARY KEY,"
+            "    RentalID INT NOT NULL,"
+            "    Amount DECIMAL(10, 2) NOT NULL,"
+            "    PaymentMethod VARCHAR(20) NOT NULL,"
+            "    PaymentDate DATE NOT NULL,"
+            "    Status VARCHAR(20) DEFAULT 'Pending',"
+            "    TransactionReference VARCHAR(100),"
+            "    ProcessedBy INT,"
+            "    CreatedAt TIMESTAMP DEFAULT CURRENT_TIMESTAMP,"
+            "    FOREIGN KEY (RentalID) REFERENCES Rentals(RentalID) ON DELETE CASCADE,"
+            "    FOREIGN KEY (ProcessedBy) REFERENCES Users(UserID) ON DELETE SET NULL,"
+            "    INDEX idx_rental (RentalID),"
+            "    INDEX idx_status (Status),"
+            "    INDEX idx_payment_date (PaymentDate)"
+            ")",
+            "CREATE TABLE IF NOT EXISTS ActivityLog ("
+            "    LogID INT AUTO_INCREMENT PRIMARY KEY,"
+            "    UserID INT,"
+            "    Action VARCHAR(100) NOT NULL,"
+            "    TableName VARCHAR(50),"
+            "    RecordID INT,"
+            "    Details TEXT,"
+            "    Timestamp TIMESTAMP DEFAULT CURRENT_TIMESTAMP,"
+            "    FOREIGN KEY (UserID) REFERENCES Users(UserID) ON DELETE SET NULL,"
+            "    INDEX idx_user (UserID),"
+            "    INDEX idx_timestamp (Timestamp)"
+            ")"
+        } },
+        // Databases created before CleaningStatus was part of the baseline
+        { 2, "dress_cleaning_status", {
+            "ALTER TABLE Dresses "
+            "ADD COLUMN IF NOT EXISTS CleaningStatus VARCHAR(20) DEFAULT 'Clean' AFTER AvailabilityStatus, "
+            "ALGORITHM=INPLACE, LOCK=NONE",
+            "UPDATE Dresses SET CleaningStatus = 'Clean' WHERE CleaningStatus IS NULL OR CleaningStatus = ''"
+        } },
+        { 3, "overdue_sweeper_tables", {
+            "CREATE TABLE IF NOT EXISTS SystemCounters ("
+            "    CounterName VARCHAR(50) PRIMARY KEY,"
+            "    CounterValue DECIMAL(14, 2) NOT NULL DEFAULT 0,"
+            "    UpdatedAt TIMESTAMP DEFAULT CURRENT_TIMESTAMP"
+            ")",
+            "CREATE TABLE IF NOT EXISTS Reminders ("
+            "    ReminderID INT AUTO_INCREMENT PRIMARY KEY,"
+            "    RentalID INT NOT NULL,"
+            "    CustomerID INT NOT NULL,"
+            "    ReminderType VARCHAR(20) NOT NULL,"
+            "    ReminderDate DATE NOT NULL,"
+            "    Status VARCHAR(20) DEFAULT 'Queued',"
+            "    CreatedAt TIMESTAMP DEFAULT CURRENT_TIMESTAMP,"
+            "    FOREIGN KEY (RentalID) REFERENCES Rentals(RentalID) ON DELETE CASCADE,"
+            "    FOREIGN KEY (CustomerID) REFERENCES Customers(CustomerID) ON DELETE CASCADE,"
+            "    UNIQUE KEY uq_reminder (RentalID, ReminderType, ReminderDate),"
+            "    INDEX idx_status (Status)"
+            ")"
+        } },
+        // Optimistic concurrency for dress edits and rental claims
+        { 4, "dress_version", {
+            "ALTER TABLE Dresses "
+            "ADD COLUMN IF NOT EXISTS Version INT NOT NULL DEFAULT 0 AFTER MinimumStockLevel, "
+            "ALGORITHM=INPLACE, LOCK=NONE"
+        } },
+        // Composites for the hot queries (see IndexAdvisor), then drop the
+        // single-column indexes they start with; the foreign keys are served
+        // by the composites
+        { 5, "composite_indexes", {
+            "ALTER TABLE Rentals "
+            "ADD INDEX IF NOT EXISTS idx_status_due (Status, DueDate), "
+            "ADD INDEX IF NOT EXISTS idx_customer_status (CustomerID, Status), "
+            "ADD INDEX IF NOT EXISTS idx_date_amounts (RentalDate, TotalAmount, LateFee), "
+            "ALGORITHM=INPLACE, LOCK=NONE",
+            "ALTER TABLE RentalItems "
+            "ADD INDEX IF NOT EXISTS idx_dress_rental (DressID, RentalID), "
+            "ALGORITHM=INPLACE, LOCK=NONE",
+            "ALTER TABLE Payments "
+            "ADD INDEX IF NOT EXISTS idx_rental_status (RentalID, Status, Amount), "
+            "ADD INDEX IF NOT EXISTS idx_status_date (Status, PaymentDate, Amount), "
+            "ALGORITHM=INPLACE, LOCK=NONE",
+            "ALTER TABLE Dresses "
+            "ADD INDEX IF NOT EXISTS idx_category_availability (Category, AvailabilityStatus), "
+            "ALGORITHM=INPLACE, LOCK=NONE",
+            "ALTER TABLE Rentals DROP INDEX IF EXISTS idx_status, DROP INDEX IF EXISTS idx_customer, "
+            "ALGORITHM=INPLACE, LOCK=NONE",
+            "ALTER TABLE RentalItems DROP INDEX IF EXISTS idx_dress, ALGORITHM=INPLACE, LOCK=NONE",
+            "ALTER TABLE Payments DROP INDEX IF EXISTS idx_status, DROP INDEX IF EXISTS idx_rental, "
+            "ALGORITHM=INPLACE, LOCK=NONE",
+            "ALTER TABLE Dresses DROP INDEX IF EXISTS idx_category, ALGORITHM=INPLACE, LOCK=NONE"
+        } },
+        // Per-rental ledger so payment screens need not sum Payments; filled
+        // from the existing rentals and payments
+        { 6, "rental_balances", {
+            "CREATE TABLE IF NOT EXISTS RentalBalances ("
+            "    RentalID INT PRIMARY KEY,"
+            "    AmountDue DECIMAL(10, 2) NOT NULL DEFAULT 0,"
+            "    AmountPaid DECIMAL(10, 2) NOT NULL DEFAULT 0,"
+            "    Outstanding DECIMAL(10, 2) AS (AmountDue - AmountPaid) STORED,"
+            "    UpdatedAt TIMESTAMP DEFAULT CURRENT_TIMESTAMP ON UPDATE CURRENT_TIMESTAMP,"
+            "    FOREIGN KEY (RentalID) REFERENCES Rentals(RentalID) ON DELETE CASCADE,"
+            "    INDEX idx_outstanding (Outstanding)"
+            ")",
+            "INSERT INTO RentalBalances (RentalID, AmountDue, AmountPaid) "
+            "SELECT r.RentalID, r.TotalAmount + r.LateFee, "
+            "       (SELECT COALESCE(SUM(p.Amount), 0) FROM Payments p "
+            "        WHERE p.RentalID = r.RentalID AND p.Status = 'Completed') "
+            "FROM Rentals r "
+            "ON DUPLICATE KEY UPDATE AmountDue = VALUES(AmountDue), AmountPaid = VALUES(AmountPaid)"
+        } },
+        // Multi-unit stock: units reserved per dress and day, plus the units
+        // out and a low-stock flag kept on each dress (see DressStock), all
+        // filled from the active rentals
+        { 7, "dress_stock", {
+            "ALTER TABLE Dresses "
+            "ADD COLUMN IF NOT EXISTS UnitsOut INT NOT NULL DEFAULT 0 AFTER MinimumStockLevel, "
+            "ADD COLUMN IF NOT EXISTS LowStock BOOLEAN NOT NULL DEFAULT FALSE AFTER UnitsOut, "
+            "ALGORITHM=INPLACE, LOCK=NONE",
+            "ALTER TABLE Dresses ADD INDEX IF NOT EXISTS idx_low_stock (LowStock), ALGORITHM=INPLACE, LOCK=NONE",
+            "CREATE TABLE IF NOT EXISTS DressDailyStock ("
+            "    DressID INT NOT NULL,"
+            "    StockDate DATE NOT NULL,"
+            "    Reserved INT NOT NULL DEFAULT 0,"
+            "    PRIMARY KEY (DressID, StockDate),"
+            "    FOREIGN KEY (DressID) REFERENCES Dresses(DressID) ON DELETE CASCADE"
+            ")",
+            "INSERT INTO DressDailyStock (DressID, StockDate, Reserved) "
+            "SELECT ri.DressID, DATE_ADD(r.RentalDate, INTERVAL o.n DAY) AS StockDate, COUNT(*) "
+            "FROM Rentals r "
+            "JOIN RentalItems ri ON ri.RentalID = r.RentalID "
+            "JOIN (SELECT t.n * 10 + u.n AS n FROM "
+            "      (SELECT 0 AS n UNION ALL SELECT 1 UNION ALL SELECT 2 UNION ALL SELECT 3 UNION ALL SELECT 4 "
+            "       UNION ALL SELECT 5 UNION ALL SELECT 6 UNION ALL SELECT 7 UNION ALL SELECT 8 UNION ALL SELECT 9) t "
+            "      CROSS JOIN "
+            "      (SELECT 0 AS n UNION ALL SELECT 1 UNION ALL SELECT 2 UNION ALL SELECT 3 UNION ALL SELECT 4 "
+            "       UNION ALL SELECT 5 UNION ALL SELECT 6 UNION ALL SELECT 7 UNION ALL SELECT 8 UNION ALL SELECT 9) u) o "
+            "  ON o.n <= DATEDIFF(r.DueDate, r.RentalDate) "
+            "WHERE r.Status = 'Active' "
+            "GROUP BY ri.DressID, StockDate "
+            "ON DUPLICATE KEY UPDATE Reserved = VALUES(Reserved)",
+            "UPDATE Dresses d "
+            "LEFT JOIN (SELECT ri.DressID, COUNT(*) AS Units FROM RentalItems ri "
+            "           JOIN Rentals r ON r.RentalID = ri.RentalID "
+            "           WHERE r.Status = 'Active' GROUP BY ri.DressID) a ON a.DressID = d.DressID "
+            "SET d.UnitsOut = COALESCE(a.Units, 0)",
+            "UPDATE Dresses SET LowStock = (StockQuantity - UnitsOut < MinimumStockLevel)"
+        } },
+        // Advance bookings for a category and size; the dress is assigned by
+        // ReservationPlanner and may change until the reservation is fulfilled
+        { 8, "reservations", {
+            "CREATE TABLE IF NOT EXISTS Reservations ("
+            "    ReservationID INT AUTO_INCREMENT PRIMARY KEY,"
+            "    CustomerID INT NOT NULL,"
+            "    Category VARCHAR(50) NOT NULL,"
+            "    Size VARCHAR(10) NOT NULL,"
+            "    StartDate DATE NOT NULL,"
+            "    EndDate DATE NOT NULL,"
+            "    Status VARCHAR(20) NOT NULL DEFAULT 'Booked',"
+            "    AssignedDressID INT NULL,"
+            "    RentalID INT NULL,"
+            "    CreatedAt TIMESTAMP DEFAULT CURRENT_TIMESTAMP,"
+            "    FOREIGN KEY (CustomerID) REFERENCES Customers(CustomerID) ON DELETE CASCADE,"
+            "    FOREIGN KEY (AssignedDressID) REFERENCES Dresses(DressID) ON DELETE SET NULL,"
+            "    FOREIGN KEY (RentalID) REFERENCES Rentals(RentalID) ON DELETE SET NULL,"
+            "    INDEX idx_group (Category, Size, Status, EndDate),"
+            "    INDEX idx_status_end (Status, EndDate)"
+            ")",
+            "ALTER TABLE Dresses ADD INDEX IF NOT EXISTS idx_category_size (Category, Size), "
+            "ALGORITHM=INPLACE, LOCK=NONE"
+        } },
+        // Returned dresses wait for cleaning; each job keeps its unit reserved
+        // in DressDailyStock from ReturnDate through HeldThrough (see
+        // CleaningScheduler)
+        { 9, "cleaning_jobs", {
+            "CREATE TABLE IF NOT EXISTS CleaningJobs ("
+            "    JobID INT AUTO_INCREMENT PRIMARY KEY,"
+            "    DressID INT NOT NULL,"
+            "    RentalID INT NULL,"
+            "    ReturnDate DATE NOT NULL,"
+            "    ScheduledDate DATE NULL,"
+            "    HeldThrough DATE NOT NULL,"
+            "    CompletedDate DATE NULL,"
+            "    Status VARCHAR(20) NOT NULL DEFAULT 'Queued',"
+            "    CreatedAt TIMESTAMP DEFAULT CURRENT_TIMESTAMP,"
+            "    FOREIGN KEY (DressID) REFERENCES Dresses(DressID) ON DELETE CASCADE,"
+            "    FOREIGN KEY (RentalID) REFERENCES Rentals(RentalID) ON DELETE SET NULL,"
+            "    INDEX idx_status_dress (Status, DressID)"
+            ")"
+        } },
+        // The last day each rental holds its units: the due date, or today
+        // while an overdue dress is still out (see DressStock). Rebuilds
+        // DressDailyStock, which migration 7 filled only to the due dates and
+        // at most 100 days per rental
+        { 10, "rental_held_through", {
+            "ALTER TABLE Rentals ADD COLUMN IF NOT EXISTS HeldThrough DATE NULL AFTER DueDate",
+            "UPDATE Rentals SET HeldThrough = IF(Status = 'Active', GREATEST(DueDate, CURDATE()), DueDate) "
+            "WHERE HeldThrough IS NULL",
+            "UPDATE DressDailyStock SET Reserved = 0",
+            "INSERT INTO DressDailyStock (DressID, StockDate, Reserved) "
+            "SELECT ri.DressID, DATE_ADD(r.RentalDate, INTERVAL o.n DAY) AS StockDate, COUNT(*) "
+            "FROM Rentals r "
+            "JOIN RentalItems ri ON ri.RentalID = r.RentalID "
+            "JOIN (SELECT h.n * 100 + t.n * 10 + u.n AS n FROM "
+            "      (SELECT 0 AS n UNION ALL SELECT 1 UNION ALL SELECT 2 UNION ALL SELECT 3 UNION ALL SELECT 4 "
+            "       UNION ALL SELECT 5 UNION ALL SELECT 6 UNION ALL SELECT 7 UNION ALL SELECT 8 UNION ALL SELECT 9) h "
+            "      CROSS JOIN "
+            "      (SELECT 0 AS n UNION ALL SELECT 1 UNION ALL SELECT 2 UNION ALL SELECT 3 UNION ALL SELECT 4 "
+            "       UNION ALL SELECT 5 UNION ALL SELECT 6 UNION ALL SELECT 7 UNION ALL SELECT 8 UNION ALL SELECT 9) t "
+            "      CROSS JOIN "
+            "      (SELECT 0 AS n UNION ALL SELECT 1 UNION ALL SELECT 2 UNION ALL SELECT 3 UNION ALL SELECT 4 "
+            "       UNION ALL SELECT 5 UNION ALL SELECT 6 UNION ALL SELECT 7 UNION ALL SELECT 8 UNION ALL SELECT 9) u) o "
+            "  ON o.n <= DATEDIFF(r.HeldThrough, r.RentalDate) "
+            "WHERE r.Status = 'Active' "
+            "GROUP BY ri.DressID, StockDate "
+            "ON DUPLICATE KEY UPDATE Reserved = VALUES(Reserved)",
+            "INSERT INTO DressDailyStock (DressID, StockDate, Reserved) "
+            "SELECT j.DressID, DATE_ADD(j.ReturnDate, INTERVAL o.n DAY) AS StockDate, COUNT(*) "
+            "FROM CleaningJobs j "
+            "JOIN (SELECT h.n * 100 + t.n * 10 + u.n AS n FROM "
+            "      (SELECT 0 AS n UNION ALL SELECT 1 UNION ALL SELECT 2 UNION ALL SELECT 3 UNION ALL SELECT 4 "
+            "       UNION ALL SELECT 5 UNION ALL SELECT 6 UNION ALL SELECT 7 UNION ALL SELECT 8 UNION ALL SELECT 9) h "
+            "      CROSS JOIN "
+            "      (SELECT 0 AS n UNION ALL SELECT 1 UNION ALL SELECT 2 UNION ALL SELECT 3 UNION ALL SELECT 4 "
+            "       UNION ALL SELECT 5 UNION ALL SELECT 6 UNION ALL SELECT 7 UNION ALL SELECT 8 UNION ALL SELECT 9) t "
+            "      CROSS JOIN "
+            "      (SELECT 0 AS n UNION ALL SELECT 1 UNION ALL SELECT 2 UNION ALL SELECT 3 UNION ALL SELECT 4 "
+            "       UNION ALL SELECT 5 UNION ALL SELECT 6 UNION ALL SELECT 7 UNION ALL SELECT 8 UNION ALL SELECT 9) u) o "
+            "  ON o.n <= DATEDIFF(j.HeldThrough, j.ReturnDate) "
+            "WHERE j.Status = 'Queued' "
+            "GROUP BY j.DressID, StockDate "
+            "ON DUPLICATE KEY UPDATE Reserved = Reserved + VALUES(Reserved)"
+        } },
+    };
+    return list;
+}
+
+// 64-bit FNV-1a over the statements, with a separator so moving text from
+// one statement to the next changes the result
+std::string checksum(const Migration& migration) {
+    unsigned long long hash = 14695981039346656037ULL;
+    for (const std::string& statement : migration.statements) {
+        for (char c : statement) {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 1099511628211ULL;
+        }
+        hash ^= 0xFF;
+        hash *= 1099511628211ULL;
+    }
+    char buffer[17];
+    std::snprintf(buffer, sizeof(buffer), "%016llx", hash);
+    return buffer;
+}
+
+void execute(sql::Connection* conn, const std::string& query) {
+    sql::Statement* stmt = conn->createStatement();
+    try {
+        stmt->execute(query);
+    } catch (sql::SQLException&) {
+        delete stmt;
+        throw;
+    }
+    delete stmt;
+}
+
+// First column of the first row, or -1 if there is none or it is NULL
+int queryInt(sql::Connection* conn, const std::string& query) {
+    sql::Statement* stmt = conn->createStatement();
+    sql::ResultSet* res = nullptr;
+    int value = -1;
+    try {
+        res = stmt->executeQuery(query);
+        if (res->next()) {
+            value = res->getInt(1);
+            if (res->wasNull()) value = -1;
+        }
+    } catch (sql::SQLException&) {
+        delete res;
+        delete stmt;
+        throw;
+    }
+    delete res;
+    delete stmt;
+    return value;
+}
+
+bool isLockWaitTimeout(const sql::SQLException& e) {
+    return e.getErrorCode() == 1205;
+}
+
+} // namespace
+
+SchemaMigrator::SchemaMigrator() {}
+
+int SchemaMigrator::latestVersion() {
+    return migrations().back().version;
+}
+
+int SchemaMigrator::pendingCount() const {
+    int pending = 0;
+    for (const Entry& entry : entries) {
+        if (!entry.applied) ++pending;
+    }
+    return pending;
+}
+
+void SchemaMigrator::loadApplied() {
+    entries.clear();
+    unknownVersions.clear();
+    for (const Migration& migration : migrations()) {
+        Entry entry;
+        entry.version = migration.version;
+        entry.name = migration.name;
+        entry.checksum = checksum(migration);
+        entry.applied = false;
+        entry.checksumMismatch = false;
+        entries.push_back(entry);
+    }
+
+    sql::Statement* stmt = DatabaseManager::getInstance().getConnection()->createStatement();
+    sql::ResultSet* res = nullptr;
+    try {
+        res = stmt->executeQuery("SELECT Version, Checksum, AppliedAt FROM SchemaMigrations ORDER BY Version");
+        while (res->next()) {
+            int version = res->getInt("Version");
+            bool known = false;
+            for (Entry& entry : entries) {
+                if (entry.version != version) continue;
+                entry.applied = true;
+                entry.appliedAt = res->getString("AppliedAt");
+                entry.checksumMismatch = res->getString("Checksum") != entry.checksum;
+                known = true;
+            }
+            if (!known) unknownVersions.push_back(version);
+        }
+    } catch (sql::SQLException& e) {
+        delete res;
+        delete stmt;
+        // A database that has never been migrated has no version table yet
+        if (e.getErrorCode() == 1146) return;
+        throw;
+    }
+    delete res;
+    delete stmt;
+}
+
+bool SchemaMigrator::verifyApplied() {
+    bool ok = true;
+    for (const Entry& entry : entries) {
+        if (entry.checksumMismatch) {
+            std::cerr << "Schema migration " << entry.version << " (" << entry.name
+                      << ") was applied with different statements than this build has" << std::endl;
+            ok = false;
+        }
+    }
+    if (!unknownVersions.empty()) {
+        std::cerr << "Warning: the database has schema version " << unknownVersions.back()
+                  << ", newer than this build (" << latestVersion() << ")" << std::endl;
+    }
+    return ok;
+}
+
+bool SchemaMigrator::check() {
+    try {
+        loadApplied();
+        return verifyApplied();
+    } catch (sql::SQLException& e) {
+        std::cerr << "Schema check failed: " << e.what() << std::endl;
+        return false;
+    } catch (const std::exception& e) {
+        std::cerr << "Schema check failed: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+bool SchemaMigrator::migrate() {
+    sql::Connection* conn = nullptr;
+    try {
+        conn = DatabaseManager::getInstance().getConnection();
+    } catch (const std::exception& e) {
+        std::cerr << "Schema migration: " << e.what() << std::endl;
+        return false;
+    }
+
+    bool locked = false;
+    int savedLockWait = -1;
+    bool ok = true;
+    try {
+        locked = queryInt(conn, MIGRATION_LOCK) == 1;
+        if (!locked) {
+            std::cerr << "Schema migration: another instance has held the migration lock for 60 seconds" << std::endl;
+            return false;
+        }
+
+        int lockWait = AppConfig::getInstance().getInt("migration_lock_wait", 10);
+        savedLockWait = queryInt(conn, "SELECT @@SESSION.lock_wait_timeout");
+        execute(conn, "SET SESSION lock_wait_timeout = " + std::to_string(lockWait > 0 ? lockWait : 1));
+        execute(conn, VERSION_TABLE);
+        loadApplied();
+        ok = verifyApplied();
+
+        const std::vector<Migration>& list = migrations();
+        for (size_t m = 0; ok && m < list.size(); ++m) {
+            Entry& entry = entries[m];
+            if (entry.applied) continue;
+            std::chrono::steady_clock::time_point started = std::chrono::steady_clock::now();
+            for (size_t s = 0; ok && s < list[m].statements.size(); ++s) {
+                for (int attempt = 1; ; ++attempt) {
+                    try {
+                        execute(conn, list[m].statements[s]);
+                        break;
+                    } catch (sql::SQLException& e) {
+                        // Waiting on a table lock: back off and let the blocking transaction finish
+                        if (isLockWaitTimeout(e) && attempt < MAX_STATEMENT_ATTEMPTS) {
+                            std::this_thread::sleep_for(std::chrono::seconds(attempt));
+                            continue;
+                        }
+                        std::cerr << "Schema migration " << entry.version << " (" << entry.name
+                                  << ") failed at statement " << (s + 1) << ": " << e.what() << std::endl;
+                        ok = false;
+                        break;
+                    }
+                }
+            }
+            if (!ok) break;
+
+            long long durationMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - started).count();
+            sql::PreparedStatement* pstmt = conn->prepareStatement(
+                "INSERT INTO SchemaMigrations (Version, Name, Checksum, DurationMs) VALUES (?, ?, ?, ?)"
+            );
+            try {
+                pstmt->setInt(1, entry.version);
+                pstmt->setString(2, entry.name);
+                pstmt->setString(3, entry.checksum);
+                pstmt->setInt(4, static_cast<int>(durationMs));
+                pstmt->executeUpdate();
+            } catch (sql::SQLException&) {
+                delete pstmt;
+                throw;
+            }
+            delete pstmt;
+            entry.applied = true;
+        }
+        if (ok) loadApplied();
+    } catch (sql::SQLException& e) {
+        std::cerr << "Schema migration failed: " << e.what() << std::endl;
+        ok = false;
+    }
+
+    try {
+        if (savedLockWait > 0) execute(conn, "SET SESSION lock_wait_timeout = " + std::to_string(savedLockWait));
+        if (locked) queryInt(conn, MIGRATION_UNLOCK);
+    } catch (sql::SQLException& e) {
+        std::cerr << "Schema migration cleanup failed: " << e.what() << std::endl;
+    }
+    return ok;
+}
+
+void SchemaMigrator::printStatus(std::ostream& out) {
+    TableRenderer table(SCREEN_WIDTH);
+    table.addColumn("Version", 0, 0, TableRenderer::ALIGN_RIGHT);
+    table.addColumn("Migration", 12);
+    table.addColumn("Checksum", 16);
+    table.addColumn("Status", 10);
+    for (const Entry& entry : entries) {
+        std::string status;
+        if (entry.checksumMismatch) {
+            status = UIColors::colorize("CHECKSUM MISMATCH", UIColors::BOLD + UIColors::RED);
+        } else if (entry.applied) {
+            status = UIColors::colorize("applied " + entry.appliedAt, UIColors::GREEN);
+        } else {
+            status = UIColors::colorize("pending", UIColors::YELLOW);
+        }
+        table.addRow({ std::to_string(entry.version), entry.name, entry.checksum, status });
+    }
+    table.render(out);
+    for (int version : unknownVersions) {
+        out << UIColors::colorize("Version " + std::to_string(version) + " is applied but unknown to this build",
+                                  UIColors::YELLOW) << '\n';
+    }
+}
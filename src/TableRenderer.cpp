@@ -0,0 +1,215 @@
+#include "TableRenderer.h"
+#include "UIColors.h"
+#include <algorithm>
+#include <utility>
+
+namespace {
+
+// Appends text that is known to be wider than width, cut down to width - 1
+// visible columns plus a '.' marker. Escape sequences are copied whole and a
+// reset is appended if any were seen, so a cut colored cell cannot bleed into
+// the border.
+void appendCut(std::string& result, const std::string& text, int width) {
+    if (width <= 0) return;
+    int keep = width - 1;
+    int count = 0;
+    bool sawEscape = false;
+    for (size_t i = 0; i < text.size(); ++i) {
+        unsigned char c = static_cast<unsigned char>(text[i]);
+        if (c == 0x1b && i + 1 < text.size() && text[i + 1] == '[') {
+            size_t start = i;
+            i += 2;
+            while (i < text.size() && (static_cast<unsigned char>(text[i]) < 0x40 ||
+                                       static_cast<unsigned char>(text[i]) > 0x7e)) {
+                ++i;
+            }
+            result.append(text, start, i - start + 1);
+            sawEscape = true;
+            continue;
+        }
+        if ((c & 0xc0) != 0x80) {
+            if (count == keep) break;
+            ++count;
+        }
+        result += text[i];
+    }
+    if (sawEscape) result += UIColors::RESET;
+    result += '.';
+}
+
+} // namespace
+
+TableRenderer::TableRenderer(int maxWidth) : maxWidth(maxWidth), padding(0), stream(nullptr) {}
+
+void TableRenderer::addColumn(const std::string& header, int minWidth, int maxWidth, Align align) {
+    Column column;
+    column.header = header;
+    column.headerWidth = UIColors::visibleWidth(header);
+    column.minWidth = minWidth;
+    column.maxWidth = maxWidth;
+    column.align = align;
+    column.width = 0;
+    columns.push_back(column);
+}
+
+void TableRenderer::storeCell(std::string&& text) {
+    Cell cell;
+    cell.width = UIColors::visibleWidth(text);
+    cell.text = std::move(text);
+    cells.push_back(std::move(cell));
+}
+
+void TableRenderer::addRow(const std::vector<std::string>& row) {
+    for (size_t c = 0; c < columns.size(); ++c) {
+        storeCell(c < row.size() ? std::string(row[c]) : std::string());
+    }
+}
+
+void TableRenderer::addRow(std::vector<std::string>&& row) {
+    for (size_t c = 0; c < columns.size(); ++c) {
+        storeCell(c < row.size() ? std::move(row[c]) : std::string());
+    }
+}
+
+std::string TableRenderer::truncate(const std::string& text, int width) {
+    if (UIColors::visibleWidth(text) <= width) return text;
+    std::string result;
+    appendCut(result, text, width);
+    return result;
+}
+
+void TableRenderer::fitColumns() {
+    int available = maxWidth > 0 ? maxWidth - static_cast<int>(columns.size()) - 1 : 0;
+    int total = 0;
+    for (Column& column : columns) {
+        if (column.maxWidth > 0) column.width = std::min(column.width, column.maxWidth);
+        column.width = std::max(column.width, column.minWidth);
+        if (available > 0) column.width = std::min(column.width, available);
+        if (column.width < 2) column.width = 2;
+        total += column.width;
+    }
+
+    // Narrow the widest column one step at a time until the table fits; a column
+    // stops at its minWidth, or at its header width when it has none
+    while (available > 0 && total > available) {
+        Column* widest = nullptr;
+        for (Column& column : columns) {
+            int floor = column.minWidth > 0 ? column.minWidth : std::min(column.headerWidth + 1, column.width);
+            if (column.width > std::max(floor, 2) && (!widest || column.width > widest->width)) widest = &column;
+        }
+        if (!widest) break;
+        --widest->width;
+        --total;
+    }
+
+    int tableWidth = total + static_cast<int>(columns.size()) + 1;
+    padding = maxWidth > tableWidth ? (maxWidth - tableWidth) / 2 : 0;
+}
+
+void TableRenderer::buildBorder() {
+    border.assign(padding, ' ');
+    border += '+';
+    for (const Column& column : columns) {
+        border.append(column.width, '-');
+        border += '+';
+    }
+    border += '\n';
+}
+
+void TableRenderer::appendCell(const Column& column, const std::string& text, int width) {
+    // The last column of each cell is the gap to the next border
+    int limit = column.width - 1;
+    if (width > limit) {
+        // A cut cell is exactly limit columns wide
+        if (column.align == ALIGN_RIGHT) line += ' ';
+        appendCut(line, text, limit);
+        if (column.align != ALIGN_RIGHT) line += ' ';
+    } else if (column.align == ALIGN_RIGHT) {
+        line.append(column.width - width, ' ');
+        line += text;
+    } else {
+        line += text;
+        line.append(column.width - width, ' ');
+    }
+    line += '|';
+}
+
+void TableRenderer::writeHeader() {
+    buildBorder();
+    line.assign(padding, ' ');
+    line += '|';
+    for (const Column& column : columns) {
+        int limit = column.width - 1;
+        std::string header = truncate(column.header, limit);
+        int width = std::min(column.headerWidth, limit);
+        line += UIColors::colorize(header, UIColors::BOLD + UIColors::CYAN);
+        line.append(column.width - width, ' ');
+        line += '|';
+    }
+    line += '\n';
+    *stream << border << line << border;
+}
+
+void TableRenderer::writeRow(const Cell* row) {
+    line.assign(padding, ' ');
+    line += '|';
+    for (size_t c = 0; c < columns.size(); ++c) {
+        appendCell(columns[c], row[c].text, row[c].width);
+    }
+    line += '\n';
+    stream->write(line.data(), static_cast<std::streamsize>(line.size()));
+}
+
+void TableRenderer::render(std::ostream& os) {
+    if (columns.empty()) return;
+    stream = &os;
+    for (Column& column : columns) column.width = column.headerWidth + 1;
+    for (size_t i = 0; i < cells.size(); ++i) {
+        Column& column = columns[i % columns.size()];
+        column.width = std::max(column.width, cells[i].width + 1);
+    }
+    fitColumns();
+    writeHeader();
+    for (size_t i = 0; i < cells.size(); i += columns.size()) {
+        writeRow(&cells[i]);
+    }
+    *stream << border;
+    stream = nullptr;
+}
+
+void TableRenderer::render() {
+    render(UIColors::out());
+}
+
+void TableRenderer::beginStream(std::ostream& os) {
+    if (columns.empty()) return;
+    stream = &os;
+    for (Column& column : columns) {
+        column.width = column.minWidth > 0 ? column.minWidth : column.headerWidth + 1;
+    }
+    fitColumns();
+    writeHeader();
+}
+
+void TableRenderer::beginStream() {
+    beginStream(UIColors::out());
+}
+
+void TableRenderer::streamRow(const std::vector<std::string>& row) {
+    if (!stream) return;
+    static const std::string empty;
+    line.assign(padding, ' ');
+    line += '|';
+    for (size_t c = 0; c < columns.size(); ++c) {
+        const std::string& text = c < row.size() ? row[c] : empty;
+        appendCell(columns[c], text, UIColors::visibleWidth(text));
+    }
+    line += '\n';
+    stream->write(line.data(), static_cast<std::streamsize>(line.size()));
+}
+
+void TableRenderer::endStream() {
+    if (!stream) return;
+    *stream << border;
+    stream = nullptr;
+}
@@ -0,0 +1,149 @@
+#include "Trace.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <vector>
+
+struct TraceEvent {
+    const char* name;
+    long long value;
+    uint64_t id;
+    uint64_t parent;
+    uint64_t startNs;
+    uint64_t durationNs;
+};
+
+struct TraceBuffer {
+    TraceEvent* events;             // RING_SIZE entries, written only by the owner
+    std::atomic<uint64_t> written;  // total spans ever recorded
+    uint64_t nextId;
+    uint64_t currentSpan;           // innermost open span, parent of the next one
+    uint32_t threadIndex;
+};
+
+namespace {
+
+std::mutex& buffersMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+std::vector<TraceBuffer*>& allBuffers() {
+    static std::vector<TraceBuffer*> buffers;
+    return buffers;
+}
+
+uint64_t nowNs() {
+    static const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - epoch).count());
+}
+
+void exportAtExit() {
+    const char* path = std::getenv("DRS_TRACE");
+    if (path && *path) Trace::exportChromeTrace(path);
+}
+
+bool initFromEnv() {
+    const char* path = std::getenv("DRS_TRACE");
+    if (!path || !*path) return false;
+    // Construct the registry before registering the handler so it outlives it
+    allBuffers();
+    buffersMutex();
+    nowNs();
+    std::atexit(exportAtExit);
+    return true;
+}
+
+} // namespace
+
+std::atomic<bool> Trace::enabledFlag(initFromEnv());
+
+void Trace::setEnabled(bool on) {
+    allBuffers();
+    buffersMutex();
+    nowNs();
+    enabledFlag.store(on, std::memory_order_relaxed);
+}
+
+TraceBuffer* Trace::threadBuffer() {
+    static thread_local TraceBuffer* buffer = nullptr;
+    if (!buffer) {
+        // Allocated once per thread and kept after it exits so export still sees its spans
+        buffer = new TraceBuffer();
+        buffer->events = new TraceEvent[RING_SIZE];
+        buffer->written.store(0, std::memory_order_relaxed);
+        buffer->nextId = 0;
+        buffer->currentSpan = 0;
+        std::lock_guard<std::mutex> lock(buffersMutex());
+        buffer->threadIndex = static_cast<uint32_t>(allBuffers().size() + 1);
+        allBuffers().push_back(buffer);
+    }
+    return buffer;
+}
+
+TraceSpan::TraceSpan(const char* name, long long value)
+    : name(name), value(value), buffer(nullptr), id(0), parent(0), startNs(0) {
+    if (!Trace::enabled()) return;
+    buffer = Trace::threadBuffer();
+    id = (static_cast<uint64_t>(buffer->threadIndex) << 40) | ++buffer->nextId;
+    parent = buffer->currentSpan;
+    buffer->currentSpan = id;
+    startNs = nowNs();
+}
+
+TraceSpan::~TraceSpan() {
+    if (!buffer) return;
+    uint64_t endNs = nowNs();
+    uint64_t index = buffer->written.load(std::memory_order_relaxed);
+    TraceEvent& event = buffer->events[index % Trace::RING_SIZE];
+    event.name = name;
+    event.value = value;
+    event.id = id;
+    event.parent = parent;
+    event.startNs = startNs;
+    event.durationNs = endNs - startNs;
+    buffer->written.store(index + 1, std::memory_order_release);
+    buffer->currentSpan = parent;
+}
+
+bool Trace::exportChromeTrace(const std::string& path) {
+    std::vector<TraceBuffer*> buffers;
+    {
+        std::lock_guard<std::mutex> lock(buffersMutex());
+        buffers = allBuffers();
+    }
+
+    FILE* out = std::fopen(path.c_str(), "w");
+    if (!out) {
+        std::cerr << "Error: cannot write trace file " << path << std::endl;
+        return false;
+    }
+    std::fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", out);
+    bool first = true;
+    for (TraceBuffer* buffer : buffers) {
+        uint64_t written = buffer->written.load(std::memory_order_acquire);
+        uint64_t begin = written > RING_SIZE ? written - RING_SIZE : 0;
+        for (uint64_t i = begin; i < written; ++i) {
+            const TraceEvent& event = buffer->events[i % RING_SIZE];
+            // Category is the prefix before the first dot: "rental.createRental" -> "rental"
+            const char* dot = std::strchr(event.name, '.');
+            int categoryLength = dot ? static_cast<int>(dot - event.name) : static_cast<int>(std::strlen(event.name));
+            std::fprintf(out,
+                         "%s\n{\"name\":\"%s\",\"cat\":\"%.*s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,"
+                         "\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"id\":%llu,\"parent\":%llu",
+                         first ? "" : ",", event.name, categoryLength, event.name, buffer->threadIndex,
+                         event.startNs / 1000.0, event.durationNs / 1000.0,
+                         static_cast<unsigned long long>(event.id), static_cast<unsigned long long>(event.parent));
+            if (event.value >= 0) std::fprintf(out, ",\"value\":%lld", event.value);
+            std::fputs("}}", out);
+            first = false;
+        }
+    }
+    std::fputs("\n]}\n", out);
+    std::fclose(out);
+    return true;
+}
@@ -3,10 +3,18 @@
 #include <iostream>
 #include <iomanip>
 #include <sstream>
+#include <cstdio>
+#include <cstdlib>
+#include <cerrno>
 
 #ifdef _WIN32
 #define NOMINMAX  // Prevent Windows.h from defining min/max macros
 #include <windows.h>
+#include <io.h>
+#define isatty _isatty
+#define fileno _fileno
+#else
+#include <unistd.h>
 #endif
 
 bool UIColors::colors_enabled = true;
@@ -56,144 +64,225 @@ bool UIColors::colorsEnabled() {
     return colors_enabled;
 }
 
+void UIColors::configureForTerminal() {
+    const char* noColor = std::getenv("NO_COLOR");
+    if ((noColor && *noColor) || !isatty(fileno(stdout))) {
+        disableColors();
+    } else {
+        enableColors();
+    }
+}
+
+namespace {
+
+// Appends to a std::string; endl/flush on the frame stream are no-ops
+class FrameBuffer : public std::streambuf {
+public:
+    std::string data;
+    
+protected:
+    int overflow(int c) override {
+        if (c != EOF) data += static_cast<char>(c);
+        return c;
+    }
+    std::streamsize xsputn(const char* s, std::streamsize n) override {
+        data.append(s, static_cast<size_t>(n));
+        return n;
+    }
+};
+
+struct Frame {
+    FrameBuffer buffer;
+    std::ostream stream;
+    int depth;
+    Frame() : stream(&buffer), depth(0) {
+        buffer.data.reserve(64 * 1024);
+    }
+};
+
+Frame& threadFrame() {
+    static thread_local Frame frame;
+    return frame;
+}
+
+// The console buffer std::cout started with; if something else has been
+// installed (e.g. output silenced by a tool) frames go through std::cout
+std::streambuf* const consoleBuffer = std::cout.rdbuf();
+
+void writeToStdout(const std::string& data) {
+    if (data.empty()) return;
+    std::cout.flush(); // keep anything written outside the frame in order
+#ifndef _WIN32
+    if (std::cout.rdbuf() == consoleBuffer) {
+        std::fflush(stdout);
+        const char* p = data.data();
+        size_t remaining = data.size();
+        while (remaining > 0) {
+            ssize_t n = ::write(STDOUT_FILENO, p, remaining);
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                return;
+            }
+            p += n;
+            remaining -= static_cast<size_t>(n);
+        }
+        return;
+    }
+#endif
+    std::cout.write(data.data(), static_cast<std::streamsize>(data.size()));
+    std::cout.flush();
+}
+
+} // namespace
+
+void UIColors::beginFrame() {
+    threadFrame().depth++;
+}
+
+void UIColors::endFrame() {
+    Frame& frame = threadFrame();
+    if (frame.depth == 0) return;
+    if (--frame.depth > 0) return;
+    writeToStdout(frame.buffer.data);
+    frame.buffer.data.clear();
+}
+
+std::ostream& UIColors::out() {
+    Frame& frame = threadFrame();
+    return frame.depth > 0 ? frame.stream : std::cout;
+}
+
+int UIColors::visibleWidth(const std::string& text) {
+    int width = 0;
+    for (size_t i = 0; i < text.size(); ++i) {
+        unsigned char c = static_cast<unsigned char>(text[i]);
+        if (c == 0x1b && i + 1 < text.size() && text[i + 1] == '[') {
+            // Skip CSI sequence up to its final byte (0x40-0x7e)
+            i += 2;
+            while (i < text.size() && (static_cast<unsigned char>(text[i]) < 0x40 ||
+                                       static_cast<unsigned char>(text[i]) > 0x7e)) {
+                ++i;
+            }
+            continue;
+        }
+        if ((c & 0xc0) != 0x80) ++width; // count lead bytes only
+    }
+    return width;
+}
+
+void UIColors::writeLine(const std::string& color, const std::string& text) {
+    std::ostream& os = out();
+    if (colors_enabled && !color.empty()) {
+        os << color << text << RESET << '\n';
+    } else {
+        os << text << '\n';
+    }
+}
+
 void UIColors::printCentered(const std::string& text, int width, const std::string& color) {
     // Handle long text by splitting into multiple lines
-    if (text.length() > static_cast<size_t>(width - 4)) {
+    if (visibleWidth(text) > width - 4) {
         // Split long text
         std::istringstream iss(text);
         std::string word;
         std::string line;
         
         while (iss >> word) {
-            if ((line + word).length() < static_cast<size_t>(width - 4)) {
+            if (visibleWidth(line) + visibleWidth(word) < width - 4) {
                 if (!line.empty()) line += " ";
                 line += word;
             } else {
                 if (!line.empty()) {
-                    int padding = (width - static_cast<int>(line.length())) / 2;
+                    int padding = (width - visibleWidth(line)) / 2;
                     if (padding < 0) padding = 0;
-                    std::string output = std::string(padding, ' ') + line;
-                    if (colors_enabled && !color.empty()) {
-                        std::cout << color << output << RESET << std::endl;
-                    } else {
-                        std::cout << output << std::endl;
-                    }
+                    writeLine(color, std::string(padding, ' ') + line);
                 }
                 line = word;
             }
         }
         if (!line.empty()) {
-            int padding = (width - static_cast<int>(line.length())) / 2;
+            int padding = (width - visibleWidth(line)) / 2;
             if (padding < 0) padding = 0;
-            std::string output = std::string(padding, ' ') + line;
-            if (colors_enabled && !color.empty()) {
-                std::cout << color << output << RESET << std::endl;
-            } else {
-                std::cout << output << std::endl;
-            }
+            writeLine(color, std::string(padding, ' ') + line);
         }
     } else {
-    int padding = (width - static_cast<int>(text.length())) / 2;
-    if (padding < 0) padding = 0;
-    
-    std::string output = std::string(padding, ' ') + text;
-    if (colors_enabled && !color.empty()) {
-        std::cout << color << output << RESET << std::endl;
-    } else {
-        std::cout << output << std::endl;
-        }
+        int padding = (width - visibleWidth(text)) / 2;
+        if (padding < 0) padding = 0;
+        writeLine(color, std::string(padding, ' ') + text);
     }
 }
 
 void UIColors::printHeader(const std::string& title, int width) {
+    static const std::string BOLD_CYAN = BOLD + CYAN;
+    RenderFrame frame;
     printSeparator(width);
-    printCentered(title, width, BOLD + CYAN);
+    printCentered(title, width, BOLD_CYAN);
     printSeparator(width);
 }
 
 void UIColors::printSeparator(int width, char ch) {
-    std::string sep(width, ch);
-    if (colors_enabled) {
-        std::cout << CYAN << sep << RESET << std::endl;
+    // The default separator is drawn on nearly every screen; build it once
+    static const std::string DEFAULT_SEPARATOR(SCREEN_WIDTH, '=');
+    if (width == SCREEN_WIDTH && ch == '=') {
+        writeLine(CYAN, DEFAULT_SEPARATOR);
     } else {
-        std::cout << sep << std::endl;
+        writeLine(CYAN, std::string(width, ch));
     }
 }
 
 void UIColors::printSuccess(const std::string& message) {
-    std::string fullMessage = "[SUCCESS] " + message;
-    if (colors_enabled) {
-        printCentered(fullMessage, 80, GREEN);
-    } else {
-        printCentered(fullMessage, 80);
-    }
+    printCentered("[SUCCESS] " + message, 80, GREEN);
 }
 
 void UIColors::printError(const std::string& message) {
-    std::string fullMessage = "[ERROR] " + message;
-    if (colors_enabled) {
-        printCentered(fullMessage, 80, RED);
-    } else {
-        printCentered(fullMessage, 80);
-    }
+    printCentered("[ERROR] " + message, 80, RED);
 }
 
 void UIColors::printWarning(const std::string& message) {
-    std::string fullMessage = "[WARNING] " + message;
-    if (colors_enabled) {
-        printCentered(fullMessage, 80, YELLOW);
-    } else {
-        printCentered(fullMessage, 80);
-    }
+    printCentered("[WARNING] " + message, 80, YELLOW);
 }
 
 void UIColors::printInfo(const std::string& message) {
-    std::string fullMessage = "[INFO] " + message;
-    if (colors_enabled) {
-        printCentered(fullMessage, 80, BLUE);
-    } else {
-        printCentered(fullMessage, 80);
-    }
+    printCentered("[INFO] " + message, 80, BLUE);
 }
 
 void UIColors::printMenuOption(int num, const std::string& text) {
-    std::ostringstream oss;
-    oss << num << ". " << text;
+    int padding = (SCREEN_WIDTH - visibleWidth(text) - 6) / 2;
+    if (padding < 0) padding = 0;
+    std::ostream& os = out();
     if (colors_enabled) {
-        int padding = (SCREEN_WIDTH - static_cast<int>(text.length()) - 6) / 2;
-        if (padding < 0) padding = 0;
-        std::string output = std::string(padding, ' ') + std::to_string(num) + ". " + text;
-        std::cout << std::string(padding, ' ') << CYAN << std::to_string(num) << RESET << ". " << WHITE << text << RESET << std::endl;
+        os << std::string(padding, ' ') << CYAN << num << RESET << ". " << WHITE << text << RESET << '\n';
     } else {
-        int padding = (SCREEN_WIDTH - static_cast<int>(text.length()) - 6) / 2;
-        if (padding < 0) padding = 0;
-        std::cout << std::string(padding, ' ') << std::setw(3) << num << ". " << text << std::endl;
+        os << std::string(padding, ' ') << std::setw(3) << num << ". " << text << '\n';
     }
 }
 
 std::string UIColors::colorize(const std::string& text, const std::string& color) {
     if (colors_enabled) {
-        return color + text + RESET;
+        std::string result;
+        result.reserve(color.size() + text.size() + RESET.size());
+        result += color;
+        result += text;
+        result += RESET;
+        return result;
     }
     return text;
 }
 
 std::string UIColors::bold(const std::string& text) {
-    if (colors_enabled) {
-        return BOLD + text + RESET;
-    }
-    return text;
+    return colorize(text, BOLD);
 }
 
 void UIColors::printCenteredInput(const std::string& prompt, int width, const std::string& color) {
-    int padding = (width - static_cast<int>(prompt.length())) / 2;
+    int padding = (width - visibleWidth(prompt)) / 2;
     if (padding < 0) padding = 0;
     
+    // A prompt must reach the screen before we block on input
+    std::ostream& os = out();
     std::string output = std::string(padding, ' ') + prompt;
     if (colors_enabled && !color.empty()) {
-        std::cout << color << output << RESET << std::flush;
+        os << color << output << RESET << std::flush;
     } else {
-        std::cout << output << std::flush;
+        os << output << std::flush;
     }
 }
-
@@ -0,0 +1,67 @@
+#include "WorkerPool.h"
+#include "DatabaseManager.h"
+#include <exception>
+#include <iostream>
+
+WorkerPool::WorkerPool() : running(0), stopRequested(false) {}
+
+WorkerPool::~WorkerPool() {
+    stop();
+}
+
+void WorkerPool::start(int threadCount) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!threads.empty()) return;
+    stopRequested = false;
+    for (int i = 0; i < threadCount; ++i) threads.push_back(std::thread(&WorkerPool::threadMain, this));
+}
+
+void WorkerPool::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (threads.empty()) return;
+        stopRequested = true;
+    }
+    taskReady.notify_all();
+    for (size_t i = 0; i < threads.size(); ++i) threads[i].join();
+    threads.clear();
+}
+
+void WorkerPool::submit(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.push_back(std::move(task));
+    }
+    taskReady.notify_one();
+}
+
+size_t WorkerPool::queued() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return tasks.size();
+}
+
+int WorkerPool::busy() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return running;
+}
+
+void WorkerPool::threadMain() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        taskReady.wait(lock, [this] { return stopRequested || !tasks.empty(); });
+        if (tasks.empty()) break;
+        std::function<void()> task = std::move(tasks.front());
+        tasks.pop_front();
+        ++running;
+        lock.unlock();
+        try {
+            task();
+        } catch (const std::exception& e) {
+            std::cerr << "Worker task failed: " << e.what() << std::endl;
+        }
+        lock.lock();
+        --running;
+    }
+    lock.unlock();
+    DatabaseManager::getInstance().releaseThreadConnection();
+}
@@ -6,10 +6,47 @@
 #include "AuthManager.h"
 #include "ReportManager.h"
 #include "DressManager.h"
+#include "OverdueSweeper.h"
+#include "CleaningScheduler.h"
+#include "IndexAdvisor.h"
+#include "SchemaMigrator.h"
+#include "AppConfig.h"
 #include "MenuHandlers.h"
+#include "RentalServer.h"
+#include "RentalClient.h"
+#include "HttpServer.h"
+#include <csignal>
 
-int main() {
-    UIColors::enableColors();
+namespace {
+
+RentalServer* activeServer = nullptr;
+HttpServer* activeHttpServer = nullptr;
+
+void stopServer(int) {
+    if (activeServer) activeServer->stop();
+    if (activeHttpServer) activeHttpServer->stop();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    UIColors::configureForTerminal();
+    bool checkIndexes = false;
+    bool migrateOnly = false;
+    bool serverMode = false;
+    bool clientMode = false;
+    bool httpMode = false;
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]) == "--no-color") UIColors::disableColors();
+        if (std::string(argv[i]) == "--check-indexes") checkIndexes = true;
+        if (std::string(argv[i]) == "--migrate") migrateOnly = true;
+        if (std::string(argv[i]) == "--server") serverMode = true;
+        if (std::string(argv[i]) == "--client") clientMode = true;
+        if (std::string(argv[i]) == "--http") httpMode = true;
+    }
+    
+    // A terminal of a running server needs no database of its own
+    if (clientMode) return RentalClient::runTerminal(RentalServer::socketPathFromConfig());
     
     UIColors::printSeparator(SCREEN_WIDTH);
     UIColors::printCentered("Initializing Dress Rental Management System...", SCREEN_WIDTH, UIColors::CYAN);
@@ -18,7 +55,7 @@ int main() {
     try {
         if (!DatabaseManager::getInstance().connect()) {
             UIColors::printError("Failed to connect to database. Please ensure MySQL is running and database exists.");
-            UIColors::printInfo("Database: dress_rental_db, User: root, Password: (empty)");
+            UIColors::printInfo("Database: " + DatabaseManager::getInstance().describeTarget());
             InputValidator::pause();
             return 1;
         }
@@ -30,12 +67,100 @@ int main() {
         return 1;
     }
     
+    // Bring the schema up to the version this build expects before anything uses it
+    SchemaMigrator migrator;
+    if (!migrator.check()) {
+        DatabaseManager::getInstance().disconnect();
+        return 1;
+    }
+    int pending = migrator.pendingCount();
+    if (pending > 0 && (migrateOnly || AppConfig::getInstance().getBool("migrate_on_start", true))) {
+        if (!migrator.migrate()) {
+            UIColors::printError("Database schema migration failed; the application cannot start.");
+            if (!migrateOnly) InputValidator::pause();
+            DatabaseManager::getInstance().disconnect();
+            return 1;
+        }
+        UIColors::printSuccess("Applied " + std::to_string(pending) + " schema migration(s).");
+    } else if (pending > 0) {
+        UIColors::printError(std::to_string(pending) + " schema migration(s) pending and migrate_on_start is off.");
+        UIColors::printInfo("Run ./rental_system --migrate as a user with ALTER privileges.");
+        InputValidator::pause();
+        DatabaseManager::getInstance().disconnect();
+        return 1;
+    }
+    if (migrateOnly) {
+        migrator.printStatus(std::cout);
+        DatabaseManager::getInstance().disconnect();
+        return 0;
+    }
+    
+    // Non-interactive check for scripts: exit status 3 if a hot query scans
+    if (checkIndexes) {
+        IndexAdvisor advisor;
+        bool analyzed = advisor.analyze();
+        if (analyzed) advisor.printReport(std::cout);
+        DatabaseManager::getInstance().disconnect();
+        return !analyzed ? 1 : (advisor.problemCount() > 0 ? 3 : 0);
+    }
+    
+    // Daemon for terminals: each of them logs in over the socket instead
+    if (serverMode) {
+        RentalServer server(RentalServer::socketPathFromConfig(), RentalServer::workersFromConfig());
+        if (!server.start()) {
+            DatabaseManager::getInstance().disconnect();
+            return 1;
+        }
+        activeServer = &server;
+        std::signal(SIGINT, stopServer);
+        std::signal(SIGTERM, stopServer);
+        OverdueSweeper::getInstance().start(OverdueSweeper::intervalFromConfig());
+        CleaningScheduler::getInstance().start(CleaningScheduler::intervalFromConfig());
+        UIColors::printSuccess("Serving terminals on " + RentalServer::socketPathFromConfig() + " with " +
+                               std::to_string(RentalServer::workersFromConfig()) + " workers; Ctrl+C stops.");
+        server.run();
+        activeServer = nullptr;
+        OverdueSweeper::getInstance().stop();
+        CleaningScheduler::getInstance().stop();
+        DatabaseManager::getInstance().disconnect();
+        return 0;
+    }
+    
+    // JSON API for the web front-end and kiosks; sessions come from POST /api/login
+    if (httpMode) {
+        HttpServer server(HttpServer::addressFromConfig(), HttpServer::portFromConfig(),
+                          RentalServer::workersFromConfig());
+        if (!server.start()) {
+            DatabaseManager::getInstance().disconnect();
+            return 1;
+        }
+        activeHttpServer = &server;
+        std::signal(SIGINT, stopServer);
+        std::signal(SIGTERM, stopServer);
+        OverdueSweeper::getInstance().start(OverdueSweeper::intervalFromConfig());
+        CleaningScheduler::getInstance().start(CleaningScheduler::intervalFromConfig());
+        UIColors::printSuccess("Serving the HTTP API on http://" + HttpServer::addressFromConfig() + ":" +
+                               std::to_string(HttpServer::portFromConfig()) + "/api/ with " +
+                               std::to_string(RentalServer::workersFromConfig()) + " workers; Ctrl+C stops.");
+        server.run();
+        activeHttpServer = nullptr;
+        OverdueSweeper::getInstance().stop();
+        CleaningScheduler::getInstance().stop();
+        DatabaseManager::getInstance().disconnect();
+        return 0;
+    }
+    
     // Require login
     if (!showLoginScreen()) {
         DatabaseManager::getInstance().disconnect();
         return 1;
     }
     
+    // Late fees, dashboard counters and reminders are kept current in the background
+    OverdueSweeper::getInstance().start(OverdueSweeper::intervalFromConfig());
+    // Returned dresses are planned into the cleaning capacity as they come back
+    CleaningScheduler::getInstance().start(CleaningScheduler::intervalFromConfig());
+    
     AuthManager auth;
     int choice;
     
@@ -104,6 +229,8 @@ int main() {
     }
     
     auth.logout();
+    OverdueSweeper::getInstance().stop();
+    CleaningScheduler::getInstance().stop();
     DatabaseManager::getInstance().disconnect();
     return 0;
 }
@@ -0,0 +1,536 @@
+// Synthetic data generator for the Dress Rental Management System.
+//
+// Produces tab-separated files for every table plus a load.sql script that
+// bulk-loads them with LOAD DATA LOCAL INFILE. Output is fully determined by
+// --seed and --as-of, so two runs with the same arguments produce identical files.
+//
+// Usage:
+//   ./datagen --customers 1000000 --dresses 50000 --rentals 3000000 --out gen/
+//   cd gen && mysql --local-infile=1 -u root dress_rental_db < load.sql
+//
+// The load script TRUNCATEs the tables first; run it against a scratch database.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cctype>
+#include <cstdint>
+#include <cmath>
+#include <ctime>
+#include <string>
+#include <vector>
+#include <random>
+#include <iostream>
+#include <algorithm>
+
+namespace {
+
+struct Options {
+    long users = 20;
+    long customers = 100000;
+    long dresses = 20000;
+    long rentals = 300000;
+    int days = 730;              // history length ending at asOf
+    unsigned long long seed = 20250101ULL;
+    std::string asOf;            // YYYY-MM-DD, defaults to today
+    std::string outDir = ".";
+};
+
+// ---- Date helpers (days since 1970-01-01, proleptic Gregorian) ----
+
+long daysFromCivil(int y, int m, int d) {
+    y -= m <= 2;
+    const long era = (y >= 0 ? y : y - 399) / 400;
+    const unsigned yoe = static_cast<unsigned>(y - era * 400);
+    const unsigned doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + static_cast<long>(doe) - 719468;
+}
+
+void civilFromDays(long z, int& y, int& m, int& d) {
+    z += 719468;
+    const long era = (z >= 0 ? z : z - 146096) / 146097;
+    const unsigned doe = static_cast<unsigned>(z - era * 146097);
+    const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const unsigned mp = (5 * doy + 2) / 153;
+    d = static_cast<int>(doy - (153 * mp + 2) / 5 + 1);
+    m = static_cast<int>(mp < 10 ? mp + 3 : mp - 9);
+    y = static_cast<int>(yoe) + static_cast<int>(era * 400) + (m <= 2);
+}
+
+std::string formatDate(long day) {
+    int y, m, d;
+    civilFromDays(day, y, m, d);
+    char buf[16];
+    std::snprintf(buf, sizeof(buf), "%04d-%02d-%02d", y, m, d);
+    return buf;
+}
+
+bool parseDate(const std::string& s, long& day) {
+    int y, m, d;
+    if (std::sscanf(s.c_str(), "%4d-%2d-%2d", &y, &m, &d) != 3) return false;
+    if (m < 1 || m > 12 || d < 1 || d > 31) return false;
+    day = daysFromCivil(y, m, d);
+    return true;
+}
+
+long todayDays() {
+    std::time_t now = std::time(nullptr);
+    std::tm tmNow;
+#ifdef _WIN32
+    localtime_s(&tmNow, &now);
+#else
+    localtime_r(&now, &tmNow);
+#endif
+    return daysFromCivil(tmNow.tm_year + 1900, tmNow.tm_mon + 1, tmNow.tm_mday);
+}
+
+// ---- Reference data ----
+
+const char* FIRST_NAMES[] = {
+    "Ahmad", "Siti", "Nur", "Muhammad", "Aisyah", "Farah", "Lim", "Tan", "Wong", "Lee",
+    "Priya", "Kavitha", "Ravi", "Arjun", "Mei Ling", "Hui Min", "Jia Wei", "Nurul", "Hafiz", "Aina",
+    "Daniel", "Sarah", "Amirah", "Iskandar", "Zarina", "Deepa", "Vijay", "Chong", "Yasmin", "Hana"
+};
+const char* LAST_NAMES[] = {
+    "Abdullah", "Rahman", "Ismail", "Hassan", "Ibrahim", "Yusof", "Wei Ming", "Chee Keong", "Kok Leong",
+    "Devi", "Kumar", "Subramaniam", "Omar", "Aziz", "Karim", "Hamid", "Ling", "Yap", "Goh", "Ong"
+};
+const char* STREETS[] = {
+    "Jalan Merdeka", "Jalan Ampang", "Jalan Bukit Bintang", "Jalan Tun Razak", "Jalan Pudu",
+    "Jalan Sultan Ismail", "Jalan Raja Chulan", "Jalan Ipoh", "Jalan Klang Lama", "Jalan Cheras"
+};
+const char* CITIES[] = {
+    "Kuala Lumpur", "Petaling Jaya", "Shah Alam", "Subang Jaya", "Klang", "Putrajaya",
+    "Seremban", "Ipoh", "Johor Bahru", "Melaka"
+};
+const int STATE_CODES[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14 };
+
+struct Category { const char* name; double basePrice; double weight; };
+const Category CATEGORIES[] = {
+    { "Evening", 150.0, 18 }, { "Formal", 130.0, 14 }, { "Wedding", 320.0, 10 },
+    { "Casual", 80.0, 16 }, { "Cocktail", 120.0, 12 }, { "Traditional", 110.0, 14 },
+    { "Party", 100.0, 10 }, { "Vintage", 140.0, 6 }
+};
+const char* STYLES[] = { "Gown", "Maxi Dress", "Sheath Dress", "A-Line Dress", "Kebaya", "Baju Kurung",
+                         "Cheongsam", "Ball Gown", "Slip Dress", "Jumpsuit", "Wrap Dress", "Mermaid Gown" };
+const char* ADJECTIVES[] = { "Elegant", "Classic", "Sparkly", "Modern", "Vintage", "Royal", "Floral",
+                             "Designer", "Satin", "Lace", "Velvet", "Chiffon", "Silk", "Beaded" };
+const char* SIZES[] = { "XS", "S", "M", "L", "XL" };
+const double SIZE_WEIGHTS[] = { 8, 26, 34, 22, 10 };
+const char* COLORS[] = { "Black", "White", "Ivory", "Red", "Pink", "Blue", "Navy", "Green", "Gold",
+                         "Silver", "Purple", "Teal", "Yellow", "Gray", "Maroon", "Peach" };
+const char* METHODS[] = { "Cash", "Credit Card", "Debit Card", "Online" };
+const double METHOD_WEIGHTS[] = { 30, 30, 20, 20 };
+
+template <size_t N>
+size_t countOf(const char* (&)[N]) { return N; }
+
+class Generator {
+public:
+    explicit Generator(const Options& opts) : opts(opts), rng(opts.seed) {}
+
+    bool run();
+
+private:
+    const Options& opts;
+    std::mt19937_64 rng;
+    long asOfDay = 0;
+
+    // Dress state needed to keep bookings non-overlapping
+    std::vector<double> dressPrice;
+    std::vector<long> dressBusyUntil;
+    std::vector<char> dressRented;
+
+    double uniform() { return std::uniform_real_distribution<double>(0.0, 1.0)(rng); }
+    long range(long lo, long hi) { return std::uniform_int_distribution<long>(lo, hi)(rng); }
+    template <size_t N>
+    const char* pick(const char* (&items)[N]) { return items[range(0, static_cast<long>(N) - 1)]; }
+    size_t weighted(const double* weights, size_t n);
+
+    FILE* open(const char* name);
+    bool writeUsers();
+    bool writeCustomers();
+    void assignDressPrices();
+    bool writeRentals();
+    bool writeDresses();
+    bool writeLoadScript();
+};
+
+size_t Generator::weighted(const double* weights, size_t n) {
+    double total = 0.0;
+    for (size_t i = 0; i < n; ++i) total += weights[i];
+    double r = uniform() * total;
+    for (size_t i = 0; i < n; ++i) {
+        if (r < weights[i]) return i;
+        r -= weights[i];
+    }
+    return n - 1;
+}
+
+FILE* Generator::open(const char* name) {
+    std::string path = opts.outDir + "/" + name;
+    FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) {
+        std::cerr << "Error: cannot open " << path << " for writing." << std::endl;
+        return nullptr;
+    }
+    static const size_t BUFFER_SIZE = 1 << 20;
+    std::setvbuf(f, nullptr, _IOFBF, BUFFER_SIZE);
+    return f;
+}
+
+bool Generator::writeUsers() {
+    FILE* f = open("users.tsv");
+    if (!f) return false;
+    for (long id = 1; id <= opts.users; ++id) {
+        const char* role = id == 1 ? "Administrator" : "Staff";
+        std::fprintf(f, "%ld\tstaff%04ld\t%s\t%s %s\tstaff%04ld@dressrental.com\t01%08ld\t%s\n",
+                     id, id, role, pick(FIRST_NAMES), pick(LAST_NAMES), id,
+                     range(10000000, 99999999), id == 1 ? "Admin2025!@" : "Staff2025!@");
+    }
+    std::fclose(f);
+    return true;
+}
+
+bool Generator::writeCustomers() {
+    FILE* f = open("customers.tsv");
+    if (!f) return false;
+    for (long id = 1; id <= opts.customers; ++id) {
+        const char* first = pick(FIRST_NAMES);
+        const char* last = pick(LAST_NAMES);
+        // Ages 18-70, weighted towards 22-40 (the typical event-goer)
+        long ageDays = static_cast<long>((18.0 + 52.0 * std::pow(uniform(), 1.8)) * 365.25);
+        long dob = asOfDay - ageDays;
+        int y, m, d;
+        civilFromDays(dob, y, m, d);
+
+        // IC: YYMMDD SS NNNNNNN without separators (InputValidator::isValidIC); the serial keeps it unique
+        std::fprintf(f, "%ld\t%s %s\t%02d%02d%02d%02d%07ld\t01%08ld\t", id, first, last,
+                     y % 100, m, d, STATE_CODES[range(0, 13)], id, range(10000000, 99999999));
+        std::string email;
+        for (const char* p = first; *p; ++p) if (*p != ' ') email += static_cast<char>(std::tolower(*p));
+        email += '.';
+        for (const char* p = last; *p; ++p) if (*p != ' ') email += static_cast<char>(std::tolower(*p));
+        std::fprintf(f, "%s%ld@example.com\t%ld %s, %s\t%04d-%02d-%02d\n",
+                     email.c_str(), id, range(1, 999), pick(STREETS), pick(CITIES), y, m, d);
+    }
+    std::fclose(f);
+    return true;
+}
+
+void Generator::assignDressPrices() {
+    const size_t categoryCount = sizeof(CATEGORIES) / sizeof(CATEGORIES[0]);
+    std::vector<double> categoryWeights(categoryCount);
+    for (size_t i = 0; i < categoryCount; ++i) categoryWeights[i] = CATEGORIES[i].weight;
+    std::lognormal_distribution<double> priceSpread(0.0, 0.25);
+
+    dressPrice.assign(opts.dresses + 1, 0.0);
+    dressBusyUntil.assign(opts.dresses + 1, 0);
+    dressRented.assign(opts.dresses + 1, 0);
+
+    // Only prices are needed up front; the rows are written after the rentals pass
+    // because AvailabilityStatus depends on which dresses are still out
+    for (long id = 1; id <= opts.dresses; ++id) {
+        const Category& cat = CATEGORIES[weighted(categoryWeights.data(), categoryCount)];
+        double price = std::round(cat.basePrice * priceSpread(rng) / 5.0) * 5.0;
+        if (price < 30.0) price = 30.0;
+        dressPrice[id] = price;
+    }
+}
+
+bool Generator::writeRentals() {
+    FILE* rentalsFile = open("rentals.tsv");
+    FILE* itemsFile = open("rental_items.tsv");
+    FILE* paymentsFile = open("payments.tsv");
+    FILE* logFile = open("activity_log.tsv");
+    if (!rentalsFile || !itemsFile || !paymentsFile || !logFile) return false;
+
+    // Daily demand: weekends and the wedding seasons (Mar-Apr, Nov-Dec) are busier
+    const long firstDay = asOfDay - opts.days + 1;
+    std::vector<double> dayWeight(opts.days);
+    double totalWeight = 0.0;
+    for (int i = 0; i < opts.days; ++i) {
+        long day = firstDay + i;
+        int y, m, d;
+        civilFromDays(day, y, m, d);
+        int weekday = static_cast<int>(((day % 7) + 11) % 7); // 0 = Sunday
+        double w = (weekday == 5 || weekday == 6) ? 1.8 : (weekday == 0 ? 1.3 : 1.0);
+        if (m == 3 || m == 4 || m == 11 || m == 12) w *= 1.5;
+        if (m == 1 || m == 2) w *= 0.8;
+        w *= 0.6 + 0.4 * (static_cast<double>(i) / opts.days); // business grows over time
+        dayWeight[i] = w;
+        totalWeight += w;
+    }
+
+    static const double DURATION_WEIGHTS[] = { 0, 6, 12, 20, 14, 10, 8, 10, 4, 3, 3, 2, 2, 2, 4 };
+    static const double ITEM_WEIGHTS[] = { 0, 60, 22, 10, 5, 3 };
+
+    long rentalID = 0, itemID = 0, paymentID = 0, logID = 0;
+    double carry = 0.0;
+    for (int i = 0; i < opts.days && rentalID < opts.rentals; ++i) {
+        const long day = firstDay + i;
+        carry += opts.rentals * dayWeight[i] / totalWeight;
+        long todayCount = static_cast<long>(carry);
+        carry -= todayCount;
+        const std::string rentalDate = formatDate(day);
+
+        for (long n = 0; n < todayCount && rentalID < opts.rentals; ++n) {
+            int duration = static_cast<int>(weighted(DURATION_WEIGHTS, 15));
+            long due = day + duration;
+
+            // Repeat customers: skew selection towards a loyal core
+            long customerID = 1 + static_cast<long>((opts.customers - 1) * std::pow(uniform(), 2.2));
+            int wanted = static_cast<int>(weighted(ITEM_WEIGHTS, 6));
+
+            // Return behaviour: most on time, some late, a few very late
+            double r = uniform();
+            long returnDay = r < 0.85 ? due - range(0, 1) : (r < 0.97 ? due + range(1, 7) : due + range(8, 30));
+            if (returnDay < day) returnDay = day;
+            bool active = returnDay > asOfDay;
+
+            std::vector<long> chosen;
+            for (int k = 0; k < wanted; ++k) {
+                for (int attempt = 0; attempt < 8; ++attempt) {
+                    long dressID = range(1, opts.dresses);
+                    if (dressBusyUntil[dressID] < day &&
+                        std::find(chosen.begin(), chosen.end(), dressID) == chosen.end()) {
+                        chosen.push_back(dressID);
+                        break;
+                    }
+                }
+            }
+            if (chosen.empty()) continue;
+
+            ++rentalID;
+            double total = 0.0;
+            for (long dressID : chosen) {
+                total += dressPrice[dressID] * duration;
+                dressBusyUntil[dressID] = active ? asOfDay + 365 : returnDay;
+                dressRented[dressID] = active ? 1 : 0;
+                std::fprintf(itemsFile, "%ld\t%ld\t%ld\t%.2f\n", ++itemID, rentalID, dressID, dressPrice[dressID]);
+            }
+            double lateFee = (!active && returnDay > due) ? (returnDay - due) * 10.0 : 0.0;
+            long staff = range(1, opts.users);
+
+            if (active) {
+                std::fprintf(rentalsFile, "%ld\t%ld\t%s\t%s\t\\N\t%.2f\t0.00\tActive\t%ld\n",
+                             rentalID, customerID, rentalDate.c_str(), formatDate(due).c_str(), total, staff);
+            } else {
+                std::fprintf(rentalsFile, "%ld\t%ld\t%s\t%s\t%s\t%.2f\t%.2f\tReturned\t%ld\n",
+                             rentalID, customerID, rentalDate.c_str(), formatDate(due).c_str(),
+                             formatDate(returnDay).c_str(), total, lateFee, staff);
+            }
+            std::fprintf(logFile, "%ld\t%ld\tCreate Rental\tRentals\t%ld\tGenerated rental\t%s 10:%02ld:00\n",
+                         ++logID, staff, rentalID, rentalDate.c_str(), range(0, 59));
+
+            // Payments: most pay in full up front, some split deposit/balance, a few still owe
+            const char* method = METHODS[weighted(METHOD_WEIGHTS, 4)];
+            double p = uniform();
+            std::string ref = std::string(method) == "Cash" ? "" : "TXN" + std::to_string(rentalID);
+            if (p < 0.80) {
+                const char* status = uniform() < 0.97 ? "Completed" : (uniform() < 0.5 ? "Failed" : "Refunded");
+                std::fprintf(paymentsFile, "%ld\t%ld\t%.2f\t%s\t%s\t%s\t%s\t%ld\n", ++paymentID, rentalID, total,
+                             method, rentalDate.c_str(), status, ref.c_str(), staff);
+            } else if (p < 0.92) {
+                double deposit = std::round(total * 50.0) / 100.0;
+                std::fprintf(paymentsFile, "%ld\t%ld\t%.2f\t%s\t%s\tCompleted\t%s\t%ld\n", ++paymentID, rentalID,
+                             deposit, method, rentalDate.c_str(), ref.c_str(), staff);
+                if (!active) {
+                    std::fprintf(paymentsFile, "%ld\t%ld\t%.2f\t%s\t%s\tCompleted\t%s\t%ld\n", ++paymentID, rentalID,
+                                 total - deposit, method, formatDate(returnDay).c_str(), ref.c_str(), staff);
+                }
+            } else {
+                std::fprintf(paymentsFile, "%ld\t%ld\t%.2f\t%s\t%s\tPending\t%s\t%ld\n", ++paymentID, rentalID,
+                             total, method, rentalDate.c_str(), ref.c_str(), staff);
+            }
+            std::fprintf(logFile, "%ld\t%ld\tProcess Payment\tPayments\t%ld\tGenerated payment\t%s 10:%02ld:30\n",
+                         ++logID, staff, paymentID, rentalDate.c_str(), range(0, 59));
+
+            if (!active) {
+                if (lateFee > 0.0) {
+                    std::fprintf(paymentsFile, "%ld\t%ld\t%.2f\tCash\t%s\tCompleted\t\t%ld\n", ++paymentID, rentalID,
+                                 lateFee, formatDate(returnDay).c_str(), staff);
+                }
+                std::fprintf(logFile, "%ld\t%ld\tReturn Rental\tRentals\t%ld\tGenerated return\t%s 16:%02ld:00\n",
+                             ++logID, staff, rentalID, formatDate(returnDay).c_str(), range(0, 59));
+            }
+        }
+    }
+    std::fclose(rentalsFile);
+    std::fclose(itemsFile);
+    std::fclose(paymentsFile);
+    std::fclose(logFile);
+
+    std::cout << "Generated " << rentalID << " rentals, " << itemID << " rental items, "
+              << paymentID << " payments, " << logID << " activity log entries." << std::endl;
+    return true;
+}
+
+bool Generator::writeDresses() {
+    FILE* f = open("dresses.tsv");
+    if (!f) return false;
+    const size_t categoryCount = sizeof(CATEGORIES) / sizeof(CATEGORIES[0]);
+    std::mt19937_64 dressRng(opts.seed ^ 0x9e3779b97f4a7c15ULL);
+    for (long id = 1; id <= opts.dresses; ++id) {
+        // Derive attributes from the dress price so they stay consistent with rental prices
+        size_t best = 0;
+        double bestDiff = 1e9;
+        for (size_t c = 0; c < categoryCount; ++c) {
+            double diff = std::fabs(std::log(dressPrice[id] / CATEGORIES[c].basePrice));
+            double jitter = std::uniform_real_distribution<double>(0.0, 0.3)(dressRng);
+            if (diff + jitter < bestDiff) { bestDiff = diff + jitter; best = c; }
+        }
+        double cond = std::uniform_real_distribution<double>(0.0, 1.0)(dressRng);
+        double sizeRoll = std::uniform_real_distribution<double>(0.0, 100.0)(dressRng);
+        size_t size = 0;
+        for (double acc = SIZE_WEIGHTS[0]; size < 4 && sizeRoll >= acc; acc += SIZE_WEIGHTS[++size]) {}
+        std::fprintf(f, "%ld\t%s %s #%ld\t%s\t%s\t%s\t%.2f\t%s\t%s\tClean\t1\t1\n", id,
+                     ADJECTIVES[dressRng() % countOf(ADJECTIVES)], STYLES[dressRng() % countOf(STYLES)], id,
+                     CATEGORIES[best].name, SIZES[size], COLORS[dressRng() % countOf(COLORS)], dressPrice[id],
+                     cond < 0.85 ? "Good" : (cond < 0.97 ? "Fair" : "Poor"),
+                     dressRented[id] ? "Rented" : "Available");
+    }
+    std::fclose(f);
+    return true;
+}
+
+bool Generator::writeLoadScript() {
+    FILE* sqlFile = open("load.sql");
+    if (!sqlFile) return false;
+    std::fprintf(sqlFile,
+        "-- Generated by tools/datagen (seed %llu, as of %s)\n"
+        "-- Run from this directory: mysql --local-infile=1 -u root dress_rental_db < load.sql\n"
+        "SET FOREIGN_KEY_CHECKS = 0;\n"
+        "SET UNIQUE_CHECKS = 0;\n"
+        "SET autocommit = 0;\n"
+        "TRUNCATE TABLE CleaningJobs;\n"
+        "TRUNCATE TABLE Reservations;\n"
+        "TRUNCATE TABLE Reminders;\n"
+        "TRUNCATE TABLE SystemCounters;\n"
+        "TRUNCATE TABLE RentalBalances;\n"
+        "TRUNCATE TABLE DressDailyStock;\n"
+        "TRUNCATE TABLE ActivityLog;\n"
+        "TRUNCATE TABLE Payments;\n"
+        "TRUNCATE TABLE RentalItems;\n"
+        "TRUNCATE TABLE Rentals;\n"
+        "TRUNCATE TABLE Dresses;\n"
+        "TRUNCATE TABLE Customers;\n"
+        "TRUNCATE TABLE Users;\n"
+        "LOAD DATA LOCAL INFILE 'users.tsv' INTO TABLE Users\n"
+        "  (UserID, Username, Role, FullName, Email, Phone, @pw)\n"
+        "  SET PasswordHash = SHA2(CONCAT('dress_rental_salt_2025_', @pw), 256);\n"
+        "LOAD DATA LOCAL INFILE 'customers.tsv' INTO TABLE Customers\n"
+        "  (CustomerID, Name, IC_Number, Phone, Email, Address, DateOfBirth);\n"
+        "LOAD DATA LOCAL INFILE 'dresses.tsv' INTO TABLE Dresses\n"
+        "  (DressID, DressName, Category, Size, Color, RentalPrice, ConditionStatus, AvailabilityStatus,\n"
+        "   CleaningStatus, StockQuantity, MinimumStockLevel);\n"
+        "LOAD DATA LOCAL INFILE 'rentals.tsv' INTO TABLE Rentals\n"
+        "  (RentalID, CustomerID, RentalDate, DueDate, ReturnDate, TotalAmount, LateFee, Status, CreatedBy)\n"
+        "  SET HeldThrough = IF(Status = 'Active', GREATEST(DueDate, CURDATE()), DueDate);\n"
+        "LOAD DATA LOCAL INFILE 'rental_items.tsv' INTO TABLE RentalItems\n"
+        "  (RentalItemID, RentalID, DressID, RentalPrice);\n"
+        "LOAD DATA LOCAL INFILE 'payments.tsv' INTO TABLE Payments\n"
+        "  (PaymentID, RentalID, Amount, PaymentMethod, PaymentDate, Status, @ref, ProcessedBy)\n"
+        "  SET TransactionReference = NULLIF(@ref, '');\n"
+        "LOAD DATA LOCAL INFILE 'activity_log.tsv' INTO TABLE ActivityLog\n"
+        "  (LogID, UserID, Action, TableName, RecordID, Details, Timestamp);\n"
+        "INSERT INTO RentalBalances (RentalID, AmountDue, AmountPaid)\n"
+        "  SELECT r.RentalID, r.TotalAmount + r.LateFee, COALESCE(SUM(p.Amount), 0)\n"
+        "  FROM Rentals r LEFT JOIN Payments p ON p.RentalID = r.RentalID AND p.Status = 'Completed'\n"
+        "  GROUP BY r.RentalID;\n"
+        "INSERT INTO DressDailyStock (DressID, StockDate, Reserved)\n"
+        "  SELECT ri.DressID, DATE_ADD(r.RentalDate, INTERVAL o.n DAY) AS StockDate, COUNT(*)\n"
+        "  FROM Rentals r JOIN RentalItems ri ON ri.RentalID = r.RentalID\n"
+        "  JOIN (SELECT h.n * 100 + t.n * 10 + u.n AS n FROM\n"
+        "        (SELECT 0 AS n UNION ALL SELECT 1 UNION ALL SELECT 2 UNION ALL SELECT 3 UNION ALL SELECT 4\n"
+        "         UNION ALL SELECT 5 UNION ALL SELECT 6 UNION ALL SELECT 7 UNION ALL SELECT 8 UNION ALL SELECT 9) h\n"
+        "        CROSS JOIN\n"
+        "        (SELECT 0 AS n UNION ALL SELECT 1 UNION ALL SELECT 2 UNION ALL SELECT 3 UNION ALL SELECT 4\n"
+        "         UNION ALL SELECT 5 UNION ALL SELECT 6 UNION ALL SELECT 7 UNION ALL SELECT 8 UNION ALL SELECT 9) t\n"
+        "        CROSS JOIN\n"
+        "        (SELECT 0 AS n UNION ALL SELECT 1 UNION ALL SELECT 2 UNION ALL SELECT 3 UNION ALL SELECT 4\n"
+        "         UNION ALL SELECT 5 UNION ALL SELECT 6 UNION ALL SELECT 7 UNION ALL SELECT 8 UNION ALL SELECT 9) u) o\n"
+        "    ON o.n <= DATEDIFF(r.HeldThrough, r.RentalDate)\n"
+        "  WHERE r.Status = 'Active'\n"
+        "  GROUP BY ri.DressID, StockDate;\n"
+        "UPDATE Dresses d\n"
+        "  JOIN (SELECT ri.DressID, COUNT(*) AS Units FROM RentalItems ri\n"
+        "        JOIN Rentals r ON r.RentalID = ri.RentalID WHERE r.Status = 'Active' GROUP BY ri.DressID) a\n"
+        "    ON a.DressID = d.DressID\n"
+        "  SET d.UnitsOut = a.Units;\n"
+        "UPDATE Dresses SET LowStock = (StockQuantity - UnitsOut < MinimumStockLevel);\n"
+        "COMMIT;\n"
+        "SET UNIQUE_CHECKS = 1;\n"
+        "SET FOREIGN_KEY_CHECKS = 1;\n"
+        "ANALYZE TABLE Users, Customers, Dresses, Rentals, RentalItems, Payments, RentalBalances, DressDailyStock,\n"
+        "  ActivityLog, Reservations, CleaningJobs;\n",
+        opts.seed, formatDate(asOfDay).c_str());
+    std::fclose(sqlFile);
+    return true;
+}
+
+bool Generator::run() {
+    if (opts.asOf.empty()) {
+        asOfDay = todayDays();
+    } else if (!parseDate(opts.asOf, asOfDay)) {
+        std::cerr << "Error: --as-of must be YYYY-MM-DD." << std::endl;
+        return false;
+    }
+    // Each table draws from the shared RNG in a fixed order, which keeps output reproducible
+    if (!writeUsers() || !writeCustomers()) return false;
+    assignDressPrices();
+    return writeRentals() && writeDresses() && writeLoadScript();
+}
+
+void printUsage() {
+    std::cout << "Usage: datagen [options]\n"
+              << "  --users N       staff accounts (default 20)\n"
+              << "  --customers N   customers (default 100000)\n"
+              << "  --dresses N     dresses (default 20000)\n"
+              << "  --rentals N     rentals (default 300000)\n"
+              << "  --days N        days of history ending at --as-of (default 730)\n"
+              << "  --as-of DATE    last day of history, YYYY-MM-DD (default today)\n"
+              << "  --seed N        RNG seed (default 20250101)\n"
+              << "  --out DIR       output directory (default .)\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opts;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            printUsage();
+            return 0;
+        }
+        if (i + 1 >= argc) {
+            std::cerr << "Error: missing value for " << arg << std::endl;
+            printUsage();
+            return 1;
+        }
+        std::string value = argv[++i];
+        if (arg == "--users") opts.users = std::atol(value.c_str());
+        else if (arg == "--customers") opts.customers = std::atol(value.c_str());
+        else if (arg == "--dresses") opts.dresses = std::atol(value.c_str());
+        else if (arg == "--rentals") opts.rentals = std::atol(value.c_str());
+        else if (arg == "--days") opts.days = std::atoi(value.c_str());
+        else if (arg == "--as-of") opts.asOf = value;
+        else if (arg == "--seed") opts.seed = std::strtoull(value.c_str(), nullptr, 10);
+        else if (arg == "--out") opts.outDir = value;
+        else {
+            std::cerr << "Error: unknown option " << arg << std::endl;
+            printUsage();
+            return 1;
+        }
+    }
+    if (opts.users < 1 || opts.customers < 1 || opts.dresses < 1 || opts.rentals < 0 || opts.days < 1) {
+        std::cerr << "Error: counts must be positive." << std::endl;
+        return 1;
+    }
+
+    Generator generator(opts);
+    return generator.run() ? 0 : 1;
+}
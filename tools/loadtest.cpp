@@ -0,0 +1,568 @@
+// Concurrent load driver for the Dress Rental Management System.
+//
+// Runs N worker threads against the real managers (one MySQL connection per
+// thread) with a weighted mix of operations and reports throughput and latency
+// percentiles per operation. Point it at a database filled by tools/datagen.
+//
+// Usage:
+//   ./loadtest --threads 16 --duration 60 --mix create=10,return=10,search=50,payment=20,report=10
+//
+// --scenario race instead has every thread rent and return the same few
+// dresses as fast as it can and checks that no dress is ever rented out
+// beyond its stock of units:
+//   ./loadtest --scenario race --threads 32 --hot 4 --duration 30
+//
+// --scenario terminals runs the same mix through a rental_system --server,
+// each thread a terminal with its own socket and login, so the server's
+// workers and database connections are shared by all of them:
+//   ./loadtest --scenario terminals --threads 100 --duration 60
+
+#include "DatabaseManager.h"
+#include "CustomerManager.h"
+#include "DressManager.h"
+#include "RentalManager.h"
+#include "PaymentManager.h"
+#include "ReportManager.h"
+#include "SchemaMigrator.h"
+#include "RentalClient.h"
+#include "RentalServer.h"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <ctime>
+#include <cstdlib>
+#include <memory>
+
+namespace {
+
+enum Operation { OP_CREATE, OP_RETURN, OP_SEARCH, OP_PAYMENT, OP_REPORT, OP_COUNT };
+const char* OP_NAMES[OP_COUNT] = { "create", "return", "search", "payment", "report" };
+
+struct Options {
+    int threads = 8;
+    int durationSeconds = 30;
+    long maxOps = 0;                      // 0 = run for the whole duration
+    unsigned long long seed = 42;
+    double mix[OP_COUNT] = { 10, 10, 50, 20, 10 };
+    bool race = false;                    // --scenario race
+    int hotDresses = 4;
+    bool terminals = false;               // --scenario terminals
+    std::string socketPath = RentalServer::socketPathFromConfig();
+    std::string user = "staff0002";
+    std::string password = "Staff2025!@";
+};
+
+struct OpStats {
+    std::vector<double> latenciesMs;
+    long failed = 0;
+};
+
+// Discards everything written to it; the managers print as they work
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+    std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+};
+
+// Reference data loaded once before the workers start
+struct Dataset {
+    int maxCustomerID = 0;
+    int maxDressID = 0;
+    int maxRentalID = 0;
+    std::vector<int> activeRentals;       // shared pool for returns, guarded by poolMutex
+    std::mutex poolMutex;
+    std::string today;
+    std::string year;
+
+    // Race scenario: the contested dresses, their units and how many workers
+    // hold each one
+    std::vector<int> hotDresses;
+    std::vector<int> hotStock;
+    std::unique_ptr<std::atomic<int>[]> holders;
+    std::atomic<long> doubleBookings{0};
+
+    // Terminals scenario: workers that could not connect or log in
+    std::atomic<int> terminalsFailed{0};
+};
+
+const char* SEARCH_TERMS[] = { "Gown", "Red", "Elegant", "Kebaya", "Silk", "Lim", "Ahmad", "Siti", "Tan", "Kumar" };
+
+std::string currentDate() {
+    std::time_t now = std::time(nullptr);
+    std::tm tmNow;
+    localtime_r(&now, &tmNow);
+    char buf[16];
+    std::strftime(buf, sizeof(buf), "%Y-%m-%d", &tmNow);
+    return buf;
+}
+
+bool loadDataset(Dataset& data) {
+    DatabaseManager& db = DatabaseManager::getInstance();
+    sql::ResultSet* res = db.executeSelect(
+        "SELECT (SELECT COALESCE(MAX(CustomerID), 0) FROM Customers) AS MaxCustomer, "
+        "(SELECT COALESCE(MAX(DressID), 0) FROM Dresses) AS MaxDress, "
+        "(SELECT COALESCE(MAX(RentalID), 0) FROM Rentals) AS MaxRental");
+    if (!res) return false;
+    if (res->next()) {
+        data.maxCustomerID = res->getInt("MaxCustomer");
+        data.maxDressID = res->getInt("MaxDress");
+        data.maxRentalID = res->getInt("MaxRental");
+    }
+    delete res;
+
+    res = db.executeSelect("SELECT RentalID FROM Rentals WHERE Status = 'Active' LIMIT 100000");
+    if (!res) return false;
+    while (res->next()) {
+        data.activeRentals.push_back(res->getInt("RentalID"));
+    }
+    delete res;
+
+    data.today = currentDate();
+    data.year = data.today.substr(0, 4);
+    return data.maxCustomerID > 0 && data.maxDressID > 0;
+}
+
+bool loadHotDresses(Dataset& data, int count) {
+    sql::ResultSet* res = DatabaseManager::getInstance().executeSelect(
+        "SELECT DressID, StockQuantity FROM Dresses WHERE AvailabilityStatus = 'Available' ORDER BY DressID LIMIT " +
+        std::to_string(count));
+    if (!res) return false;
+    while (res->next()) {
+        data.hotDresses.push_back(res->getInt("DressID"));
+        data.hotStock.push_back(res->getInt("StockQuantity"));
+    }
+    delete res;
+    data.holders.reset(new std::atomic<int>[data.hotDresses.size()]);
+    for (size_t i = 0; i < data.hotDresses.size(); ++i) data.holders[i].store(0);
+    return !data.hotDresses.empty();
+}
+
+// Rentals still active on the contested dresses after the run; more than a
+// dress has units is a double booking that slipped past the in-run check
+long countDoubleBookedDresses(const Dataset& data) {
+    std::string ids;
+    for (size_t i = 0; i < data.hotDresses.size(); ++i) {
+        if (i > 0) ids += ",";
+        ids += std::to_string(data.hotDresses[i]);
+    }
+    sql::ResultSet* res = DatabaseManager::getInstance().executeSelect(
+        "SELECT COUNT(*) AS Dresses FROM (SELECT ri.DressID FROM RentalItems ri "
+        "JOIN Rentals r ON ri.RentalID = r.RentalID "
+        "JOIN Dresses d ON d.DressID = ri.DressID "
+        "WHERE r.Status = 'Active' AND ri.DressID IN (" + ids + ") "
+        "GROUP BY ri.DressID, d.StockQuantity HAVING COUNT(*) > d.StockQuantity) AS doubled");
+    if (!res) return -1;
+    long count = res->next() ? res->getInt("Dresses") : -1;
+    delete res;
+    return count;
+}
+
+class Worker {
+public:
+    Worker(int index, const Options& opts, Dataset& data, std::atomic<bool>& stop, std::atomic<long>& opsDone)
+        : opts(opts), data(data), stop(stop), opsDone(opsDone),
+          rng(opts.seed + static_cast<unsigned long long>(index)), stats(OP_COUNT) {}
+
+    void run();
+    const std::vector<OpStats>& results() const { return stats; }
+
+private:
+    const Options& opts;
+    Dataset& data;
+    std::atomic<bool>& stop;
+    std::atomic<long>& opsDone;
+    std::mt19937_64 rng;
+    std::vector<OpStats> stats;
+    std::vector<int> created;             // rentals this worker created, returned first
+
+    CustomerManager customers;
+    DressManager dresses;
+    RentalManager rentals;
+    PaymentManager payments;
+    ReportManager reports;
+
+    // Terminals scenario: this worker's connection to the server
+    RentalClient terminal;
+
+    int randomInt(int lo, int hi) { return std::uniform_int_distribution<int>(lo, hi)(rng); }
+    bool execute(Operation op);
+    bool executeRemote(Operation op);
+    void race();
+    void record(Operation op, std::chrono::steady_clock::time_point start, bool ok);
+    int takeRentalForReturn();
+};
+
+int Worker::takeRentalForReturn() {
+    if (!created.empty()) {
+        int id = created.back();
+        created.pop_back();
+        return id;
+    }
+    std::lock_guard<std::mutex> lock(data.poolMutex);
+    if (data.activeRentals.empty()) return 0;
+    int id = data.activeRentals.back();
+    data.activeRentals.pop_back();
+    return id;
+}
+
+bool Worker::execute(Operation op) {
+    if (opts.terminals) return executeRemote(op);
+    switch (op) {
+        case OP_CREATE: {
+            std::vector<int> dressIDs;
+            int items = randomInt(1, 3);
+            for (int i = 0; i < items; ++i) dressIDs.push_back(randomInt(1, data.maxDressID));
+            int rentalID = rentals.createRental(randomInt(1, data.maxCustomerID), data.today,
+                                                randomInt(1, 7), dressIDs);
+            if (rentalID > 0) created.push_back(rentalID);
+            return rentalID > 0;
+        }
+        case OP_RETURN: {
+            int rentalID = takeRentalForReturn();
+            return rentalID > 0 && rentals.returnRental(rentalID, data.today);
+        }
+        case OP_SEARCH: {
+            const char* term = SEARCH_TERMS[randomInt(0, 9)];
+            if (randomInt(0, 1) == 0) {
+                dresses.searchDresses(term);
+            } else {
+                customers.searchCustomers(term);
+            }
+            return true;
+        }
+        case OP_PAYMENT: {
+            int rentalID = created.empty() ? randomInt(1, std::max(1, data.maxRentalID))
+                                           : created[randomInt(0, static_cast<int>(created.size()) - 1)];
+            return payments.createPayment(rentalID, Money::fromCents(5000), "Cash", data.today);
+        }
+        case OP_REPORT:
+            switch (randomInt(0, 3)) {
+                case 0: reports.generateMonthlySalesReport(data.year); break;
+                case 1: reports.generateRentalSummaryReport(); break;
+                case 2: reports.generateOverdueItemsReport(); break;
+                default: reports.displayDashboard(); break;
+            }
+            return true;
+        default:
+            return false;
+    }
+}
+
+// The same operations as commands to the server; a terminal that lost its
+// connection fails every operation from then on
+bool Worker::executeRemote(Operation op) {
+    RentalClient::Response response;
+    switch (op) {
+        case OP_CREATE: {
+            std::string dressIDs;
+            int items = randomInt(1, 3);
+            for (int i = 0; i < items; ++i) {
+                if (i > 0) dressIDs += ",";
+                dressIDs += std::to_string(randomInt(1, data.maxDressID));
+            }
+            if (!terminal.request("rent " + std::to_string(randomInt(1, data.maxCustomerID)) + " " +
+                                  std::to_string(randomInt(1, 7)) + " " + dressIDs, response) || !response.ok) {
+                return false;
+            }
+            // "Rental #123 created, ..."
+            size_t hash = response.body.find('#');
+            int rentalID = hash == std::string::npos ? 0 : std::atoi(response.body.c_str() + hash + 1);
+            if (rentalID > 0) created.push_back(rentalID);
+            return true;
+        }
+        case OP_RETURN: {
+            int rentalID = takeRentalForReturn();
+            return rentalID > 0 && terminal.request("return " + std::to_string(rentalID), response) && response.ok;
+        }
+        case OP_SEARCH: {
+            const char* term = SEARCH_TERMS[randomInt(0, 9)];
+            const char* command = randomInt(0, 1) == 0 ? "search " : "customers ";
+            return terminal.request(command + std::string(term), response) && response.ok;
+        }
+        case OP_PAYMENT: {
+            int rentalID = created.empty() ? randomInt(1, std::max(1, data.maxRentalID))
+                                           : created[randomInt(0, static_cast<int>(created.size()) - 1)];
+            return terminal.request("pay " + std::to_string(rentalID) + " 50.00 Cash", response) && response.ok;
+        }
+        case OP_REPORT:
+            // The catalogue and calendar snapshots the server shares
+            if (randomInt(0, 1) == 0) {
+                return terminal.request("browse availability=Available", response) && response.ok;
+            }
+            return terminal.request("free " + data.today, response) && response.ok;
+        default:
+            return false;
+    }
+}
+
+void Worker::record(Operation op, std::chrono::steady_clock::time_point start, bool ok) {
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    stats[op].latenciesMs.push_back(elapsed.count());
+    if (!ok) stats[op].failed++;
+}
+
+void Worker::race() {
+    // A failed create is a race lost to another worker (or a retry that gave up)
+    size_t slot = static_cast<size_t>(randomInt(0, static_cast<int>(data.hotDresses.size()) - 1));
+    std::vector<int> dressIDs(1, data.hotDresses[slot]);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    int rentalID = -1;
+    try {
+        rentalID = rentals.createRental(randomInt(1, data.maxCustomerID), data.today, 1, dressIDs);
+    } catch (std::exception&) {
+    }
+    record(OP_CREATE, start, rentalID > 0);
+    if (rentalID <= 0) return;
+
+    // Hold the dress briefly like a counter would; no more workers than it has
+    // units may win it meanwhile
+    if (data.holders[slot].fetch_add(1) >= data.hotStock[slot]) data.doubleBookings++;
+    std::this_thread::sleep_for(std::chrono::microseconds(randomInt(0, 2000)));
+    data.holders[slot].fetch_sub(1);
+
+    start = std::chrono::steady_clock::now();
+    bool returned = false;
+    try {
+        returned = rentals.returnRental(rentalID, data.today);
+    } catch (std::exception&) {
+    }
+    record(OP_RETURN, start, returned);
+}
+
+void Worker::run() {
+    std::discrete_distribution<int> pickOp(opts.mix, opts.mix + OP_COUNT);
+    if (opts.terminals) {
+        RentalClient::Response response;
+        if (!terminal.connect(opts.socketPath) ||
+            !terminal.request("login " + opts.user + " " + opts.password, response) || !response.ok) {
+            data.terminalsFailed++;
+            return;
+        }
+    }
+    while (!stop.load(std::memory_order_relaxed)) {
+        if (opts.maxOps > 0 && opsDone.fetch_add(1) >= opts.maxOps) break;
+        if (opts.race) {
+            race();
+            continue;
+        }
+        Operation op = static_cast<Operation>(pickOp(rng));
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        bool ok = false;
+        try {
+            ok = execute(op);
+        } catch (std::exception&) {
+            ok = false;
+        }
+        record(op, start, ok);
+    }
+    DatabaseManager::getInstance().releaseThreadConnection();
+}
+
+double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) return 0.0;
+    size_t index = static_cast<size_t>(p * (sorted.size() - 1) + 0.5);
+    return sorted[std::min(index, sorted.size() - 1)];
+}
+
+bool parseMix(const std::string& spec, double* mix) {
+    for (int i = 0; i < OP_COUNT; ++i) mix[i] = 0.0;
+    std::stringstream ss(spec);
+    std::string entry;
+    while (std::getline(ss, entry, ',')) {
+        size_t eq = entry.find('=');
+        if (eq == std::string::npos) return false;
+        std::string name = entry.substr(0, eq);
+        int op = -1;
+        for (int i = 0; i < OP_COUNT; ++i) {
+            if (name == OP_NAMES[i]) op = i;
+        }
+        if (op < 0) return false;
+        mix[op] = std::atof(entry.substr(eq + 1).c_str());
+    }
+    return true;
+}
+
+void printUsage() {
+    std::cout << "Usage: loadtest [options]\n"
+              << "  --threads N      worker threads (default 8)\n"
+              << "  --duration SEC   run time in seconds (default 30)\n"
+              << "  --ops N          stop after N operations in total (default: no limit)\n"
+              << "  --seed N         RNG seed (default 42)\n"
+              << "  --mix SPEC       weights, e.g. create=10,return=10,search=50,payment=20,report=10\n"
+              << "  --scenario NAME  mix (default); race: all threads rent and return the same dresses;\n"
+              << "                   terminals: each thread runs the mix as a terminal of rental_system --server\n"
+              << "  --hot N          dresses contested in the race scenario (default 4)\n"
+              << "  --socket PATH    server socket for the terminals scenario (default: server_socket)\n"
+              << "  --user NAME      login of every terminal (default staff0002)\n"
+              << "  --password TEXT  its password (default Staff2025!@)\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opts;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            printUsage();
+            return 0;
+        }
+        if (i + 1 >= argc) {
+            std::cerr << "Error: missing value for " << arg << std::endl;
+            return 1;
+        }
+        std::string value = argv[++i];
+        if (arg == "--threads") opts.threads = std::atoi(value.c_str());
+        else if (arg == "--duration") opts.durationSeconds = std::atoi(value.c_str());
+        else if (arg == "--ops") opts.maxOps = std::atol(value.c_str());
+        else if (arg == "--seed") opts.seed = std::strtoull(value.c_str(), nullptr, 10);
+        else if (arg == "--hot") opts.hotDresses = std::atoi(value.c_str());
+        else if (arg == "--socket") opts.socketPath = value;
+        else if (arg == "--user") opts.user = value;
+        else if (arg == "--password") opts.password = value;
+        else if (arg == "--scenario") {
+            if (value != "mix" && value != "race" && value != "terminals") {
+                std::cerr << "Error: unknown scenario " << value << std::endl;
+                return 1;
+            }
+            opts.race = value == "race";
+            opts.terminals = value == "terminals";
+        }
+        else if (arg == "--mix") {
+            if (!parseMix(value, opts.mix)) {
+                std::cerr << "Error: invalid --mix " << value << std::endl;
+                return 1;
+            }
+        } else {
+            std::cerr << "Error: unknown option " << arg << std::endl;
+            printUsage();
+            return 1;
+        }
+    }
+    if (opts.threads < 1 || opts.durationSeconds < 1 || opts.hotDresses < 1) {
+        std::cerr << "Error: --threads, --duration and --hot must be positive." << std::endl;
+        return 1;
+    }
+
+    DatabaseManager& db = DatabaseManager::getInstance();
+    if (!db.connect()) {
+        std::cerr << "Failed to connect to database." << std::endl;
+        return 1;
+    }
+    SchemaMigrator migrator;
+    if (!migrator.migrate()) {
+        std::cerr << "Database schema is not up to date." << std::endl;
+        return 1;
+    }
+    Dataset data;
+    if (!loadDataset(data)) {
+        std::cerr << "Database has no customers or dresses; run tools/datagen first." << std::endl;
+        return 1;
+    }
+    if (opts.race) {
+        if (!loadHotDresses(data, opts.hotDresses)) {
+            std::cerr << "No available dresses to race for." << std::endl;
+            return 1;
+        }
+        std::cout << "Racing " << opts.threads << " threads for " << opts.durationSeconds << "s over "
+                  << data.hotDresses.size() << " dresses..." << std::endl;
+    } else if (opts.terminals) {
+        std::cout << "Running " << opts.threads << " terminals for " << opts.durationSeconds << "s against the server on "
+                  << opts.socketPath << "..." << std::endl;
+    } else {
+        std::cout << "Running " << opts.threads << " threads for " << opts.durationSeconds << "s against "
+                  << data.maxCustomerID << " customers, " << data.maxDressID << " dresses, "
+                  << data.activeRentals.size() << " active rentals..." << std::endl;
+    }
+
+    // Manager output would dominate the measurement, so silence it for the run
+    NullBuffer nullBuffer;
+    std::streambuf* savedOut = std::cout.rdbuf(&nullBuffer);
+    std::streambuf* savedErr = std::cerr.rdbuf(&nullBuffer);
+
+    std::atomic<bool> stop(false);
+    std::atomic<long> opsDone(0);
+    std::vector<Worker*> workers;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < opts.threads; ++i) {
+        workers.push_back(new Worker(i, opts, data, stop, opsDone));
+    }
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int i = 0; i < opts.threads; ++i) {
+        threads.push_back(std::thread(&Worker::run, workers[i]));
+    }
+
+    std::chrono::steady_clock::time_point deadline = start + std::chrono::seconds(opts.durationSeconds);
+    while (std::chrono::steady_clock::now() < deadline) {
+        if (opts.maxOps > 0 && opsDone.load() >= opts.maxOps) break;
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+    stop.store(true);
+    for (size_t i = 0; i < threads.size(); ++i) threads[i].join();
+    std::chrono::duration<double> wall = std::chrono::steady_clock::now() - start;
+
+    std::cout.rdbuf(savedOut);
+    std::cerr.rdbuf(savedErr);
+
+    // Merge per-thread samples
+    std::vector<OpStats> totals(OP_COUNT);
+    for (size_t w = 0; w < workers.size(); ++w) {
+        const std::vector<OpStats>& stats = workers[w]->results();
+        for (int op = 0; op < OP_COUNT; ++op) {
+            totals[op].latenciesMs.insert(totals[op].latenciesMs.end(),
+                                          stats[op].latenciesMs.begin(), stats[op].latenciesMs.end());
+            totals[op].failed += stats[op].failed;
+        }
+        delete workers[w];
+    }
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "\n" << std::left << std::setw(10) << "Operation" << std::right
+              << std::setw(10) << "Count" << std::setw(10) << "Failed" << std::setw(12) << "Ops/sec"
+              << std::setw(12) << "p50 (ms)" << std::setw(12) << "p99 (ms)" << std::setw(12) << "Max (ms)" << "\n";
+    std::cout << std::string(78, '-') << "\n";
+    size_t totalOps = 0;
+    for (int op = 0; op < OP_COUNT; ++op) {
+        std::vector<double>& samples = totals[op].latenciesMs;
+        std::sort(samples.begin(), samples.end());
+        totalOps += samples.size();
+        std::cout << std::left << std::setw(10) << OP_NAMES[op] << std::right
+                  << std::setw(10) << samples.size() << std::setw(10) << totals[op].failed
+                  << std::setw(12) << samples.size() / wall.count()
+                  << std::setw(12) << percentile(samples, 0.50)
+                  << std::setw(12) << percentile(samples, 0.99)
+                  << std::setw(12) << (samples.empty() ? 0.0 : samples.back()) << "\n";
+    }
+    std::cout << std::string(78, '-') << "\n";
+    std::cout << std::left << std::setw(10) << "total" << std::right << std::setw(10) << totalOps
+              << std::setw(10) << "" << std::setw(12) << totalOps / wall.count() << "\n";
+    std::cout << "Wall time: " << wall.count() << "s" << std::endl;
+
+    int exitCode = 0;
+    if (opts.terminals && data.terminalsFailed.load() > 0) {
+        std::cout << "\n" << data.terminalsFailed.load() << " of " << opts.threads
+                  << " terminals could not connect or log in to " << opts.socketPath << std::endl;
+        exitCode = 1;
+    }
+    if (opts.race) {
+        size_t won = totals[OP_CREATE].latenciesMs.size() - static_cast<size_t>(totals[OP_CREATE].failed);
+        long doubled = countDoubleBookedDresses(data);
+        std::cout << "\nRace: " << won << " rentals won, " << totals[OP_CREATE].failed
+                  << " lost to another counter, " << data.doubleBookings.load() << " double bookings seen, "
+                  << doubled << " dresses left with more active rentals than units" << std::endl;
+        if (data.doubleBookings.load() != 0 || doubled != 0) exitCode = 2;
+    }
+
+    db.disconnect();
+    return exitCode;
+}